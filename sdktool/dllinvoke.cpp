@@ -199,6 +199,54 @@ void ssc_data_set_matrix( ssc_data_t p_data, const char *name, ssc_number_t *pva
 	(*f)(p_data, name, pvalues, nrows, ncols);
 }
 
+void ssc_data_set_array_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int length, ssc_deleter_t deleter, void *user_data )
+{
+	static void (*f)(ssc_data_t, const char*, ssc_number_t*, int, ssc_deleter_t, void*) = NULL;
+	CHECK_DLL_LOADED();
+	if (!f && 0 == ( f = (void(*)(ssc_data_t, const char*, ssc_number_t*, int, ssc_deleter_t, void*))PROCADDR() )) FAIL_ON_LOCATE();
+	(*f)(p_data, name, pvalues, length, deleter, user_data);
+}
+
+void ssc_data_set_matrix_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int nrows, int ncols, ssc_deleter_t deleter, void *user_data )
+{
+	static void (*f)(ssc_data_t, const char*, ssc_number_t*, int, int, ssc_deleter_t, void*) = NULL;
+	CHECK_DLL_LOADED();
+	if (!f && 0 == ( f = (void(*)(ssc_data_t, const char*, ssc_number_t*, int, int, ssc_deleter_t, void*))PROCADDR() )) FAIL_ON_LOCATE();
+	(*f)(p_data, name, pvalues, nrows, ncols, deleter, user_data);
+}
+
+ssc_weather_t ssc_weather_create( const char *file )
+{
+	static ssc_weather_t (*f)(const char*) = NULL;
+	CHECK_DLL_LOADED();
+	if (!f && 0 == ( f = (ssc_weather_t(*)(const char*))PROCADDR() )) FAIL_ON_LOCATE();
+	return (*f)(file);
+}
+
+ssc_weather_t ssc_weather_create_from_data( ssc_data_t table )
+{
+	static ssc_weather_t (*f)(ssc_data_t) = NULL;
+	CHECK_DLL_LOADED();
+	if (!f && 0 == ( f = (ssc_weather_t(*)(ssc_data_t))PROCADDR() )) FAIL_ON_LOCATE();
+	return (*f)(table);
+}
+
+void ssc_weather_free( ssc_weather_t handle )
+{
+	static void (*f)(ssc_weather_t) = NULL;
+	CHECK_DLL_LOADED();
+	if (!f && 0 == ( f = (void(*)(ssc_weather_t))PROCADDR() )) FAIL_ON_LOCATE();
+	(*f)(handle);
+}
+
+void ssc_data_set_weather_handle( ssc_data_t p_data, const char *name, ssc_weather_t handle )
+{
+	static void (*f)(ssc_data_t, const char*, ssc_weather_t) = NULL;
+	CHECK_DLL_LOADED();
+	if (!f && 0 == ( f = (void(*)(ssc_data_t, const char*, ssc_weather_t))PROCADDR() )) FAIL_ON_LOCATE();
+	(*f)(p_data, name, handle);
+}
+
 void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data_t table )
 {
 	static void (*f)(ssc_data_t, const char*, ssc_data_t) = 0;
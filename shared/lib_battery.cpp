@@ -144,6 +144,34 @@ void capacity_t::copy(capacity_t * capacity)
 	_prev_charge = capacity->_prev_charge;
 	_charge = capacity->_charge;
 }
+void capacity_t::save_state(capacity_state & state)
+{
+	state.q0 = _q0;
+	state.qmax = _qmax;
+	state.qmax_thermal = _qmax_thermal;
+	state.I = _I;
+	state.I_loss = _I_loss;
+	state.SOC = _SOC;
+	state.DOD = _DOD;
+	state.DOD_prev = _DOD_prev;
+	state.chargeChange = _chargeChange;
+	state.prev_charge = _prev_charge;
+	state.charge = _charge;
+}
+void capacity_t::restore_state(const capacity_state & state)
+{
+	_q0 = state.q0;
+	_qmax = state.qmax;
+	_qmax_thermal = state.qmax_thermal;
+	_I = state.I;
+	_I_loss = state.I_loss;
+	_SOC = state.SOC;
+	_DOD = state.DOD;
+	_DOD_prev = state.DOD_prev;
+	_chargeChange = state.chargeChange;
+	_prev_charge = state.prev_charge;
+	_charge = state.charge;
+}
 void capacity_t::check_charge_change()
 {
 	_charge = NO_CHARGE;
@@ -269,6 +297,22 @@ void capacity_kibam_t::copy(capacity_t * capacity)
 	_q20 = tmp->_q20;
 	_I20 = tmp->_I20;
 }
+void capacity_kibam_t::save_state(capacity_state & state)
+{
+	capacity_t::save_state(state);
+	state.q1 = _q1;
+	state.q2 = _q2;
+	state.q1_0 = _q1_0;
+	state.q2_0 = _q2_0;
+}
+void capacity_kibam_t::restore_state(const capacity_state & state)
+{
+	capacity_t::restore_state(state);
+	_q1 = state.q1;
+	_q2 = state.q2;
+	_q1_0 = state.q1_0;
+	_q2_0 = state.q2_0;
+}
 
 void capacity_kibam_t::replace_battery()
 {
@@ -522,6 +566,8 @@ void voltage_t::copy(voltage_t * voltage)
 	// doesn't change;
 	//_batt_voltage_matrix = voltage->_batt_voltage_matrix;
 }
+void voltage_t::save_state(voltage_state & state){ state.cell_voltage = _cell_voltage; }
+void voltage_t::restore_state(const voltage_state & state){ _cell_voltage = state.cell_voltage; }
 double voltage_t::battery_voltage(){ return _num_cells_series*_cell_voltage; }
 double voltage_t::battery_voltage_nominal(){ return _num_cells_series * _cell_voltage_nominal; }
 double voltage_t::cell_voltage(){ return _cell_voltage; }
@@ -801,6 +847,22 @@ void lifetime_t::copy(lifetime_t * lifetime)
 	_replacement_scheduled = lifetime->_replacement_scheduled;
 	_q = lifetime->_q;
 }
+void lifetime_t::save_state(lifetime_state & state, std::vector<double> & peaks)
+{
+	_lifetime_cycle->save_state(state.cycle, peaks);
+	_lifetime_calendar->save_state(state.calendar);
+	state.replacements = _replacements;
+	state.replacement_scheduled = _replacement_scheduled;
+	state.q = _q;
+}
+void lifetime_t::restore_state(const lifetime_state & state, const std::vector<double> & peaks)
+{
+	_lifetime_cycle->restore_state(state.cycle, peaks);
+	_lifetime_calendar->restore_state(state.calendar);
+	_replacements = state.replacements;
+	_replacement_scheduled = state.replacement_scheduled;
+	_q = state.q;
+}
 double lifetime_t::capacity_percent(){ return _q; }
 void lifetime_t::runLifetimeModels(size_t idx, capacity_t * capacity, double T_battery)
 {
@@ -891,6 +953,32 @@ void lifetime_cycle_t::copy(lifetime_cycle_t * lifetime_cycle)
 	_Range = lifetime_cycle->_Range;
 	_average_range = lifetime_cycle->_average_range;
 }
+void lifetime_cycle_t::save_state(lifetime_cycle_state & state, std::vector<double> & peaks)
+{
+	state.nCycles = _nCycles;
+	state.q = _q;
+	state.Dlt = _Dlt;
+	state.jlt = _jlt;
+	state.Xlt = _Xlt;
+	state.Ylt = _Ylt;
+	state.Range = _Range;
+	state.average_range = _average_range;
+
+	// assign reuses the existing buffer, so this does not allocate once the peaks stop growing
+	peaks.assign(_Peaks.begin(), _Peaks.end());
+}
+void lifetime_cycle_t::restore_state(const lifetime_cycle_state & state, const std::vector<double> & peaks)
+{
+	_nCycles = state.nCycles;
+	_q = state.q;
+	_Dlt = state.Dlt;
+	_jlt = state.jlt;
+	_Xlt = state.Xlt;
+	_Ylt = state.Ylt;
+	_Range = state.Range;
+	_average_range = state.average_range;
+	_Peaks.assign(peaks.begin(), peaks.end());
+}
 double lifetime_cycle_t::computeCycleDamageAtDOD(double DOD)
 {
 	if (DOD == 0)
@@ -1208,6 +1296,22 @@ void lifetime_calendar_t::copy(lifetime_calendar_t * lifetime_calendar)
 	_b = lifetime_calendar->_b;
 	_c = lifetime_calendar->_c;
 }
+void lifetime_calendar_t::save_state(lifetime_calendar_state & state)
+{
+	state.day_age_of_battery = _day_age_of_battery;
+	state.last_idx = _last_idx;
+	state.q = _q;
+	state.dq_old = _dq_old;
+	state.dq_new = _dq_new;
+}
+void lifetime_calendar_t::restore_state(const lifetime_calendar_state & state)
+{
+	_day_age_of_battery = state.day_age_of_battery;
+	_last_idx = state.last_idx;
+	_q = state.q;
+	_dq_old = state.dq_old;
+	_dq_new = state.dq_new;
+}
 double lifetime_calendar_t::runLifetimeCalendarModel(size_t idx, double T, double SOC)
 {
 	if (_calendar_choice != lifetime_calendar_t::NONE)
@@ -1335,6 +1439,18 @@ void thermal_t::copy(thermal_t * thermal)
 	_capacity_percent = thermal->_capacity_percent;
 	_T_max = thermal->_T_max;
 }
+void thermal_t::save_state(thermal_state & state)
+{
+	state.R = _R;
+	state.T_battery = _T_battery;
+	state.capacity_percent = _capacity_percent;
+}
+void thermal_t::restore_state(const thermal_state & state)
+{
+	_R = state.R;
+	_T_battery = state.T_battery;
+	_capacity_percent = state.capacity_percent;
+}
 void thermal_t::replace_battery()
 { 
 	_T_battery = _T_room; 
@@ -1431,6 +1547,8 @@ void losses_t::copy(losses_t * losses)
 	_idle_loss = losses->_idle_loss;
 	_full_loss = losses->_full_loss;*/
 }
+void losses_t::save_state(losses_state & state){ state.nCycle = _nCycle; }
+void losses_t::restore_state(const losses_state & state){ _nCycle = state.nCycle; }
 
 void losses_t::replace_battery(){ _nCycle = 0; }
 void losses_t::run_losses(double dt_hour, size_t idx)
@@ -1512,6 +1630,26 @@ void battery_t::copy(const battery_t * battery)
 	_last_idx = battery->_last_idx;
 }
 
+// save the state which changes while running, the sub-model pointers and parameters are untouched
+void battery_t::save_state(battery_state & state)
+{
+	_capacity->save_state(state.capacity);
+	_voltage->save_state(state.voltage);
+	_thermal->save_state(state.thermal);
+	_lifetime->save_state(state.lifetime, state.peaks);
+	_losses->save_state(state.losses);
+	state.last_idx = _last_idx;
+}
+void battery_t::restore_state(const battery_state & state)
+{
+	_capacity->restore_state(state.capacity);
+	_voltage->restore_state(state.voltage);
+	_thermal->restore_state(state.thermal);
+	_lifetime->restore_state(state.lifetime, state.peaks);
+	_losses->restore_state(state.losses);
+	_last_idx = state.last_idx;
+}
+
 void battery_t::delete_clone()
 {
 	if (_capacity) delete _capacity;
@@ -84,6 +84,91 @@ protected:
 	std::vector<int> count;
 };
 
+/*
+Snapshots of the time-varying state of the battery models.
+Parameters and tables are left out, so saving and restoring a battery is a plain struct copy
+*/
+struct capacity_state
+{
+	double q0;
+	double qmax;
+	double qmax_thermal;
+	double I;
+	double I_loss;
+	double SOC;
+	double DOD;
+	double DOD_prev;
+	bool chargeChange;
+	int prev_charge;
+	int charge;
+
+	// KiBaM only
+	double q1;
+	double q2;
+	double q1_0;
+	double q2_0;
+};
+
+struct voltage_state
+{
+	double cell_voltage;
+};
+
+struct thermal_state
+{
+	double R;
+	double T_battery;
+	double capacity_percent;
+};
+
+struct lifetime_cycle_state
+{
+	int nCycles;
+	double q;
+	double Dlt;
+	int jlt;
+	double Xlt;
+	double Ylt;
+	double Range;
+	double average_range;
+};
+
+struct lifetime_calendar_state
+{
+	int day_age_of_battery;
+	size_t last_idx;
+	double q;
+	double dq_old;
+	double dq_new;
+};
+
+struct lifetime_state
+{
+	lifetime_cycle_state cycle;
+	lifetime_calendar_state calendar;
+	int replacements;
+	bool replacement_scheduled;
+	double q;
+};
+
+struct losses_state
+{
+	int nCycle;
+};
+
+struct battery_state
+{
+	capacity_state capacity;
+	voltage_state voltage;
+	thermal_state thermal;
+	lifetime_state lifetime;
+	losses_state losses;
+	size_t last_idx;
+
+	// rainflow peaks are variable length, the buffer is reused between saves
+	std::vector<double> peaks;
+};
+
 /*
 Base class from which capacity models derive
 Note, all capacity models are based on the capacity of one battery
@@ -102,6 +187,10 @@ public:
 	// shallow copy from capacity to this
 	virtual void copy(capacity_t *);
 
+	// save and restore the time-varying state
+	virtual void save_state(capacity_state &);
+	virtual void restore_state(const capacity_state &);
+
 	// virtual destructor
 	virtual ~capacity_t(){};
 	
@@ -170,6 +259,9 @@ public:
 	// copy from capacity to this
 	void copy(capacity_t *);
 
+	void save_state(capacity_state &);
+	void restore_state(const capacity_state &);
+
 	void updateCapacity(double &I, double dt);
 	void updateCapacityForThermal(double capacity_percent);
 	void updateCapacityForLifetime(double capacity_percent);
@@ -254,6 +346,9 @@ public:
 	// copy from voltage to this
 	virtual void copy(voltage_t *);
 
+	// save and restore the time-varying state
+	void save_state(voltage_state &);
+	void restore_state(const voltage_state &);
 
 	virtual ~voltage_t(){};
 
@@ -398,6 +493,10 @@ public:
 	// copy from lifetime_cycle to this
 	void copy(lifetime_cycle_t *);
 
+	// save and restore the time-varying state, the rainflow peaks are saved separately
+	void save_state(lifetime_cycle_state &, std::vector<double> & peaks);
+	void restore_state(const lifetime_cycle_state &, const std::vector<double> & peaks);
+
 	// return q, the effective capacity percent
 	double runCycleLifetime(double DOD);
 
@@ -456,6 +555,10 @@ public:
 	// copy from lifetime_calendar to this
 	void copy(lifetime_calendar_t *);
 
+	// save and restore the time-varying state
+	void save_state(lifetime_calendar_state &);
+	void restore_state(const lifetime_calendar_state &);
+
 	/// Given the index of the simulation, the tempertature and SOC, return the effective capacity percent
 	double runLifetimeCalendarModel(size_t idx, double T, double SOC);
 
@@ -512,6 +615,10 @@ public:
 	// copy lifetime to this
 	void copy(lifetime_t *);
 
+	// save and restore the time-varying state of lifetime and its cycle and calendar models
+	void save_state(lifetime_state &, std::vector<double> & peaks);
+	void restore_state(const lifetime_state &, const std::vector<double> & peaks);
+
 	void runLifetimeModels(size_t idx, capacity_t *, double T_battery);
 
 	double capacity_percent();
@@ -558,6 +665,10 @@ public:
 	// copy thermal to this
 	void copy(thermal_t *);
 
+	// save and restore the time-varying state
+	void save_state(thermal_state &);
+	void restore_state(const thermal_state &);
+
 	void updateTemperature(double I, double R, double dt);
 	void replace_battery();
 
@@ -605,6 +716,10 @@ public:
 	// copy losses to this
 	void copy(losses_t *);
 
+	// save and restore the time-varying state
+	void save_state(losses_state &);
+	void restore_state(const losses_state &);
+
 	// main APIs
 	void run_losses(double dt_hour, size_t index);
 	void replace_battery();
@@ -642,6 +757,10 @@ public:
 	// copy members from battery to this
 	void copy(const battery_t * battery);
 
+	// save and restore the time-varying state of all models, much cheaper than copy
+	void save_state(battery_state &);
+	void restore_state(const battery_state &);
+
 	// virtual destructor, does nothing as no memory allocated in constructor
 	virtual ~battery_t();
 
@@ -68,9 +68,9 @@ dispatch_t::dispatch_t(battery_t * Battery, double dt_hour, double SOC_min, doub
 	m_batteryPower->powerBatteryDischargeMax = Pd_max;
 	m_batteryPower->meterPosition = battMeterPosition;
 
-	// initalize Battery and a copy of the Battery for iteration
+	// initalize Battery and a snapshot of the Battery state for iteration
 	_Battery = Battery;
-	_Battery_initial = new battery_t(*_Battery);
+	_Battery->save_state(_Battery_initial);
 
 	// Call the dispatch init method
 	init(_Battery, dt_hour, current_choice, t_min, mode);
@@ -114,7 +114,7 @@ dispatch_t::dispatch_t(const dispatch_t& dispatch)
 	m_batteryPower = m_batteryPowerFlow->getBatteryPower();
 
 	_Battery = new battery_t(*dispatch._Battery);
-	_Battery_initial = new battery_t(*dispatch._Battery_initial);
+	_Battery_initial = dispatch._Battery_initial;
 	init(_Battery, dispatch._dt_hour, dispatch._current_choice, dispatch._t_min, dispatch._mode);
 }
 
@@ -122,7 +122,7 @@ dispatch_t::dispatch_t(const dispatch_t& dispatch)
 void dispatch_t::copy(const dispatch_t * dispatch)
 {
 	_Battery->copy(dispatch->_Battery);
-	_Battery_initial->copy(dispatch->_Battery_initial);
+	_Battery_initial = dispatch->_Battery_initial;
 	init(_Battery, dispatch->_dt_hour,  dispatch->_current_choice, dispatch->_t_min, dispatch->_mode);
 
 	// can't create shallow copy of unique ptr
@@ -132,15 +132,12 @@ void dispatch_t::copy(const dispatch_t * dispatch)
 }
 void dispatch_t::delete_clone()
 {
-	// need to delete both, since allocated memory for both in deep copy 
+	// need to delete the battery, since allocated memory in deep copy 
 	if (_Battery) delete _Battery;
-	if (_Battery_initial) delete _Battery_initial;
 }
 dispatch_t::~dispatch_t()
 {
 	// original _Battery doesn't need deleted, since was a pointer passed in
-	_Battery_initial->delete_clone();
-	delete _Battery_initial;
 }
 bool dispatch_t::check_constraints(double &I, size_t count)
 {
@@ -198,7 +195,7 @@ bool dispatch_t::check_constraints(double &I, size_t count)
 	// reset
 	if (iterate)
 	{
-		_Battery->copy(_Battery_initial);
+		_Battery->restore_state(_Battery_initial);
 		m_batteryPower->powerBattery = 0;
 		m_batteryPower->powerGridToBattery = 0;
 		m_batteryPower->powerBatteryToGrid = 0;
@@ -329,7 +326,7 @@ void dispatch_t::runDispatch(size_t year, size_t hour_of_year, size_t step)
 	double I = current_controller(_Battery->battery_voltage_nominal());
 
 	// Setup battery iteration
-	_Battery_initial->copy(_Battery);
+	_Battery->save_state(_Battery_initial);
 	bool iterate = true;
 	size_t count = 0;
 	size_t idx = util::index_year_hour_step(year, hour_of_year, step, static_cast<size_t>(1 / _dt_hour));
@@ -527,7 +524,7 @@ bool dispatch_manual_t::check_constraints(double &I, size_t count)
 		// reset
 		if (iterate)
 		{
-			_Battery->copy(_Battery_initial);
+			_Battery->restore_state(_Battery_initial);
 			m_batteryPower->powerBattery = 0;
 			m_batteryPower->powerGridToBattery = 0;
 			m_batteryPower->powerBatteryToGrid = 0;
@@ -775,7 +772,7 @@ bool dispatch_automatic_t::check_constraints(double &I, size_t count)
 		// reset
 		if (iterate)
 		{
-			_Battery->copy(_Battery_initial);
+			_Battery->restore_state(_Battery_initial);
 			m_batteryPower->powerBattery = 0;
 			m_batteryPower->powerGridToBattery = 0;
 			m_batteryPower->powerBatteryToGrid = 0;
@@ -169,7 +169,7 @@ protected:
 	bool restrict_power(double &I);
 
 	battery_t * _Battery;
-	battery_t * _Battery_initial;
+	battery_state _Battery_initial;
 
 	double _dt_hour;
 
@@ -84,15 +84,10 @@ double air_mass_modifier( double Zenith_deg, double Elev_m, double a[5] )
 	return f1 > 0.0 ? f1 : 0.0;
 }
 
-bool cec6par_module_t::operator() ( pvinput_t &input, double TcellC, double opvoltage, pvoutput_t &out )
+double cec6par_module_t::effective_irradiance( pvinput_t &input, double &G_total, double &aoi_modifier )
 {
-	double muIsc = alpha_isc * (1-Adj/100);
-	//double muVoc = beta_voc * (1+Adj/100);
-	
-	/* initialize output first */
-	out.Power = out.Voltage = out.Current = out.Efficiency = out.Voc_oper = out.Isc_oper= out.AOIModifier = 0.0;
-	
-	double G_front, G_total, Geff_front_total, Geff_total;
+	double G_front, Geff_front_total, Geff_total;
+	aoi_modifier = 0.0;
 
 	if( input.radmode != 3){ // Determine if the model needs to skip the cover effects (will only be skipped if the user is using POA reference cell data) 
 		G_front = input.Ibeam + input.Idiff + input.Ignd;
@@ -109,11 +104,9 @@ bool cec6par_module_t::operator() ( pvinput_t &input, double TcellC, double opvo
 
 		Geff_total = Geff_front_total + input.Irear;
 
-		double aoi_modifier = 0.0;
 		if (G_front > 0.) {
 			aoi_modifier = Geff_front_total / G_front;
 		}
-		out.AOIModifier = aoi_modifier;
 
 	
 		double theta_z = input.Zenith;
@@ -132,19 +125,40 @@ bool cec6par_module_t::operator() ( pvinput_t &input, double TcellC, double opvo
 
 	}
 
+	return Geff_total;
+}
+
+void cec6par_module_t::operating_parameters( double Geff_total, double T_cell, double &IL_oper, double &IO_oper, double &A_oper, double &Rsh_oper )
+{
+	double muIsc = alpha_isc * (1-Adj/100);
+	//double muVoc = beta_voc * (1+Adj/100);
+
+	// calculation of IL and IO at operating conditions
+	IL_oper = Geff_total/I_ref *( Il + muIsc*(T_cell-Tc_ref) );
+	if (IL_oper < 0.0) IL_oper = 0.0;
+		
+	double EG = eg0 * (1-0.0002677*(T_cell-Tc_ref));
+	IO_oper = Io * pow(T_cell/Tc_ref, 3) * exp( 1/KB*(eg0/Tc_ref - EG/T_cell) );
+	A_oper = a * T_cell / Tc_ref;
+	Rsh_oper = Rsh*(I_ref/Geff_total);
+}
+
+bool cec6par_module_t::operator() ( pvinput_t &input, double TcellC, double opvoltage, pvoutput_t &out )
+{
+	/* initialize output first */
+	out.Power = out.Voltage = out.Current = out.Efficiency = out.Voc_oper = out.Isc_oper= out.AOIModifier = 0.0;
+	
+	double G_total, aoi_modifier;
+	double Geff_total = effective_irradiance( input, G_total, aoi_modifier );
+	out.AOIModifier = aoi_modifier;
+
 	double T_cell = input.Tdry + 273.15;
 	if ( Geff_total >= 1.0 ) 
 	{
 		T_cell = TcellC + 273.15; // want cell temp in kelvin
 
-		// calculation of IL and IO at operating conditions
-		double IL_oper = Geff_total/I_ref *( Il + muIsc*(T_cell-Tc_ref) );
-		if (IL_oper < 0.0) IL_oper = 0.0;
-		
-		double EG = eg0 * (1-0.0002677*(T_cell-Tc_ref));
-		double IO_oper = Io * pow(T_cell/Tc_ref, 3) * exp( 1/KB*(eg0/Tc_ref - EG/T_cell) );
-		double A_oper = a * T_cell / Tc_ref;
-		double Rsh_oper = Rsh*(I_ref/Geff_total);
+		double IL_oper, IO_oper, A_oper, Rsh_oper;
+		operating_parameters( Geff_total, T_cell, IL_oper, IO_oper, A_oper, Rsh_oper );
 			
 		double V_oc = openvoltage_5par( Voc, A_oper, IL_oper, IO_oper, Rsh_oper );
 		double I_sc = IL_oper/(1+Rs/Rsh_oper);
@@ -176,6 +190,50 @@ bool cec6par_module_t::operator() ( pvinput_t &input, double TcellC, double opvo
 	return out.Power >= 0;
 }
 
+bool cec6par_module_t::current_sweep( pvinput_t &input, double TcellC, const double *V, size_t n, double *I )
+{
+	for ( size_t i = 0; i < n; i++ )
+		I[i] = 0.0;
+
+	double G_total, aoi_modifier;
+	double Geff_total = effective_irradiance( input, G_total, aoi_modifier );
+	if ( Geff_total < 1.0 )
+		return true;
+
+	// operating parameters and open circuit voltage depend only on irradiance and
+	// cell temperature, so they are computed once for the whole sweep
+	double IL_oper, IO_oper, A_oper, Rsh_oper;
+	operating_parameters( Geff_total, TcellC + 273.15, IL_oper, IO_oper, A_oper, Rsh_oper );
+	double V_oc = openvoltage_5par( Voc, A_oper, IL_oper, IO_oper, Rsh_oper );
+
+	// voltages at or above V_oc carry no current, the rest are solved together
+	std::vector<double> Vsolve, Isolve;
+	std::vector<size_t> isolve;
+	Vsolve.reserve( n );
+	isolve.reserve( n );
+	for ( size_t i = 0; i < n; i++ )
+	{
+		if ( V[i] < V_oc )
+		{
+			Vsolve.push_back( V[i] );
+			isolve.push_back( i );
+		}
+	}
+	if ( Vsolve.empty() )
+		return true;
+
+	Isolve.resize( Vsolve.size() );
+	current_5par_batch( &Vsolve[0], Vsolve.size(), 0.9*IL_oper, A_oper, IL_oper, IO_oper, Rs, Rsh_oper, &Isolve[0] );
+
+	bool ok = true;
+	for ( size_t k = 0; k < isolve.size(); k++ )
+	{
+		I[isolve[k]] = Isolve[k];
+		if ( V[isolve[k]]*Isolve[k] < 0 ) ok = false;
+	}
+	return ok;
+}
+
 
 
 /**********************************************************************************************
@@ -86,6 +86,11 @@ public:
 	virtual double IscRef() { return Isc; }
 
 	virtual bool operator() ( pvinput_t &input, double TcellC, double opvoltage, pvoutput_t &output );
+	virtual bool current_sweep( pvinput_t &input, double TcellC, const double *V, size_t n, double *I );
+
+private:
+	double effective_irradiance( pvinput_t &input, double &G_total, double &aoi_modifier );
+	void operating_parameters( double Geff_total, double T_cell, double &IL_oper, double &IO_oper, double &A_oper, double &Rsh_oper );
 };
 
 
@@ -97,6 +102,7 @@ public:
 	double Tnoct;
 
 	virtual bool operator() ( pvinput_t &input, pvmodule_t &module, double opvoltage, double &Tcell );
+	virtual bool depends_on_voltage() { return false; }
 };
 
 
@@ -857,12 +857,15 @@ irrad::irrad()
 	setup();
 }
 irrad::irrad(Irradiance_IO * irradianceIO, Subarray_IO * subarrayIO)
+	: irrad(irradianceIO, subarrayIO, irradianceIO->weatherRecord)
+{
+}
+irrad::irrad(Irradiance_IO * irradianceIO, Subarray_IO * subarrayIO, const weather_record &wf)
 {
 	setup();
 	irradiance = irradianceIO;
 	subarray = subarrayIO;
 
-	weather_record wf = irradiance->weatherRecord;
 	weather_header hdr = irradiance->weatherHeader;
 
 	int month_idx = wf.month - 1;
@@ -339,6 +339,9 @@ public:
 	/// Construct the irrad class with an Irradiance_IO() object and Subarray_IO() object
 	irrad(Irradiance_IO * , Subarray_IO *);
 
+	/// Construct the irrad class for an explicit weather record instead of Irradiance_IO::weatherRecord
+	irrad(Irradiance_IO *, Subarray_IO *, const weather_record &);
+
 	/// Initialize irrad member data
 	void setup();
 
@@ -128,6 +128,7 @@ class mock_celltemp_t : public pvcelltemp_t
 {
 public:
 	virtual bool operator() (pvinput_t &input, pvmodule_t &module, double opvoltage, double &Tcell);
+	virtual bool depends_on_voltage() { return false; }
 };
 
 #endif
\ No newline at end of file
@@ -11,10 +11,6 @@ PVIOManager::PVIOManager(compute_module*  cm, std::string cmName)
 	std::unique_ptr<Simulation_IO> ptr2(new Simulation_IO(cm, *m_IrradianceIO));
 	m_SimulationIO = std::move(ptr2);
 
-	std::unique_ptr<ShadeDB8_mpp> shadeDatabase(new ShadeDB8_mpp());
-	m_shadeDatabase = std::move(shadeDatabase);
-	m_shadeDatabase->init();
-
 	std::unique_ptr<Inverter_IO> ptrInv(new Inverter_IO(cm, cmName));
 	m_InverterIO = std::move(ptrInv);
 
@@ -33,6 +29,27 @@ PVIOManager::PVIOManager(compute_module*  cm, std::string cmName)
 		}
 	}
 
+	// Subarrays using the shading database each get an instance backed by the process-wide tables,
+	// so subarrays evaluated on separate threads do not share warning state
+	std::string shadeDatabaseFile;
+	if (cm->is_assigned("shading_db_file")) shadeDatabaseFile = cm->as_string("shading_db_file");
+	bool shadeDatabaseWarned = false;
+	for (size_t subarray = 0; subarray < m_SubarraysIO.size(); subarray++)
+	{
+		std::unique_ptr<ShadeDB8_mpp> shadeDatabase;
+		if (m_SubarraysIO[subarray]->shadeCalculator.use_shade_db()) {
+			shadeDatabase.reset(new ShadeDB8_mpp());
+			shadeDatabase->init(shadeDatabaseFile);
+
+			// report a file that could not be mapped once, not per subarray
+			if (!shadeDatabaseWarned && !shadeDatabase->get_warning().empty()) {
+				cm->log("shading_db_file: " + shadeDatabase->get_warning(), SSC_WARNING);
+				shadeDatabaseWarned = true;
+			}
+		}
+		m_shadeDatabase.push_back(std::move(shadeDatabase));
+	}
+
 	// Aggregate Subarray outputs in different structure
 	std::unique_ptr<PVSystem_IO> pvSystem(new PVSystem_IO(cm, cmName, m_SimulationIO.get(), m_IrradianceIO.get(), getSubarrays(), m_InverterIO.get()));
 	m_PVSystemIO = std::move(pvSystem);
@@ -59,6 +76,72 @@ PVSystem_IO * PVIOManager::getPVSystemIO()  { return m_PVSystemIO.get(); }
 Simulation_IO * PVIOManager::getSimulationIO()  { return m_SimulationIO.get(); }
 
 
+PVOutputSelection::PVOutputSelection(compute_module* cm)
+{
+	groups = ALL;
+	if (cm->is_assigned("timeseries_output_groups")) groups = cm->as_integer("timeseries_output_groups");
+}
+
+ssc_number_t * PVOutputSelection::allocate(compute_module* cm, const std::string &name, size_t length, int group, std::vector<ssc_number_t> &scratch) const
+{
+	if (isSaved(group))
+		return cm->allocate(name, length);
+
+	// scratch is never resized once handed out
+	if (scratch.empty())
+		scratch.resize(length, 0);
+	else if (scratch.size() < length)
+		return cm->allocate(name, length);
+
+	return &scratch[0];
+}
+
+PVOutputSeries::PVOutputSeries()
+	: m_data(0), m_stepsPerHour(1), m_annual(0)
+{
+	for (size_t m = 0; m < 12; m++)
+		m_monthly[m] = 0;
+}
+
+void PVOutputSeries::allocate(compute_module* cm, const PVOutputSelection &selection, const std::string &name, size_t length, size_t stepsPerHour, int group)
+{
+	m_data = selection.isSaved(group) ? cm->allocate(name, length) : 0;
+	m_stepsPerHour = stepsPerHour;
+}
+
+void PVOutputSeries::set(size_t idx, ssc_number_t value)
+{
+	if (m_data) m_data[idx] = value;
+	accumulate(idx, value);
+}
+
+void PVOutputSeries::add(size_t idx, ssc_number_t value)
+{
+	if (m_data) m_data[idx] += value;
+	accumulate(idx, value);
+}
+
+void PVOutputSeries::accumulate(size_t idx, ssc_number_t value)
+{
+	m_annual += value;
+	int month = util::month_of((double)(idx / m_stepsPerHour));
+	if (month > 0) m_monthly[month - 1] += value;
+}
+
+ssc_number_t PVOutputSeries::assignAnnual(compute_module* cm, const std::string &annualName, double scale)
+{
+	ssc_number_t annual = (ssc_number_t)(m_annual * scale);
+	cm->assign(annualName, var_data(annual));
+	return annual;
+}
+
+void PVOutputSeries::assignMonthly(compute_module* cm, const std::string &monthlyName, double scale)
+{
+	ssc_number_t *monthly = cm->allocate(monthlyName, 12);
+	for (size_t m = 0; m < 12; m++)
+		monthly[m] = m_monthly[m] * (ssc_number_t)scale;
+}
+
 Simulation_IO::Simulation_IO(compute_module* cm, Irradiance_IO & IrradianceIO)
 {
 	numberOfWeatherFileRecords = IrradianceIO.numberOfWeatherFileRecords;
@@ -74,16 +157,16 @@ Simulation_IO::Simulation_IO(compute_module* cm, Irradiance_IO & IrradianceIO)
 }
 
 Irradiance_IO::Irradiance_IO(compute_module* cm, std::string cmName)
+	: outputSelection(cm)
 {
 	numberOfSubarrays = 4;
 	radiationMode = cm->as_integer("irrad_mode");
 	skyModel = cm->as_integer("sky_model");
 
 	if (cm->is_assigned("solar_resource_file")) {
-		weatherDataProvider = std::unique_ptr<weather_data_provider>(new weatherfile(cm->as_string("solar_resource_file")));
-		weatherfile *weatherFile = dynamic_cast<weatherfile*>(weatherDataProvider.get());
-		if (!weatherFile->ok()) throw compute_module::exec_error(cmName, weatherFile->message());
-		if (weatherFile->has_message()) cm->log(weatherFile->message(), SSC_WARNING);
+		weatherDataProvider = std::unique_ptr<weather_data_provider>(open_weather_resource(cm, "solar_resource_file"));
+		if (!weatherDataProvider->ok()) throw compute_module::exec_error(cmName, weatherDataProvider->message());
+		if (weatherDataProvider->has_message()) cm->log(weatherDataProvider->message(), SSC_WARNING);
 	}
 	else if (cm->is_assigned("solar_resource_data")) {
 		weatherDataProvider = std::unique_ptr<weather_data_provider>(new weatherdata(cm->lookup("solar_resource_data")));
@@ -219,19 +302,19 @@ void Irradiance_IO::checkWeatherFile(compute_module * cm, std::string cmName)
 
 void Irradiance_IO::AllocateOutputs(compute_module* cm)
 {
-	p_weatherFileGHI = cm->allocate("gh", numberOfWeatherFileRecords);
-	p_weatherFileDNI = cm->allocate("dn", numberOfWeatherFileRecords);
-	p_weatherFileDHI = cm->allocate("df", numberOfWeatherFileRecords);
-	p_sunPositionTime = cm->allocate("sunpos_hour", numberOfWeatherFileRecords);
-	p_weatherFileWindSpeed = cm->allocate("wspd", numberOfWeatherFileRecords);
-	p_weatherFileAmbientTemp = cm->allocate("tdry", numberOfWeatherFileRecords);
-	p_weatherFileAlbedo = cm->allocate("alb", numberOfWeatherFileRecords);
-	p_weatherFileSnowDepth = cm->allocate("snowdepth", numberOfWeatherFileRecords);
+	weatherFileGHI.allocate(cm, outputSelection, "gh", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::WEATHER);
+	p_weatherFileDNI = outputSelection.allocate(cm, "dn", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_weatherFileDHI = outputSelection.allocate(cm, "df", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_sunPositionTime = outputSelection.allocate(cm, "sunpos_hour", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_weatherFileWindSpeed = outputSelection.allocate(cm, "wspd", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_weatherFileAmbientTemp = outputSelection.allocate(cm, "tdry", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_weatherFileAlbedo = outputSelection.allocate(cm, "alb", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_weatherFileSnowDepth = outputSelection.allocate(cm, "snowdepth", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
 
 	// If using input POA, must have POA for every subarray or assume POA applies to each subarray
 	for (size_t subarray = 0; subarray != numberOfSubarrays; subarray++) {
 		std::string wfpoa = "wfpoa" + util::to_string(static_cast<int>(subarray + 1));
-		p_weatherFilePOA.push_back(cm->allocate(wfpoa, numberOfWeatherFileRecords));
+		p_weatherFilePOA.push_back(outputSelection.allocate(cm, wfpoa, numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs));
 	}
 
 	//set up the calculated components of irradiance such that they aren't reported if they aren't assigned
@@ -241,11 +324,11 @@ void Irradiance_IO::AllocateOutputs(compute_module* cm)
 	if (radiationMode == GH_DF || radiationMode == POA_R || radiationMode == POA_P) p_IrradianceCalculated[2] = cm->allocate("dn_calc", numberOfWeatherFileRecords);
 
 	//output arrays for solar position calculations- same for all four subarrays
-	p_sunZenithAngle = cm->allocate("sol_zen", numberOfWeatherFileRecords);
-	p_sunAltitudeAngle = cm->allocate("sol_alt", numberOfWeatherFileRecords);
-	p_sunAzimuthAngle = cm->allocate("sol_azi", numberOfWeatherFileRecords);
-	p_absoluteAirmass = cm->allocate("airmass", numberOfWeatherFileRecords);
-	p_sunUpOverHorizon = cm->allocate("sunup", numberOfWeatherFileRecords);
+	p_sunZenithAngle = outputSelection.allocate(cm, "sol_zen", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_sunAltitudeAngle = outputSelection.allocate(cm, "sol_alt", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_sunAzimuthAngle = outputSelection.allocate(cm, "sol_azi", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_absoluteAirmass = outputSelection.allocate(cm, "airmass", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
+	p_sunUpOverHorizon = outputSelection.allocate(cm, "sunup", numberOfWeatherFileRecords, PVOutputSelection::WEATHER, unsavedOutputs);
 }
 
 void Irradiance_IO::AssignOutputs(compute_module* cm)
@@ -376,6 +459,7 @@ void Subarray_IO::AssignOutputs(compute_module* cm)
 
 
 PVSystem_IO::PVSystem_IO(compute_module* cm, std::string cmName, Simulation_IO * SimulationIO, Irradiance_IO * IrradianceIO, std::vector<Subarray_IO*> SubarraysAll, Inverter_IO * InverterIO)
+	: outputSelection(cm)
 {
 	Irradiance = IrradianceIO;
 	Simulation = SimulationIO;
@@ -487,85 +571,88 @@ void PVSystem_IO::AllocateOutputs(compute_module* cm)
 	size_t numberOfWeatherFileRecords = Irradiance->numberOfWeatherFileRecords;
 	size_t numberOfLifetimeRecords = Simulation->numberOfSteps;
 	size_t numberOfYears = Simulation->numberOfYears;
+	size_t stepsPerHour = Simulation->stepsPerHour;
+
+	unsavedSubarrayOutputs.resize(Subarrays.size());
 
 	for (size_t subarray = 0; subarray < Subarrays.size(); subarray++)
 	{
 		if (Subarrays[subarray]->enable)
 		{
 			std::string prefix = Subarrays[subarray]->prefix;
-			p_angleOfIncidence.push_back(cm->allocate(prefix + "aoi", numberOfWeatherFileRecords));
-			p_angleOfIncidenceModifier.push_back(cm->allocate(prefix + "aoi_modifier", numberOfWeatherFileRecords));
-			p_surfaceTilt.push_back(cm->allocate(prefix + "surf_tilt", numberOfWeatherFileRecords));
-			p_surfaceAzimuth.push_back(cm->allocate(prefix + "surf_azi", numberOfWeatherFileRecords));
-			p_axisRotation.push_back(cm->allocate(prefix + "axisrot", numberOfWeatherFileRecords));
-			p_idealRotation.push_back(cm->allocate(prefix + "idealrot", numberOfWeatherFileRecords));
-			p_poaNominalFront.push_back(cm->allocate(prefix + "poa_nom", numberOfWeatherFileRecords));
-			p_poaShadedFront.push_back(cm->allocate(prefix + "poa_shaded", numberOfWeatherFileRecords));
-			p_poaShadedSoiledFront.push_back(cm->allocate(prefix + "poa_shaded_soiled", numberOfWeatherFileRecords));
-			p_poaBeamFront.push_back(cm->allocate(prefix + "poa_eff_beam", numberOfWeatherFileRecords));
-			p_poaDiffuseFront.push_back(cm->allocate(prefix + "poa_eff_diff", numberOfWeatherFileRecords));
-			p_poaTotal.push_back(cm->allocate(prefix + "poa_eff", numberOfWeatherFileRecords));
-			p_poaRear.push_back(cm->allocate(prefix + "poa_rear", numberOfWeatherFileRecords));
-			p_poaFront.push_back(cm->allocate(prefix + "poa_front", numberOfWeatherFileRecords));
-			p_derateSoiling.push_back(cm->allocate(prefix + "soiling_derate", numberOfWeatherFileRecords));
-			p_beamShadingFactor.push_back(cm->allocate(prefix + "beam_shading_factor", numberOfWeatherFileRecords));
-			p_temperatureCell.push_back(cm->allocate(prefix + "celltemp", numberOfWeatherFileRecords));
-			p_moduleEfficiency.push_back(cm->allocate(prefix + "modeff", numberOfWeatherFileRecords));
-			p_dcVoltage.push_back(cm->allocate(prefix + "dc_voltage", numberOfWeatherFileRecords));
-			p_voltageOpenCircuit.push_back(cm->allocate(prefix + "voc", numberOfWeatherFileRecords));
-			p_currentShortCircuit.push_back(cm->allocate(prefix + "isc", numberOfWeatherFileRecords));
-			p_dcPowerGross.push_back(cm->allocate(prefix + "dc_gross", numberOfWeatherFileRecords));
-			p_derateLinear.push_back(cm->allocate(prefix + "linear_derate", numberOfWeatherFileRecords));
-			p_derateSelfShading.push_back(cm->allocate(prefix + "ss_derate", numberOfWeatherFileRecords));
-			p_derateSelfShadingDiffuse.push_back(cm->allocate(prefix + "ss_diffuse_derate", numberOfWeatherFileRecords));
-			p_derateSelfShadingReflected.push_back(cm->allocate(prefix + "ss_reflected_derate", numberOfWeatherFileRecords));
+			p_angleOfIncidence.push_back(outputSelection.allocate(cm, prefix + "aoi", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_angleOfIncidenceModifier.push_back(outputSelection.allocate(cm, prefix + "aoi_modifier", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_surfaceTilt.push_back(outputSelection.allocate(cm, prefix + "surf_tilt", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_surfaceAzimuth.push_back(outputSelection.allocate(cm, prefix + "surf_azi", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_axisRotation.push_back(outputSelection.allocate(cm, prefix + "axisrot", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_idealRotation.push_back(outputSelection.allocate(cm, prefix + "idealrot", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaNominalFront.push_back(outputSelection.allocate(cm, prefix + "poa_nom", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaShadedFront.push_back(outputSelection.allocate(cm, prefix + "poa_shaded", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaShadedSoiledFront.push_back(outputSelection.allocate(cm, prefix + "poa_shaded_soiled", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaBeamFront.push_back(outputSelection.allocate(cm, prefix + "poa_eff_beam", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaDiffuseFront.push_back(outputSelection.allocate(cm, prefix + "poa_eff_diff", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaTotal.push_back(outputSelection.allocate(cm, prefix + "poa_eff", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaRear.push_back(outputSelection.allocate(cm, prefix + "poa_rear", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_poaFront.push_back(outputSelection.allocate(cm, prefix + "poa_front", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_derateSoiling.push_back(outputSelection.allocate(cm, prefix + "soiling_derate", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_beamShadingFactor.push_back(outputSelection.allocate(cm, prefix + "beam_shading_factor", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_temperatureCell.push_back(outputSelection.allocate(cm, prefix + "celltemp", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_moduleEfficiency.push_back(outputSelection.allocate(cm, prefix + "modeff", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_dcVoltage.push_back(outputSelection.allocate(cm, prefix + "dc_voltage", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_voltageOpenCircuit.push_back(outputSelection.allocate(cm, prefix + "voc", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_currentShortCircuit.push_back(outputSelection.allocate(cm, prefix + "isc", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_dcPowerGross.push_back(outputSelection.allocate(cm, prefix + "dc_gross", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_derateLinear.push_back(outputSelection.allocate(cm, prefix + "linear_derate", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_derateSelfShading.push_back(outputSelection.allocate(cm, prefix + "ss_derate", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_derateSelfShadingDiffuse.push_back(outputSelection.allocate(cm, prefix + "ss_diffuse_derate", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+			p_derateSelfShadingReflected.push_back(outputSelection.allocate(cm, prefix + "ss_reflected_derate", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
 
 			if (Subarrays[subarray]->enableShowModel) {
-				p_snowLoss.push_back(cm->allocate(prefix + "snow_loss", numberOfWeatherFileRecords));
-				p_snowCoverage.push_back(cm->allocate(prefix + "snow_coverage", numberOfWeatherFileRecords));
+				p_snowLoss.push_back(outputSelection.allocate(cm, prefix + "snow_loss", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_snowCoverage.push_back(outputSelection.allocate(cm, prefix + "snow_coverage", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
 			}
 
 			if (Subarrays[subarray]->enableSelfShadingOutputs)
 			{
 				// ShadeDB validation
-				p_shadeDB_GPOA.push_back(cm->allocate("shadedb_" + prefix + "gpoa", numberOfWeatherFileRecords));
-				p_shadeDB_DPOA.push_back(cm->allocate("shadedb_" + prefix + "dpoa", numberOfWeatherFileRecords));
-				p_shadeDB_temperatureCell.push_back(cm->allocate("shadedb_" + prefix + "pv_cell_temp", numberOfWeatherFileRecords));
-				p_shadeDB_modulesPerString.push_back(cm->allocate("shadedb_" + prefix + "mods_per_str", numberOfWeatherFileRecords));
-				p_shadeDB_voltageMaxPowerSTC.push_back(cm->allocate("shadedb_" + prefix + "str_vmp_stc", numberOfWeatherFileRecords));
-				p_shadeDB_voltageMPPTLow.push_back(cm->allocate("shadedb_" + prefix + "mppt_lo", numberOfWeatherFileRecords));
-				p_shadeDB_voltageMPPTHigh.push_back(cm->allocate("shadedb_" + prefix + "mppt_hi", numberOfWeatherFileRecords));
+				p_shadeDB_GPOA.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "gpoa", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_shadeDB_DPOA.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "dpoa", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_shadeDB_temperatureCell.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "pv_cell_temp", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_shadeDB_modulesPerString.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "mods_per_str", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_shadeDB_voltageMaxPowerSTC.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "str_vmp_stc", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_shadeDB_voltageMPPTLow.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "mppt_lo", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
+				p_shadeDB_voltageMPPTHigh.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "mppt_hi", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
 			}
-			p_shadeDBShadeFraction.push_back(cm->allocate("shadedb_" + prefix + "shade_frac", numberOfWeatherFileRecords));
+			p_shadeDBShadeFraction.push_back(outputSelection.allocate(cm, "shadedb_" + prefix + "shade_frac", numberOfWeatherFileRecords, PVOutputSelection::SUBARRAY, unsavedSubarrayOutputs[subarray]));
 		}
 	}
-	p_transformerNoLoadLoss = cm->allocate("xfmr_nll_ts", numberOfWeatherFileRecords);
-	p_transformerLoadLoss = cm->allocate("xfmr_ll_ts", numberOfWeatherFileRecords);
-	p_transformerLoss = cm->allocate("xfmr_loss_ts", numberOfWeatherFileRecords);
+	p_transformerNoLoadLoss = outputSelection.allocate(cm, "xfmr_nll_ts", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
+	p_transformerLoadLoss = outputSelection.allocate(cm, "xfmr_ll_ts", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
+	p_transformerLoss = outputSelection.allocate(cm, "xfmr_loss_ts", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
 
-	p_poaFrontNominalTotal = cm->allocate("poa_nom", numberOfWeatherFileRecords);
-	p_poaFrontBeamNominalTotal = cm->allocate("poa_beam_nom", numberOfWeatherFileRecords);
-	p_poaFrontBeamTotal = cm->allocate("poa_beam_eff", numberOfWeatherFileRecords);
-	p_poaFrontShadedTotal = cm->allocate("poa_shaded", numberOfWeatherFileRecords);
-	p_poaFrontShadedSoiledTotal = cm->allocate("poa_shaded_soiled", numberOfWeatherFileRecords);
-	p_poaFrontTotal = cm->allocate("poa_front", numberOfWeatherFileRecords);
-	p_poaRearTotal = cm->allocate("poa_rear", numberOfWeatherFileRecords);
-	p_poaTotalAllSubarrays = cm->allocate("poa_eff", numberOfWeatherFileRecords);
+	poaFrontNominalTotal.allocate(cm, outputSelection, "poa_nom", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaFrontBeamNominalTotal.allocate(cm, outputSelection, "poa_beam_nom", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaFrontBeamTotal.allocate(cm, outputSelection, "poa_beam_eff", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaFrontShadedTotal.allocate(cm, outputSelection, "poa_shaded", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaFrontShadedSoiledTotal.allocate(cm, outputSelection, "poa_shaded_soiled", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaFrontTotal.allocate(cm, outputSelection, "poa_front", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaRearTotal.allocate(cm, outputSelection, "poa_rear", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
+	poaTotalAllSubarrays.allocate(cm, outputSelection, "poa_eff", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::POA);
 
-	p_snowLossTotal = cm->allocate("dc_snow_loss", numberOfWeatherFileRecords);
+	snowLossTotal.allocate(cm, outputSelection, "dc_snow_loss", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::LOSSES);
 
 	p_inverterDCVoltage = cm->allocate("inverter_dc_voltage", numberOfLifetimeRecords);
-	p_inverterEfficiency = cm->allocate("inv_eff", numberOfWeatherFileRecords);
-	p_inverterClipLoss = cm->allocate("inv_cliploss", numberOfWeatherFileRecords);
-	p_inverterMPPTLoss = cm->allocate("dc_invmppt_loss", numberOfWeatherFileRecords);
+	p_inverterEfficiency = outputSelection.allocate(cm, "inv_eff", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
+	inverterClipLoss.allocate(cm, outputSelection, "inv_cliploss", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::LOSSES);
+	inverterMPPTLoss.allocate(cm, outputSelection, "dc_invmppt_loss", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::LOSSES);
 
-	p_inverterPowerConsumptionLoss = cm->allocate("inv_psoloss", numberOfWeatherFileRecords);
-	p_inverterNightTimeLoss = cm->allocate("inv_pntloss", numberOfWeatherFileRecords);
-	p_inverterThermalLoss = cm->allocate("inv_tdcloss", numberOfWeatherFileRecords);
-	p_inverterTotalLoss = cm->allocate("inv_total_loss", numberOfWeatherFileRecords);
+	inverterPowerConsumptionLoss.allocate(cm, outputSelection, "inv_psoloss", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::LOSSES);
+	inverterNightTimeLoss.allocate(cm, outputSelection, "inv_pntloss", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::LOSSES);
+	inverterThermalLoss.allocate(cm, outputSelection, "inv_tdcloss", numberOfWeatherFileRecords, stepsPerHour, PVOutputSelection::LOSSES);
+	p_inverterTotalLoss = outputSelection.allocate(cm, "inv_total_loss", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
 
-	p_acWiringLoss = cm->allocate("ac_wiring_loss", numberOfWeatherFileRecords);
-	p_transmissionLoss = cm->allocate("ac_transmission_loss", numberOfWeatherFileRecords);
+	p_acWiringLoss = outputSelection.allocate(cm, "ac_wiring_loss", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
+	p_transmissionLoss = outputSelection.allocate(cm, "ac_transmission_loss", numberOfWeatherFileRecords, PVOutputSelection::LOSSES, unsavedOutputs);
 	p_systemDCPower = cm->allocate("dc_net", numberOfLifetimeRecords);
 	p_systemACPower = cm->allocate("gen", numberOfLifetimeRecords);
 
@@ -40,6 +40,64 @@ struct Inverter_IO;
 /// Structure containing the aggregate outputs for all subarrays
 struct PVSystem_IO;
 
+/**
+* \struct PVOutputSelection
+*
+* Selects the groups of time series outputs that are saved to the compute module from the
+* "timeseries_output_groups" input.  A series in a group that is not selected is never allocated in
+* the compute module; it is written to a scratch buffer owned by the IO structure, which is never read.
+*/
+struct PVOutputSelection
+{
+	enum GROUP { WEATHER = 1, SUBARRAY = 2, POA = 4, LOSSES = 8, ALL = -1 };
+
+	/// Read the selected groups from the compute module, all groups are saved if not assigned
+	PVOutputSelection(compute_module* cm);
+
+	/// Return whether series in the group are saved
+	bool isSaved(int group) const { return (groups & group) != 0; }
+
+	/// Allocate the output if its group is saved, otherwise return the scratch buffer
+	ssc_number_t * allocate(compute_module* cm, const std::string &name, size_t length, int group, std::vector<ssc_number_t> &scratch) const;
+
+	int groups;
+};
+
+/**
+* \class PVOutputSeries
+*
+* A year-one time series output whose monthly and annual sums are accumulated as it is written,
+* so that the aggregates are available whether or not the series itself is saved.
+*/
+class PVOutputSeries
+{
+public:
+	PVOutputSeries();
+
+	/// Allocate the series in the compute module if its group is saved
+	void allocate(compute_module* cm, const PVOutputSelection &selection, const std::string &name, size_t length, size_t stepsPerHour, int group);
+
+	/// Set the value at the time index
+	void set(size_t idx, ssc_number_t value);
+
+	/// Add to the value at the time index
+	void add(size_t idx, ssc_number_t value);
+
+	/// Assign the annual sum times scale to the compute module and return it
+	ssc_number_t assignAnnual(compute_module* cm, const std::string &annualName, double scale);
+
+	/// Assign the monthly sums times scale to the compute module
+	void assignMonthly(compute_module* cm, const std::string &monthlyName, double scale);
+
+private:
+	void accumulate(size_t idx, ssc_number_t value);
+
+	ssc_number_t * m_data;
+	size_t m_stepsPerHour;
+	double m_annual;
+	ssc_number_t m_monthly[12];
+};
+
 /**
 * \class PVIOManager
 *
@@ -85,7 +143,7 @@ public:
 	std::unique_ptr<PVSystem_IO> m_PVSystemIO;
 	std::unique_ptr<Inverter_IO> m_InverterIO;
 	std::vector<std::unique_ptr<Subarray_IO>> m_SubarraysIO;
-	std::unique_ptr<ShadeDB8_mpp> m_shadeDatabase;
+	std::vector<std::unique_ptr<ShadeDB8_mpp>> m_shadeDatabase; /// Per-subarray shading database, null if the subarray does not use it
 	size_t nSubarrays;
 
 private:
@@ -122,6 +180,9 @@ struct Irradiance_IO
 	/// Assign outputs from member data after the IrradianceModel has run 
 	void AssignOutputs(compute_module* cm);
 
+	PVOutputSelection outputSelection;						  /// The time series output groups to save
+	std::vector<ssc_number_t> unsavedOutputs;					  /// Scratch buffer for time series which are not saved
+
 	// Constants
 	static const int irradiationMax = 1500;						  /// The maximum irradiation (W/m2) allowed
 	static const int irradprocNoInterpolateSunriseSunset = -1;    /// Interpolate the sunrise/sunset
@@ -145,7 +206,7 @@ struct Irradiance_IO
 	std::vector<double> userSpecifiedMonthlyAlbedo;				  /// User can provide monthly ground albedo values (0-1)
 	
 	// Irradiance data Outputs (p_ is just a convention to organize all pointer outputs)
-	ssc_number_t * p_weatherFileGHI;			/// The Global Horizonal Irradiance from the weather file [W/m2]
+	PVOutputSeries weatherFileGHI;				/// The Global Horizonal Irradiance from the weather file [W/m2]
 	ssc_number_t * p_weatherFileDNI;			/// The Direct Normal (Beam) Irradiance from the weather file [W/m2]
 	ssc_number_t * p_weatherFileDHI;			/// The Direct Normal (Beam) Irradiance from the weather file [W/m2]
 	std::vector<ssc_number_t *> p_weatherFilePOA; /// The Plane of Array Irradiance from the weather file [W/m2]
@@ -190,6 +251,10 @@ struct PVSystem_IO
 	size_t numberOfSubarrays;
 	size_t numberOfInverters;
 
+	PVOutputSelection outputSelection;
+	std::vector<ssc_number_t> unsavedOutputs;
+	std::vector<std::vector<ssc_number_t>> unsavedSubarrayOutputs; /// Separate per subarray as subarrays may run on worker threads
+
 	Irradiance_IO * Irradiance;
 	Simulation_IO * Simulation;
 	std::vector<Subarray_IO*> Subarrays;
@@ -270,26 +335,26 @@ struct PVSystem_IO
 	ssc_number_t *p_transformerLoss;
 
 	// outputs summed across all subarrays (some could be moved to other structures)
-	ssc_number_t *p_poaFrontNominalTotal;
-	ssc_number_t *p_poaFrontBeamNominalTotal;
-	ssc_number_t *p_poaFrontBeamTotal;
-	ssc_number_t *p_poaFrontShadedTotal;
-	ssc_number_t *p_poaFrontShadedSoiledTotal;
-	ssc_number_t *p_poaRearTotal;
-	ssc_number_t *p_poaFrontTotal;
-	ssc_number_t *p_poaTotalAllSubarrays;
+	PVOutputSeries poaFrontNominalTotal;
+	PVOutputSeries poaFrontBeamNominalTotal;
+	PVOutputSeries poaFrontBeamTotal;
+	PVOutputSeries poaFrontShadedTotal;
+	PVOutputSeries poaFrontShadedSoiledTotal;
+	PVOutputSeries poaRearTotal;
+	PVOutputSeries poaFrontTotal;
+	PVOutputSeries poaTotalAllSubarrays;
 
 
-	ssc_number_t *p_snowLossTotal;
+	PVOutputSeries snowLossTotal;
 
 	ssc_number_t *p_inverterDCVoltage;
 	ssc_number_t *p_inverterEfficiency;
-	ssc_number_t *p_inverterClipLoss;
-	ssc_number_t *p_inverterMPPTLoss;
+	PVOutputSeries inverterClipLoss;
+	PVOutputSeries inverterMPPTLoss;
 
-	ssc_number_t *p_inverterPowerConsumptionLoss;
-	ssc_number_t *p_inverterNightTimeLoss;
-	ssc_number_t *p_inverterThermalLoss;
+	PVOutputSeries inverterPowerConsumptionLoss;
+	PVOutputSeries inverterNightTimeLoss;
+	PVOutputSeries inverterThermalLoss;
 	ssc_number_t *p_inverterTotalLoss;
 
 	ssc_number_t *p_acWiringLoss;
@@ -52,6 +52,9 @@
 #include <algorithm>    // std::sort
 #include <math.h> // logarithm function
 #include <cstring> // memcpy
+#include <cstdio>
+#include <map>
+#include <mutex>
 
 #include "lib_miniz.h" // decompression
 #include "DB8_vmpp_impp_uint8_bin.h" // char* of binary compressed file
@@ -82,29 +85,60 @@ short ShadeDB8_mpp::get_impp(size_t i)
 };
 
 
-bool ShadeDB8_mpp::get_index(const size_t &N, const size_t &d, const  size_t &t, const size_t &S, const  db_type &DB_TYPE, size_t* ret_ndx)
+// offset of the first S vector for each (N, d, t) combination, in the order the tables are stored:
+// N outermost, then diffuse fraction d, then shaded fraction t
+class shade_db_offsets
 {
-	bool ret_val = false;
-	//size_t ret_ndx=-1;
-	size_t length=0;
-//	size_t length_t =10, length_d=10;
-	size_t iN = 0, id = 0, it = 0;
+public:
+	shade_db_offsets()
+	{
+		size_t ndx = 0;
+		for (size_t N = 1; N <= 8; N++)
+		{
+			for (size_t d = 1; d <= 10; d++)
+			{
+				for (size_t t = 1; t <= 10; t++)
+				{
+					// number of s vectors times length of each S vector
+					num_s[N - 1][t - 1] = choose(t + N - 1, t);
+					offset[N - 1][d - 1][t - 1] = ndx;
+					ndx += num_s[N - 1][t - 1] * 8;
+				}
+			}
+		}
+	}
+	static size_t choose(size_t n, size_t k)
+	{
+		if (k > n) return 0;
+		if (k * 2 > n) k = n - k;
+		if (k == 0) return 1;
+		size_t result = n;
+		for (size_t i = 2; i <= k; ++i) {
+			result *= (n - i + 1);
+			result /= i;
+		}
+		return result;
+	}
+	size_t num_s[8][10];
+	size_t offset[8][10][10];
+};
+// filled during static initialization so lookups need no locking
+static const shade_db_offsets shade_db_offset_table;
 
+bool ShadeDB8_mpp::get_index(const size_t &N, const size_t &d, const  size_t &t, const size_t &S, const  db_type &DB_TYPE, size_t* ret_ndx)
+{
 	// ret_ndx==0 is an error condition.
 	// check N
-	if ((N < 1) || (N>8)) return ret_val;
+	if ((N < 1) || (N>8)) return false;
 	// check d
-	if ((d < 1) || (d>10)) return ret_val;
+	if ((d < 1) || (d>10)) return false;
 	// check t
-	if ((t < 1) || (t>10)) return ret_val;
+	if ((t < 1) || (t>10)) return false;
 
 	// check S value for validity
-	// find number of s vectors
-	size_t size_s = n_choose_k(t + N - 1, t);
-	if ((S < 1) || (S>size_s)) return ret_val;
-
-
+	if ((S < 1) || (S>shade_db_offset_table.num_s[N - 1][t - 1])) return false;
 
+	size_t length = 0;
 	switch (DB_TYPE)
 	{
 		case VMPP:
@@ -114,46 +148,16 @@ bool ShadeDB8_mpp::get_index(const size_t &N, const size_t &d, const  size_t &t,
 			length = 8;
 			break;
 	}
-	if (length == 0) return ret_val;
-	*ret_ndx = 0; // independent vectors for vmpp,impp,vs and is so offset=0
+	if (length == 0) return false;
 
-	size_t t_ub = 11; // upper bound of t index for iteration
-	size_t d_ub = 10; // upper bound of d index for iteration
-	do
-	{
-		iN++;
-		d_ub = ((iN == N) ? d : 10);
-		id = 0;
-		do
-		{
-			id++;
-			t_ub = (((iN==N) && (id==d)) ? t : 11);
-			for (it = 1; it < t_ub; it++)
-			{
-				// find number of s vectors
-				size_s = n_choose_k(it + iN - 1, it);
-				// multiply by length of each S vector
-				*ret_ndx += size_s*length;
-			}
-		} while (id < d_ub);
-	} while (iN < N);
-	*ret_ndx += (S - 1)*length;
-	ret_val = true;
-	return ret_val;
+	// independent vectors for vmpp,impp,vs and is so offset=0
+	*ret_ndx = shade_db_offset_table.offset[N - 1][d - 1][t - 1] + (S - 1)*length;
+	return true;
 }
 
 size_t ShadeDB8_mpp::n_choose_k(size_t n, size_t k)
 {
-	if (k > n) return 0;
-	if (k * 2 > n) k = n - k;
-	if (k == 0) return 1;
-
-	size_t result = n;
-	for (size_t i = 2; i <= k; ++i) {
-		result *= (n - i + 1);
-		result /= i;
-	}
-	return result;
+	return shade_db_offsets::choose(n, k);
 }
 
 std::vector<double> ShadeDB8_mpp::get_vector(const size_t &N, const size_t &d, const size_t &t, const size_t &S, const db_type &DB_TYPE)
@@ -184,55 +188,136 @@ std::vector<double> ShadeDB8_mpp::get_vector(const size_t &N, const size_t &d, c
 	return ret_vec;
 }
 
-void ShadeDB8_mpp::init()
+void ShadeDB8_mpp::init(const std::string &decompressed_file)
 {
 	p_error_msg = "";
 	p_warning_msg = "";
-	p_vmpp_uint8_size = 12091680; // uint8 size from matlab
-	p_impp_uint8_size = 12091680; // uint8 size from matlab
-	p_vmpp = (unsigned char *)malloc(p_vmpp_uint8_size);//malloc(12091680); uint8 size
-	p_impp = (unsigned char *)malloc(p_impp_uint8_size);//malloc(12091680); uint8 size
-	p_compressed_size = 3133517; // from modified example5.c in miniz project
-	decompress_file_to_uint8();
+	p_tables = ShadeDB8_tables::acquire(decompressed_file);
+	if (!decompressed_file.empty() && !p_tables->get_error().empty())
+	{
+		p_warning_msg = p_tables->get_error() + ", using embedded shading database";
+		p_tables = ShadeDB8_tables::acquire();
+	}
+	p_error_msg = p_tables->get_error();
+	p_vmpp = p_tables->vmpp();
+	p_impp = p_tables->impp();
 }
 
-ShadeDB8_mpp::~ShadeDB8_mpp()
-{
-	if (p_vmpp)
-		free(p_vmpp);
-	if (p_impp)
-		free(p_impp);
-}
+static std::mutex shade_db_tables_mutex;
+// only weak references are kept here, so the tables live as long as a ShadeDB8_mpp uses them
+static std::weak_ptr<const ShadeDB8_tables> shade_db_embedded;
+static std::map<std::string, std::weak_ptr<const ShadeDB8_tables> > shade_db_mapped;
 
+std::shared_ptr<const ShadeDB8_tables> ShadeDB8_tables::acquire(const std::string &decompressed_file)
+{
+	std::lock_guard<std::mutex> lock(shade_db_tables_mutex);
+	if (decompressed_file.empty())
+	{
+		std::shared_ptr<const ShadeDB8_tables> embedded = shade_db_embedded.lock();
+		if (!embedded)
+		{
+			std::shared_ptr<ShadeDB8_tables> tables(new ShadeDB8_tables());
+			tables->decompress();
+			shade_db_embedded = embedded = tables;
+		}
+		return embedded;
+	}
 
+	std::map<std::string, std::weak_ptr<const ShadeDB8_tables> >::iterator it = shade_db_mapped.begin();
+	while (it != shade_db_mapped.end())
+	{
+		if (it->second.expired())
+			shade_db_mapped.erase(it++);
+		else
+			++it;
+	}
+	it = shade_db_mapped.find(decompressed_file);
+	if (it != shade_db_mapped.end())
+		return it->second.lock();
+
+	std::shared_ptr<ShadeDB8_tables> tables(new ShadeDB8_tables());
+	if (tables->map_file(decompressed_file))
+		shade_db_mapped[decompressed_file] = tables;
+	return tables;
+}
 
-bool ShadeDB8_mpp::decompress_file_to_uint8()
+bool ShadeDB8_tables::write_decompressed(const std::string &file, std::string *error)
 {
-	size_t status;
-	uint8 *pTmp_data;
-
-	size_t mem_size = p_vmpp_uint8_size + p_impp_uint8_size;
+	std::shared_ptr<const ShadeDB8_tables> tables = acquire();
+	if (!tables->get_error().empty())
+	{
+		if (error) *error = tables->get_error();
+		return false;
+	}
+	FILE *fp = fopen(file.c_str(), "wb");
+	if (!fp)
+	{
+		if (error) *error = "could not open " + file + " for writing";
+		return false;
+	}
+	size_t mem_size = vmpp_uint8_size + impp_uint8_size;
+	bool ok = (fwrite(tables->p_data, 1, mem_size, fp) == mem_size);
+	if (fclose(fp) != 0) ok = false;
+	if (!ok && error) *error = "failed to write " + file;
+	return ok;
+}
 
-	pTmp_data = (uint8 *)malloc(mem_size);
+ShadeDB8_tables::ShadeDB8_tables()
+{
+	p_data = NULL;
+	p_buffer = NULL;
+}
 
-	status = tinfl_decompress_mem_to_mem((void *)pTmp_data, mem_size, pCmp_data, p_compressed_size, TINFL_FLAG_PARSE_ZLIB_HEADER);
+ShadeDB8_tables::~ShadeDB8_tables()
+{
+	if (p_buffer)
+		free(p_buffer);
+}
 
-	memcpy(p_vmpp, pTmp_data, p_vmpp_uint8_size);
-	memcpy(p_impp, pTmp_data + p_vmpp_uint8_size, p_impp_uint8_size);
+bool ShadeDB8_tables::decompress()
+{
+	size_t mem_size = vmpp_uint8_size + impp_uint8_size;
+	// vmpp followed by impp, exactly as stored in the compressed database
+	p_buffer = (uint8 *)malloc(mem_size);
+	p_data = p_buffer;
 
-	free(pTmp_data);
+	size_t status = tinfl_decompress_mem_to_mem((void *)p_buffer, mem_size, pCmp_data, compressed_size, TINFL_FLAG_PARSE_ZLIB_HEADER);
 
 	if (status == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED)
 	{
 		std::stringstream outm;
 		outm << "tinfl_decompress_mem_to_mem() failed with status " << (int)status;
 		p_error_msg = outm.str();
-		return EXIT_FAILURE;
+		return false;
 	}
 
 	return true;
 };
 
+bool ShadeDB8_tables::map_file(const std::string &file)
+{
+	size_t size;
+	if (!util::file_stat(file.c_str(), &size, 0))
+	{
+		p_error_msg = "could not open shading database file " + file;
+		return false;
+	}
+	if (size != vmpp_uint8_size + impp_uint8_size)
+	{
+		p_error_msg = "shading database file " + file + " has the wrong size";
+		return false;
+	}
+	// the file could be replaced between the two checks
+	if (!p_map.open(file) || p_map.size() != size)
+	{
+		p_map.close();
+		p_error_msg = "could not map shading database file " + file;
+		return false;
+	}
+	p_data = p_map.data();
+	return true;
+}
+
 double ShadeDB8_mpp::get_shade_loss(double &gpoa, double &dpoa, std::vector<double> &shade_frac, bool use_pv_cell_temp, double pv_cell_temp, int mods_per_str, double str_vmp_stc, double mppt_lo, double mppt_hi)
 {
 	double shade_loss = 0;
@@ -56,8 +56,43 @@
 #include <vector>
 #include <stdlib.h>
 #include <string>
+#include <memory>
+
+#include "lib_util.h"
 
 extern const unsigned char pCmp_data[3133517];
+
+// decompressed vmpp and impp tables, shared read-only by the ShadeDB8_mpp instances that are alive at the same time
+class ShadeDB8_tables
+{
+public:
+	~ShadeDB8_tables();
+	const unsigned char *vmpp() const { return p_data; }
+	const unsigned char *impp() const { return p_data + vmpp_uint8_size; }
+	std::string get_error() const { return p_error_msg; }
+
+	static const size_t vmpp_uint8_size = 12091680; // uint8 size from matlab
+	static const size_t impp_uint8_size = 12091680; // uint8 size from matlab
+	static const size_t compressed_size = 3133517; // from modified example5.c in miniz project
+
+	// shared tables: the embedded database is decompressed when no other user holds it, or if a file
+	// written by write_decompressed() is given it is mapped read-only into memory instead. the memory
+	// is released when the last returned pointer is released
+	static std::shared_ptr<const ShadeDB8_tables> acquire(const std::string &decompressed_file = "");
+	// writes the decompressed vmpp and impp tables to a file for use with acquire()
+	static bool write_decompressed(const std::string &file, std::string *error = 0);
+
+private:
+	ShadeDB8_tables();
+	bool decompress();
+	bool map_file(const std::string &file);
+
+	const unsigned char *p_data;
+	unsigned char *p_buffer;
+	util::mapped_file p_map;
+	std::string p_error_msg;
+};
+
 // shading database with up to 8 strings
 class ShadeDB8_mpp
 {
@@ -67,8 +102,8 @@ public:
 		p_vmpp = NULL;
 		p_impp=NULL ;
 	};
-	~ShadeDB8_mpp();
-	void init();
+	// attaches to the shared tables, see ShadeDB8_tables::acquire
+	void init(const std::string &decompressed_file = "");
 	short vmpp(size_t ndx){
 		return get_vmpp(ndx);
 	};
@@ -85,14 +120,11 @@ public:
 
 
 private:
-	unsigned char *p_vmpp;
-	unsigned char *p_impp;
+	std::shared_ptr<const ShadeDB8_tables> p_tables;
+	const unsigned char *p_vmpp;
+	const unsigned char *p_impp;
 	short get_vmpp(size_t i);
 	short get_impp(size_t i);
-	bool decompress_file_to_uint8();
-	size_t p_vmpp_uint8_size;
-	size_t p_impp_uint8_size;
-	size_t p_compressed_size;
 	std::string p_warning_msg;
 	std::string p_error_msg;
 };
@@ -126,6 +126,18 @@ std::string pvmodule_t::error()
 	return m_err;
 }
 
+bool pvmodule_t::current_sweep( pvinput_t &input, double TcellC, const double *V, size_t n, double *I )
+{
+	bool ok = true;
+	for ( size_t i = 0; i < n; i++ )
+	{
+		pvoutput_t out( 0, 0, 0, 0, 0, 0, 0, 0 );
+		ok = (*this)( input, TcellC, V[i], out ) && ok;
+		I[i] = out.Current;
+	}
+	return ok;
+}
+
 spe_module_t::spe_module_t( )
 {
 	VmpNominal = 0;
@@ -338,6 +350,61 @@ double current_5par( double V, double IMR, double A, double IL, double IO, doubl
 	return INEW;
 }
 
+void current_5par_batch( const double *V, size_t n, double IMR, double A, double IL, double IO, double RS, double RSH, double *I )
+{
+/*
+	Same Newton iteration as current_5par for a whole voltage sweep.  Voltages are
+	processed in small blocks that iterate in lockstep, and each lane stops on
+	exactly the same test as the scalar routine, so results match current_5par.
+*/
+	const size_t NB = 16;
+	const int maxit = 4000;
+	double IOLD[NB], INEW[NB];
+	int it[NB];
+	bool active[NB];
+
+	for ( size_t k0 = 0; k0 < n; k0 += NB )
+	{
+		size_t nb = (n - k0 < NB) ? n - k0 : NB;
+		size_t nactive = 0;
+		for ( size_t j = 0; j < nb; j++ )
+		{
+			IOLD[j] = 0.0;
+			INEW[j] = IMR;
+			it[j] = 0;
+			active[j] = fabs(INEW[j]-IOLD[j]) > 0.0001;
+			if ( active[j] ) nactive++;
+			else I[k0+j] = INEW[j];
+		}
+
+		while( nactive > 0 )
+		{
+			for ( size_t j = 0; j < nb; j++ )
+			{
+				if ( !active[j] ) continue;
+
+				double V_MODULE = V[k0+j];
+				IOLD[j] = INEW[j];
+				double F = IL-IOLD[j]-IO*(exp((V_MODULE+IOLD[j]*RS)/A)-1.0) - (V_MODULE+IOLD[j]*RS)/RSH;
+				double FPRIME = -1.0-IO*(RS/A)*exp((V_MODULE+IOLD[j]*RS)/A)-(RS/RSH);
+				INEW[j] = max(0.0,(IOLD[j]-(F/FPRIME)));
+				if ( it[j]++ == maxit )
+				{
+					I[k0+j] = -1.0;
+					active[j] = false;
+					nactive--;
+				}
+				else if ( !(fabs(INEW[j]-IOLD[j]) > 0.0001) )
+				{
+					I[k0+j] = INEW[j];
+					active[j] = false;
+					nactive--;
+				}
+			}
+		}
+	}
+}
+
 double current_5par_rec(double V, double IMR, double A, double IL, double IO, double RS, double RSH, double D2MuTau, double Vbi)
 {
 	/*
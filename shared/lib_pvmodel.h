@@ -112,6 +112,9 @@ protected:
 public:
 	
 	virtual bool operator() ( pvinput_t &input, pvmodule_t &module, double opvoltage, double &Tcell ) = 0;
+
+	// false if the cell temperature does not depend on the module operating voltage
+	virtual bool depends_on_voltage() { return true; }
 	std::string error();
 };
 
@@ -129,6 +132,10 @@ public:
 
 
 	virtual bool operator() ( pvinput_t &input, double TcellC, double opvoltage, pvoutput_t &output ) = 0;
+
+	// module current at each of n operating voltages for a single cell temperature,
+	// the default evaluates operator() at each voltage
+	virtual bool current_sweep( pvinput_t &input, double TcellC, const double *V, size_t n, double *I );
 	std::string error();
 };
 
@@ -163,6 +170,7 @@ public:
 #define AOI_MAX 89.5
 
 double current_5par( double V, double IMR, double A, double IL, double IO, double RS, double RSH );
+void current_5par_batch( const double *V, size_t n, double IMR, double A, double IL, double IO, double RS, double RSH, double *I );
 double current_5par_rec(double V, double IMR, double A, double IL, double IO, double RS, double RSH, double D2MuTau, double Vbi);
 double openvoltage_5par( double Voc0, double a, double IL, double IO, double Rsh );
 double openvoltage_5par_rec(double Voc0, double a, double IL, double IO, double Rsh, double D2MuTau, double Vbi);
@@ -94,10 +94,10 @@ double mask_angle_func(double x, double R, double B, double tilt_eff)
 #define K 5
 #define FUNC(x,R,B,tilt) ((*func)(x,R,B,tilt))
 
-double trapzd(double (*func)(double,double,double,double), double a, double b, double R, double B, double tilt, int n)
+// the running estimate s is owned by the caller (qromb) so concurrent integrations do not share state
+double trapzd(double (*func)(double,double,double,double), double a, double b, double R, double B, double tilt, int n, double &s)
 {
 	double x,tnm,sum,del;
-	static double s;
 	int it,j;
 	if (n == 1) 
 	{
@@ -160,15 +160,15 @@ void polint(double xa[], double ya[], int n, double x, double *y, double *dy)
 double qromb(double (*func)(double,double,double,double), double a, double b, double R, double B, double tilt)
 {
 	void polint(double xa[], double ya[], int n, double x, double *y, double *dy);
-	double trapzd(double (*func)(double,double,double,double), double a, double b, double R, double B, double tilt, int n);
+	double trapzd(double (*func)(double,double,double,double), double a, double b, double R, double B, double tilt, int n, double &s);
 	void nrerror(char error_text[]);
-	double ss,dss;
+	double ss,dss,st=0;
 	double s[JMAXP],h[JMAXP+1];
 	int j;
 	h[1]=1.0;
 	for (j=1;j<=JMAX;j++) 
 	{
-		s[j]=trapzd(func,a,b,R,B,tilt,j);
+		s[j]=trapzd(func,a,b,R,B,tilt,j,st);
 		if (j >= K) 
 		{
 			polint(&h[j-K],&s[j-K],K,0.0,&ss,&dss);
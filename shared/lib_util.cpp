@@ -57,10 +57,14 @@
 #ifdef _WIN32
 #include <direct.h>
 #include <Windows.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #else
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #endif
 
 #include "lib_util.h"
@@ -225,6 +229,85 @@ bool util::file_exists( const char *file )
 #endif
 }
 
+bool util::file_stat( const char *file, size_t *size, long long *mtime )
+{
+#ifdef _WIN32
+	struct _stat64 st;
+	if ( _stat64( file, &st ) != 0 ) return false;
+#else
+	struct stat st;
+	if ( ::stat( file, &st ) != 0 ) return false;
+#endif
+	if ( size ) *size = (size_t)st.st_size;
+	if ( mtime ) *mtime = (long long)st.st_mtime;
+	return true;
+}
+
+util::mapped_file::mapped_file()
+	: p(0), n(0)
+{
+#ifdef _WIN32
+	hfile = hmap = 0;
+#endif
+}
+
+bool util::mapped_file::open( const std::string &file )
+{
+	close();
+#ifdef _WIN32
+	HANDLE fh = ::CreateFileA( file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( fh == INVALID_HANDLE_VALUE ) return false;
+	LARGE_INTEGER fsize;
+	if ( !::GetFileSizeEx( fh, &fsize ) || fsize.QuadPart == 0 )
+	{
+		::CloseHandle( fh );
+		return false;
+	}
+	HANDLE mh = ::CreateFileMappingA( fh, NULL, PAGE_READONLY, 0, 0, NULL );
+	void *view = ( mh != NULL ) ? ::MapViewOfFile( mh, FILE_MAP_READ, 0, 0, 0 ) : NULL;
+	if ( view == NULL )
+	{
+		if ( mh != NULL ) ::CloseHandle( mh );
+		::CloseHandle( fh );
+		return false;
+	}
+	hfile = fh;
+	hmap = mh;
+	n = (size_t)fsize.QuadPart;
+#else
+	int fd = ::open( file.c_str(), O_RDONLY );
+	if ( fd < 0 ) return false;
+	struct stat st;
+	if ( ::fstat( fd, &st ) != 0 || st.st_size == 0 )
+	{
+		::close( fd );
+		return false;
+	}
+	void *view = ::mmap( NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	// the mapping stays valid after the descriptor is closed
+	::close( fd );
+	if ( view == MAP_FAILED ) return false;
+	n = (size_t)st.st_size;
+#endif
+	p = (const unsigned char*)view;
+	return true;
+}
+
+void util::mapped_file::close()
+{
+	if ( !p ) return;
+#ifdef _WIN32
+	::UnmapViewOfFile( p );
+	::CloseHandle( (HANDLE)hmap );
+	::CloseHandle( (HANDLE)hfile );
+	hfile = hmap = 0;
+#else
+	::munmap( (void*)p, n );
+#endif
+	p = 0;
+	n = 0;
+}
+
 bool util::dir_exists( const char *path )
 {
 #ifdef _WIN32
@@ -54,6 +54,8 @@
 #include <string>
 #include <vector>
 #include <cassert>
+#include <new>
+#include <utility>
 
 #include <unordered_map>
 using std::unordered_map;
@@ -62,6 +64,13 @@ using std::unordered_map;
 #pragma warning(disable: 4290)  // ignore warning: 'C++ exception specification ignored except to indicate a function is not __declspec(nothrow)'
 #pragma warning(disable: 4996)  // fopen and fopen_s among others
 #endif
+
+// VS2013 does not understand noexcept
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define UTIL_NOEXCEPT throw()
+#else
+#define UTIL_NOEXCEPT noexcept
+#endif
 /* 
 
 For proper compilation:
@@ -212,6 +221,30 @@ namespace util
 		FILE *p;
 	};
 
+	// read-only memory mapping of an entire file
+	class mapped_file
+	{
+	public:
+		mapped_file();
+		~mapped_file() { close(); }
+		bool open( const std::string &file );
+		bool ok() const { return 0 != p; }
+		const unsigned char *data() const { return p; }
+		size_t size() const { return n; }
+		void close();
+	private:
+		mapped_file( const mapped_file & );
+		mapped_file &operator=( const mapped_file & );
+		const unsigned char *p;
+		size_t n;
+#ifdef _WIN32
+		void *hfile, *hmap;
+#endif
+	};
+
+	/* size in bytes and modification time of a file, returns false if it cannot be queried */
+	bool file_stat( const char *file, size_t *size, long long *mtime );
+
 	template< typename T, size_t n_rows, size_t n_cols >
 	class matrix_static_t
 	{
@@ -277,39 +310,121 @@ namespace util
 		}
 	};
 
+	/* heap storage for matrix_t.  an alignment of zero uses plain new[]/delete[],
+	   otherwise the cells start on a multiple of 'align' bytes (a power of two),
+	   with the address of the raw allocation stashed just in front of them */
+	template< typename T >
+	T *matrix_alloc( size_t n, size_t align )
+	{
+		if ( align == 0 ) return new T[n];
+
+		if ( align < sizeof(void*) ) align = sizeof(void*);
+		char *raw = static_cast<char*>( ::operator new( n*sizeof(T) + align + sizeof(void*) ) );
+		size_t base = reinterpret_cast<size_t>( raw + sizeof(void*) );
+		T *p = reinterpret_cast<T*>( (base + align - 1) & ~(align - 1) );
+		reinterpret_cast<void**>(p)[-1] = raw;
+		for ( size_t i=0;i<n;i++ )
+			new (p+i) T();
+		return p;
+	}
+
+	template< typename T >
+	void matrix_free( T *p, size_t n, size_t align )
+	{
+		if ( p == NULL ) return;
+		if ( align == 0 ) { delete [] p; return; }
+
+		for ( size_t i=0;i<n;i++ )
+			p[i].~T();
+		::operator delete( reinterpret_cast<void**>(p)[-1] );
+	}
+
 	template< typename T >
 	class matrix_t
 	{
 	protected:
 		T *t_array;
 		size_t n_rows, n_cols;
+		size_t n_align; // requested byte alignment of heap storage, 0 for the default
+		bool b_borrowed; // t_array is owned by someone else and must not be deleted
+		T t_single; // 1x1 matrices (i.e. SSC_NUMBER values) live here, without a heap allocation
+
+		inline bool is_inline() const
+		{
+			return t_array == &t_single;
+		}
+
+		void init()
+		{
+			t_single = T();
+			t_array = &t_single;
+			n_rows = n_cols = 1;
+			n_align = 0;
+			b_borrowed = false;
+		}
+
+		// drop the current storage and fall back to the inline 1x1 cell
+		void release()
+		{
+			if ( !b_borrowed && !is_inline() )
+				matrix_free( t_array, n_rows*n_cols, n_align );
+			t_single = T();
+			t_array = &t_single;
+			n_rows = n_cols = 1;
+			b_borrowed = false;
+		}
+
+		// take over the storage of rhs, leaving it as an empty 1x1 matrix
+		void take( matrix_t &rhs )
+		{
+			n_rows = rhs.n_rows;
+			n_cols = rhs.n_cols;
+			n_align = rhs.n_align;
+			b_borrowed = rhs.b_borrowed;
+			if ( rhs.is_inline() )
+			{
+				t_single = std::move( rhs.t_single );
+				t_array = &t_single;
+			}
+			else
+				t_array = rhs.t_array;
+
+			rhs.t_single = T();
+			rhs.t_array = &rhs.t_single;
+			rhs.n_rows = rhs.n_cols = 1;
+			rhs.b_borrowed = false;
+		}
+
 	public:
 
 		matrix_t()
 		{
-			t_array = new T[1];
-			n_rows = n_cols = 1;
+			init();
 		}
 
 		matrix_t( const matrix_t &cc )
 		{
-			n_rows = n_cols = 0;
-			t_array = NULL;
+			init();
+			n_align = cc.n_align;
 			copy( cc );
 		}
+
+		matrix_t( matrix_t &&rhs ) UTIL_NOEXCEPT
+		{
+			init();
+			take( rhs );
+		}
 		
 		matrix_t(size_t len)
 		{
-			n_rows = n_cols = 0;
-			t_array = NULL;
+			init();
 			if (len < 1) len = 1;
 			resize( 1, len );
 		}
 
 		matrix_t(size_t nr, size_t nc)
 		{
-			n_rows = n_cols = 0;
-			t_array = NULL;
+			init();
 			if (nr < 1) nr = 1;
 			if (nc < 1) nc = 1;
 			resize(nr,nc);
@@ -317,8 +432,7 @@ namespace util
 		
 		matrix_t(size_t nr, size_t nc, const T &val)
 		{
-			n_rows = n_cols = 0;
-			t_array = NULL;
+			init();
 			if (nr < 1) nr = 1;
 			if (nc < 1) nc = 1;
 			resize(nr,nc);
@@ -326,8 +440,7 @@ namespace util
 		}
 		matrix_t(size_t nr, size_t nc, const std::vector<T> *val)
 		{
-			n_rows = n_cols = 0;
-			t_array = NULL;
+			init();
 			if (nr < 1) nr = 1;
 			if (nc < 1) nc = 1;
 			resize(nr, nc);
@@ -337,16 +450,58 @@ namespace util
 		}
 
 
-		virtual ~matrix_t()
+		~matrix_t()
 		{
-			if (t_array) delete [] t_array;
+			release();
 		}
 		
 		void clear()
 		{
-			if (t_array) delete [] t_array;
-			n_rows = n_cols = 1;
-			t_array = new T[1];
+			release();
+		}
+
+		/* reference external memory without copying it. the caller
+		   keeps ownership and must keep the buffer alive for as long
+		   as this matrix refers to it.  any subsequent resize or
+		   assignment detaches the matrix and allocates its own storage */
+		void borrow( T *pvalues, size_t nr, size_t nc )
+		{
+			if (pvalues == NULL || nr < 1 || nc < 1) return;
+			release();
+			t_array = pvalues;
+			n_rows = nr;
+			n_cols = nc;
+			b_borrowed = true;
+		}
+
+		inline bool is_borrowed() const
+		{
+			return b_borrowed;
+		}
+
+		/* place heap storage on a multiple of 'bytes' (a power of two, e.g. 32 or 64
+		   for SIMD loads), or back on the default allocator with 0.  contents are kept. */
+		void set_alignment( size_t bytes )
+		{
+			if ( bytes == n_align ) return;
+			if ( b_borrowed || is_inline() )
+			{
+				n_align = bytes;
+				return;
+			}
+
+			size_t nn = n_rows*n_cols;
+			T *p = matrix_alloc<T>( nn, bytes );
+			for (size_t i=0;i<nn;i++)
+				p[i] = t_array[i];
+			matrix_free( t_array, nn, n_align );
+			t_array = p;
+			n_align = bytes;
+		}
+
+		inline size_t alignment() const
+		{
+			return n_align;
 		}
 		
 		void copy( const matrix_t &rhs )
@@ -386,6 +541,17 @@ namespace util
 
 			return *this;
 		}
+
+		matrix_t &operator=( matrix_t &&rhs ) UTIL_NOEXCEPT
+		{
+			if ( this != &rhs )
+			{
+				release();
+				take( rhs );
+			}
+
+			return *this;
+		}
 		
 		matrix_t &operator=(const T &val)
 		{
@@ -431,10 +597,16 @@ namespace util
 		void resize(size_t nr, size_t nc)
 		{
 			if (nr < 1 || nc < 1) return;
+			if (b_borrowed) release();
 			if (nr == n_rows && nc == n_cols) return;
-			
-			if (t_array) delete [] t_array;
-			t_array = new T[ nr * nc ];
+
+			// storage with the same number of cells is reused as is
+			if ( nr*nc != n_rows*n_cols )
+			{
+				release();
+				if ( nr*nc > 1 )
+					t_array = matrix_alloc<T>( nr*nc, n_align );
+			}
 			n_rows = nr;
 			n_cols = nc;
 		}
@@ -580,12 +752,73 @@ namespace util
 			return t_array;
 		}
 
+		inline const T *data() const
+		{
+			return t_array;
+		}
+
 		inline T value() const
 		{
 			return t_array[0];
 		}
 	};
 
+	/* read-only, non-owning window onto matrix_t data (or any row-major
+	   buffer).  cheap to pass by value; the viewed storage must outlive it */
+	template< typename T >
+	class matrix_view_t
+	{
+	protected:
+		const T *t_array;
+		size_t n_rows, n_cols;
+	public:
+
+		matrix_view_t() : t_array(NULL), n_rows(0), n_cols(0)
+		{
+		}
+
+		matrix_view_t( const matrix_t<T> &mat ) : t_array(mat.data()), n_rows(mat.nrows()), n_cols(mat.ncols())
+		{
+		}
+
+		matrix_view_t( const T *pvalues, size_t nr, size_t nc ) : t_array(pvalues), n_rows(nr), n_cols(nc)
+		{
+		}
+
+		inline const T &at(size_t i) const
+		{
+	#ifdef _DEBUG
+			VEC_ASSERT( i >= 0 && i < n_rows*n_cols );
+	#endif
+			return t_array[i];
+		}
+
+		inline const T &at(size_t r, size_t c) const
+		{
+	#ifdef _DEBUG
+			VEC_ASSERT( r >= 0 && r < n_rows && c >= 0 && c < n_cols );
+	#endif
+			return t_array[n_cols*r+c];
+		}
+
+		inline const T &operator()(size_t r, size_t c) const
+		{
+			return at(r, c);
+		}
+
+		inline const T &operator[](size_t i) const
+		{
+			return at(i);
+		}
+
+		inline size_t nrows() const { return n_rows; }
+		inline size_t ncols() const { return n_cols; }
+		inline size_t ncells() const { return n_rows*n_cols; }
+		inline size_t length() const { return n_cols; }
+		inline const T *data() const { return t_array; }
+		inline T value() const { return t_array[0]; }
+	};
+
 	template< typename T >
 	class block_t
 	{
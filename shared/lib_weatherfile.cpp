@@ -53,6 +53,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
 #include <numeric>
 #include <limits>
 #include <iostream>
@@ -474,6 +475,12 @@ void weatherfile::reset()
 
 	m_hdr.reset();
 	//m_rec.reset();
+
+	for (size_t k = 0; k < _MAXCOL_; k++)
+	{
+		m_columns[k].index = -1;
+		m_columns[k].values = 0;
+	}
 }
 
 
@@ -584,6 +591,47 @@ bool weatherfile::open(const std::string &file, bool header_only)
 		return false;
 	}
 
+	m_file = file;
+
+	if (cmp_ext(file, "wfbin"))
+		return open_binary(file, header_only, std::string());
+
+	// use a binary cache of the text file if one exists and is current
+	std::string cache_file = file + ".wfbin";
+	bool write_cache = !header_only && s_binaryCache;
+	source_key key;
+	bool hashed = false;
+	if (util::file_exists(cache_file.c_str()) && open_binary(cache_file, header_only, file, &hashed))
+	{
+		// once the source is old enough, rewrite a hashed cache so later opens only stat the source
+		if (write_cache && hashed && get_source_key(file, &key) && !source_is_recent(key))
+			write_binary(cache_file, key);
+		return true;
+	}
+
+	// key the source before parsing so a change made during the parse invalidates the cache
+	if (write_cache)
+		write_cache = get_source_key(file, &key);
+	if (write_cache && source_is_recent(key))
+	{
+		key.hashed = 1;
+		write_cache = hash_source(file, &key.hash);
+	}
+
+	if (!open_text(file, header_only))
+		return false;
+
+	// failing to write the cache is not an error
+	if (write_cache)
+		write_binary(cache_file, key);
+
+	return true;
+}
+
+bool weatherfile::open_text(const std::string &file, bool header_only)
+{
+	m_binary.close();
+
 	if (cmp_ext(file, "tm2") || cmp_ext(file, "tmy2"))
 		m_type = TMY2;
 	else if (cmp_ext(file, "tm3") || cmp_ext(file, "tmy3"))
@@ -1515,33 +1563,267 @@ bool weatherfile::open(const std::string &file, bool header_only)
 		}
 	}
 
+	for (size_t k = 0; k < _MAXCOL_; k++)
+		m_columns[k].values = m_columns[k].data.empty() ? 0 : &m_columns[k].data[0];
+
 	return true;
 }
 
-bool weatherfile::read( weather_record *r )
+#ifdef _WIN32
+#include <process.h>
+#define wf_getpid() _getpid()
+#else
+#include <unistd.h>
+#define wf_getpid() getpid()
+#endif
+
+static const char wfbin_magic[8] = { 'S', 'S', 'C', 'W', 'F', 'B', 'I', 'N' };
+static const unsigned int wfbin_version = 2;
+static const unsigned int wfbin_byte_order = 0x01020304;
+
+bool weatherfile::s_binaryCache = (getenv("SSC_WEATHER_CACHE") != 0);
+
+void weatherfile::enable_binary_cache(bool b)
+{
+	s_binaryCache = b;
+}
+
+bool weatherfile::get_source_key(const std::string &file, source_key *key)
 {
-	if ( r && m_index < m_nRecords)
+	size_t size;
+	if (!util::file_stat(file.c_str(), &size, &key->mtime))
+		return false;
+	key->size = size;
+	key->hashed = 0;
+	key->hash = 0;
+	return true;
+}
+
+bool weatherfile::source_is_recent(const source_key &key)
+{
+	// mtime has one second resolution (two on FAT), so a file changed within
+	// that window could change again without its size or mtime changing
+	return key.mtime >= (long long)time(0) - 2;
+}
+
+bool weatherfile::hash_source(const std::string &file, unsigned long long *hash)
+{
+	util::stdfile fp(file, "rb");
+	if (!fp.ok()) return false;
+
+	// 64 bit FNV-1a
+	unsigned long long h = 14695981039346656037ULL;
+	unsigned char buf[65536];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
 	{
-		r->year = (int)m_columns[YEAR].data[m_index];
-		r->month = (int)m_columns[MONTH].data[m_index];
-		r->day = (int)m_columns[DAY].data[m_index];
-		r->hour = (int)m_columns[HOUR].data[m_index];
-		r->minute = m_columns[MINUTE].data[m_index];
-		r->gh = m_columns[GHI].data[m_index];
-		r->dn = m_columns[DNI].data[m_index];
-		r->df = m_columns[DHI].data[m_index];
-		r->poa = m_columns[POA].data[m_index];
-		r->wspd = m_columns[WSPD].data[m_index];
-		r->wdir = m_columns[WDIR].data[m_index];
-		r->tdry = m_columns[TDRY].data[m_index];
-		r->twet = m_columns[TWET].data[m_index];
-		r->tdew = m_columns[TDEW].data[m_index];
-		r->rhum = m_columns[RH].data[m_index];
-		r->pres = m_columns[PRES].data[m_index];
-		r->snow = m_columns[SNOW].data[m_index];
-		r->alb = m_columns[ALB].data[m_index];
-		r->aod = m_columns[AOD].data[m_index];
+		for (size_t i = 0; i < n; i++)
+		{
+			h ^= buf[i];
+			h *= 1099511628211ULL;
+		}
+	}
+	*hash = h;
+	return true;
+}
+
+template< typename T >
+static bool wfbin_get(const unsigned char *&p, const unsigned char *end, T *v)
+{
+	if ((size_t)(end - p) < sizeof(T)) return false;
+	memcpy(v, p, sizeof(T));
+	p += sizeof(T);
+	return true;
+}
 
+static bool wfbin_get_string(const unsigned char *&p, const unsigned char *end, std::string *str)
+{
+	unsigned int len;
+	if (!wfbin_get(p, end, &len) || (size_t)(end - p) < len) return false;
+	str->assign((const char*)p, len);
+	p += len;
+	return true;
+}
+
+template< typename T >
+static void wfbin_put(FILE *fp, const T &v)
+{
+	fwrite(&v, sizeof(T), 1, fp);
+}
+
+static void wfbin_put_string(FILE *fp, const std::string &str)
+{
+	wfbin_put(fp, (unsigned int)str.length());
+	fwrite(str.c_str(), 1, str.length(), fp);
+}
+
+bool weatherfile::open_binary(const std::string &file, bool header_only, const std::string &source, bool *hashed)
+{
+	// a cache that fails any check is ignored and the text file is parsed instead
+	bool is_cache = !source.empty();
+	if (!m_binary.open(file))
+	{
+		if (!is_cache) m_message = "could not open file for reading: " + file;
+		return false;
+	}
+
+	const unsigned char *p = m_binary.data();
+	const unsigned char *end = p + m_binary.size();
+
+	char magic[8];
+	unsigned int version, byte_order, ncol;
+	unsigned long long nrec, start_sec, step_sec;
+	int type, start_year, leap_year, hasunits;
+	source_key src;
+	int index[_MAXCOL_];
+	weather_header hdr;
+	std::string message;
+
+	bool ok = wfbin_get(p, end, &magic)
+		&& memcmp(magic, wfbin_magic, sizeof(magic)) == 0
+		&& wfbin_get(p, end, &version) && version == wfbin_version
+		&& wfbin_get(p, end, &byte_order) && byte_order == wfbin_byte_order
+		&& wfbin_get(p, end, &ncol) && ncol == _MAXCOL_
+		&& wfbin_get(p, end, &nrec)
+		&& wfbin_get(p, end, &start_sec)
+		&& wfbin_get(p, end, &step_sec)
+		&& wfbin_get(p, end, &type)
+		&& wfbin_get(p, end, &start_year)
+		&& wfbin_get(p, end, &leap_year)
+		&& wfbin_get(p, end, &hasunits)
+		&& wfbin_get(p, end, &src.size)
+		&& wfbin_get(p, end, &src.mtime)
+		&& wfbin_get(p, end, &src.hashed)
+		&& wfbin_get(p, end, &src.hash)
+		&& wfbin_get(p, end, &index)
+		&& wfbin_get(p, end, &hdr.tz)
+		&& wfbin_get(p, end, &hdr.lat)
+		&& wfbin_get(p, end, &hdr.lon)
+		&& wfbin_get(p, end, &hdr.elev)
+		&& wfbin_get_string(p, end, &hdr.location)
+		&& wfbin_get_string(p, end, &hdr.city)
+		&& wfbin_get_string(p, end, &hdr.state)
+		&& wfbin_get_string(p, end, &hdr.country)
+		&& wfbin_get_string(p, end, &hdr.source)
+		&& wfbin_get_string(p, end, &hdr.description)
+		&& wfbin_get_string(p, end, &hdr.url)
+		&& wfbin_get_string(p, end, &message);
+
+	if (ok && is_cache)
+	{
+		source_key cur;
+		ok = get_source_key(source, &cur) && src.size == cur.size && src.mtime == cur.mtime;
+		if (ok && src.hashed)
+			ok = hash_source(source, &cur.hash) && src.hash == cur.hash;
+	}
+
+	// columns start at the next 8 byte boundary
+	size_t offset = (size_t)(p - m_binary.data());
+	offset = (offset + 7) & ~(size_t)7;
+	if (ok && (m_binary.size() < offset || (m_binary.size() - offset) / (sizeof(float) * _MAXCOL_) < nrec))
+		ok = false;
+
+	if (!ok)
+	{
+		m_binary.close();
+		if (!is_cache) m_message = "invalid binary weather file: " + file;
+		return false;
+	}
+
+	hdr.hasunits = (hasunits != 0);
+	m_hdr = hdr;
+	// warnings from the text parse the file was made from
+	m_message = message;
+	m_type = type;
+	m_startYear = start_year;
+	m_hasLeapYear = (leap_year != 0);
+	m_startSec = (size_t)start_sec;
+	m_stepSec = (size_t)step_sec;
+	m_nRecords = (size_t)nrec;
+
+	const float *data = (const float*)(m_binary.data() + offset);
+	for (size_t k = 0; k < _MAXCOL_; k++)
+	{
+		m_columns[k].index = index[k];
+		m_columns[k].data.clear();
+		m_columns[k].values = header_only ? 0 : data + k * m_nRecords;
+	}
+
+	if (header_only)
+		m_binary.close();
+
+	if (hashed) *hashed = (src.hashed != 0);
+	return true;
+}
+
+bool weatherfile::write_binary(const std::string &file, const source_key &key)
+{
+	if (m_nRecords == 0 || !m_columns[0].values) return false;
+
+	// write to a temporary file first so readers never map a partial file
+	std::string tmp_file = util::format("%s.%d.tmp", file.c_str(), (int)wf_getpid());
+	util::stdfile fp(tmp_file, "wb");
+	if (!fp.ok()) return false;
+
+	fwrite(wfbin_magic, 1, sizeof(wfbin_magic), fp);
+	wfbin_put(fp, wfbin_version);
+	wfbin_put(fp, wfbin_byte_order);
+	wfbin_put(fp, (unsigned int)_MAXCOL_);
+	wfbin_put(fp, (unsigned long long)m_nRecords);
+	wfbin_put(fp, (unsigned long long)m_startSec);
+	wfbin_put(fp, (unsigned long long)m_stepSec);
+	wfbin_put(fp, (int)m_type);
+	wfbin_put(fp, (int)m_startYear);
+	wfbin_put(fp, (int)(m_hasLeapYear ? 1 : 0));
+	wfbin_put(fp, (int)(m_hdr.hasunits ? 1 : 0));
+	wfbin_put(fp, key.size);
+	wfbin_put(fp, key.mtime);
+	wfbin_put(fp, key.hashed);
+	wfbin_put(fp, key.hash);
+	for (size_t k = 0; k < _MAXCOL_; k++)
+		wfbin_put(fp, (int)m_columns[k].index);
+	wfbin_put(fp, m_hdr.tz);
+	wfbin_put(fp, m_hdr.lat);
+	wfbin_put(fp, m_hdr.lon);
+	wfbin_put(fp, m_hdr.elev);
+	wfbin_put_string(fp, m_hdr.location);
+	wfbin_put_string(fp, m_hdr.city);
+	wfbin_put_string(fp, m_hdr.state);
+	wfbin_put_string(fp, m_hdr.country);
+	wfbin_put_string(fp, m_hdr.source);
+	wfbin_put_string(fp, m_hdr.description);
+	wfbin_put_string(fp, m_hdr.url);
+	wfbin_put_string(fp, m_message);
+
+	long pos = ftell(fp);
+	while (pos % 8 != 0)
+	{
+		fputc(0, fp);
+		pos++;
+	}
+
+	bool ok = true;
+	for (size_t k = 0; k < _MAXCOL_; k++)
+		if (fwrite(m_columns[k].values, sizeof(float), m_nRecords, fp) != m_nRecords)
+			ok = false;
+
+	if (fclose(fp.disown()) != 0) ok = false;
+
+	if (ok)
+	{
+		util::remove_file(file.c_str());
+		ok = (0 == rename(tmp_file.c_str(), file.c_str()));
+	}
+	if (!ok)
+		util::remove_file(tmp_file.c_str());
+
+	return ok;
+}
+
+bool weatherfile::read( weather_record *r )
+{
+	if ( read_at( m_index, r ) )
+	{
 		m_index++;
 		return true;
 	}
@@ -1549,6 +1831,35 @@ bool weatherfile::read( weather_record *r )
 		return false;
 }
 
+bool weatherfile::read_at( size_t index, weather_record *r )
+{
+	if ( r && index < m_nRecords)
+	{
+		r->year = (int)m_columns[YEAR].values[index];
+		r->month = (int)m_columns[MONTH].values[index];
+		r->day = (int)m_columns[DAY].values[index];
+		r->hour = (int)m_columns[HOUR].values[index];
+		r->minute = m_columns[MINUTE].values[index];
+		r->gh = m_columns[GHI].values[index];
+		r->dn = m_columns[DNI].values[index];
+		r->df = m_columns[DHI].values[index];
+		r->poa = m_columns[POA].values[index];
+		r->wspd = m_columns[WSPD].values[index];
+		r->wdir = m_columns[WDIR].values[index];
+		r->tdry = m_columns[TDRY].values[index];
+		r->twet = m_columns[TWET].values[index];
+		r->tdew = m_columns[TDEW].values[index];
+		r->rhum = m_columns[RH].values[index];
+		r->pres = m_columns[PRES].values[index];
+		r->snow = m_columns[SNOW].values[index];
+		r->alb = m_columns[ALB].values[index];
+		r->aod = m_columns[AOD].values[index];
+		return true;
+	}
+	else
+		return false;
+}
+
 bool weatherfile::has_data_column( size_t id )
 {
 	return m_columns[id].index >= 0;
@@ -1630,3 +1941,40 @@ bool weatherfile::convert_to_wfcsv( const std::string &input, const std::string
 
 }
 
+bool weatherfile::convert_to_wfbin( const std::string &input, const std::string &output )
+{
+	weatherfile wf( input );
+	if ( !wf.ok() ) return false;
+
+	source_key key;
+	if ( !get_source_key( input, &key ) ) return false;
+
+	return wf.write_binary( output, key );
+}
+
+shared_weather_reader::shared_weather_reader( const std::shared_ptr<weather_data_provider> &source )
+	: weather_data_provider( *source ), m_source( source )
+{
+	m_index = 0;
+}
+
+bool shared_weather_reader::read( weather_record *r )
+{
+	if ( r && m_source->read_at( m_index, r ) )
+	{
+		m_index++;
+		return true;
+	}
+	else
+		return false;
+}
+
+bool shared_weather_reader::read_at( size_t index, weather_record *r )
+{
+	return r && m_source->read_at( index, r );
+}
+
+bool shared_weather_reader::has_data_column( size_t id )
+{
+	return m_source->has_data_column( id );
+}
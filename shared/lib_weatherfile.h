@@ -52,8 +52,11 @@
 
 #include <string>
 #include <vector>  // needed to compile in typelib_vc2012
+#include <memory>
 #include <cmath>
 
+#include "lib_util.h"
+
 /***************************************************************************\
 
    Function humidity()
@@ -216,6 +219,10 @@ public:
 	/// reads one more record
 	virtual bool read( weather_record *r ) = 0; 
 
+	/// reads the record at a given index without moving the counter, providers that
+	/// support it can be shared read-only between several shared_weather_reader objects
+	virtual bool read_at( size_t index, weather_record *r ) { return false; }
+
 
 	// some helper methods for ease of use of this class
 	virtual weather_header &header()  {
@@ -236,8 +243,28 @@ private:
 	{
 		int index; // used for wfcsv to get column index in CSV file from which to read
 		std::vector<float> data;
+		const float *values; // points to data, or into the mapped binary file
 	};
 	column m_columns[_MAXCOL_];
+	util::mapped_file m_binary;
+
+	// identifies the text file a binary cache was made from. The content hash is
+	// only taken when the file changed too recently for its mtime to be trusted
+	struct source_key
+	{
+		unsigned long long size;
+		long long mtime;
+		int hashed;
+		unsigned long long hash;
+	};
+	static bool get_source_key( const std::string &file, source_key *key );
+	static bool hash_source( const std::string &file, unsigned long long *hash );
+	static bool source_is_recent( const source_key &key );
+	static bool s_binaryCache;
+
+	bool open_text( const std::string &file, bool header_only );
+	bool open_binary( const std::string &file, bool header_only, const std::string &source, bool *hashed = 0 );
+	bool write_binary( const std::string &file, const source_key &key );
 
 public:
 	weatherfile();
@@ -261,14 +288,35 @@ public:
 	bool open( const std::string &file, bool header_only = false );
 
 	bool read( weather_record *r ); 
+	bool read_at( size_t index, weather_record *r );
 	bool has_data_column( size_t id );
 	
 	static std::string normalize_city( const std::string &in );
 	static bool convert_to_wfcsv( const std::string &input, const std::string &output );
+
+	/* Binary columnar format: header followed by float32 columns, opened by memory mapping.
+	Files with the .wfbin extension are read directly; for text files a valid 'file.wfbin' sidecar
+	with matching source size, modification time and content hash is used instead of parsing. */
+	static bool convert_to_wfbin( const std::string &input, const std::string &output );
+	/* write the sidecar whenever a text file is parsed, also enabled by the SSC_WEATHER_CACHE environment variable */
+	static void enable_binary_cache( bool b );
 	
 };
+/* Reader with its own record counter over weather data loaded once by another provider.
+The source is kept alive by reference count and never copied or modified, so any number
+of compute modules can read the same data set. */
+class shared_weather_reader : public weather_data_provider
+{
+private:
+	std::shared_ptr<weather_data_provider> m_source;
 
+public:
+	shared_weather_reader( const std::shared_ptr<weather_data_provider> &source );
 
+	bool read( weather_record *r );
+	bool read_at( size_t index, weather_record *r );
+	bool has_data_column( size_t id );
+};
 
 #endif
 
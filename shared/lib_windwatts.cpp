@@ -311,6 +311,192 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 }
 
 
+void windPowerCalculator::wakeTableBins(double directionBinDeg, double speedBinMS, size_t &nDir, size_t &nSpeed)
+{
+	nDir = (size_t)(360.0 / directionBinDeg + 0.5);
+	if (nDir < 4) nDir = 4;
+	std::vector<double> curveWS = windTurb->getPowerCurveWS();
+	double maxWS = curveWS.size() > 0 ? curveWS.back() : 0.0;
+	nSpeed = (size_t)ceil(maxWS / speedBinMS) + 2;
+}
+
+size_t windPowerCalculator::WakeTableEvaluations(double directionBinDeg, double speedBinMS)
+{
+	if (directionBinDeg <= 0 || speedBinMS <= 0 || !windTurb)
+		return 0;
+	size_t nDir, nSpeed;
+	wakeTableBins(directionBinDeg, speedBinMS, nDir, nSpeed);
+	return nDir * (nSpeed - 1);
+}
+
+bool windPowerCalculator::InitializeWakeTable(double directionBinDeg, double speedBinMS)
+{
+	ClearWakeTable();
+	if (directionBinDeg <= 0 || directionBinDeg > 90 || speedBinMS <= 0 || speedBinMS > 5){
+		errDetails = "Wake table direction bin must be in (0,90] degrees and speed bin in (0,5] m/s.";
+		return false;
+	}
+	if (!wakeModel || !windTurb || nTurbines < 1 || nTurbines > MAX_WIND_TURBINES){
+		errDetails = "The wind power calculator must be initialized before building the wake table.";
+		return false;
+	}
+
+	// the turbine power and thrust curves depend on density only through ws * (rho/rho_sea_level)^(1/3),
+	// so the table is built at sea level density and looked up with the density-normalized speed
+	size_t nDir, nSpeed;
+	wakeTableBins(directionBinDeg, speedBinMS, nDir, nSpeed);
+	double dirBin = 360.0 / nDir;
+
+	std::vector<double> speedRatio(nDir * nSpeed * nTurbines, 1.0), ti(nDir * nSpeed * nTurbines, turbulenceIntensity);
+	std::vector<double> power(nTurbines), thrust(nTurbines), eff(nTurbines), wind(nTurbines), turbul(nTurbines), dd(nTurbines), dc(nTurbines);
+	std::vector<bool> valid(nSpeed, false);
+	double farmPower = 0.0;
+	for (size_t id = 0; id < nDir; id++)
+	{
+		for (size_t is = 1; is < nSpeed; is++)
+		{
+			double ws = is * speedBinMS;
+			if ((int)nTurbines != windPowerUsingResource(ws, id * dirBin, 1.0, 15.0, &farmPower,
+				&power[0], &thrust[0], &eff[0], &wind[0], &turbul[0], &dd[0], &dc[0]))
+				return false;
+
+			size_t k = (id * nSpeed + is) * nTurbines;
+			for (size_t i = 0; i < nTurbines; i++)
+			{
+				speedRatio[k + i] = wind[i] / ws;
+				ti[k + i] = turbul[i];
+			}
+			valid[is] = farmPower > 0.0;
+		}
+		// bins where the turbines do not run carry no wake information: copy the nearest bin that does
+		// so interpolation near cut-in and cut-out does not blend in unwaked ratios
+		int lastValid = -1;
+		for (size_t is = 0; is < nSpeed; is++)
+		{
+			if (valid[is]) { lastValid = (int)is; continue; }
+			int src = lastValid;
+			for (size_t js = is + 1; js < nSpeed && (src < 0 || js - is < is - (size_t)src); js++)
+				if (valid[js]) { src = (int)js; break; }
+			if (src < 0) continue;
+			size_t k = (id * nSpeed + is) * nTurbines, ks = (id * nSpeed + src) * nTurbines;
+			for (size_t i = 0; i < nTurbines; i++)
+			{
+				speedRatio[k + i] = speedRatio[ks + i];
+				ti[k + i] = ti[ks + i];
+			}
+		}
+	}
+
+	wakeTableDirBin = dirBin;
+	wakeTableSpeedBin = speedBinMS;
+	wakeTableDirBins = nDir;
+	wakeTableSpeedBins = nSpeed;
+	wakeTableSpeedRatio.swap(speedRatio);
+	wakeTableTI.swap(ti);
+	return true;
+}
+
+void windPowerCalculator::ClearWakeTable()
+{
+	wakeTableSpeedRatio.clear();
+	wakeTableTI.clear();
+	wakeTableDirBins = wakeTableSpeedBins = 0;
+}
+
+int windPowerCalculator::windPowerUsingWakeTable(/*INPUTS */ double windSpeed, double windDirDeg, double airPressureAtm, double TdryC,
+	/*OUTPUTS*/ double *farmPower, double power[], double thrust[], double eff[], double adWindSpeed[], double TI[],
+	double distanceDownwind[], double distanceCrosswind[])
+{
+	if (!UsingWakeTable())
+		return windPowerUsingResource(windSpeed, windDirDeg, airPressureAtm, TdryC, farmPower, power, thrust, eff, adWindSpeed, TI, distanceDownwind, distanceCrosswind);
+
+	if ((nTurbines > MAX_WIND_TURBINES) || (nTurbines < 1))
+	{
+		errDetails = "The number of wind turbines was greater than the maximum allowed in the wake model.";
+		return 0;
+	}
+
+	size_t i;
+	double fAirDensity = (airPressureAtm * physics::Pa_PER_Atm) / (physics::R_GAS_DRY_AIR * physics::CelciusToKelvin(TdryC));   //!Air Density, kg/m^3
+
+	double fTurbine_output(0.0), fThrust_coeff(0.0);
+	windTurb->turbinePower(windSpeed, fAirDensity, &fTurbine_output, &fThrust_coeff);
+	if (windTurb->errDetails.length() > 0){
+		errDetails = windTurb->errDetails;
+		return 0;
+	}
+
+	for (i = 0; i<nTurbines; i++)
+	{
+		power[i] = 0.0;
+		thrust[i] = 0.0;
+		eff[i] = 0.0;
+		adWindSpeed[i] = windSpeed;
+		TI[i] = turbulenceIntensity;
+	}
+
+	if (nTurbines < 2)
+	{
+		*farmPower = fTurbine_output;
+		return 1;
+	}
+
+	if (fTurbine_output <= 0.0)
+	{
+		*farmPower = 0.0;
+		return (int)nTurbines;
+	}
+
+	// downwind and crosswind distances in meters, as reported by windPowerUsingResource
+	double d(0.0), c(0.0), Dmin(0.0), Cmin(0.0);
+	for (i = 0; i<nTurbines; i++)
+	{
+		coordtrans(YCoords[i], XCoords[i], windDirDeg, &d, &c);
+		distanceDownwind[i] = d;
+		distanceCrosswind[i] = c;
+		Dmin = (i == 0) ? d : min_of(d, Dmin);
+		Cmin = (i == 0) ? c : min_of(c, Cmin);
+	}
+	for (i = 0; i<nTurbines; i++)
+	{
+		distanceDownwind[i] -= Dmin;
+		distanceCrosswind[i] -= Cmin;
+	}
+
+	// bilinear interpolation in direction (periodic) and normalized speed (clamped)
+	double fd = fmod(windDirDeg, 360.0);
+	if (fd < 0) fd += 360.0;
+	fd /= wakeTableDirBin;
+	size_t d0 = (size_t)fd;
+	double wd = fd - d0;
+	d0 %= wakeTableDirBins;
+	size_t d1 = (d0 + 1) % wakeTableDirBins;
+
+	double fs = windSpeed * pow(fAirDensity / physics::AIR_DENSITY_SEA_LEVEL, 1.0 / 3.0) / wakeTableSpeedBin;
+	if (fs > wakeTableSpeedBins - 1) fs = (double)(wakeTableSpeedBins - 1);
+	size_t s0 = (size_t)fs;
+	double ws = fs - s0;
+	size_t s1 = (s0 + 1 < wakeTableSpeedBins) ? s0 + 1 : s0;
+
+	const double w00 = (1 - wd)*(1 - ws), w01 = (1 - wd)*ws, w10 = wd*(1 - ws), w11 = wd*ws;
+	const size_t k00 = (d0 * wakeTableSpeedBins + s0) * nTurbines, k01 = (d0 * wakeTableSpeedBins + s1) * nTurbines,
+		k10 = (d1 * wakeTableSpeedBins + s0) * nTurbines, k11 = (d1 * wakeTableSpeedBins + s1) * nTurbines;
+
+	*farmPower = 0;
+	for (i = 0; i<nTurbines; i++)
+	{
+		double ratio = w00*wakeTableSpeedRatio[k00 + i] + w01*wakeTableSpeedRatio[k01 + i] + w10*wakeTableSpeedRatio[k10 + i] + w11*wakeTableSpeedRatio[k11 + i];
+		adWindSpeed[i] = windSpeed * ratio;
+		TI[i] = w00*wakeTableTI[k00 + i] + w01*wakeTableTI[k01 + i] + w10*wakeTableTI[k10 + i] + w11*wakeTableTI[k11 + i];
+		windTurb->turbinePower(adWindSpeed[i], fAirDensity, &power[i], &thrust[i]);
+		eff[i] = windTurb->calculateEff(power[i], fTurbine_output);
+		*farmPower += power[i];
+	}
+
+	return (int)nTurbines;
+}
+
+
 double windPowerCalculator::windPowerUsingWeibull(double weibull_k, double avg_speed, double ref_height, double energy_turbine[])
 {	// returns same units as 'power_curve'
 
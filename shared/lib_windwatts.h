@@ -72,6 +72,15 @@ private:
 	std::shared_ptr<wakeModelBase> wakeModel;
 	std::string errDetails;
 
+	// optional precomputed wake table: per-turbine wind speed ratio and turbulence intensity indexed by
+	// [(direction bin * nSpeedBins + speed bin) * nTurbines + turbine], speed is density-normalized hub speed
+	double wakeTableDirBin, wakeTableSpeedBin;
+	size_t wakeTableDirBins, wakeTableSpeedBins;
+	std::vector<double> wakeTableSpeedRatio, wakeTableTI;
+
+	/// Number of direction and speed bins in a wake table with the given bin sizes
+	void wakeTableBins(double directionBinDeg, double speedBinMS, size_t &nDir, size_t &nSpeed);
+
 	/// Transforms the east, north coordinate system to a downwind, crosswind orientation orthogonal to current wind direction
 	void coordtrans(double metersNorth, double metersEast, double fWind_dir_degrees, double *fMetersDownWind, double *metersCrosswind);
 	double gammaln(double x);
@@ -86,6 +95,8 @@ public:
 		nTurbines = 0;
 		turbulenceIntensity = 0.0;
 		errDetails="";
+		wakeTableDirBin = wakeTableSpeedBin = 0.0;
+		wakeTableDirBins = wakeTableSpeedBins = 0;
 	}
 	
 	static const int MAX_WIND_TURBINES = 300;	// Max turbines in the farm
@@ -122,6 +133,18 @@ public:
 			double distCross[] // distance cross wind
 		);
 
+	/// Tabulates the wake model over wind direction and density-normalized hub speed bins using windPowerUsingResource.
+	/// Turbulence intensity is fixed for a run, so the table holds a single ambient intensity slice.
+	bool InitializeWakeTable(double directionBinDeg, double speedBinMS);
+	/// Number of wake model evaluations InitializeWakeTable makes with the given bin sizes
+	size_t WakeTableEvaluations(double directionBinDeg, double speedBinMS);
+	bool UsingWakeTable() { return !wakeTableSpeedRatio.empty(); }
+	void ClearWakeTable();
+
+	/// Same inputs and outputs as windPowerUsingResource, with the wake deficits interpolated from the wake table
+	int windPowerUsingWakeTable(double windSpeed, double windDirDeg, double BarPAtm, double TdryC,
+		double *farmPwer, double power[], double thrust[], double eff[], double wind[], double turbul[], double distDown[], double distCross[]);
+
 	double windPowerUsingWeibull(
 		double weibull_k, 
 		double avg_speed, 
@@ -592,6 +592,21 @@ bool AutoPilot::Setup(var_map &V, bool /*for_optimize*/)
 	True	-	no errors setting up the field
 	False	-	errors setting up the field
 	*/
+	return SetupField(V, 0);
+}
+
+bool AutoPilot::Setup(var_map &V, sp_layout_table &positions, bool /*for_optimize*/)
+{
+	/* 
+	Set up the SolarField object with the heliostat positions provided in 'positions' rather than 
+	in the text form of V.sf.layout_data. Aim points are calculated; cant vectors and focal lengths 
+	are used only where 'user_optics' is set.
+	*/
+	return SetupField(V, &positions);
+}
+
+bool AutoPilot::SetupField(var_map &V, sp_layout_table *positions)
+{
 	_cancel_simulation = false;	
 
 	//-----------------------------------------------------------------
@@ -633,11 +648,32 @@ bool AutoPilot::Setup(var_map &V, bool /*for_optimize*/)
 	//	V.flux.y_res.val = 15;
 	//}
 	
+	//positions provided directly take the place of the layout_data string
+	layout_shell layout;
+	if( positions != 0 )
+	{
+		layout.resize( positions->positions.size() );
+		for(size_t i=0; i<positions->positions.size(); i++)
+		{
+			sp_layout_table::h_position &hp = positions->positions.at(i);
+			layout_obj &lo = layout.at(i);
+
+			lo.helio_type = hp.template_number;
+			lo.location.Set( hp.location.x, hp.location.y, hp.location.z );
+			lo.aim.Set( hp.aimpoint.x, hp.aimpoint.y, hp.aimpoint.z );
+			lo.cant.Set( hp.cant_vector.i, hp.cant_vector.j, hp.cant_vector.k );
+			lo.focal_x = lo.focal_y = hp.focal_length;
+			lo.is_user_cant = lo.is_user_focus = hp.user_optics;
+			lo.is_user_aim = false;
+			lo.is_enabled = lo.is_in_layout = true;
+		}
+	}
+
 	//Create the solar field object
-	_SF->Create(V);
+	_SF->Create(V, positions != 0 ? &layout : 0);
 
 	//if a layout is provided in the sp_layout structure, go ahead and create the geometry here.
-    if( ! V.sf.layout_data.val.empty() )
+    if( ! V.sf.layout_data.val.empty() || positions != 0 )
     {
 		_SF->PrepareFieldLayout(*_SF, 0, true);	//Run the layout method in refresh_only mode
         Vect sun = Ambient::calcSunVectorFromAzZen( _SF->getVarMap()->sf.sun_az_des.Val()*D2R, (90. - _SF->getVarMap()->sf.sun_el_des.Val())*D2R );   
@@ -711,6 +747,15 @@ void AutoPilot::GenerateDesignPointSimulations(var_map &V, vector<string> &wdata
 
 }
 
+void AutoPilot::GenerateDesignPointSimulations(var_map &V, WeatherData &wdata)
+{
+	/* 
+	Overload that takes the hourly weather data in columns, avoiding the text form above. Columns used are 
+	Day (1..), Hour (0..), Month (1-12), DNI (W/m2), T_db (C), Pres (bar), and V_wind (m/s).
+	*/
+	interop::GenerateSimulationWeatherData(V, -1, wdata);
+}
+
 void AutoPilot::PreSimCallbackUpdate()
 {
 	//pass the callback along to the solar field, if applicable
@@ -2362,7 +2407,7 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
 
 					if(_has_detail_callback){
 						if(! _detail_siminfo->setCurrentSimulation(nsim_done) )
-                            break;
+                            CancelSimulation();
                     }
 					
 				
@@ -2378,7 +2423,7 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
 				}
 			    //check to see whether simulation errored out
                 bool errored_out = false;
-                for(int i=0; i<_n_threads; i++){
+                for(int i=0; i<nthreads; i++){
                     errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
                 }
                 if( errored_out )
@@ -2386,7 +2431,7 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
                     CancelSimulation();
                     //Get the error messages, if any
                     string errmsgs;
-                    for(int i=0; i<_n_threads; i++){
+                    for(int i=0; i<nthreads; i++){
                         for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
                             errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
                     }
@@ -2397,12 +2442,13 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
                 }
 
 	            //Clean up dynamic memory
-	            for(int i=0; i<_n_threads; i++){
+	            for(int i=0; i<nthreads; i++){
 		            delete SFarr[i];
 	            }
 	            delete [] SFarr;
 	            delete [] _simthread;
 	            _simthread = 0;
+				_in_mt_simulation = false;
 
 	            //If the simulation was cancelled per the check above, exit out
 	            if(cancelled || errored_out){
@@ -2434,7 +2480,8 @@ bool AutoPilot_MT::CreateLayout(sp_layout &layout, bool do_post_process)
             Vect sun = Ambient::calcSunVectorFromAzZen( _SF->getVarMap()->sf.sun_az_des.Val()*D2R, (90. - _SF->getVarMap()->sf.sun_el_des.Val())*D2R );   
 
 			if(! _cancel_simulation)
-				_SF->calcHeliostatShadows(sun);	if(_SF->ErrCheck()){return false;}
+				_SF->calcHeliostatShadows(sun);
+			if(_SF->ErrCheck()){return false;}
 			if(! _cancel_simulation)
 				PostProcessLayout(layout);
 		}
@@ -2455,8 +2502,9 @@ bool AutoPilot_MT::SetMaxThreadCount(int nt)
 	//check to make sure the max number of threads is less
 	//than the machine's capacity
 	try{
-		unsigned int nmax = std::thread::hardware_concurrency();
-		_n_threads = min(max(nt,1), (int)nmax);
+		int nmax = (int)std::thread::hardware_concurrency();
+		if(nmax < 1) nmax = 1;	//concurrency could not be determined
+		_n_threads = min(max(nt,1), nmax);
 	}
 	catch(...)
 	{
@@ -2524,10 +2572,13 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 
 	//------------do the multithreaded run----------------
 	
+	//no more threads than simulations
+	int nthreads = min(_n_threads, max(_sim_total, 1));
+
 	//Create copies of the solar field
 	SolarField **SFarr;
-	SFarr = new SolarField*[_n_threads];
-	for(int i=0; i<_n_threads; i++){
+	SFarr = new SolarField*[nthreads];
+	for(int i=0; i<nthreads; i++){
 		SFarr[i] = new SolarField(*_SF);
 	}
 
@@ -2536,30 +2587,30 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 	results.resize(_sim_total);
 						
 	//Calculate the number of simulations per thread
-	int npert = (int)ceil((float)_sim_total/(float)_n_threads);
+	int npert = (int)ceil((float)_sim_total/(float)nthreads);
 
 	//Create thread objects
-	_simthread = new LayoutSimThread[_n_threads];
-	_n_threads_active = _n_threads;	//Keep track of how many threads are active
+	_simthread = new LayoutSimThread[nthreads];
+	_n_threads_active = nthreads;	//Keep track of how many threads are active
 				
 	int
 		sim_first = 0,
 		sim_last = npert;
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
         std::string istr = my_to_string(i);
 		_simthread[i].Setup(istr, SFarr[i], &results, &sunpos, P, sim_first, sim_last, true, false);
 		sim_first = sim_last;
 		sim_last = min(sim_last+npert, _sim_total);
 	}
 	//Run
-	for(int i=0; i<_n_threads; i++)
+	for(int i=0; i<nthreads; i++)
 		thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ).detach();
 			
 
 	//Wait loop
 	while(true){
 		int nsim_done = 0, nsim_remain=0, nthread_done=0;
-		for(int i=0; i<_n_threads; i++){
+		for(int i=0; i<nthreads; i++){
 			if( _simthread[i].IsFinished() )
 				nthread_done ++;
 					
@@ -2574,19 +2625,19 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 			if( ! _summary_siminfo->setCurrentSimulation(nsim_done) )
 				CancelSimulation();
 		}
-		if(nthread_done == _n_threads) break;
+		if(nthread_done == nthreads) break;
 		std::this_thread::sleep_for(std::chrono::milliseconds(75));
 	}
 
 	//Check to see whether the simulation was cancelled
 	bool cancelled = false;
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
 		cancelled = cancelled || _simthread[i].IsSimulationCancelled();
 	}
     
     //check to see whether simulation errored out
     bool errored_out = false;
-    for(int i=0; i<_n_threads; i++){
+    for(int i=0; i<nthreads; i++){
         errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
     }
     if( errored_out )
@@ -2594,7 +2645,7 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
         CancelSimulation();
         //Get the error messages, if any
         string errmsgs;
-        for(int i=0; i<_n_threads; i++){
+        for(int i=0; i<nthreads; i++){
             for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
                 errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
         }
@@ -2605,12 +2656,13 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
     }
 
 	//Clean up dynamic memory
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
 		delete SFarr[i];
 	}
 	delete [] SFarr;
 	delete [] _simthread;
 	_simthread = 0;
+	_in_mt_simulation = false;
 
 	//If the simulation was cancelled per the check above, exit out
 	if(cancelled || errored_out){
@@ -2694,10 +2746,13 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
 
 	//------------do the multithreaded run----------------
 	
+	//no more threads than simulations
+	int nthreads = min(_n_threads, max(_sim_total, 1));
+
 	//Create copies of the solar field
 	SolarField **SFarr;
-	SFarr = new SolarField*[_n_threads];
-	for(int i=0; i<_n_threads; i++){
+	SFarr = new SolarField*[nthreads];
+	for(int i=0; i<nthreads; i++){
 		SFarr[i] = new SolarField(*_SF);
 	}
 
@@ -2706,16 +2761,16 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
 	results.resize(_sim_total);
 
 	//Calculate the number of simulations per thread
-	int npert = (int)ceil((float)_sim_total/(float)_n_threads);
+	int npert = (int)ceil((float)_sim_total/(float)nthreads);
 
 	//Create thread objects
-	_simthread = new LayoutSimThread[_n_threads];
-	_n_threads_active = _n_threads;	//Keep track of how many threads are active
+	_simthread = new LayoutSimThread[nthreads];
+	_n_threads_active = nthreads;	//Keep track of how many threads are active
 	
 	int
 		sim_first = 0,
 		sim_last = npert;
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
         std::string istr = my_to_string(i);
         _simthread[i].Setup(istr, SFarr[i], &results, &sunpos, P, sim_first, sim_last, true, true);
 		_simthread[i].IsFluxmapNormalized(is_normalized);
@@ -2723,14 +2778,14 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
 		sim_last = min(sim_last+npert, _sim_total);
 	}
 	//Run
-	for(int i=0; i<_n_threads; i++)
+	for(int i=0; i<nthreads; i++)
 		thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ).detach();
 			
 
 	//Wait loop
 	while(true){
 		int nsim_done = 0, nsim_remain=0, nthread_done=0;
-		for(int i=0; i<_n_threads; i++){
+		for(int i=0; i<nthreads; i++){
 			if( _simthread[i].IsFinished() )
 				nthread_done ++;
 					
@@ -2745,18 +2800,18 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
 			if( ! _summary_siminfo->setCurrentSimulation(nsim_done) ) 
 				CancelSimulation();
 		}
-		if(nthread_done == _n_threads) break;
+		if(nthread_done == nthreads) break;
 		std::this_thread::sleep_for(std::chrono::milliseconds(75));
 	}
 
 	//Check to see whether the simulation was cancelled
 	bool cancelled = false;
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
 		cancelled = cancelled || _simthread[i].IsSimulationCancelled();
 	}
 	//check to see whether simulation errored out
     bool errored_out = false;
-    for(int i=0; i<_n_threads; i++){
+    for(int i=0; i<nthreads; i++){
         errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
     }
     if( errored_out )
@@ -2764,7 +2819,7 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
         CancelSimulation();
         //Get the error messages, if any
         string errmsgs;
-        for(int i=0; i<_n_threads; i++){
+        for(int i=0; i<nthreads; i++){
             for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
                 errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
         }
@@ -2775,12 +2830,13 @@ bool AutoPilot_MT::CalculateFluxMaps(sp_flux_table &fluxtab, int flux_res_x, int
     }
 
 	//Clean up dynamic memory
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
 		delete SFarr[i];
 	}
 	delete [] SFarr;
 	delete [] _simthread;
 	_simthread = 0;
+	_in_mt_simulation = false;
 
 	//If the simulation was cancelled per the check above, exit out
 	if(cancelled || errored_out){
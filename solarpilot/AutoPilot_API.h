@@ -99,6 +99,7 @@ protected:
 	std::vector<double> interpolate_vectors( std::vector<double> &A, std::vector<double> &B, double alpha);
 
 
+	bool SetupField(var_map &V, sp_layout_table *positions);
 	void PrepareFluxSimulation(sp_flux_table &fluxtab, int flux_res_x, int flux_res_y, bool is_normalized);
 	void PostProcessLayout(sp_layout &layout);
 	void PostProcessFlux(sim_result &result, sp_flux_map &fluxmap, int flux_layer = 0);
@@ -122,8 +123,10 @@ public:
 	void PreSimCallbackUpdate();
 	void SetExternalSFObject(SolarField *SF);
 	bool Setup(var_map &V, bool for_optimize = false);
+	bool Setup(var_map &V, sp_layout_table &positions, bool for_optimize = false);	//heliostat positions provided directly
 	//generate weather data
 	void GenerateDesignPointSimulations(var_map &V, std::vector<std::string> &hourly_weather_data);
+	void GenerateDesignPointSimulations(var_map &V, WeatherData &hourly_weather_data);
 	//Simulation methods
 	bool EvaluateDesign(double &obj_metric, double &flux_max, double &tot_cost);
 	void PostEvaluationUpdate(int iter, std::vector<double> &pos, double &obj, double &flux, double &cost, std::string *note=0);
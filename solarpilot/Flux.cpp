@@ -2220,6 +2220,23 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 
 	//Get the flux surface offset
 	sp_point *offset = flux_surface.getSurfaceOffset();
+
+	//Collect the flux point locations and normals in contiguous arrays
+	int npt = nfx*nfy;
+	_fkd.resize(npt, _n_terms);
+	for(int j=0; j<nfx; j++){
+		for(int k=0; k<nfy; k++){
+			FluxPoint *pt = &grid->at(j).at(k);
+			int p = j*nfy + k;
+			_fkd.px[p] = pt->location.x + offset->x;
+			_fkd.py[p] = pt->location.y + offset->y;
+			_fkd.pz[p] = pt->location.z;		//the receiver height is added for each heliostat
+			_fkd.nx[p] = pt->normal.i;
+			_fkd.ny[p] = pt->normal.j;
+			_fkd.nz[p] = pt->normal.k;
+			_fkd.flux[p] = pt->flux;
+		}
+	}
 	
 	int nh = (int)helios.size();
 	if(show_progress){
@@ -2235,12 +2252,6 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
         if(! helios.at(i)->IsEnabled() )
             continue;
 
-		//Get the image error std dev's
-		double sigx, sigy;	
-		helios.at(i)->getImageSize(sigx, sigy);	//Image size is normalized by the tower height
-		
-		//Get the heliostat aim point
-		sp_point *aim = helios.at(i)->getAimPoint();
 		//Get the height of the receiver that the heliostat is aiming at
 		double tht = helios.at(i)->getWhichReceiver()->getVarMap()->optical_height.Val();
 
@@ -2248,62 +2259,18 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 		//reciever divided by the tower height squared. (the tht^2 term falls out of the normalizing procedure
 		//that we previously used in defining the Hermite moments). See DELSOL 7634.
 		double cnorm = helios.at(i)->getArea() * helios.at(i)->getEfficiencyTotal()/(tht*tht);
-		//Loop through each flux point
-		//Rows
-		for(int j=0; j<nfx; j++){
-			//Cols
-			for(int k=0; k<nfy; k++){
-				//Get the flux point
-				FluxPoint *pt = &grid->at(j).at(k);
-				//Calculate the dot product between the flux point normal and the helio->tower vector
-				Vect *tv = helios.at(i)->getTowerVector();
-				Vect tvr;
-				tvr.Set( -tv->i, -tv->j, -tv->k );	//Reverse
-
-				double f_dot_t = Toolbox::dotprod(pt->normal, tvr);	
-				//If the dot product is negative, the point is not in view of the heliostat, so continue.
-				if(f_dot_t < 0.) continue;
-				if(f_dot_t>1.){
-					continue;
-				}
-				//Translate the flux point location into global coordinates
-				sp_point pt_g;
-				pt_g.Set(pt->location.x + offset->x, pt->location.y + offset->y, pt->location.z + tht); //tht include z offset
-
-				//Project the current flux point into the image plane as defined by the 
-				//aim point and the heliostat-to-receiver vector.
-				sp_point pt_ip;
-				Toolbox::plane_intersect(*aim, tvr, pt_g, tvr, pt_ip); 
-				
-				//Now the point pt_ip indicates in global coordinates the projection of the flux point onto the image plane.
-				
-				//Translate the flux point into coordinates relative to the aim point
-				pt_ip.Subtract( *aim );
-				
-				//Express this point in image plane coordinates
-                double azpt = atan2(tvr.i, tvr.j);
-                double zenpt = acos(tvr.k);
-
-				Toolbox::rotation(pi-azpt, 2, pt_ip);
-				Toolbox::rotation(zenpt, 0, pt_ip);
-
-				//This rotation now expresses pt_ip in x,y coordinates of the image plane.
+		
+		//Add the flux from this heliostat to each flux point
+		fluxDensityKernel(helios.at(i), cnorm, tht, npt);
+	}
 
-				//Normalize the x,y coordinates with respect to the image error size
-				double
-					xn = -pt_ip.x/tht / sigx,       //with delsol formulation, image is flipped in x direction. Not sure why.
-					yn = pt_ip.y/tht / sigy;
-				
-				//Calculate the flux
-                double hfe = hermiteFluxEval(helios.at(i), xn, yn) * exp( -0.5 *( xn*xn + yn*yn) );
-                //if( hfe != hfe )
-                //{
-                //    double xxxxx = 0.;
-                //}
-				pt->flux += f_dot_t * hfe * cnorm;
-			}
+	//Copy the accumulated flux back to the grid
+	for(int j=0; j<nfx; j++){
+		for(int k=0; k<nfy; k++){
+			grid->at(j).at(k).flux = _fkd.flux[j*nfy + k];
 		}
 	}
+
 	if(show_progress){
 		siminfo->Reset();
 		siminfo->setCurrentSimulation(0);
@@ -2327,6 +2294,154 @@ void Flux::fluxDensity(simulation_info *siminfo, FluxSurface &flux_surface, Hvec
 
 }
 
+void Flux::flux_kernel_data::resize(int npt, int nterms)
+{
+	std::vector<double> *pt_arrays[] = {&px, &py, &pz, &nx, &ny, &nz, &flux, &xn, &yn, &scale, &herm};
+	for(int i=0; i<11; i++)
+		pt_arrays[i]->resize(npt);
+	hx.resize( nterms*npt );
+	hy.resize( nterms*npt );
+}
+
+void Flux::fluxDensityKernel(Heliostat *H, double cnorm, double tht, int npt)
+{
+	/* 
+	Add the flux from heliostat H to each of the 'npt' flux points stored in _fkd. 
+
+	This evaluates the same quantities as hermiteFluxEval() for each point. The projection of each flux 
+	point onto the image plane and the rotation into image plane coordinates are linear in the point 
+	location, so they are combined into a single pair of coefficient vectors for the heliostat. Each
+	loop below runs over the flux points with no branches or calls other than exp() so that the 
+	compiler can vectorize it.
+	*/
+
+	//Get the image error std dev's
+	double sigx, sigy;	
+	H->getImageSize(sigx, sigy);	//Image size is normalized by the tower height
+		
+	//Get the heliostat aim point
+	sp_point *aim = H->getAimPoint();
+
+	//Reverse of the helio->tower vector. This is the normal of the image plane.
+	Vect *tv = H->getTowerVector();
+	double 
+		ti = -tv->i,
+		tj = -tv->j,
+		tk = -tv->k;
+	double tt = ti*ti + tj*tj + tk*tk;
+
+	//Rotation into image plane coordinates
+    double azpt = atan2(ti, tj);
+    double zenpt = acos(tk);
+	double
+		c1 = cos(pi-azpt),
+		s1 = sin(pi-azpt),
+		c2 = cos(zenpt),
+		s2 = sin(zenpt);
+	
+	//image plane x and y axes, with the component along the plane normal removed (projection onto the plane)
+	double 
+		ux = c1, uy = s1, uz = 0.,
+		vx = -c2*s1, vy = c2*c1, vz = s2;
+	double udt = (ux*ti + uy*tj + uz*tk)/tt;
+	double vdt = (vx*ti + vy*tj + vz*tk)/tt;
+	
+	//normalized coordinates are xn = -(u.q)/tht/sigx and yn = (v.q)/tht/sigy for the point q relative to the aim point.
+	//With delsol formulation, image is flipped in x direction.
+	double fx = -1./(tht*sigx);
+	double fy = 1./(tht*sigy);
+	double 
+		ax = (ux - udt*ti)*fx, ay = (uy - udt*tj)*fx, az = (uz - udt*tk)*fx,
+		bx = (vx - vdt*ti)*fy, by = (vy - vdt*tj)*fy, bz = (vz - vdt*tk)*fy;
+	double 
+		qx = -aim->x,
+		qy = -aim->y,
+		qz = tht - aim->z;
+	double 
+		a0 = ax*qx + ay*qy + az*qz,
+		b0 = bx*qx + by*qy + bz*qz;
+
+	double *px = &_fkd.px[0], *py = &_fkd.py[0], *pz = &_fkd.pz[0];
+	double *nx = &_fkd.nx[0], *ny = &_fkd.ny[0], *nz = &_fkd.nz[0];
+	double *xn = &_fkd.xn[0], *yn = &_fkd.yn[0], *scale = &_fkd.scale[0], *herm = &_fkd.herm[0];
+	double *hx = &_fkd.hx[0], *hy = &_fkd.hy[0];
+
+	for(int p=0; p<npt; p++){
+		xn[p] = a0 + ax*px[p] + ay*py[p] + az*pz[p];
+		yn[p] = b0 + bx*px[p] + by*py[p] + bz*pz[p];
+		
+		//Points facing away from the heliostat (or with invalid normals) receive no flux
+		double f_dot_t = nx[p]*ti + ny[p]*tj + nz[p]*tk;
+		double fvis = (f_dot_t >= 0. && f_dot_t <= 1.) ? f_dot_t : 0.;
+		scale[p] = fvis * cnorm * exp( -0.5 *( xn[p]*xn[p] + yn[p]*yn[p]) );
+
+		hx[npt + p] = xn[p];	//H_1
+		hy[npt + p] = yn[p];
+		herm[p] = 0.;
+	}
+	
+	//Hermite polynomials for orders 2.._n_terms-1. Row n of hx and hy holds H_n. Row 0 is not used 
+	//since H_0 = 1.
+	for(int n=2; n<_n_terms; n++){
+		double *h0 = &hx[(n-2)*npt];
+		double *h1 = &hx[(n-1)*npt];
+		double *h2 = &hx[n*npt];
+		double *g0 = &hy[(n-2)*npt];
+		double *g1 = &hy[(n-1)*npt];
+		double *g2 = &hy[n*npt];
+		double fn = (double)(n-1);
+		if(n == 2){
+			for(int p=0; p<npt; p++){
+				h2[p] = xn[p]*h1[p] - fn;
+				g2[p] = yn[p]*g1[p] - fn;
+			}
+		}
+		else{
+			for(int p=0; p<npt; p++){
+				h2[p] = xn[p]*h1[p] - fn*h0[p];
+				g2[p] = yn[p]*g1[p] - fn*g0[p];
+			}
+		}
+	}
+
+	//Sum the series using the packed coefficients from the heliostat
+	matrix_t<double> *hc = H->getHermiteCoefObject();
+	int ipak = 0;
+	for(int i=1; i<_n_terms+1; i++){
+		int
+			jmin = JMN(i-1),
+			jmax = JMX(i-1);
+		for(int j=jmin; j<jmax+1; j+=2){
+			double c = hc->at(ipak++);
+			//order i-1 in x and j-1 in y
+			if(i == 1 && j == 1){
+				for(int p=0; p<npt; p++)
+					herm[p] += c;
+			}
+			else if(i == 1){
+				double *g = &hy[(j-1)*npt];
+				for(int p=0; p<npt; p++)
+					herm[p] += c*g[p];
+			}
+			else if(j == 1){
+				double *h = &hx[(i-1)*npt];
+				for(int p=0; p<npt; p++)
+					herm[p] += c*h[p];
+			}
+			else{
+				double *h = &hx[(i-1)*npt];
+				double *g = &hy[(j-1)*npt];
+				for(int p=0; p<npt; p++)
+					herm[p] += c*h[p]*g[p];
+			}
+		}
+	}
+
+	double *flux = &_fkd.flux[0];
+	for(int p=0; p<npt; p++)
+		flux[p] += scale[p] * (herm[p] < 0. ? 0. : herm[p]);
+}
+
 double Flux::hermiteFluxEval(Heliostat *H, double xs, double ys){
 	/* 
 	Evaluate the flux density at point (x,y) in the image plane for the give heliostat H
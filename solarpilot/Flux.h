@@ -112,6 +112,26 @@ class Flux
 	double _ag[16];
 	double _xg[16];
 
+	struct flux_kernel_data
+	{
+		/* 
+		Flux point data in contiguous arrays for the fluxDensity kernel. Each array holds one value 
+		per flux point; hx and hy hold one row of points per Hermite order. Retained between calls 
+		so that flux map tables don't allocate for each sun position.
+		*/
+		std::vector<double>
+			px, py, pz,		//flux point location, including the surface offset
+			nx, ny, nz,		//flux point normal
+			flux,			//accumulated flux
+			xn, yn,			//normalized image plane coordinates for the current heliostat
+			scale,			//cosine, gaussian, and normalizing factor for the current heliostat
+			herm,			//Hermite series sum for the current heliostat
+			hx, hy;			//Hermite polynomials, _n_terms x npt
+		void resize(int npt, int nterms);
+	} _fkd;
+
+	void fluxDensityKernel(Heliostat *H, double cnorm, double tht, int npt);
+
  public:
 
 
@@ -79,6 +79,100 @@ sim_params::sim_params()
     is_layout = false;
 }
 
+//Heliostat neighbor index
+helio_neighbor_index::helio_neighbor_index()
+{
+	clear();
+}
+
+void helio_neighbor_index::clear()
+{
+	_x0 = _y0 = 0.;
+	_dx = _dy = 1.;
+	_nx = _ny = 0;
+	_zmin = _zmax = _hmax = 0.;
+	_objects = 0;
+	_nobjects = 0;
+	_cell_start.clear();
+	_items.clear();
+}
+
+bool helio_neighbor_index::isCurrent(vector<Heliostat> &helios)
+{
+	//The index is current as long as the heliostat objects haven't been reallocated or resized since it was built
+	return _nx > 0 && _nobjects == (int)helios.size() && _objects == (helios.empty() ? 0 : &helios.front());
+}
+
+void helio_neighbor_index::build(vector<Heliostat> &helios, double cell_size)
+{
+	/* 
+	Sort the heliostats into cells of width 'cell_size' using a counting sort. The cell size is increased
+	for sparse fields so that the grid never has many more cells than heliostats.
+	*/
+	int nh = (int)helios.size();
+	_objects = nh > 0 ? &helios.front() : 0;
+	_nobjects = nh;
+
+	double xmin=0., xmax=0., ymin=0., ymax=0.;
+	_zmin = _zmax = _hmax = 0.;
+	for(int i=0; i<nh; i++){
+		sp_point *loc = helios.at(i).getLocation();
+		if(i == 0 || loc->x < xmin) xmin = loc->x;
+		if(i == 0 || loc->x > xmax) xmax = loc->x;
+		if(i == 0 || loc->y < ymin) ymin = loc->y;
+		if(i == 0 || loc->y > ymax) ymax = loc->y;
+		if(i == 0 || loc->z < _zmin) _zmin = loc->z;
+		if(i == 0 || loc->z > _zmax) _zmax = loc->z;
+		_hmax = fmax(_hmax, helios.at(i).getVarMap()->height.val);
+	}
+
+	if(! (cell_size > 0.) ) cell_size = 1.;
+	while( (floor((xmax - xmin)/cell_size) + 1.)*(floor((ymax - ymin)/cell_size) + 1.) > 4.*nh + 16. )
+		cell_size *= 2.;
+
+	_x0 = xmin;
+	_y0 = ymin;
+	_dx = _dy = cell_size;
+	_nx = (int)floor((xmax - xmin)/cell_size) + 1;
+	_ny = (int)floor((ymax - ymin)/cell_size) + 1;
+	
+	//count the heliostats in each cell, then convert the counts to offsets
+	vector<int> cell(nh);
+	_cell_start.assign(_nx*_ny + 1, 0);
+	for(int i=0; i<nh; i++){
+		sp_point *loc = helios.at(i).getLocation();
+		int row = min((int)((loc->y - _y0)/_dy), _ny-1);
+		int col = min((int)((loc->x - _x0)/_dx), _nx-1);
+		helios.at(i).setGroupId(row, col);
+		cell.at(i) = row*_nx + col;
+		_cell_start.at(cell.at(i)+1)++;
+	}
+	for(int k=0; k<_nx*_ny; k++)
+		_cell_start.at(k+1) += _cell_start.at(k);
+
+	//fill the cells, keeping the original heliostat order within each cell
+	vector<int> next(_cell_start.begin(), _cell_start.end()-1);
+	_items.resize(nh);
+	for(int i=0; i<nh; i++)
+		_items.at( next.at(cell.at(i))++ ) = &helios.at(i);
+}
+
+double helio_neighbor_index::zmin(){return _zmin;}
+double helio_neighbor_index::zmax(){return _zmax;}
+double helio_neighbor_index::hmax(){return _hmax;}
+
+void helio_neighbor_index::cellRange(double x, double y, double r, int &row0, int &row1, int &col0, int &col1)
+{
+	//Range of cells that overlap the square of half-width 'r' centered at (x,y)
+	col0 = (int)fmax(0., fmin(floor((x - r - _x0)/_dx), _nx-1.));
+	col1 = (int)fmax(0., fmin(floor((x + r - _x0)/_dx), _nx-1.));
+	row0 = (int)fmax(0., fmin(floor((y - r - _y0)/_dy), _ny-1.));
+	row1 = (int)fmax(0., fmin(floor((y + r - _y0)/_dy), _ny-1.));
+}
+
+Heliostat **helio_neighbor_index::cellBegin(int row, int col){return _items.data() + _cell_start.at(row*_nx + col);}
+Heliostat **helio_neighbor_index::cellEnd(int row, int col){return _items.data() + _cell_start.at(row*_nx + col + 1);}
+
 //-------Access functions
 //"GETS"
 SolarField::clouds *SolarField::getCloudObject(){return &_clouds;}
@@ -90,6 +184,12 @@ Financial *SolarField::getFinancialObject(){return &_financial;}
 FluxSimData *SolarField::getFluxSimObject(){return &_fluxsim;}
 htemp_map *SolarField::getHeliostatTemplates(){return &_helio_templates;}
 Hvector *SolarField::getHeliostats(){return &_heliostats;}
+helio_neighbor_index *SolarField::getNeighborIndex()
+{
+	if(! _neighbor_index.isCurrent(_helio_objects) )
+		UpdateNeighborIndex();
+	return &_neighbor_index;
+}
 layout_shell *SolarField::getLayoutShellObject(){return &_layout;}
 unordered_map<int,Heliostat*> *SolarField::getHeliostatsByID(){return &_helio_by_id;}
 vector<Heliostat> *SolarField::getHeliostatObjects(){return &_helio_objects;}
@@ -205,21 +305,6 @@ SolarField::SolarField( const SolarField &sf )
 		_helio_by_id[ id ] = hp_map[ const_cast<Heliostat*>( const_cast<SolarField*>(&sf)->_helio_by_id[id] ) ];
 	}
 
-	//Heliostat groups
-	int nr, nc;
-	nr = (int)sf._helio_groups.nrows();
-	nc = (int)sf._helio_groups.ncols();
-	_helio_groups.resize_fill(nr, nc, Hvector()); //NULL));
-	for(int i=0; i<nr; i++){
-		for(int j=0; j<nc; j++){
-			int nh = (int)sf._helio_groups.at(i,j).size();
-			_helio_groups.at(i,j).resize(nh);
-			for(int k=0; k<nh; k++){
-				_helio_groups.at(i,j).at(k) = hp_map[ sf._helio_groups.at(i,j).at(k) ];
-			}
-		}
-	}
-
 	//Layout groups
 	_layout_groups.resize(sf._layout_groups.size());
 	for(int j=0; j<(int)sf._layout_groups.size(); j++){
@@ -231,24 +316,8 @@ SolarField::SolarField( const SolarField &sf )
 	}
 	
 
-	//Neighbors
-	nr = (int)sf._neighbors.nrows();
-	nc = (int)sf._neighbors.ncols();
-	_neighbors.resize_fill(nr, nc, Hvector()); //0, NULL));
-	for(int i=0; i<nr; i++){
-		for(int j=0; j<nc; j++){
-			int nh = (int)sf._neighbors.at(i,j).size();
-			_neighbors.at(i,j).resize(nh);
-			for(int k=0; k<nh; k++){
-				_neighbors.at(i,j).at(k) = hp_map[ sf._neighbors.at(i,j).at(k)];
-			}
-		}
-	}
-	for(int i=0; i<npos; i++){
-		//Each heliostat needs to have the neighbor group assigned to it
-		Heliostat *hptr = _heliostats.at(i);
-		hptr->setNeighborList( &_neighbors.at( hptr->getGroupId()[0], hptr->getGroupId()[1] ) );
-	}
+	//The neighbor index refers to the original heliostat objects. Leave it empty so that it's rebuilt on first use.
+	_neighbor_index.clear();
 
 	//Create receivers
 	unordered_map<Receiver*, Receiver*> r_map;	//map old receiver -> new receiver
@@ -282,7 +351,7 @@ SolarField::SolarField( const SolarField &sf )
 
 
 //Scripts
-void SolarField::Create(var_map &V){
+void SolarField::Create(var_map &V, const layout_shell *layout){
 	/*
 	Create a solar field instance, set the variable values according to the map provided by the GUI.
 	This simply instantiates all the needed objects for the solar field but does not do any analysis.
@@ -324,12 +393,15 @@ void SolarField::Create(var_map &V){
 	//Land
 	_land.Create(V);
 
-	//Parse the layout string into a layout object
-	if(! V.sf.layout_data.val.empty() )
+	//Parse the layout string into a layout object, unless the layout was provided directly
+	if( layout != 0 || ! V.sf.layout_data.val.empty() )
     {
         //V.sf.layout_method.combo_select_by_mapval( var_solarfield::LAYOUT_METHOD::USERDEFINED );
 		//Convert the string contents to a layout_shell object
-		SolarField::parseHeliostatXYZFile( V.sf.layout_data.val, _layout );
+        if( layout != 0 )
+            _layout = *layout;
+        else
+		    SolarField::parseHeliostatXYZFile( V.sf.layout_data.val, _layout );
         vector<sp_point> lpt;
         for(int i=0; i<(int)_layout.size(); i++)
             lpt.push_back( _layout.at(i).location );
@@ -458,9 +530,8 @@ void SolarField::Clean(){
 	_helio_templates.clear();
     _helio_template_objects.clear();
 	_heliostats.clear();
-	_helio_groups.clear();
 	_helio_by_id.clear();
-	_neighbors.clear();
+	_neighbor_index.clear();
 	_receivers.clear();
 	
 	_is_created = false;
@@ -517,102 +588,24 @@ double SolarField::calcAverageAttenuation()
     }
 }
 
-bool SolarField::UpdateNeighborList(double lims[4], double zen){
+bool SolarField::UpdateNeighborIndex(){
 	/* 
-	Update the neighbors associated with each heliostat based on the shadow extent. Determine this range
-	based on the current sun position
-
-	lims:
-	0 : xmin
-	1 : xmax
-	2 : ymin
-	3 : ymax
+	Build the spatial index of heliostat positions that is used to find the neighbors that can shadow or 
+	block each heliostat. The index depends only on the heliostat positions, so it is built once per layout 
+	and shared by all of the sun positions that are simulated. The interaction range for each sun position 
+	is determined when the index is queried (see SimulateHeliostatEfficiency).
 	*/
-	
-	double 
-		xmax = lims[0],
-		xmin = lims[1],
-		ymax = lims[2],
-		ymin = lims[3];
+	if(CheckCancelStatus()) return false;	//check for cancelled simulation
 
-	//add a little buffer to the min/max extents
-	if(xmax>0.) {xmax *= 1.01;} else {xmax *= 0.99;}
-	if(xmin<0.) {xmin *= 1.01;} else {xmin *= 0.99;}
-	if(ymax>0.) {ymax *= 1.01;} else {ymax *= 0.99;}
-	if(ymin<0.) {ymin *= 1.01;} else {ymin *= 0.99;}
-	
-	//How many nodes should be in the mesh? Determine the shadow length at some low sun position (say 15deg)
-	//and use this to size the nodes. Shadowing will be evaluated among heliostats in the current node
-	//and surrounding 8 nodes.
+	//Size the cells at about two heliostat spacings. The query range then covers only a modest number of cells 
+	//for high sun positions, while low sun positions simply span more of them.
 	double rcol = 0.;
-	double hm = 0.;
-	for(htemp_map::iterator it = _helio_templates.begin(); it != _helio_templates.end(); it++){
-        var_heliostat* Hv = it->second->getVarMap();
-		rcol += it->second->getCollisionRadius();
-		hm += Hv->height.val/2.;
-	}
-	rcol *= 1./(double)_helio_templates.size();
-	hm *= 1./(double)_helio_templates.size();
-
-	// This is the shadowing radius at 15deg. Use this as the x and y dimension of the mesh.
-	// Multiply the cell width by 0.5 since several adjacent cells will participate in the shadowing. We don't
-	// need each cell to be the full shadowing radius wide.
-	double r_shad_max = fmax(2.*rcol/tan(PI/2.-zen), 3.*rcol);
-	double r_block_max = 10.*hm;	//by similar triangles and assuming the maximum heliostat-to-tower distance is 10 tower heights, calculate max. blocking interaction radius
-	double r_interact = max(r_shad_max, r_block_max);
-	r_interact = fmin(r_interact, 2.*hm*100);	//limit to a reasonable value
-	int ncol, nrow;
-	double dcol, drow;
-	ncol = max(1, int((xmax - xmin)/r_interact));		//The number of column nodes
-	nrow = max(1, int((ymax - ymin)/r_interact));		//The number of row nodes
-	dcol = (xmax - xmin)/float(ncol);
-	drow = (ymax - ymin)/float(nrow);			//The column and row node width
-
-	//resize the mesh array accordingly
-	_helio_groups.resize_fill(nrow, ncol, Hvector());
-
-	int col, row;	//indicates which node the heliostat is in
-	int Npos = (int)_helio_objects.size();
-	for(int i=0; i<Npos; i++){
-		Heliostat *hptr = &_helio_objects.at(i);
-		//Find which node to add this heliostat to
-		row = (int)(floor((hptr->getLocation()->y - ymin)/drow));
-		row = (int)fmax(0., fmin(row, nrow-1));
-		col = (int)(floor((hptr->getLocation()->x - xmin)/dcol));
-		col = (int)fmax(0., fmin(col, ncol-1));
-		//Add the heliostat ID to the mesh node
-		_helio_groups.at(row,col).push_back(hptr); 
-		//Add the mesh node ID to the heliostat information
-		hptr->setGroupId(row,col);
-	}
-
-	//Go over each node and compile a list of neighbors from the block of 9 adjacent cells.
-	if(CheckCancelStatus()) return false;	//check for cancelled simulation
-	int nh;
-	_neighbors.resize_fill(nrow, ncol, Hvector());
-	for(int i=0; i<nrow; i++){		//Loop over each row
-		for(int j=0; j<ncol; j++){	//Loop over each column
-			for(int k=i-1;k<i+2;k++){	//At each node position, get the surrounding nodes in the +/-y direction
-				if(k<0 || k>nrow-1) continue;	//If the search goes out of bounds in the y direction, loop to the next position
-				for(int l=j-1;l<j+2;l++){	//At each node position, get the surrounding nodes in the +/-x direction
-					if(l<0 || l>ncol-1) continue;	//If the search goes out of bounds in the x direction, loop to the next position
-					nh = (int)_helio_groups.at(k,l).size();	//How many heliostats are in this cell?
-					for(int m=0; m<nh; m++){	//Add each heliostat element in the mesh to the list of neighbors for the current cell at (i,j)
-						_neighbors.at(i,j).push_back( _helio_groups.at(k,l).at(m) );
-					}
-				}
-			}
-		}
-	}
-	if(CheckCancelStatus()) return false;	//check for cancelled simulation
+	for(htemp_map::iterator it = _helio_templates.begin(); it != _helio_templates.end(); it++)
+		rcol = fmax(rcol, it->second->getCollisionRadius());
+	
+	_neighbor_index.build(_helio_objects, 4.*rcol);
 
-	//For each heliostat, assign the list of neighbors that are stored in the _neighbors grid
-	for(int i=0;i<Npos;i++){
-		Heliostat *hptr = &_helio_objects.at(i);
-		hptr->setNeighborList( &_neighbors.at( hptr->getGroupId()[0], hptr->getGroupId()[1] ) );	//Set the neighbor list according to the stored _neighbors indices
-	}
 	return true;
-
 }
 
 bool SolarField::UpdateLayoutGroups(double lims[4]){
@@ -1251,9 +1244,9 @@ bool SolarField::PrepareFieldLayout(SolarField &SF, WeatherData *wdata, bool ref
         return false;
     }
 	
-	//Update the neighbor list based on zenith. Also initialize the layout groups.
+	//Index the heliostat positions for the neighbor search. Also initialize the layout groups.
 	double *helio_extents = SF.getHeliostatExtents();
-	bool isok = SF.UpdateNeighborList(helio_extents, 0. );	//_ambient.getSolarZenith());   don't include shadowing effects in layout (zenith = 0.)
+	bool isok = SF.UpdateNeighborIndex();
 	if(SF.CheckCancelStatus() || !isok) return false;	//check for cancelled simulation
 	if(V->sf.is_opt_zoning.val ){
         if(! SF.getSimInfoObject()->addSimulationNotice("Calculating layout optical groups") ){
@@ -3058,9 +3051,6 @@ void SolarField::Simulate(double azimuth, double zenith, sim_params &P)
     P.is_layout = psave;
     calcAllAimPoints(Sun, P); //.is_layout, P.is_layout);  // , simple? , quiet?
     
-    //Update the heliostat neighbors to include possible shadowers
-	UpdateNeighborList(_helio_extents, P.is_layout ? 0. : zenith);		//don't include shadowing effects in layout (zenith = 0.)
-	
     //For each heliostat, assess the losses
 	//for layout calculations, we can speed things up by only calculating the intercept factor for representative heliostats. (similar to DELSOL).
 	int nh = (int)_heliostats.size();
@@ -3097,6 +3087,42 @@ void SolarField::Simulate(double azimuth, double zenith, sim_params &P)
 	
 
 
+}
+
+static double interactionReach(Vect &dir, double dz_min, double dz_max, double hmax, double r_limit)
+{
+	/* 
+	Horizontal distance beyond which no neighbor can interfere along direction 'dir'. This is the largest 
+	'l_max' limit from calcShadowBlock given the range of neighbor elevation differences [dz_min, dz_max] 
+	(including the heliostat tilt) and the tallest heliostat.
+	*/
+	double tanpi2zen = dir.k/sqrt(dir.i*dir.i + dir.j*dir.j);
+	double l_max = r_limit;
+	if(tanpi2zen > 0.)
+		l_max = dz_max/tanpi2zen + hmax;
+	else if(tanpi2zen < 0.)		//direction below the horizon
+		l_max = dz_min/tanpi2zen + hmax;
+	return fmax(0., fmin(l_max, r_limit));
+}
+
+double SolarField::calcInteractionReach(Heliostat *H, Vect &Sun, bool is_layout)
+{
+	/* 
+	Find the range around heliostat H within which a neighbor can possibly interfere. This bounds the 
+	'l_max' distance in calcShadowBlock for every neighbor, so no interfering neighbor is farther away. 
+	Shadowing isn't evaluated for layout simulations, so only blocking sets the range in that case.
+	*/
+	helio_neighbor_index *index = getNeighborIndex();
+	sp_point *loc = H->getLocation();
+	double 
+		hmax = index->hmax(),
+		dz_min = index->zmin() - loc->z,
+		dz_max = index->zmax() - loc->z + hmax,
+		r_limit = _var_map->sf.interaction_limit.val*hmax;
+	double reach = interactionReach(*H->getTowerVector(), dz_min, dz_max, hmax, r_limit);
+	if(!is_layout)
+		reach = fmax(reach, interactionReach(Sun, dz_min, dz_max, hmax, r_limit));
+	return reach;
 }
 
 void SolarField::SimulateHeliostatEfficiency(SolarField *SF, Vect &Sun, Heliostat *helios, sim_params &P)
@@ -3147,14 +3173,24 @@ void SolarField::SimulateHeliostatEfficiency(SolarField *SF, Vect &Sun, Heliosta
 		block_tot = 1.;
 		
     double interaction_limit = V->sf.interaction_limit.val;
-	Hvector *neibs = helios->getNeighborList();
-	int nn = (int)neibs->size();
-	for(int j=0; j<nn; j++){
-		if(helios == neibs->at(j) ) continue;	//Don't calculate blocking or shading for the same heliostat
+	
+	//Only the neighbors within reach of the heliostat can interfere
+	helio_neighbor_index *index = SF->getNeighborIndex();
+	sp_point *loc = helios->getLocation();
+	double reach = SF->calcInteractionReach(helios, Sun, P.is_layout);
+
+	int row0, row1, col0, col1;
+	index->cellRange(loc->x, loc->y, reach, row0, row1, col0, col1);
+	for(int r=row0; r<=row1; r++){
+		//the cells in a row are stored contiguously
+		Heliostat **neib_end = index->cellEnd(r, col1);
+		for(Heliostat **neib = index->cellBegin(r, col0); neib != neib_end; neib++){
+			if(helios == *neib ) continue;	//Don't calculate blocking or shading for the same heliostat
 		
-        if(!P.is_layout) shad_tot += -SF->calcShadowBlock(helios, neibs->at(j), 0, Sun, interaction_limit);	//Don't calculate shadowing for layout simulations. Cascaded shadowing effects can skew the layout.
+			if(!P.is_layout) shad_tot += -SF->calcShadowBlock(helios, *neib, 0, Sun, interaction_limit);	//Don't calculate shadowing for layout simulations. Cascaded shadowing effects can skew the layout.
 		
-        block_tot += -SF->calcShadowBlock(helios, neibs->at(j), 1, Sun, interaction_limit);
+			block_tot += -SF->calcShadowBlock(helios, *neib, 1, Sun, interaction_limit);
+		}
 	}
 		
 	if(shad_tot < 0.) shad_tot = 0.;
@@ -3314,19 +3350,18 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 
 
 		//-----------test
-		vector<sp_point> 
-			*cobj = HI->getCornerCoords(),
-			ints(2);	//intersection points
-		vector<bool> hits(2, false);	//track whether either point hit
+		vector<sp_point> *cobj = HI->getCornerCoords();
+		sp_point ints[2];	//intersection points
+		bool hits[2] = {false, false};	//track whether either point hit
 		int i;
 		for(i=0; i<2; i++){
-			if( Toolbox::plane_intersect(*Hloc, *Ht, cobj->at(i), *H_inter, ints.at(i)) ){
+			if( Toolbox::plane_intersect(*Hloc, *Ht, cobj->at(i), *H_inter, ints[i]) ){
 				//An intercept on the plane was detected. Is the intercept within the heliostat area?
-				hits.at(i) = Toolbox::pointInPolygon(*H->getCornerCoords(), ints.at(i) );
+				hits[i] = Toolbox::pointInPolygon(*H->getCornerCoords(), ints[i] );
 			}
 		}
 		//Do either of the corners shadow/block the heliostat?
-		if(hits.at(0) || hits.at(1)){
+		if(hits[0] || hits[1]){
 			//interfering detected. 
 			double dx_inter, dy_inter;
 			
@@ -3334,30 +3369,30 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 			To calculate the fraction of energy lost, we first transform the intersection point into heliostat coordinates
 			so that it's easier to find how the shadow is cast on the heliostat.
 			*/
-			vector<sp_point> ints_trans(2);	//Copy of the intersection points for heliostat coordinate transform
+			sp_point ints_trans[2];	//Copy of the intersection points for heliostat coordinate transform
 			for(i=0; i<2; i++){
 				//Express each point of HI in global coords relative to the centroid of H
 				//i.e. (ints_trans.x - H->x, ... )
-				ints_trans.at(i).Set(ints.at(i).x - Hloc->x, ints.at(i).y - Hloc->y, ints.at(i).z - Hloc->z);
+				ints_trans[i].Set(ints[i].x - Hloc->x, ints[i].y - Hloc->y, ints[i].z - Hloc->z);
 
 				//First rotate azimuthally back to the north position
-				Toolbox::rotation(-H->getAzimuthTrack(), 2, ints_trans.at(i));
+				Toolbox::rotation(-H->getAzimuthTrack(), 2, ints_trans[i]);
 				//Next rotate in zenith to get it into heliostat coords. The z component should be very small or zero. 
 				//Y components should be relatively close for rectangular heliostats
-				Toolbox::rotation(-H->getZenithTrack(), 0, ints_trans.at(i));
+				Toolbox::rotation(-H->getZenithTrack(), 0, ints_trans[i]);
 			}
 			
 			//Based on how the image appears, determine interfering. 
 			//Recall that after transformation, the positive y edge corresponds to the bottom of the heliostat.
 			int which_is_off, which_is_on;
-			if(hits.at(0) && hits.at(1)) {
+			if(hits[0] && hits[1]) {
 				//Both corners are active in interfering (i.e. the shadow image is contained within the shadowed heliostat
-				dy_inter = ( Hh - (ints_trans.at(0).y + ints_trans.at(1).y) ) / (2. * Hh);	//Use the average z position of both points
-				dx_inter = fabs(ints_trans.at(0).x - ints_trans.at(1).x ) / Hw;
+				dy_inter = ( Hh - (ints_trans[0].y + ints_trans[1].y) ) / (2. * Hh);	//Use the average z position of both points
+				dx_inter = fabs(ints_trans[0].x - ints_trans[1].x ) / Hw;
 
 				return dy_inter * dx_inter;
 			}
-			else if(hits.at(0)) { 
+			else if(hits[0]) { 
 				//Only the first corner appears in the shadow/blocking image
 				which_is_off = 1;
 				which_is_on = 0;
@@ -3368,12 +3403,12 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 				which_is_on = 1;
 			}
 			
-			dy_inter = (Hh/2. - ints_trans.at(which_is_on).y) / Hh;	//The z-interfering component	
-			if( ints_trans.at(which_is_off).x > Hw/2. ){ // The shadow image spills off the +x side of the heliostat
-				dx_inter = .5 - ints_trans.at(which_is_on).x / Hw;
+			dy_inter = (Hh/2. - ints_trans[which_is_on].y) / Hh;	//The z-interfering component	
+			if( ints_trans[which_is_off].x > Hw/2. ){ // The shadow image spills off the +x side of the heliostat
+				dx_inter = .5 - ints_trans[which_is_on].x / Hw;
 			}
 			else {	//The shadow image spills off the -x side of the heliostat
-				dx_inter = ints_trans.at(which_is_on).x / Hw + .5;
+				dx_inter = ints_trans[which_is_on].x / Hw + .5;
 			}
 
 			return dy_inter * dx_inter;
@@ -118,6 +118,35 @@ struct sim_params
 };
 
 typedef std::vector<layout_obj> layout_shell;
+
+class helio_neighbor_index
+{
+	/*
+	A uniform 2D grid over the heliostat positions, stored in compressed row form. Cells are numbered 
+	row-major and the heliostats in each cell are stored contiguously in _items, so the heliostats in 
+	columns c0..c1 of a single row form one contiguous span. The grid depends only on the heliostat 
+	positions and is built once per layout; shading and blocking queries for each sun position just 
+	select the span of cells within reach of the heliostat of interest.
+	*/
+	double _x0, _y0, _dx, _dy;
+	int _nx, _ny;
+	double _zmin, _zmax, _hmax;	//range of heliostat elevations and tallest heliostat in the index
+	const Heliostat *_objects;	//address of the indexed heliostat array, used to detect a rebuilt layout
+	int _nobjects;
+	std::vector<int> _cell_start;	//offset into _items of the first heliostat in each cell, size nx*ny+1
+	Hvector _items;
+public:
+	helio_neighbor_index();
+	void clear();
+	bool isCurrent(std::vector<Heliostat> &helios);
+	void build(std::vector<Heliostat> &helios, double cell_size);
+	double zmin();
+	double zmax();
+	double hmax();
+	void cellRange(double x, double y, double r, int &row0, int &row1, int &col0, int &col1);
+	Heliostat **cellBegin(int row, int col);	//first heliostat in cell (row,col)
+	Heliostat **cellEnd(int row, int col);		//one past the last heliostat in cell (row,col)
+};
 typedef std::map<int, Heliostat*> htemp_map;
 
 /*The SolarField class will serve as the object that binds together all of the aspects of the solar field
@@ -148,9 +177,7 @@ protected:
 	std::vector<Heliostat> _helio_template_objects;	//Actual heliostat objects
 	unordered_map<int,Heliostat*> _helio_by_id;	//map of heliostats by ID#
 	Hvector _heliostats; //A std::vector containing all of the heliostats in the field that are used in calculation
-	matrix_t<Hvector> 
-		_helio_groups,	//A 2-D mesh containing vectors that list the heliostats in each field group.
-		_neighbors;	//A 2-D mesh where each node lists the heliostats that neighbor each other
+	helio_neighbor_index _neighbor_index;	//Spatial index of heliostat positions used to find possible shadowers/blockers
 	std::vector<Hvector> _layout_groups; //a std::vector of heliostat vectors that share flux intercept factor during layout calculations
 	std::vector<Receiver*> _receivers; //A std::vector containing all of the receiver objects
 	std::vector<Receiver*> _active_receivers;	//A std::vector containing only active receivers
@@ -199,6 +226,7 @@ public:
 	layout_shell *getLayoutShellObject();
 	unordered_map<int,Heliostat*> *getHeliostatsByID();
 	std::vector<Heliostat> *getHeliostatObjects();
+	helio_neighbor_index *getNeighborIndex();	//rebuilt first if the layout has changed
 	clouds *getCloudObject();
     var_map *getVarMap();
 	
@@ -229,7 +257,7 @@ public:
 	void setHeliostatExtents(double xmax, double xmin, double ymax, double ymin);
 	
 	//Scripts
-	void Create(var_map &V);
+	void Create(var_map &V, const layout_shell *layout = 0);	//optional layout takes the place of the layout_data string
     void updateCalculatedParameters(var_map &V);
     void updateAllCalculatedParameters(var_map &V);
 	void Clean();
@@ -245,7 +273,7 @@ public:
 	void UpdateLayoutAfterChange();  //update land, layout object, and solar field calculations after the layout has changed
 	static void AnnualEfficiencySimulation( SolarField &SF, sim_results &results); //, double *azs, double *zens, double *met);
 	static void AnnualEfficiencySimulation( std::string weather_file, SolarField *SF, sim_results &results); //, double *azs, double *zens, double *met);	//overload
-	bool UpdateNeighborList(double lims[4], double zen);
+	bool UpdateNeighborIndex();
 	bool UpdateLayoutGroups(double lims[4]);
 
 	void radialStaggerPositions(std::vector<sp_point> &HelPos); //Vector of the possible heliostat locations
@@ -259,6 +287,7 @@ public:
 	
     static void SimulateHeliostatEfficiency(SolarField *SF, Vect &Sun, Heliostat *helio, sim_params &P);
 	double calcShadowBlock(Heliostat *H, Heliostat *HS, int mode, Vect &Sun, double interaction_limit = 100.);	//Calculate the shadowing or blocking between two heliostats
+	double calcInteractionReach(Heliostat *H, Vect &Sun, bool is_layout);	//Horizontal distance from H beyond which no heliostat shadows or blocks it
 	void updateAllTrackVectors(Vect &Sun);	//Macro for calculating corner positions
 	void calcHeliostatShadows(Vect &Sun);	//Macro for calculating heliostat shadows
 	void calcAllAimPoints(Vect &Sun, sim_params &P); //bool force_simple=false, bool quiet=true); 
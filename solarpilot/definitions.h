@@ -65,13 +65,15 @@
 //Include Coretrace (relevant to fieldcore only! Disabling this option will cause SolarPILOT compilation to fail.).
 #ifdef SP_STANDALONE
 	#define SP_USE_SOLTRACE
-	//Compile without threading functionality? Comment out to remove.
-	#define SP_USE_THREADS
 	//crete local make-dir functions
 	#ifdef _WIN32 
 	    #define SP_USE_MKDIR
 	#endif
 #endif
+//Compile with threading functionality. Define SP_NO_THREADS to remove.
+#ifndef SP_NO_THREADS
+	#define SP_USE_THREADS
+#endif
 
 #ifndef PI
     #define PI 3.14159265358979311600
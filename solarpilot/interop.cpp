@@ -104,16 +104,42 @@ par_variable::par_variable()
 //-------------------
 
 
+static void parseSimulationWeatherEntry(const std::string &entry, WeatherData &wf)
+{
+	//day, hour, month, dni, tdry, pres, wspd
+	vector<string> tsdat = split(entry, ",");
+	double v[7];
+	for(int i=0; i<7; i++)
+		to_double(tsdat.at(i), &v[i]);
+	wf.append(v[0], v[1], v[2], v[3], v[4], v[5], v[6], 1.);
+}
+
 void interop::GenerateSimulationWeatherData(var_map &V, int design_method, ArrayString &wf_entries){
 	/* 
-	Calculate and fill the weather data steps needed for simulation and the associated time step.
-
-	The weather data is filled in the variable set vset["solarfield"][0]["sim_step_data"].value
+	OVERLOAD to support the ArrayString type. 
 
 	wf_entries consists of a list strings corresponding to each time step. 
 	Each string is comma-separated and has the following entries:
 	day, hour, month, dn, tdry, pres/1000., wspd
 	*/
+
+	//parse each entry once and call the main method
+	WeatherData wfdat;
+	for(int i=0; i<wf_entries.size(); i++)
+		parseSimulationWeatherEntry(wf_entries.at(i), wfdat);
+
+	interop::GenerateSimulationWeatherData(V, design_method, wfdat);
+}
+
+void interop::GenerateSimulationWeatherData(var_map &V, int design_method, WeatherData &wf_entries){
+	/* 
+	Calculate and fill the weather data steps needed for simulation and the associated time step.
+
+	The weather data is filled in the variable set vset["solarfield"][0]["sim_step_data"].value
+
+	wf_entries contains the hourly weather data in columns:
+	Day, Hour, Month, DNI [W/m2], T_db [C], Pres [bar], V_wind [m/s]. Step_weight is not used.
+	*/
 	
 	WeatherData *wdatvar = &V.sf.sim_step_data.Val(); 
 
@@ -248,7 +274,6 @@ void interop::GenerateSimulationWeatherData(var_map &V, int design_method, Array
 		quicksort(simdays, 0, nday-1);
 
 		//Calculate the month and day for each item
-		vector<string> tsdat;
 		for(int i=0; i<nday; i++){
 			int month, dom;
 			double hoy;
@@ -302,12 +327,10 @@ void interop::GenerateSimulationWeatherData(var_map &V, int design_method, Array
 				while(jd<hr_end+.001){	//include hr_end
 					//index associated with time jd
 					int jind = (int)floor(jd);	//the (j-1) originally may have been an error
-					tsdat = split(wf_entries.at(jind), ",");
-
-					to_double(tsdat.at(3), &dni);
-					to_double(tsdat.at(4), &tdry);
-					to_double(tsdat.at(5), &pres);
-					to_double(tsdat.at(6), &wind);
+					dni = wf_entries.DNI.at(jind);
+					tdry = wf_entries.T_db.at(jind);
+					pres = wf_entries.Pres.at(jind);
+					wind = wf_entries.V_wind.at(jind);
 
 					/*all_time.push_back(jd);
 					all_dni.push_back(dni);
@@ -342,12 +365,11 @@ void interop::GenerateSimulationWeatherData(var_map &V, int design_method, Array
 					//calculate the adjusted DNI based on the time surrounding the simulation position
 					double dnimod, dnicomp;
 					if(iind > 0)
-					    tsdat = split(wf_entries.at(min(8759,jind+1)), ",");
+					    dnicomp = wf_entries.DNI.at(min(8759,jind+1));
 						//dnicomp = i < ndatpt - 1 ? all_dni.at(i+1) : 0.;
 					else
-					    tsdat = split(wf_entries.at(max(0,jind-1)), ",");
+					    dnicomp = wf_entries.DNI.at(max(0,jind-1));
 						//dnicomp = i > 0 ? all_dni.at(i-1) : 0.;
-					to_double(tsdat.at(3), &dnicomp);
 
 					//dnimod = all_dni.at(i)*fthis + dnicomp * fcomp;
 					dnimod = dni*fthis + dnicomp * fcomp;
@@ -408,15 +430,13 @@ void interop::GenerateSimulationWeatherData(var_map &V, int design_method, Array
 						if(ind < 0) ind += 8760;
 						if(ind > 8759) ind += -8760;
 
-						tsdat = split(wf_entries.at(ind), ",");
-						to_double(tsdat.at(3), &dni);
-						to_double(tsdat.at(4), &tdry);
-						to_double(tsdat.at(5), &pres);
-						to_double(tsdat.at(6), &wind);
+						dni = wf_entries.DNI.at(ind);
+						tdry = wf_entries.T_db.at(ind);
+						pres = wf_entries.Pres.at(ind);
+						wind = wf_entries.V_wind.at(ind);
 
 						//get the complement dni data
-						tsdat = split(wf_entries.at( min( max(ind+iind, 0), nwf-1) ), ",");
-						to_double(tsdat.at(3), &dnicomp);
+						dnicomp = wf_entries.DNI.at( min( max(ind+iind, 0), nwf-1) );
 
 
 						//
@@ -504,10 +524,10 @@ void interop::GenerateSimulationWeatherData(var_map &vset, int design_method, ve
 	1..,  0..,  1-12, W/m2,    C,  bar,  m/s
 	*/
 
-	//create an array string and call the main method
-	ArrayString wfdat;
+	//parse each entry once and call the main method
+	WeatherData wfdat;
 	for(int i=0; i<(int)wf_entries.size(); i++)
-		wfdat.Add( wf_entries.at(i) );
+		parseSimulationWeatherEntry(wf_entries.at(i), wfdat);
 
 	interop::GenerateSimulationWeatherData(vset, design_method, wfdat);
 
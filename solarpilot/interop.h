@@ -182,6 +182,7 @@ namespace interop
 	//-- Methods for calculating simulation input values
 	void GenerateSimulationWeatherData(var_map &V, int design_method, ArrayString &wf_entries);
 	void GenerateSimulationWeatherData(var_map &V, int design_method, std::vector<std::string> &wf_entries);	//overload
+	void GenerateSimulationWeatherData(var_map &V, int design_method, WeatherData &wf_entries);	//overload, hourly data in columns
 	bool parseRange(std::string &range, int &rangelow, int &rangehi, bool &include_low, bool &include_hi);
 	void ticker_initialize(int indices[], int n);
 	bool ticker_increment(int lengths[], int indices[], bool changed[], int n);
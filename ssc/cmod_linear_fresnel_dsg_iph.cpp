@@ -224,7 +224,7 @@ public:
 	{
 		// Weather reader
 		C_csp_weatherreader weather_reader;
-		weather_reader.m_weather_data_provider = std::make_shared<weatherfile>(as_string("file_name"));
+		weather_reader.m_weather_data_provider = std::shared_ptr<weather_data_provider>(open_weather_resource(this, "file_name"));
 		weather_reader.m_trackmode = 0;
 		weather_reader.m_tilt = 0.0;
 		weather_reader.m_azimuth = 0.0;
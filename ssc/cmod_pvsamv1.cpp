@@ -47,9 +47,75 @@
 *  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************************************/
 
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "cmod_pvsamv1.h"
 #include "lib_pv_io_manager.h"
 
+/// Persistent worker threads which run one task per subarray for each block of the simulation
+class subarray_worker_pool
+{
+public:
+	subarray_worker_pool(const std::vector<size_t> &subarrays, std::function<void(size_t)> task)
+		: m_task(task), m_generation(0), m_pending(0), m_stop(false)
+	{
+		for (size_t i = 0; i < subarrays.size(); i++)
+			m_threads.push_back(std::thread(&subarray_worker_pool::work, this, subarrays[i]));
+	}
+	~subarray_worker_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_start.notify_all();
+		for (size_t i = 0; i < m_threads.size(); i++)
+			m_threads[i].join();
+	}
+
+	/// Run the task for every subarray and wait until all of them are done
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_pending = m_threads.size();
+		m_generation++;
+		m_start.notify_all();
+		m_done.wait(lock, [this] { return m_pending == 0; });
+	}
+
+private:
+	void work(size_t nn)
+	{
+		size_t generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+				if (m_stop) return;
+				generation = m_generation;
+			}
+			m_task(nn);
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_pending == 0)
+				m_done.notify_one();
+		}
+	}
+
+	std::function<void(size_t)> m_task;
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_start, m_done;
+	size_t m_generation;
+	size_t m_pending;
+	bool m_stop;
+};
+
 // comment following define if do not want shading database validation outputs
 //#define SHADE_DB_OUTPUTS
 
@@ -62,6 +128,9 @@ static var_info _cm_vtab_pvsamv1[] = {
 	{ SSC_INPUT,		SSC_NUMBER,		 "transformer_no_load_loss",					"Power transformer no load loss",						"%",		"",								 "pvsamv1",				 "?=0",						 "",							 "" },
 	{ SSC_INPUT,		SSC_NUMBER,		 "transformer_load_loss",						"Power transformer load loss",							"%",		"",								 "pvsamv1",				 "?=0",						 "",							 "" },
 
+	// optional selection of time series outputs
+	{ SSC_INPUT,        SSC_NUMBER,      "timeseries_output_groups",                    "Time series output groups to save",                    "",         "1=weather,2=subarray,4=array POA,8=losses,-1=all", "pvsamv1",     "?=-1",                       "INTEGER,MIN=-1",               "" },
+
 	// optional for lifetime analysis
 	{ SSC_INPUT,        SSC_NUMBER,      "system_use_lifetime_output",                  "PV lifetime simulation",                               "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "analysis_period",                             "Lifetime analysis period",                             "years",    "",                              "pvsamv1",             "system_use_lifetime_output=1",   "",                             "" },
@@ -87,6 +156,9 @@ static var_info _cm_vtab_pvsamv1[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "inverter_count",                              "Number of inverters",                                   "",        "",                              "pvsamv1",              "*",                        "INTEGER,POSITIVE",              "" },
 
 	{ SSC_INPUT,        SSC_NUMBER,      "enable_mismatch_vmax_calc",                   "Enable mismatched subarray Vmax calculation",           "",        "",                              "pvsamv1",              "?=0",                      "BOOLEAN",                       "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "enable_parallel_subarrays",                   "Calculate subarray irradiance in parallel threads",     "",        "",                              "pvsamv1",              "?=0",                      "BOOLEAN",                       "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "enable_lifetime_poa_cache",                   "Replay year one irradiance in lifetime simulations",    "",        "Only used when the cache fits in 64 MB", "pvsamv1",      "?=1",                      "BOOLEAN",                       "" },
+	{ SSC_INPUT,        SSC_STRING,      "shading_db_file",                             "Pre-decompressed shading database file (memory mapped)", "",       "",                              "pvsamv1",              "?",                        "",                              "" },
 
 	{ SSC_INPUT,        SSC_NUMBER,      "subarray1_nstrings",                          "Sub-array 1 Number of parallel strings",                  "",       "",                             "pvsamv1",              "",						 "INTEGER",                       "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "subarray1_tilt",                              "Sub-array 1 Tilt",                                      "deg",     "0=horizontal,90=vertical",      "pvsamv1",              "naof:subarray1_tilt_eq_lat", "MIN=0,MAX=90",                "" },
@@ -524,9 +596,9 @@ static var_info _cm_vtab_pvsamv1[] = {
 
 /* environmental conditions */
 	// irradiance data from weather file
-	{ SSC_OUTPUT,        SSC_ARRAY,      "gh",                                         "Irradiance GHI from weather file",                                     "W/m2",   "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "dn",                                         "Irradiance DNI from weather file",                                     "W/m2",   "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "df",                                         "Irradiance DHI from weather file",                                     "W/m2",   "",                      "Time Series",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "gh",                                         "Irradiance GHI from weather file",                                     "W/m2",   "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "dn",                                         "Irradiance DNI from weather file",                                     "W/m2",   "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "df",                                         "Irradiance DHI from weather file",                                     "W/m2",   "",                      "Time Series",       "" ,                    "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "wfpoa",                                      "Irradiance POA from weather file",                                     "W/m2",   "",                      "Time Series",       "",                     "",                              "" },
 
 	//not all of these three calculated values will be reported, based on irrad_mode selection
@@ -535,46 +607,46 @@ static var_info _cm_vtab_pvsamv1[] = {
 	{ SSC_OUTPUT,        SSC_ARRAY,      "df_calc",                                    "Irradiance DHI calculated",                                       "W/m2",   "",                      "Time Series",       "",                     "",                              "" },
 
 	// non-irradiance data from weather file
-	{ SSC_OUTPUT,        SSC_ARRAY,      "wspd",                                       "Weather file wind speed",                                                        "m/s",    "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "tdry",                                       "Weather file ambient temperature",                                               "C",      "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "alb",                                        "Weather file albedo",							                                 "",       "",                     "Time Series",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "wspd",                                       "Weather file wind speed",                                                        "m/s",    "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "tdry",                                       "Weather file ambient temperature",                                               "C",      "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "alb",                                        "Weather file albedo",							                                 "",       "",                     "Time Series",       "" ,                    "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "snowdepth",                                  "Weather file snow depth",							                            "cm",       "",                    "Time Series",       "",                    "",                              "" },
 
 	// calculated sun position data
-	{ SSC_OUTPUT,        SSC_ARRAY,      "sol_zen",                                    "Sun zenith angle",                                                  "deg",    "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "sol_alt",                                    "Sun altitude angle",                                                "deg",    "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "sol_azi",                                    "Sun azimuth angle",                                                 "deg",    "",                      "Time Series",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "sunup",                                      "Sun up over horizon",                                               "0/1/2/3", "",                     "Time Series",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "sol_zen",                                    "Sun zenith angle",                                                  "deg",    "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "sol_alt",                                    "Sun altitude angle",                                                "deg",    "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "sol_azi",                                    "Sun azimuth angle",                                                 "deg",    "",                      "Time Series",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "sunup",                                      "Sun up over horizon",                                               "0/1/2/3", "",                     "Time Series",       "" ,                    "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "sunpos_hour",                                "Sun position time",                                     "hour",   "",                      "Time Series",       "",                     "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "airmass",                                    "Absolute air mass",                                                 "",       "",                      "Time Series",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "airmass",                                    "Absolute air mass",                                                 "",       "",                      "Time Series",       "" ,                    "",                              "" },
 
 	/* sub-array level outputs */
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_surf_tilt",                  "Subarray 1 Surface tilt",                                              "deg",    "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_surf_azi",                   "Subarray 1 Surface azimuth",                                           "deg",    "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_aoi",                        "Subarray 1 Angle of incidence",                                        "deg",    "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_aoi_modifier",               "Subarray 1 Angle of incidence Modifier",                               "0-1",    "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_axisrot",                    "Subarray 1 Axis rotation for 1 axis trackers",                         "deg",    "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_idealrot",                   "Subarray 1 Axis rotation ideal for 1 axis trackers",                   "deg",    "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_eff_beam",               "Subarray 1 POA front beam irradiance after shading and soiling",       "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_eff_diff",               "Subarray 1 POA front diffuse irradiance after shading and soiling",    "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_nom",                    "Subarray 1 POA total front irradiance nominal",                        "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_shaded",                 "Subarray 1 POA total front irradiance after shading only",             "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_shaded_soiled",          "Subarray 1 POA total front irradiance after shading and soiling",      "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_front",                  "Subarray 1 POA total front irradiance after module cover",              "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_rear",                   "Subarray 1 POA total rear irradiance after module cover",              "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_eff",                    "Subarray 1 POA total irradiance after module cover",                   "W/m2",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_soiling_derate",             "Subarray 1 Soiling beam irradiance factor",                            "frac",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_beam_shading_factor",        "Subarray 1 External shading and soiling beam irradiance factor",       "frac",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_linear_derate",              "Subarray 1 Self-shading linear beam irradiance factor",                "frac",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_ss_diffuse_derate",          "Subarray 1 Self-shading non-linear sky diffuse irradiance factor",     "frac",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_ss_reflected_derate",        "Subarray 1 Self-shading non-linear ground diffuse irradiance factor",  "frac",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_ss_derate",                  "Subarray 1 Self-shading non-linear DC factor",                         "frac",   "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_surf_tilt",                  "Subarray 1 Surface tilt",                                              "deg",    "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_surf_azi",                   "Subarray 1 Surface azimuth",                                           "deg",    "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_aoi",                        "Subarray 1 Angle of incidence",                                        "deg",    "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_aoi_modifier",               "Subarray 1 Angle of incidence Modifier",                               "0-1",    "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_axisrot",                    "Subarray 1 Axis rotation for 1 axis trackers",                         "deg",    "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_idealrot",                   "Subarray 1 Axis rotation ideal for 1 axis trackers",                   "deg",    "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_eff_beam",               "Subarray 1 POA front beam irradiance after shading and soiling",       "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_eff_diff",               "Subarray 1 POA front diffuse irradiance after shading and soiling",    "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_nom",                    "Subarray 1 POA total front irradiance nominal",                        "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_shaded",                 "Subarray 1 POA total front irradiance after shading only",             "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_shaded_soiled",          "Subarray 1 POA total front irradiance after shading and soiling",      "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_front",                  "Subarray 1 POA total front irradiance after module cover",              "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_rear",                   "Subarray 1 POA total rear irradiance after module cover",              "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_poa_eff",                    "Subarray 1 POA total irradiance after module cover",                   "W/m2",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_soiling_derate",             "Subarray 1 Soiling beam irradiance factor",                            "frac",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_beam_shading_factor",        "Subarray 1 External shading and soiling beam irradiance factor",       "frac",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_linear_derate",              "Subarray 1 Self-shading linear beam irradiance factor",                "frac",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_ss_diffuse_derate",          "Subarray 1 Self-shading non-linear sky diffuse irradiance factor",     "frac",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_ss_reflected_derate",        "Subarray 1 Self-shading non-linear ground diffuse irradiance factor",  "frac",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_ss_derate",                  "Subarray 1 Self-shading non-linear DC factor",                         "frac",   "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "shadedb_subarray1_shade_frac",         "Subarray 1 Partial external shading DC factor",                        "frac",   "", "Time Series (Subarray 1)",       "",                     "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_snow_coverage",              "Subarray 1 Snow cover",                                                "0..1",   "", "Time Series (Subarray 1)",       "",                     "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_snow_loss",                  "Subarray 1 Snow cover DC power loss",                                  "kW",     "", "Time Series (Subarray 1)",       "",                     "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_modeff",                     "Subarray 1 Module efficiency",                                         "%",      "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_celltemp",                   "Subarray 1 Cell temperature",                                          "C",      "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_dc_voltage",                 "Subarray 1 Operating voltage",                                         "V",      "", "Time Series (Subarray 1)",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_modeff",                     "Subarray 1 Module efficiency",                                         "%",      "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_celltemp",                   "Subarray 1 Cell temperature",                                          "C",      "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_dc_voltage",                 "Subarray 1 Operating voltage",                                         "V",      "", "Time Series (Subarray 1)",       "" ,                    "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_voc",                        "Subarray 1 Open circuit voltage",                                      "V",      "", "Time Series (Subarray 1)",       "",                     "",                              "" },
 	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray1_isc",                        "Subarray 1 Short circuit current",                                     "A",      "", "Time Series (Subarray 1)",       "",                     "",                              "" },
 
@@ -667,14 +739,14 @@ static var_info _cm_vtab_pvsamv1[] = {
 	{ SSC_OUTPUT,        SSC_ARRAY,      "subarray4_isc",                        "Subarray 4 Short circuit current",                                     "A",      "", "Time Series (Subarray 4)",       "",                     "",                              "" },
 
 /* aggregate array level outputs */
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_nom",                              "Array POA front-side total radiation nominal",                    "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_beam_nom",                         "Array POA front-side beam radiation nominal",                     "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_beam_eff",                         "Array POA beam radiation after shading and soiling",              "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_shaded",                           "Array POA front-side total radiation after shading only",         "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_shaded_soiled",                    "Array POA front-side total radiation after shading and soiling",  "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_front",                            "Array POA front-side total radiation after cover",                "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_rear",                             "Array POA rear-side total radiation after cover",                 "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_eff",                              "Array POA radiation total after cover",                           "kW",   "",  "Time Series (Array)",       "*",                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_nom",                              "Array POA front-side total radiation nominal",                    "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_beam_nom",                         "Array POA front-side beam radiation nominal",                     "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_beam_eff",                         "Array POA beam radiation after shading and soiling",              "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_shaded",                           "Array POA front-side total radiation after shading only",         "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_shaded_soiled",                    "Array POA front-side total radiation after shading and soiling",  "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_front",                            "Array POA front-side total radiation after cover",                "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_rear",                             "Array POA rear-side total radiation after cover",                 "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "poa_eff",                              "Array POA radiation total after cover",                           "kW",   "",  "Time Series (Array)",       "" ,                    "",                              "" },
 
 	//SEV: total dc snow loss time series (not a required output) 
 	{ SSC_OUTPUT,        SSC_ARRAY,      "dc_snow_loss",                         "Array DC power loss due to snow",						 "kW",   "",   "Time Series (Array)",       "",                    "",                              "" },
@@ -682,14 +754,14 @@ static var_info _cm_vtab_pvsamv1[] = {
 	
 	//inverter outputs
 	{ SSC_OUTPUT,        SSC_ARRAY,      "inverter_dc_voltage",                  "Inverter DC input voltage",                            "V",    "",  "Time Series (Inverter)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_eff",                              "Inverter efficiency",                                  "%",    "",  "Time Series (Inverter)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "dc_invmppt_loss",                      "Inverter clipping loss DC MPPT voltage limits",         "kW",  "",  "Time Series (Inverter)",       "*",                    "",                              "" },
-    { SSC_OUTPUT,        SSC_ARRAY,      "inv_cliploss",                         "Inverter clipping loss AC power limit",                "kW",   "",  "Time Series (Inverter)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_psoloss",                          "Inverter power consumption loss",                      "kW",   "",  "Time Series (Inverter)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_pntloss",                          "Inverter night time loss",                             "kW",   "",  "Time Series (Inverter)",       "*",                    "",                              "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_tdcloss",                       	 "Inverter thermal derate loss",                         "kW",   "",   "Time Series (Inverter)",      "*",             "",                   "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_total_loss",                       "Inverter total power loss",                            "kW",   "",   "Time Series (Inverter)",      "*",             "",                   "" },
-	{ SSC_OUTPUT,        SSC_ARRAY,      "ac_wiring_loss",                       "AC wiring loss",                                       "kW",   "",   "Time Series (Inverter)",      "*",                        "",                   "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_eff",                              "Inverter efficiency",                                  "%",    "",  "Time Series (Inverter)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "dc_invmppt_loss",                      "Inverter clipping loss DC MPPT voltage limits",         "kW",  "",  "Time Series (Inverter)",       "" ,                    "",                              "" },
+    { SSC_OUTPUT,        SSC_ARRAY,      "inv_cliploss",                         "Inverter clipping loss AC power limit",                "kW",   "",  "Time Series (Inverter)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_psoloss",                          "Inverter power consumption loss",                      "kW",   "",  "Time Series (Inverter)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_pntloss",                          "Inverter night time loss",                             "kW",   "",  "Time Series (Inverter)",       "" ,                    "",                              "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_tdcloss",                       	 "Inverter thermal derate loss",                         "kW",   "",   "Time Series (Inverter)",      "" ,             "",                   "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "inv_total_loss",                       "Inverter total power loss",                            "kW",   "",   "Time Series (Inverter)",      "" ,             "",                   "" },
+	{ SSC_OUTPUT,        SSC_ARRAY,      "ac_wiring_loss",                       "AC wiring loss",                                       "kW",   "",   "Time Series (Inverter)",      "" ,                        "",                   "" },
 
 	// transformer model outputs
 	{ SSC_OUTPUT,        SSC_ARRAY,      "xfmr_nll_ts",                          "Transformer no load loss",                              "kW", "",    "Time Series (Transformer)", "", "", "" },
@@ -1175,6 +1247,482 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 		}
 	}
 
+	// weather, sun position and array geometry are identical in every year of a lifetime simulation,
+	// so the plane-of-array irradiance, shading and self-shading results from year one are stored
+	// and replayed in later years. POA input models carry day-of-year state across years and are
+	// always recomputed. the cache holds a full year of records, so it is skipped when it would
+	// be too large, e.g. for one-minute weather files with several subarrays.
+	struct poa_cache_record
+	{
+		double poaBeamFront, poaDiffuseFront, poaGroundFront, poaRear, poaTotal;
+		double angleOfIncidenceDegrees, surfaceTiltDegrees, surfaceAzimuthDegrees;
+		double nonlinearDCShadingDerate, dcShadeFactor;
+		bool sunUp, usePOAFromWF;
+
+		// sun position and irradiance values used after the subarray loop
+		double solazi, solzen, solalt, alb, ipoa, ipoa_front, ipoa_rear_after_losses;
+		int sunup;
+
+		// contributions to the timestep irradiance totals (W)
+		double accum_front_nom, accum_front_beam_nom, accum_front_shaded, accum_front_shaded_soiled;
+		double accum_front_beam_eff, accum_rear;
+	};
+	struct pending_log
+	{
+		pending_log(size_t r, const std::string &s, int ty = SSC_NOTICE, float tm = -1.0f) : rec(r), text(s), type(ty), time(tm) {}
+		size_t rec;
+		std::string text;
+		int type;
+		float time;
+	};
+
+	// year one irradiance can optionally be computed a day at a time ahead of the main loop, with one
+	// thread per subarray. subarray state is only touched by its own thread, results are combined in
+	// subarray order and messages are reported in the order of the serial calculation, so the outputs
+	// are identical to the serial calculation. POA input models share state across subarrays and
+	// always run serially.
+	std::vector<size_t> active_subarrays;
+	for (size_t nn = 0; nn < num_subarrays; nn++)
+		if (Subarrays[nn]->enable && Subarrays[nn]->nStrings >= 1)
+			active_subarrays.push_back(nn);
+	size_t n_active_subarrays = active_subarrays.size();
+	size_t first_active_subarray = n_active_subarrays > 0 ? active_subarrays[0] : 0;
+	bool parallel_subarrays = (as_boolean("enable_parallel_subarrays") && n_active_subarrays > 1
+		&& radmode != Irradiance_IO::POA_R && radmode != Irradiance_IO::POA_P);
+
+	size_t nrec_year = 8760 * step_per_hour;
+	size_t nrec_block = 24 * step_per_hour;
+	const size_t poa_cache_max_bytes = 64 * 1024 * 1024;
+	bool use_poa_cache = (nyears > 1 && as_boolean("enable_lifetime_poa_cache")
+		&& nrec_year * num_subarrays * sizeof(poa_cache_record) <= poa_cache_max_bytes
+		&& radmode != Irradiance_IO::POA_R && radmode != Irradiance_IO::POA_P);
+	std::vector<poa_cache_record> poa_cache; // [record * num_subarrays + subarray]
+	if (use_poa_cache)
+		poa_cache.resize(nrec_year * num_subarrays);
+	else if (parallel_subarrays)
+		poa_cache.resize(nrec_block * num_subarrays);
+	std::vector<weather_record> wf_block(parallel_subarrays ? nrec_block : 0);
+	double dc_shade_factor[4] = { 1.0, 1.0, 1.0, 1.0 };
+	ssc_number_t beam_top_of_hour[4] = { 0, 0, 0, 0 };
+
+	// incident irradiance on one subarray for one timestep. outputs that are common to all subarrays
+	// are only written when shared_outputs is set. messages are collected in logs if given, so that
+	// worker threads never call back into the compute module.
+	auto calc_subarray_poa = [&](size_t nn, const weather_record &wf, size_t iyear, size_t hour, size_t jj, size_t idx,
+		bool shared_outputs, poa_cache_record &pc, std::vector<pending_log> *logs)
+	{
+		auto post = [&](const std::string &text, int type, float time)
+		{
+			if (logs) logs->push_back(pending_log(idx, text, type, time));
+			else log(text, type, time);
+		};
+
+		double solazi = 0, solzen = 0, solalt = 0;
+		int sunup = 0;
+		double ipoa_rear = 0, ipoa_rear_after_losses = 0, ipoa_front = 0, ipoa = 0, alb = 0;
+
+		irrad irr(Irradiance, Subarrays[nn], wf);
+
+		int code = irr.calc();
+
+		if (code != 0)
+			throw exec_error("pvsamv1",
+			util::format("failed to calculate irradiance incident on surface (POA) %d (code: %d) [y:%d m:%d d:%d h:%d]",
+			nn + 1, code, wf.year, wf.month, wf.day, wf.hour));
+
+		// p_irrad_calc is only weather file records long...
+		if (iyear == 0 && shared_outputs)
+		{
+			if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P) {
+				double gh_temp, df_temp, dn_temp;
+				gh_temp = df_temp = dn_temp = 0;
+				irr.get_irrad(&gh_temp, &dn_temp, &df_temp);
+				Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)df_temp;
+				Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)dn_temp;
+			}
+		}
+		// beam, skydiff, and grounddiff IN THE PLANE OF ARRAY (W/m2)
+		double ibeam, iskydiff, ignddiff;
+		double aoi, stilt, sazi, rot, btd;
+
+		// Ensure that the usePOAFromWF flag is false unless a reference cell has been used. 
+		//  This will later get forced to false if any shading has been applied (in any scenario)
+		//  also this will also be forced to false if using the cec mcsp thermal model OR if using the spe module model with a diffuse util. factor < 1.0
+		Subarrays[nn]->poa.usePOAFromWF = false;
+		if (radmode == Irradiance_IO::POA_R){
+			ipoa = wf.poa;
+			Subarrays[nn]->poa.usePOAFromWF = true;
+		}
+		else if (radmode == Irradiance_IO::POA_P){
+			ipoa = wf.poa;
+		}
+
+		if (Subarrays[nn]->Module->simpleEfficiencyForceNoPOA && (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P)){  // only will be true if using a poa model AND spe module model AND spe_fp is < 1
+			Subarrays[nn]->poa.usePOAFromWF = false;
+			if (idx == 0)
+				post("The combination of POA irradiance as in input, single point efficiency module model, and module diffuse utilization factor less than one means that SAM must use a POA decomposition model to calculate the incident diffuse irradiance", SSC_WARNING, -1.0f);
+		}
+
+		if (Subarrays[nn]->Module->mountingSpecificCellTemperatureForceNoPOA && (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P)){
+			Subarrays[nn]->poa.usePOAFromWF = false;
+			if (idx == 0)
+				post("The combination of POA irradiance as input and heat transfer method for cell temperature means that SAM must use a POA decomposition model to calculate the beam irradiance required by the cell temperature model", SSC_WARNING, -1.0f);
+		}
+
+
+		// Get Incident angles and irradiances
+		irr.get_sun(&solazi, &solzen, &solalt, 0, 0, 0, &sunup, 0, 0, 0);
+		irr.get_angles(&aoi, &stilt, &sazi, &rot, &btd);
+		irr.get_poa(&ibeam, &iskydiff, &ignddiff, 0, 0, 0);
+		alb = irr.getAlbedo();
+
+		if (iyear == 0 && shared_outputs)
+			Irradiance->p_sunPositionTime[idx] = (ssc_number_t)irr.get_sunpos_calc_hour();
+
+		// save weather file beam, diffuse, and global for output and for use later in pvsamv1- year 1 only
+		/*jmf 2016: these calculations are currently redundant with calculations in irrad.calc() because ibeam and idiff in that function are DNI and DHI, **NOT** in the plane of array
+		we'll have to fix this redundancy in the pvsamv1 rewrite. it will require allowing irradproc to report the errors below
+		and deciding what to do if the weather file DOES contain the third component but it's not being used in the calculations.*/
+		if (iyear == 0)
+		{
+			if (shared_outputs)
+			{
+				// Apply all irradiance component data from weather file (if it exists)
+				Irradiance->p_weatherFilePOA[0][idx] = (ssc_number_t)wf.poa;
+				Irradiance->p_weatherFileDNI[idx] = (ssc_number_t)wf.dn;
+				Irradiance->weatherFileGHI.set(idx, (ssc_number_t)(wf.gh));
+				Irradiance->p_weatherFileDHI[idx] = (ssc_number_t)(wf.df);
+			}
+
+			// calculate beam if global & diffuse are selected as inputs
+			// the top of hour value is kept per subarray for the self-shading calculation below
+			if (radmode == Irradiance_IO::GH_DF)
+			{
+				ssc_number_t dn_calc = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
+				if (dn_calc < -1)
+					dn_calc = 0; // reported once per timestep after the subarrays are merged
+				if (shared_outputs)
+					Irradiance->p_IrradianceCalculated[2][idx] = dn_calc;
+				if (jj == 0)
+					beam_top_of_hour[nn] = dn_calc;
+			}
+
+			// calculate global if beam & diffuse are selected as inputs
+			if (radmode == Irradiance_IO::DN_DF && shared_outputs)
+			{
+				Irradiance->p_IrradianceCalculated[0][idx] = (ssc_number_t)(wf.df + wf.dn * cos(solzen*3.1415926 / 180));
+				if (Irradiance->p_IrradianceCalculated[0][idx] < -1)
+				{
+					post(util::format("SAM calculated negative global horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+						Irradiance->p_IrradianceCalculated[0][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+					Irradiance->p_IrradianceCalculated[0][idx] = 0;
+				}
+			}
+
+			// calculate diffuse if total & beam are selected as inputs
+			if (radmode == Irradiance_IO::DN_GH && shared_outputs)
+			{
+				Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)(wf.gh - wf.dn * cos(solzen*3.1415926 / 180));
+				if (Irradiance->p_IrradianceCalculated[1][idx] < -1)
+				{
+					post(util::format("SAM calculated negative diffuse horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+						Irradiance->p_IrradianceCalculated[1][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+					Irradiance->p_IrradianceCalculated[1][idx] = 0;
+				}
+			}
+		}
+
+		// record sub-array plane of array output before computing shading and soiling
+		if (iyear == 0)
+		{
+			if (radmode != Irradiance_IO::POA_R)
+				PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ibeam + iskydiff + ignddiff));
+			else
+				PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ipoa));
+		}
+
+
+		// record sub-array contribution to total POA power for this time step  (W)
+		if (radmode != Irradiance_IO::POA_R)
+			pc.accum_front_nom = (ibeam + iskydiff + ignddiff) * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+		else
+			pc.accum_front_nom = (ipoa)* ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+
+		// record sub-array contribution to total POA beam power for this time step (W)
+		pc.accum_front_beam_nom = ibeam * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+
+		// for non-linear shading from shading database
+		if (Subarrays[nn]->shadeCalculator.use_shade_db())
+		{
+			double shadedb_gpoa = ibeam + iskydiff + ignddiff;
+			double shadedb_dpoa = iskydiff + ignddiff;
+
+			// update cell temperature - unshaded value per Sara 1/25/16
+			double tcell = wf.tdry;
+			if (sunup > 0)
+			{
+				// calculate cell temperature using selected temperature model
+				pvinput_t in(ibeam, iskydiff, ignddiff, 0, ipoa,
+					wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+					solzen, aoi, hdr.elev,
+					stilt, sazi,
+					((double)wf.hour) + wf.minute / 60.0,
+					radmode, Subarrays[nn]->poa.usePOAFromWF);
+				// voltage set to -1 for max power
+				(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, -1.0, tcell);
+			}
+			double shadedb_str_vmp_stc = modules_per_string * Subarrays[nn]->Module->voltageMaxPower;
+			double shadedb_mppt_lo = PVSystem->voltageMpptLow1Module * modules_per_string;;
+			double shadedb_mppt_hi = PVSystem->voltageMpptHi1Module * modules_per_string;;
+
+			/// shading database if necessary
+			std::unique_ptr<ShadeDB8_mpp> &p_shade_db = IOManager->m_shadeDatabase[nn];
+			if (!Subarrays[nn]->shadeCalculator.fbeam_shade_db(p_shade_db, hour, solalt, solazi, jj, step_per_hour, shadedb_gpoa, shadedb_dpoa, tcell, modules_per_string, shadedb_str_vmp_stc, shadedb_mppt_lo, shadedb_mppt_hi))
+			{
+				throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+			}
+			if (iyear == 0)
+			{
+#ifdef SHADE_DB_OUTPUTS
+				p_shadedb_gpoa[nn][idx] = (ssc_number_t)shadedb_gpoa;
+				p_shadedb_dpoa[nn][idx] = (ssc_number_t)shadedb_dpoa;
+				p_shadedb_pv_cell_temp[nn][idx] = (ssc_number_t)tcell;
+				p_shadedb_mods_per_str[nn][idx] = (ssc_number_t)modules_per_string;
+				p_shadedb_str_vmp_stc[nn][idx] = (ssc_number_t)shadedb_str_vmp_stc;
+				p_shadedb_mppt_lo[nn][idx] = (ssc_number_t)shadedb_mppt_lo;
+				p_shadedb_mppt_hi[nn][idx] = (ssc_number_t)shadedb_mppt_hi;
+				post("shade db hour " + util::to_string((int)hour) +"\n" + p_shade_db->get_warning(), SSC_NOTICE, -1.0f);
+#endif
+				// fraction shaded for comparison
+				PVSystem->p_shadeDBShadeFraction[nn][idx] = (ssc_number_t)(Subarrays[nn]->shadeCalculator.dc_shade_factor());
+			}
+		}
+		else
+		{
+			if (!Subarrays[nn]->shadeCalculator.fbeam(hour, solalt, solazi, jj, step_per_hour))
+			{
+				throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
+			}
+		}
+
+		// apply hourly shading factors to beam (if none enabled, factors are 1.0) 
+		// shj 3/21/16 - update to handle negative shading loss
+		if (Subarrays[nn]->shadeCalculator.beam_shade_factor() != 1.0){
+			//							if (sa[nn].shad.beam_shade_factor() < 1.0){
+			// Sara 1/25/16 - shading database derate applied to dc only
+			// shading loss applied to beam if not from shading database
+			ibeam *= Subarrays[nn]->shadeCalculator.beam_shade_factor();
+			if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
+				Subarrays[nn]->poa.usePOAFromWF = false;
+				if (Subarrays[nn]->poa.poaShadWarningCount == 0){
+					post(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
+						wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
+				}
+				else{
+					post(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
+						wf.year, wf.month, wf.day, wf.hour), SSC_NOTICE, (float)idx);
+				}
+				Subarrays[nn]->poa.poaShadWarningCount++;
+			}
+		}
+
+		// apply sky diffuse shading factor (specified as constant, nominally 1.0 if disabled in UI)
+		if (Subarrays[nn]->shadeCalculator.fdiff() < 1.0){
+			iskydiff *= Subarrays[nn]->shadeCalculator.fdiff();
+			if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
+				if (idx == 0)
+					post("Combining POA irradiance as input with the diffuse shading losses forces SAM to use a POA decomposition model to calculate incident diffuse irradiance", SSC_WARNING, -1.0f);
+				Subarrays[nn]->poa.usePOAFromWF = false;
+			}
+		}
+
+		double beam_shading_factor = Subarrays[nn]->shadeCalculator.beam_shade_factor();
+
+		//self-shading calculations
+		if (((Subarrays[nn]->trackMode == 0 || Subarrays[nn]->trackMode == 4) && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2)) //fixed tilt or timeseries tilt, self-shading (linear or non-linear) OR
+			|| (Subarrays[nn]->trackMode == 1 && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2) && Subarrays[nn]->backtrackingEnabled == 0)) //one-axis tracking, self-shading, not backtracking
+		{
+
+			if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
+				if (idx == 0)
+					post("Combining POA irradiance as input with self shading forces SAM to employ a POA decomposition model to calculate incident beam irradiance", SSC_WARNING, -1.0f);
+				Subarrays[nn]->poa.usePOAFromWF = false;
+			}
+
+			// info to be passed to self-shading function
+			bool trackbool = (Subarrays[nn]->trackMode == 1);	// 0 for fixed tilt and timeseries tilt, 1 for one-axis
+			bool linear = (Subarrays[nn]->shadeMode == 2); //0 for full self-shading, 1 for linear self-shading
+
+			//geometric fraction of the array that is shaded for one-axis trackers.
+			//USES A DIFFERENT FUNCTION THAN THE SELF-SHADING BECAUSE SS IS MEANT FOR FIXED ONLY. shadeFraction1x IS FOR ONE-AXIS TRACKERS ONLY.
+			//used in the non-linear self-shading calculator for one-axis tracking only
+			double shad1xf = 0;
+			if (trackbool)
+				shad1xf = shadeFraction1x(solazi, solzen, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->groundCoverageRatio, rot);
+
+			//execute self-shading calculations
+			ssc_number_t beam_to_use; //some self-shading calculations require DNI, NOT ibeam (beam in POA). Need to know whether to use DNI from wf or calculated, depending on radmode
+			if (radmode == Irradiance_IO::DN_DF || radmode == Irradiance_IO::DN_GH) beam_to_use = (ssc_number_t)wf.dn;
+			else if (radmode == Irradiance_IO::GH_DF && iyear == 0) beam_to_use = beam_top_of_hour[nn]; // top of hour in first year
+			else beam_to_use = Irradiance->p_IrradianceCalculated[2][hour * step_per_hour]; // top of hour in first year
+
+			if (linear && trackbool) //one-axis linear
+			{
+				ibeam *= (1 - shad1xf); //derate beam irradiance linearly by the geometric shading fraction calculated above per Chris Deline 2/10/16
+				beam_shading_factor *= (1 - shad1xf);
+				if (iyear == 0)
+				{
+					PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
+					PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - shad1xf);
+					PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
+					PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
+				}
+			}
+
+			else if (ss_exec(Subarrays[nn]->selfShadingInputs, stilt, sazi, solzen, solazi, beam_to_use, ibeam, (iskydiff + ignddiff), alb, trackbool, linear, shad1xf, Subarrays[nn]->selfShadingOutputs))
+			{
+				if (linear) //fixed tilt linear
+				{
+					ibeam *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+					beam_shading_factor *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+					if (iyear == 0)
+					{
+						PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
+						PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
+						PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
+						PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
+					}
+				}
+				else //non-linear: fixed tilt AND one-axis
+				{
+					if (iyear == 0)
+					{
+						PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
+						PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
+						PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_dc_derate;
+						PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)1;
+					}
+
+					// Sky diffuse and ground-reflected diffuse are derated according to C. Deline's algorithm
+					iskydiff *= Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
+					ignddiff *= Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
+					// Beam is not derated- all beam derate effects (linear and non-linear) are taken into account in the nonlinear_dc_shading_derate
+					Subarrays[nn]->poa.nonlinearDCShadingDerate = Subarrays[nn]->selfShadingOutputs.m_dc_derate;
+				}
+			}
+			else
+				throw exec_error("pvsamv1", util::format("Self-shading calculation failed at %d", (int)idx));
+		}
+
+		double poashad = (radmode == Irradiance_IO::POA_R) ? ipoa : (ibeam + iskydiff + ignddiff);
+
+		// determine sub-array contribution to total shaded plane of array for this hour
+		pc.accum_front_shaded = poashad * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+
+		// apply soiling derate to all components of irradiance
+		double soiling_factor = 1.0;
+		int month_idx = wf.month - 1;
+		if (month_idx >= 0 && month_idx < 12)
+		{
+			soiling_factor = Subarrays[nn]->monthlySoiling[month_idx];
+			ibeam *= soiling_factor;
+			iskydiff *= soiling_factor;
+			ignddiff *= soiling_factor;
+			if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
+				ipoa *= soiling_factor;
+				if (soiling_factor < 1 && idx == 0)
+					post("Soiling may already be accounted for in the input POA data. Please confirm that the input data does not contain soiling effects, or remove the additional losses on the Losses page.", SSC_WARNING, -1.0f);
+			}
+			beam_shading_factor *= soiling_factor;
+		}
+
+		// Calculate total front irradiation after soiling added to shading
+		ipoa_front = ibeam + iskydiff + ignddiff;
+		pc.accum_front_shaded_soiled = ipoa_front * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+		
+		// Calculate rear-side irradiance for bifacial modules
+		if (Subarrays[0]->Module->isBifacial)
+		{
+			double slopeLength = Subarrays[nn]->selfShadingInputs.length * Subarrays[nn]->selfShadingInputs.nmody;
+			if (Subarrays[nn]->selfShadingInputs.mod_orient == 1) {
+				slopeLength = Subarrays[nn]->selfShadingInputs.width * Subarrays[nn]->selfShadingInputs.nmody;
+			}
+			irr.calc_rear_side(Subarrays[0]->Module->bifacialTransmissionFactor, Subarrays[0]->Module->bifaciality, Subarrays[0]->Module->groundClearanceHeight, slopeLength);
+			ipoa_rear = irr.get_poa_rear();
+			ipoa_rear_after_losses = ipoa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+		}
+		pc.accum_rear = ipoa_rear * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+
+		if (iyear == 0) 
+		{
+			// save sub-array level outputs			
+			PVSystem->p_poaShadedFront[nn][idx] = (ssc_number_t)poashad;
+			PVSystem->p_poaShadedSoiledFront[nn][idx] = (ssc_number_t)ipoa_front;
+			PVSystem->p_poaBeamFront[nn][idx] = (ssc_number_t)ibeam;
+			PVSystem->p_poaDiffuseFront[nn][idx] = (ssc_number_t)(iskydiff + ignddiff);
+			PVSystem->p_poaRear[nn][idx] = (ssc_number_t)(ipoa_rear_after_losses);
+			PVSystem->p_beamShadingFactor[nn][idx] = (ssc_number_t)beam_shading_factor;
+			PVSystem->p_axisRotation[nn][idx] = (ssc_number_t)rot;
+			PVSystem->p_idealRotation[nn][idx] = (ssc_number_t)(rot - btd);
+			PVSystem->p_angleOfIncidence[nn][idx] = (ssc_number_t)aoi;
+			PVSystem->p_surfaceTilt[nn][idx] = (ssc_number_t)stilt;
+			PVSystem->p_surfaceAzimuth[nn][idx] = (ssc_number_t)sazi;
+			PVSystem->p_derateSoiling[nn][idx] = (ssc_number_t)soiling_factor;
+		}
+
+		// accumulate incident total radiation (W) in this timestep (all subarrays)
+		pc.accum_front_beam_eff = ibeam * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+
+		// save the required irradiance inputs on array plane for the module output calculations.
+		pc.poaBeamFront = ibeam;
+		pc.poaDiffuseFront = iskydiff;
+		pc.poaGroundFront = ignddiff;
+		pc.poaRear = ipoa_rear_after_losses;
+		pc.poaTotal = (radmode == Irradiance_IO::POA_R) ? ipoa :(ipoa_front + ipoa_rear_after_losses);
+		pc.angleOfIncidenceDegrees = aoi;
+		pc.surfaceTiltDegrees = stilt;
+		pc.surfaceAzimuthDegrees = sazi;
+		pc.nonlinearDCShadingDerate = Subarrays[nn]->poa.nonlinearDCShadingDerate;
+		pc.dcShadeFactor = Subarrays[nn]->shadeCalculator.dc_shade_factor();
+		pc.sunUp = (sunup != 0);
+		pc.usePOAFromWF = Subarrays[nn]->poa.usePOAFromWF;
+
+		pc.solazi = solazi;
+		pc.solzen = solzen;
+		pc.solalt = solalt;
+		pc.sunup = sunup;
+		pc.alb = alb;
+		pc.ipoa = ipoa;
+		pc.ipoa_front = ipoa_front;
+		pc.ipoa_rear_after_losses = ipoa_rear_after_losses;
+	};
+
+	// the subarray threads are started once and reused for every day of year one
+	size_t block_irec = 0;
+	std::vector<std::exception_ptr> block_errors(num_subarrays);
+	std::vector< std::vector<pending_log> > block_logs(num_subarrays);
+	std::unique_ptr<subarray_worker_pool> subarray_workers;
+	if (parallel_subarrays)
+	{
+		subarray_workers.reset(new subarray_worker_pool(active_subarrays, [&](size_t nn)
+		{
+			try
+			{
+				for (size_t k = 0; k < nrec_block; k++)
+				{
+					size_t krec = block_irec + k;
+					size_t kslot = (use_poa_cache ? krec : k) * num_subarrays + nn;
+					calc_subarray_poa(nn, wf_block[k], 0, krec / step_per_hour, krec % step_per_hour, krec,
+						nn == first_active_subarray, poa_cache[kslot], &block_logs[nn]);
+				}
+			}
+			catch (...)
+			{
+				block_errors[nn] = std::current_exception();
+			}
+		}));
+	}
+
 	/* *********************************************************************************************
 	PV DC calculation
 	*********************************************************************************************** */
@@ -1211,7 +1759,35 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 				//						iyear, hour, jj, cur_load), SSC_WARNING, (float)idx);
 				p_load_full.push_back((ssc_number_t)cur_load);
 
-				if (!wdprov->read(&Irradiance->weatherRecord))
+				size_t irec = hour * step_per_hour + jj;
+
+				// compute the next day of year one irradiance for all subarrays concurrently
+				if (parallel_subarrays && iyear == 0 && irec % nrec_block == 0)
+				{
+					for (size_t k = 0; k < nrec_block; k++)
+						if (!wdprov->read(&wf_block[k]))
+							throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(idx + k + 1)) + " in weather file");
+
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+						block_logs[nn].clear();
+					block_irec = irec;
+					subarray_workers->run();
+
+					// report messages in timestep then subarray order, as the serial calculation would
+					std::vector<size_t> next(num_subarrays, 0);
+					for (size_t krec = irec; krec < irec + nrec_block; krec++)
+						for (size_t nn = 0; nn < num_subarrays; nn++)
+							for (; next[nn] < block_logs[nn].size() && block_logs[nn][next[nn]].rec == krec; next[nn]++)
+								log(block_logs[nn][next[nn]].text, block_logs[nn][next[nn]].type, block_logs[nn][next[nn]].time);
+
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+						if (block_errors[nn])
+							std::rethrow_exception(block_errors[nn]);
+				}
+
+				if (parallel_subarrays && iyear == 0)
+					Irradiance->weatherRecord = wf_block[irec % nrec_block];
+				else if (!wdprov->read(&Irradiance->weatherRecord))
 					throw exec_error("pvsamv1", "could not read data line " + util::to_string((int)(idx + 1)) + " in weather file");
 
 				weather_record wf = Irradiance->weatherRecord;
@@ -1249,8 +1825,11 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 				double ts_accum_poa_front_beam_eff = 0.0;
 
 				// calculate incident irradiance on each subarray
-				double ipoa_rear, ipoa_rear_after_losses, ipoa_front, ipoa, alb;
-				ipoa_rear = ipoa_rear_after_losses = ipoa_front = ipoa = alb = 0;
+				double ipoa_rear_after_losses, ipoa_front, ipoa, alb;
+				ipoa_rear_after_losses = ipoa_front = ipoa = alb = 0;
+
+				// year one results are precomputed when running in parallel, later years replay year one
+				bool precomputed = (use_poa_cache && iyear > 0) || (parallel_subarrays && iyear == 0);
 
 				for (int nn = 0; nn < num_subarrays; nn++)
 				{
@@ -1258,364 +1837,53 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 						|| Subarrays[nn]->nStrings < 1)
 						continue; // skip disabled subarrays
 
-					irrad irr(Irradiance, Subarrays[nn]);
-					
-					int code = irr.calc();
-
-					if (code != 0)
-						throw exec_error("pvsamv1",
-						util::format("failed to calculate irradiance incident on surface (POA) %d (code: %d) [y:%d m:%d d:%d h:%d]",
-						nn + 1, code, wf.year, wf.month, wf.day, wf.hour));
-
-					// p_irrad_calc is only weather file records long...
-					if (iyear == 0)
-					{
-						if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P) {
-							double gh_temp, df_temp, dn_temp;
-							gh_temp = df_temp = dn_temp = 0;
-							irr.get_irrad(&gh_temp, &dn_temp, &df_temp);
-							Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)df_temp;
-							Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)dn_temp;
-						}
-					}
-					// beam, skydiff, and grounddiff IN THE PLANE OF ARRAY (W/m2)
-					double ibeam, iskydiff, ignddiff;
-					double aoi, stilt, sazi, rot, btd;
-
-					// Ensure that the usePOAFromWF flag is false unless a reference cell has been used. 
-					//  This will later get forced to false if any shading has been applied (in any scenario)
-					//  also this will also be forced to false if using the cec mcsp thermal model OR if using the spe module model with a diffuse util. factor < 1.0
-					Subarrays[nn]->poa.usePOAFromWF = false;
-					if (radmode == Irradiance_IO::POA_R){
-						ipoa = wf.poa;
-						Subarrays[nn]->poa.usePOAFromWF = true;
-					}
-					else if (radmode == Irradiance_IO::POA_P){
-						ipoa = wf.poa;
-					}
-
-					if (Subarrays[nn]->Module->simpleEfficiencyForceNoPOA && (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P)){  // only will be true if using a poa model AND spe module model AND spe_fp is < 1
-						Subarrays[nn]->poa.usePOAFromWF = false;
-						if (idx == 0)
-							log("The combination of POA irradiance as in input, single point efficiency module model, and module diffuse utilization factor less than one means that SAM must use a POA decomposition model to calculate the incident diffuse irradiance", SSC_WARNING);
-					}
-
-					if (Subarrays[nn]->Module->mountingSpecificCellTemperatureForceNoPOA && (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P)){
-						Subarrays[nn]->poa.usePOAFromWF = false;
-						if (idx == 0)
-							log("The combination of POA irradiance as input and heat transfer method for cell temperature means that SAM must use a POA decomposition model to calculate the beam irradiance required by the cell temperature model", SSC_WARNING);
-					}
-
-
-					// Get Incident angles and irradiances
-					irr.get_sun(&solazi, &solzen, &solalt, 0, 0, 0, &sunup, 0, 0, 0);
-					irr.get_angles(&aoi, &stilt, &sazi, &rot, &btd);
-					irr.get_poa(&ibeam, &iskydiff, &ignddiff, 0, 0, 0);
-					alb = irr.getAlbedo();
-
-					if (iyear == 0)
-						Irradiance->p_sunPositionTime[idx] = (ssc_number_t)irr.get_sunpos_calc_hour();
-
-					// save weather file beam, diffuse, and global for output and for use later in pvsamv1- year 1 only
-					/*jmf 2016: these calculations are currently redundant with calculations in irrad.calc() because ibeam and idiff in that function are DNI and DHI, **NOT** in the plane of array
-					we'll have to fix this redundancy in the pvsamv1 rewrite. it will require allowing irradproc to report the errors below
-					and deciding what to do if the weather file DOES contain the third component but it's not being used in the calculations.*/
-					if (iyear == 0)
-					{
-						// Apply all irradiance component data from weather file (if it exists)
-						Irradiance->p_weatherFilePOA[0][idx] = (ssc_number_t)wf.poa;
-						Irradiance->p_weatherFileDNI[idx] = (ssc_number_t)wf.dn;
-						Irradiance->p_weatherFileGHI[idx] = (ssc_number_t)(wf.gh);
-						Irradiance->p_weatherFileDHI[idx] = (ssc_number_t)(wf.df);
-
-						// calculate beam if global & diffuse are selected as inputs
-						if (radmode == Irradiance_IO::GH_DF)
-						{
-							Irradiance->p_IrradianceCalculated[2][idx] = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[2][idx] < -1)
-							{
-								log(util::format("SAM calculated negative direct normal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[2][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[2][idx] = 0;
-							}
-						}
-
-						// calculate global if beam & diffuse are selected as inputs
-						if (radmode == Irradiance_IO::DN_DF)
-						{
-							Irradiance->p_IrradianceCalculated[0][idx] = (ssc_number_t)(wf.df + wf.dn * cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[0][idx] < -1)
-							{
-								log(util::format("SAM calculated negative global horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[0][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[0][idx] = 0;
-							}
-						}
-
-						// calculate diffuse if total & beam are selected as inputs
-						if (radmode == Irradiance_IO::DN_GH)
-						{
-							Irradiance->p_IrradianceCalculated[1][idx] = (ssc_number_t)(wf.gh - wf.dn * cos(solzen*3.1415926 / 180));
-							if (Irradiance->p_IrradianceCalculated[1][idx] < -1)
-							{
-								log(util::format("SAM calculated negative diffuse horizontal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
-									Irradiance->p_IrradianceCalculated[1][idx], wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-								Irradiance->p_IrradianceCalculated[1][idx] = 0;
-							}
-						}
-					}
-
-					// record sub-array plane of array output before computing shading and soiling
-					if (iyear == 0)
-					{
-						if (radmode != Irradiance_IO::POA_R)
-							PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ibeam + iskydiff + ignddiff));
-						else
-							PVSystem->p_poaNominalFront[nn][idx] = (ssc_number_t)((ipoa));
-					}
-
-
-					// record sub-array contribution to total POA power for this time step  (W)
-					if (radmode != Irradiance_IO::POA_R)
-						ts_accum_poa_front_nom += (ibeam + iskydiff + ignddiff) * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
-					else
-						ts_accum_poa_front_nom += (ipoa)* ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
-
-					// record sub-array contribution to total POA beam power for this time step (W)
-					ts_accum_poa_front_beam_nom += ibeam * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
-
-					// for non-linear shading from shading database
-					if (Subarrays[nn]->shadeCalculator.use_shade_db())
-					{
-						double shadedb_gpoa = ibeam + iskydiff + ignddiff;
-						double shadedb_dpoa = iskydiff + ignddiff;
-
-						// update cell temperature - unshaded value per Sara 1/25/16
-						double tcell = wf.tdry;
-						if (sunup > 0)
-						{
-							// calculate cell temperature using selected temperature model
-							pvinput_t in(ibeam, iskydiff, ignddiff, 0, ipoa,
-								wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-								solzen, aoi, hdr.elev,
-								stilt, sazi,
-								((double)wf.hour) + wf.minute / 60.0,
-								radmode, Subarrays[nn]->poa.usePOAFromWF);
-							// voltage set to -1 for max power
-							(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, -1.0, tcell);
-						}
-						double shadedb_str_vmp_stc = modules_per_string * Subarrays[nn]->Module->voltageMaxPower;
-						double shadedb_mppt_lo = PVSystem->voltageMpptLow1Module * modules_per_string;;
-						double shadedb_mppt_hi = PVSystem->voltageMpptHi1Module * modules_per_string;;
-
-						/// shading database if necessary
-						smart_ptr<ShadeDB8_mpp>::ptr  p_shade_db;
-						if (!Subarrays[nn]->shadeCalculator.fbeam_shade_db(p_shade_db, hour, solalt, solazi, jj, step_per_hour, shadedb_gpoa, shadedb_dpoa, tcell, modules_per_string, shadedb_str_vmp_stc, shadedb_mppt_lo, shadedb_mppt_hi))
-						{
-							throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
-						}
-						if (iyear == 0)
-						{
-#ifdef SHADE_DB_OUTPUTS
-							p_shadedb_gpoa[nn][idx] = (ssc_number_t)shadedb_gpoa;
-							p_shadedb_dpoa[nn][idx] = (ssc_number_t)shadedb_dpoa;
-							p_shadedb_pv_cell_temp[nn][idx] = (ssc_number_t)tcell;
-							p_shadedb_mods_per_str[nn][idx] = (ssc_number_t)modules_per_string;
-							p_shadedb_str_vmp_stc[nn][idx] = (ssc_number_t)shadedb_str_vmp_stc;
-							p_shadedb_mppt_lo[nn][idx] = (ssc_number_t)shadedb_mppt_lo;
-							p_shadedb_mppt_hi[nn][idx] = (ssc_number_t)shadedb_mppt_hi;
-							log("shade db hour " + util::to_string((int)hour) +"\n" + p_shade_db->get_warning());
-#endif
-							// fraction shaded for comparison
-							PVSystem->p_shadeDBShadeFraction[nn][idx] = (ssc_number_t)(Subarrays[nn]->shadeCalculator.dc_shade_factor());
-						}
-					}
-					else
-					{
-						if (!Subarrays[nn]->shadeCalculator.fbeam(hour, solalt, solazi, jj, step_per_hour))
-						{
-							throw exec_error("pvsamv1", util::format("Error calculating shading factor for subarray %d", nn));
-						}
-					}
-
-					// apply hourly shading factors to beam (if none enabled, factors are 1.0) 
-					// shj 3/21/16 - update to handle negative shading loss
-					if (Subarrays[nn]->shadeCalculator.beam_shade_factor() != 1.0){
-						//							if (sa[nn].shad.beam_shade_factor() < 1.0){
-						// Sara 1/25/16 - shading database derate applied to dc only
-						// shading loss applied to beam if not from shading database
-						ibeam *= Subarrays[nn]->shadeCalculator.beam_shade_factor();
-						if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
-							Subarrays[nn]->poa.usePOAFromWF = false;
-							if (Subarrays[nn]->poa.poaShadWarningCount == 0){
-								log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
-									wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
-							}
-							else{
-								log(util::format("Combining POA irradiance as input with the beam shading losses at time [y:%d m:%d d:%d h:%d] forces SAM to use a POA decomposition model to calculate incident beam irradiance",
-									wf.year, wf.month, wf.day, wf.hour), SSC_NOTICE, (float)idx);
-							}
-							Subarrays[nn]->poa.poaShadWarningCount++;
-						}
-					}
-
-					// apply sky diffuse shading factor (specified as constant, nominally 1.0 if disabled in UI)
-					if (Subarrays[nn]->shadeCalculator.fdiff() < 1.0){
-						iskydiff *= Subarrays[nn]->shadeCalculator.fdiff();
-						if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
-							if (idx == 0)
-								log("Combining POA irradiance as input with the diffuse shading losses forces SAM to use a POA decomposition model to calculate incident diffuse irradiance", SSC_WARNING);
-							Subarrays[nn]->poa.usePOAFromWF = false;
-						}
-					}
-
-					double beam_shading_factor = Subarrays[nn]->shadeCalculator.beam_shade_factor();
-
-					//self-shading calculations
-					if (((Subarrays[nn]->trackMode == 0 || Subarrays[nn]->trackMode == 4) && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2)) //fixed tilt or timeseries tilt, self-shading (linear or non-linear) OR
-						|| (Subarrays[nn]->trackMode == 1 && (Subarrays[nn]->shadeMode == 1 || Subarrays[nn]->shadeMode == 2) && Subarrays[nn]->backtrackingEnabled == 0)) //one-axis tracking, self-shading, not backtracking
-					{
-
-						if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
-							if (idx == 0)
-								log("Combining POA irradiance as input with self shading forces SAM to employ a POA decomposition model to calculate incident beam irradiance", SSC_WARNING);
-							Subarrays[nn]->poa.usePOAFromWF = false;
-						}
-
-						// info to be passed to self-shading function
-						bool trackbool = (Subarrays[nn]->trackMode == 1);	// 0 for fixed tilt and timeseries tilt, 1 for one-axis
-						bool linear = (Subarrays[nn]->shadeMode == 2); //0 for full self-shading, 1 for linear self-shading
-
-						//geometric fraction of the array that is shaded for one-axis trackers.
-						//USES A DIFFERENT FUNCTION THAN THE SELF-SHADING BECAUSE SS IS MEANT FOR FIXED ONLY. shadeFraction1x IS FOR ONE-AXIS TRACKERS ONLY.
-						//used in the non-linear self-shading calculator for one-axis tracking only
-						double shad1xf = 0;
-						if (trackbool)
-							shad1xf = shadeFraction1x(solazi, solzen, Subarrays[nn]->tiltDegrees, Subarrays[nn]->azimuthDegrees, Subarrays[nn]->groundCoverageRatio, rot);
-
-						//execute self-shading calculations
-						ssc_number_t beam_to_use; //some self-shading calculations require DNI, NOT ibeam (beam in POA). Need to know whether to use DNI from wf or calculated, depending on radmode
-						if (radmode == Irradiance_IO::DN_DF || radmode == Irradiance_IO::DN_GH) beam_to_use = (ssc_number_t)wf.dn;
-						else beam_to_use = Irradiance->p_IrradianceCalculated[2][hour * step_per_hour]; // top of hour in first year
-
-						if (linear && trackbool) //one-axis linear
-						{
-							ibeam *= (1 - shad1xf); //derate beam irradiance linearly by the geometric shading fraction calculated above per Chris Deline 2/10/16
-							beam_shading_factor *= (1 - shad1xf);
-							if (iyear == 0)
-							{
-								PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
-								PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - shad1xf);
-								PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
-								PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
-							}
-						}
-
-						else if (ss_exec(Subarrays[nn]->selfShadingInputs, stilt, sazi, solzen, solazi, beam_to_use, ibeam, (iskydiff + ignddiff), alb, trackbool, linear, shad1xf, Subarrays[nn]->selfShadingOutputs))
-						{
-							if (linear) //fixed tilt linear
-							{
-								ibeam *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-								beam_shading_factor *= (1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-								if (iyear == 0)
-								{
-									PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)1;
-									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)(1 - Subarrays[nn]->selfShadingOutputs.m_shade_frac_fixed);
-									PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)1; //no diffuse derate for linear shading
-									PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)1; //no reflected derate for linear shading
-								}
-							}
-							else //non-linear: fixed tilt AND one-axis
-							{
-								if (iyear == 0)
-								{
-									PVSystem->p_derateSelfShadingDiffuse[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
-									PVSystem->p_derateSelfShadingReflected[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
-									PVSystem->p_derateSelfShading[nn][idx] = (ssc_number_t)Subarrays[nn]->selfShadingOutputs.m_dc_derate;
-									PVSystem->p_derateLinear[nn][idx] = (ssc_number_t)1;
-								}
-
-								// Sky diffuse and ground-reflected diffuse are derated according to C. Deline's algorithm
-								iskydiff *= Subarrays[nn]->selfShadingOutputs.m_diffuse_derate;
-								ignddiff *= Subarrays[nn]->selfShadingOutputs.m_reflected_derate;
-								// Beam is not derated- all beam derate effects (linear and non-linear) are taken into account in the nonlinear_dc_shading_derate
-								Subarrays[nn]->poa.nonlinearDCShadingDerate = Subarrays[nn]->selfShadingOutputs.m_dc_derate;
-							}
-						}
-						else
-							throw exec_error("pvsamv1", util::format("Self-shading calculation failed at %d", (int)idx));
-					}
-
-					double poashad = (radmode == Irradiance_IO::POA_R) ? ipoa : (ibeam + iskydiff + ignddiff);
-
-					// determine sub-array contribution to total shaded plane of array for this hour
-					ts_accum_poa_front_shaded += poashad * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
-
-					// apply soiling derate to all components of irradiance
-					double soiling_factor = 1.0;
-					int month_idx = wf.month - 1;
-					if (month_idx >= 0 && month_idx < 12)
-					{
-						soiling_factor = Subarrays[nn]->monthlySoiling[month_idx];
-						ibeam *= soiling_factor;
-						iskydiff *= soiling_factor;
-						ignddiff *= soiling_factor;
-						if (radmode == Irradiance_IO::POA_R || radmode == Irradiance_IO::POA_P){
-							ipoa *= soiling_factor;
-							if (soiling_factor < 1 && idx == 0)
-								log("Soiling may already be accounted for in the input POA data. Please confirm that the input data does not contain soiling effects, or remove the additional losses on the Losses page.", SSC_WARNING);
-						}
-						beam_shading_factor *= soiling_factor;
-					}
+					poa_cache_record pc_now;
+					poa_cache_record &pc = (use_poa_cache || parallel_subarrays)
+						? poa_cache[(use_poa_cache ? irec : irec % nrec_block) * num_subarrays + nn] : pc_now;
+					if (!precomputed)
+						calc_subarray_poa(nn, wf, iyear, hour, jj, idx, true, pc, 0);
 
-					// Calculate total front irradiation after soiling added to shading
-					ipoa_front = ibeam + iskydiff + ignddiff;
-					ts_accum_poa_front_shaded_soiled += ipoa_front * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
-					
-					// Calculate rear-side irradiance for bifacial modules
-					if (Subarrays[0]->Module->isBifacial)
-					{
-						double slopeLength = Subarrays[nn]->selfShadingInputs.length * Subarrays[nn]->selfShadingInputs.nmody;
-						if (Subarrays[nn]->selfShadingInputs.mod_orient == 1) {
-							slopeLength = Subarrays[nn]->selfShadingInputs.width * Subarrays[nn]->selfShadingInputs.nmody;
-						}
-						irr.calc_rear_side(Subarrays[0]->Module->bifacialTransmissionFactor, Subarrays[0]->Module->bifaciality, Subarrays[0]->Module->groundClearanceHeight, slopeLength);
-						ipoa_rear = irr.get_poa_rear();
-						ipoa_rear_after_losses = ipoa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
-					}
-					ts_accum_poa_rear += ipoa_rear * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
+					// save the required irradiance inputs on array plane for the module output calculations.
+					Subarrays[nn]->poa.poaBeamFront = pc.poaBeamFront;
+					Subarrays[nn]->poa.poaDiffuseFront = pc.poaDiffuseFront;
+					Subarrays[nn]->poa.poaGroundFront = pc.poaGroundFront;
+					Subarrays[nn]->poa.poaRear = pc.poaRear;
+					Subarrays[nn]->poa.poaTotal = pc.poaTotal;
+					Subarrays[nn]->poa.angleOfIncidenceDegrees = pc.angleOfIncidenceDegrees;
+					Subarrays[nn]->poa.surfaceTiltDegrees = pc.surfaceTiltDegrees;
+					Subarrays[nn]->poa.surfaceAzimuthDegrees = pc.surfaceAzimuthDegrees;
+					Subarrays[nn]->poa.nonlinearDCShadingDerate = pc.nonlinearDCShadingDerate;
+					Subarrays[nn]->poa.sunUp = pc.sunUp;
+					Subarrays[nn]->poa.usePOAFromWF = pc.usePOAFromWF;
+					dc_shade_factor[nn] = pc.dcShadeFactor;
+
+					solazi = pc.solazi;
+					solzen = pc.solzen;
+					solalt = pc.solalt;
+					sunup = pc.sunup;
+					alb = pc.alb;
+					ipoa = pc.ipoa;
+					ipoa_front = pc.ipoa_front;
+					ipoa_rear_after_losses = pc.ipoa_rear_after_losses;
+
+					// sub-array contributions to the timestep totals
+					ts_accum_poa_front_nom += pc.accum_front_nom;
+					ts_accum_poa_front_beam_nom += pc.accum_front_beam_nom;
+					ts_accum_poa_front_shaded += pc.accum_front_shaded;
+					ts_accum_poa_front_shaded_soiled += pc.accum_front_shaded_soiled;
+					ts_accum_poa_rear += pc.accum_rear;
 					ts_accum_poa_rear_after_losses = ts_accum_poa_rear * (1 - Subarrays[nn]->rearIrradianceLossPercent);
+					ts_accum_poa_front_beam_eff += pc.accum_front_beam_eff;
+				}
 
-					if (iyear == 0) 
-					{
-						// save sub-array level outputs			
-						PVSystem->p_poaShadedFront[nn][idx] = (ssc_number_t)poashad;
-						PVSystem->p_poaShadedSoiledFront[nn][idx] = (ssc_number_t)ipoa_front;
-						PVSystem->p_poaBeamFront[nn][idx] = (ssc_number_t)ibeam;
-						PVSystem->p_poaDiffuseFront[nn][idx] = (ssc_number_t)(iskydiff + ignddiff);
-						PVSystem->p_poaRear[nn][idx] = (ssc_number_t)(ipoa_rear_after_losses);
-						PVSystem->p_beamShadingFactor[nn][idx] = (ssc_number_t)beam_shading_factor;
-						PVSystem->p_axisRotation[nn][idx] = (ssc_number_t)rot;
-						PVSystem->p_idealRotation[nn][idx] = (ssc_number_t)(rot - btd);
-						PVSystem->p_angleOfIncidence[nn][idx] = (ssc_number_t)aoi;
-						PVSystem->p_surfaceTilt[nn][idx] = (ssc_number_t)stilt;
-						PVSystem->p_surfaceAzimuth[nn][idx] = (ssc_number_t)sazi;
-						PVSystem->p_derateSoiling[nn][idx] = (ssc_number_t)soiling_factor;
-					}
-
-					// accumulate incident total radiation (W) in this timestep (all subarrays)
-					ts_accum_poa_front_beam_eff += ibeam * ref_area_m2 * modules_per_string * Subarrays[nn]->nStrings;
-
-					// save the required irradiance inputs on array plane for the module output calculations.
-					Subarrays[nn]->poa.poaBeamFront = ibeam;
-					Subarrays[nn]->poa.poaDiffuseFront = iskydiff;
-					Subarrays[nn]->poa.poaGroundFront = ignddiff;
-					Subarrays[nn]->poa.poaRear = ipoa_rear_after_losses;
-					Subarrays[nn]->poa.poaTotal = (radmode == Irradiance_IO::POA_R) ? ipoa :(ipoa_front + ipoa_rear_after_losses);
-					Subarrays[nn]->poa.angleOfIncidenceDegrees = aoi;
-					Subarrays[nn]->poa.sunUp = sunup;
-					Subarrays[nn]->poa.surfaceTiltDegrees = stilt;
-					Subarrays[nn]->poa.surfaceAzimuthDegrees = sazi;
+				// the sun position is the same for every subarray, so negative calculated beam is reported
+				// here once per timestep whether the subarrays were calculated in parallel or in series
+				if (iyear == 0 && radmode == Irradiance_IO::GH_DF)
+				{
+					ssc_number_t dn_calc = (ssc_number_t)((wf.gh - wf.df) / cos(solzen*3.1415926 / 180));
+					if (dn_calc < -1)
+						log(util::format("SAM calculated negative direct normal irradiance %lg W/m2 at time [y:%d m:%d d:%d h:%d], set to zero.",
+							dn_calc, wf.year, wf.month, wf.day, wf.hour), SSC_WARNING, (float)idx);
 				}
 
 				// compute dc power output of one module in each subarray
@@ -1628,35 +1896,51 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					double vmax = Subarrays[0]->Module->moduleModel->VocRef()*1.3; // maximum voltage
 					double vmin = 0.4 * vmax; // minimum voltage
 					const int NP = 100;
-					double V[NP], I[NP], P[NP];
+					double V[NP], I[NP], Isub[NP], P[NP];
 					double Pmax = 0;
-					// sweep voltage, calculating current for each subarray module, and adding
 					for (int i = 0; i < NP; i++)
 					{
 						V[i] = vmin + (vmax - vmin)*i / ((double)NP);
 						I[i] = 0;
-						for (int nn = 0; nn < 4; nn++)
+					}
+					// sweep voltage, calculating current for each subarray module, and adding
+					for (size_t nn = 0; nn < num_subarrays; nn++)
+					{
+						if (!Subarrays[nn]->enable || Subarrays[nn]->nStrings < 1) continue; // skip disabled subarrays
+						if (!Subarrays[nn]->poa.sunUp) continue; // no current
+
+						pvinput_t in(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
+							wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
+							solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
+							Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
+							((double)wf.hour) + wf.minute / 60.0,
+							radmode, Subarrays[nn]->poa.usePOAFromWF);
+
+						if (Subarrays[nn]->Module->cellTempModel->depends_on_voltage())
 						{
-							if (!Subarrays[nn]->enable || Subarrays[nn]->nStrings < 1) continue; // skip disabled subarrays
-
-							pvinput_t in(Subarrays[nn]->poa.poaBeamFront, Subarrays[nn]->poa.poaDiffuseFront, Subarrays[nn]->poa.poaGroundFront, Subarrays[nn]->poa.poaRear, Subarrays[nn]->poa.poaTotal,
-								wf.tdry, wf.tdew, wf.wspd, wf.wdir, wf.pres,
-								solzen, Subarrays[nn]->poa.angleOfIncidenceDegrees, hdr.elev,
-								Subarrays[nn]->poa.surfaceTiltDegrees, Subarrays[nn]->poa.surfaceAzimuthDegrees,
-								((double)wf.hour) + wf.minute / 60.0,
-								radmode, Subarrays[nn]->poa.usePOAFromWF);
-							pvoutput_t out(0, 0, 0, 0, 0, 0, 0, 0);
-							if (Subarrays[nn]->poa.sunUp)
+							for (int i = 0; i < NP; i++)
 							{
 								double tcell = wf.tdry;
 								// calculate cell temperature using selected temperature model
 								(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, V[i], tcell);
-								// calculate module power output using conversion model previously specified
-								(*Subarrays[nn]->Module->moduleModel)(in, tcell, V[i], out);
+								// calculate module current at this voltage using conversion model previously specified
+								Subarrays[nn]->Module->moduleModel->current_sweep(in, tcell, &V[i], 1, &Isub[i]);
 							}
-							I[i] += out.Current;
+						}
+						else
+						{
+							// cell temperature is the same at every voltage, so the whole sweep is evaluated at once
+							double tcell = wf.tdry;
+							(*Subarrays[nn]->Module->cellTempModel)(in, *Subarrays[nn]->Module->moduleModel, V[0], tcell);
+							Subarrays[nn]->Module->moduleModel->current_sweep(in, tcell, V, NP, Isub);
 						}
 
+						for (int i = 0; i < NP; i++)
+							I[i] += Isub[i];
+					}
+
+					for (int i = 0; i < NP; i++)
+					{
 						P[i] = V[i] * I[i];
 						if (P[i] > Pmax)
 						{
@@ -1803,7 +2087,7 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 						if (iyear == 0)
 						{
 							PVSystem->p_snowLoss[nn][idx] = (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->module.dcPowerW*smLoss);
-							PVSystem->p_snowLossTotal[idx] += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->module.dcPowerW*smLoss);
+							PVSystem->snowLossTotal.add(idx, (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->module.dcPowerW*smLoss));
 							PVSystem->p_snowCoverage[nn][idx] = (ssc_number_t)(Subarrays[nn]->snowModel.coverage);
 							annual_snow_loss += (ssc_number_t)(util::watt_to_kilowatt*Subarrays[nn]->module.dcPowerW*smLoss);
 						}
@@ -1830,7 +2114,7 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					}
 					// Sara 1/25/16 - shading database derate applied to dc only
 					// shading loss applied to beam if not from shading database
-					Subarrays[nn]->module.dcPowerW *= Subarrays[nn]->shadeCalculator.dc_shade_factor();
+					Subarrays[nn]->module.dcPowerW *= dc_shade_factor[nn];
 
 
 					dcpwr_net += Subarrays[nn]->module.dcPowerW *  (1 - Subarrays[nn]->dcLossTotalPercent);
@@ -1873,15 +2157,15 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					Irradiance->p_sunUpOverHorizon[idx] = (ssc_number_t)sunup;
 
 					// Sum of radiation power on each subarray for the current timestep [kW]
-					PVSystem->p_poaFrontNominalTotal[idx] = (ssc_number_t)(ts_accum_poa_front_nom * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontBeamNominalTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_nom * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontShadedTotal[idx] = (ssc_number_t)(ts_accum_poa_front_shaded * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontShadedSoiledTotal[idx] = (ssc_number_t)(ts_accum_poa_front_shaded_soiled * util::watt_to_kilowatt);
-					PVSystem->p_poaFrontTotal[idx] = (ssc_number_t)(ts_accum_poa_front_total * util::watt_to_kilowatt);
-					PVSystem->p_poaRearTotal[idx] = (ssc_number_t)(ts_accum_poa_rear_after_losses * util::watt_to_kilowatt);
-					PVSystem->p_poaTotalAllSubarrays[idx] = (ssc_number_t)(ts_accum_poa_total_eff * util::watt_to_kilowatt); 
-					PVSystem->p_poaFrontBeamTotal[idx] = (ssc_number_t)(ts_accum_poa_front_beam_eff * util::watt_to_kilowatt);
-					PVSystem->p_inverterMPPTLoss[idx] = (ssc_number_t)(mppt_clip_window * util::watt_to_kilowatt);
+					PVSystem->poaFrontNominalTotal.set(idx, (ssc_number_t)(ts_accum_poa_front_nom * util::watt_to_kilowatt));
+					PVSystem->poaFrontBeamNominalTotal.set(idx, (ssc_number_t)(ts_accum_poa_front_beam_nom * util::watt_to_kilowatt));
+					PVSystem->poaFrontShadedTotal.set(idx, (ssc_number_t)(ts_accum_poa_front_shaded * util::watt_to_kilowatt));
+					PVSystem->poaFrontShadedSoiledTotal.set(idx, (ssc_number_t)(ts_accum_poa_front_shaded_soiled * util::watt_to_kilowatt));
+					PVSystem->poaFrontTotal.set(idx, (ssc_number_t)(ts_accum_poa_front_total * util::watt_to_kilowatt));
+					PVSystem->poaRearTotal.set(idx, (ssc_number_t)(ts_accum_poa_rear_after_losses * util::watt_to_kilowatt));
+					PVSystem->poaTotalAllSubarrays.set(idx, (ssc_number_t)(ts_accum_poa_total_eff * util::watt_to_kilowatt));
+					PVSystem->poaFrontBeamTotal.set(idx, (ssc_number_t)(ts_accum_poa_front_beam_eff * util::watt_to_kilowatt));
+					PVSystem->inverterMPPTLoss.set(idx, (ssc_number_t)(mppt_clip_window * util::watt_to_kilowatt));
 				}
 				
 				PVSystem->p_inverterDCVoltage[idx] = (ssc_number_t)dc_string_voltage;
@@ -1988,10 +2272,10 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					annual_ac_loss_ond += sharedInverter->dcWiringLoss_ond_kW *  ts_hour; // (TR)
 
 					PVSystem->p_inverterEfficiency[idx] = (ssc_number_t)(sharedInverter->efficiencyAC);
-					PVSystem->p_inverterClipLoss[idx] = (ssc_number_t)(sharedInverter->powerClipLoss_kW);
-					PVSystem->p_inverterPowerConsumptionLoss[idx] = (ssc_number_t)(sharedInverter->powerConsumptionLoss_kW);
-					PVSystem->p_inverterNightTimeLoss[idx] = (ssc_number_t)(sharedInverter->powerNightLoss_kW);
-					PVSystem->p_inverterThermalLoss[idx] = (ssc_number_t)(sharedInverter->powerTempLoss_kW);
+					PVSystem->inverterClipLoss.set(idx, (ssc_number_t)(sharedInverter->powerClipLoss_kW));
+					PVSystem->inverterPowerConsumptionLoss.set(idx, (ssc_number_t)(sharedInverter->powerConsumptionLoss_kW));
+					PVSystem->inverterNightTimeLoss.set(idx, (ssc_number_t)(sharedInverter->powerNightLoss_kW));
+					PVSystem->inverterThermalLoss.set(idx, (ssc_number_t)(sharedInverter->powerTempLoss_kW));
 					PVSystem->p_acWiringLoss[idx] = (ssc_number_t)(ac_wiringloss);
 					PVSystem->p_transmissionLoss[idx] = (ssc_number_t)(transmissionloss);
 					PVSystem->p_inverterTotalLoss[idx] = (ssc_number_t)(sharedInverter->powerLossTotal_kW);
@@ -2118,8 +2402,8 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 		}
 			
 		// scale by ts_hour to convert power -> energy
-		accumulate_monthly_for_year( "dc_snow_loss", "monthly_snow_loss", ts_hour , step_per_hour );			
-		accumulate_annual_for_year( "dc_snow_loss", "annual_snow_loss", ts_hour, step_per_hour);
+		PVSystem->snowLossTotal.assignMonthly(this, "monthly_snow_loss", ts_hour);			
+		PVSystem->snowLossTotal.assignAnnual(this, "annual_snow_loss", ts_hour);
 	}
 		 
 	if (hour != 8760)
@@ -2130,34 +2414,34 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 	accumulate_monthly_for_year("gen", "monthly_energy", ts_hour, step_per_hour);
 		
 	// scale by ts_hour to convert power -> energy
-	accumulate_annual_for_year("gh", "annual_gh", ts_hour, step_per_hour);
+	Irradiance->weatherFileGHI.assignAnnual(this, "annual_gh", ts_hour);
 		
 	// scale by ts_hour to convert power -> energy
-	double annual_poa_nom = accumulate_annual_for_year("poa_nom", "annual_poa_nom", ts_hour, step_per_hour);
-	double annual_poa_beam_nom = accumulate_annual_for_year("poa_beam_nom", "annual_poa_beam_nom", ts_hour, step_per_hour);
-	double annual_poa_shaded = accumulate_annual_for_year("poa_shaded", "annual_poa_shaded", ts_hour, step_per_hour);
-	double annual_poa_shaded_soiled = accumulate_annual_for_year("poa_shaded_soiled", "annual_poa_shaded_soiled", ts_hour, step_per_hour);
-	double annual_poa_front = accumulate_annual_for_year("poa_front", "annual_poa_front", ts_hour, step_per_hour);
-	double annual_poa_rear = accumulate_annual_for_year("poa_rear", "annual_poa_rear", ts_hour, step_per_hour);
-	double annual_poa_eff = accumulate_annual_for_year("poa_eff", "annual_poa_eff", ts_hour, step_per_hour);
-	double annual_poa_beam_eff = accumulate_annual_for_year("poa_beam_eff", "annual_poa_beam_eff", ts_hour, step_per_hour);
+	double annual_poa_nom = PVSystem->poaFrontNominalTotal.assignAnnual(this, "annual_poa_nom", ts_hour);
+	double annual_poa_beam_nom = PVSystem->poaFrontBeamNominalTotal.assignAnnual(this, "annual_poa_beam_nom", ts_hour);
+	double annual_poa_shaded = PVSystem->poaFrontShadedTotal.assignAnnual(this, "annual_poa_shaded", ts_hour);
+	double annual_poa_shaded_soiled = PVSystem->poaFrontShadedSoiledTotal.assignAnnual(this, "annual_poa_shaded_soiled", ts_hour);
+	double annual_poa_front = PVSystem->poaFrontTotal.assignAnnual(this, "annual_poa_front", ts_hour);
+	double annual_poa_rear = PVSystem->poaRearTotal.assignAnnual(this, "annual_poa_rear", ts_hour);
+	double annual_poa_eff = PVSystem->poaTotalAllSubarrays.assignAnnual(this, "annual_poa_eff", ts_hour);
+	double annual_poa_beam_eff = PVSystem->poaFrontBeamTotal.assignAnnual(this, "annual_poa_beam_eff", ts_hour);
 		
-	accumulate_monthly_for_year( "poa_nom", "monthly_poa_nom", ts_hour, step_per_hour );
-	accumulate_monthly_for_year( "poa_beam_nom", "monthly_poa_beam_nom", ts_hour, step_per_hour );
-	accumulate_monthly_for_year("poa_front", "monthly_poa_front", ts_hour, step_per_hour);
-	accumulate_monthly_for_year( "poa_rear", "monthly_poa_rear", ts_hour, step_per_hour );
-	accumulate_monthly_for_year("poa_eff", "monthly_poa_eff", ts_hour, step_per_hour);
-	accumulate_monthly_for_year( "poa_beam_eff", "monthly_poa_beam_eff", ts_hour, step_per_hour );
+	PVSystem->poaFrontNominalTotal.assignMonthly(this, "monthly_poa_nom", ts_hour);
+	PVSystem->poaFrontBeamNominalTotal.assignMonthly(this, "monthly_poa_beam_nom", ts_hour);
+	PVSystem->poaFrontTotal.assignMonthly(this, "monthly_poa_front", ts_hour);
+	PVSystem->poaRearTotal.assignMonthly(this, "monthly_poa_rear", ts_hour);
+	PVSystem->poaTotalAllSubarrays.assignMonthly(this, "monthly_poa_eff", ts_hour);
+	PVSystem->poaFrontBeamTotal.assignMonthly(this, "monthly_poa_beam_eff", ts_hour);
 
 	// scale by ts_hour to convert power -> energy
 	double annual_dc_net = accumulate_annual_for_year("dc_net", "annual_dc_net", ts_hour, step_per_hour);
 	accumulate_annual_for_year("gen", "annual_ac_net", ts_hour, step_per_hour);
-	double annual_inv_cliploss = accumulate_annual_for_year("inv_cliploss", "annual_inv_cliploss", ts_hour, step_per_hour);
-	accumulate_annual_for_year("dc_invmppt_loss", "annual_dc_invmppt_loss", ts_hour, step_per_hour);
+	double annual_inv_cliploss = PVSystem->inverterClipLoss.assignAnnual(this, "annual_inv_cliploss", ts_hour);
+	PVSystem->inverterMPPTLoss.assignAnnual(this, "annual_dc_invmppt_loss", ts_hour);
 
-	double annual_inv_psoloss = accumulate_annual_for_year("inv_psoloss", "annual_inv_psoloss", ts_hour, step_per_hour );
-	double annual_inv_pntloss = accumulate_annual_for_year("inv_pntloss", "annual_inv_pntloss", ts_hour, step_per_hour);
-	double annual_inv_tdcloss = accumulate_annual_for_year("inv_tdcloss", "annual_inv_tdcloss", ts_hour, step_per_hour);
+	double annual_inv_psoloss = PVSystem->inverterPowerConsumptionLoss.assignAnnual(this, "annual_inv_psoloss", ts_hour);
+	double annual_inv_pntloss = PVSystem->inverterNightTimeLoss.assignAnnual(this, "annual_inv_pntloss", ts_hour);
+	double annual_inv_tdcloss = PVSystem->inverterThermalLoss.assignAnnual(this, "annual_inv_tdcloss", ts_hour);
 
 	double nom_rad = Subarrays[0]->Module->isConcentratingPV ? annual_poa_beam_nom : annual_poa_nom;
 	double inp_rad = Subarrays[0]->Module->isConcentratingPV ? annual_poa_beam_eff : annual_poa_eff;
@@ -386,12 +386,9 @@ public:
 
 		if ( is_assigned( "solar_resource_file" ) )
 		{
-			const char *file = as_string("solar_resource_file");
-			wdprov = std::unique_ptr<weather_data_provider>( new weatherfile( file ) );
-
-			weatherfile *wfile = dynamic_cast<weatherfile*>(wdprov.get());
-			if (!wfile->ok()) throw exec_error("pvwattsv5", wfile->message());
-			if( wfile->has_message() ) log( wfile->message(), SSC_WARNING);
+			wdprov = std::unique_ptr<weather_data_provider>( open_weather_resource( this, "solar_resource_file" ) );
+			if (!wdprov->ok()) throw exec_error("pvwattsv5", wdprov->message());
+			if( wdprov->has_message() ) log( wdprov->message(), SSC_WARNING);
 		}
 		else if ( is_assigned( "solar_resource_data" ) )
 		{
@@ -60,6 +60,7 @@ static var_info _cm_vtab_sco2_csp_ud_pc_tables[] = {
 	// Off Design UDPC Options
 	{ SSC_INPUT,  SSC_NUMBER,  "is_generate_udpc",     "1 = generate udpc tables, 0 = only calculate design point cyle", "",   "",    "",      "?=1",   "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "is_apply_default_htf_mins", "1 = yes (0.5 rc, 0.7 simple), 0 = no, only use 'm_dot_htf_ND_low'", "", "", "",   "?=1",   "",       "" },
+	{ SSC_INPUT,  SSC_NUMBER,  "udpc_n_threads",       "No. threads for the UDPC parametric runs (0=all cores)", "",           "",    "",      "?=1",   "INTEGER,MIN=0", "" },
 	// User Defined Power Cycle Table Inputs
 	{ SSC_INOUT,  SSC_NUMBER,  "T_htf_hot_low",        "Lower level of HTF hot temperature",					  "C",         "",    "",      "",     "",       "" },
 	{ SSC_INOUT,  SSC_NUMBER,  "T_htf_hot_high",	   "Upper level of HTF hot temperature",					  "C",		   "",    "",      "",     "",       "" },
@@ -193,7 +194,8 @@ public:
 			c_sco2_cycle.generate_ud_pc_tables(T_htf_hot_low, T_htf_hot_high, n_T_htf_hot_in,
 							T_amb_low, T_amb_high, n_T_amb_in,
 							m_dot_htf_ND_low, m_dot_htf_ND_high, n_m_dot_htf_ND_in,
-							T_htf_parametrics, T_amb_parametrics, m_dot_htf_ND_parametrics);
+							T_htf_parametrics, T_amb_parametrics, m_dot_htf_ND_parametrics,
+							as_integer("udpc_n_threads"));
 		}
 		catch( C_csp_exception &csp_exception )
 		{
@@ -101,6 +101,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
     { SSC_INPUT,        SSC_NUMBER,      "v_wind_max",           "Max. wind velocity",                                                "m/s",          "",            "heliostat",      "*",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "interp_nug",           "Interpolation nugget",                                              "-",            "",            "heliostat",      "?=0",                     "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "interp_beta",          "Interpolation beta coef.",                                          "-",            "",            "heliostat",      "?=1.99",                  "",                     "" },
+    { SSC_INPUT,        SSC_NUMBER,      "eta_map_interp",       "Field efficiency interpolation method 0=Gauss-Markov,1=Bicubic grid", "-",          "",            "heliostat",      "?=0",                     "INTEGER,MIN=0,MAX=1",  "" },
     { SSC_INPUT,        SSC_MATRIX,      "helio_aim_points",     "Heliostat aim point table",                                         "m",            "",            "heliostat",      "?",                       "",                     "" },
     { SSC_INPUT,        SSC_MATRIX,      "eta_map",              "Field efficiency array",                                            "-",            "",            "heliostat",      "?",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "eta_map_aod_format",   "Use 3D AOD format field efficiency array"                           "-",            "",            "heliostat",      "?=0",                     "",                     "" },
@@ -115,6 +116,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_INPUT,        SSC_NUMBER,      "cant_type",            "Heliostat cant method",                                             "",             "",            "heliostat",      "*",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "n_flux_days",          "No. days in flux map lookup",                                       "",             "",            "heliostat",      "?=8",                     "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "delta_flux_hrs",       "Hourly frequency in flux map lookup",                               "",             "",            "heliostat",      "?=1",                     "",                     "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "sp_n_threads",         "No. threads for SolarPILOT layout and flux simulations (0=all cores)", "",          "",            "heliostat",      "?=1",                     "INTEGER,MIN=0",        "" },
     { SSC_INPUT,        SSC_NUMBER,      "water_usage_per_wash", "Water usage per wash",                                              "L/m2_aper",    "",            "heliostat",      "*",                       "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "washing_frequency",    "Mirror washing frequency",                                          "none",         "",            "heliostat",      "*",                       "",                     "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "check_max_flux",       "Check max flux at design point",                                    "",             "",            "heliostat",      "?=0",                     "",                     "" },
@@ -305,6 +307,9 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
     { SSC_INPUT,        SSC_NUMBER,      "disp_reporting",       "Dispatch optimization reporting level",                             "-",            "",            "sys_ctrl_disp_opt", "?=-1",                    "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "disp_spec_presolve",   "Dispatch optimization presolve heuristic",                          "-",            "",            "sys_ctrl_disp_opt", "?=-1",                    "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "disp_spec_scaling",    "Dispatch optimization scaling heuristic",                           "-",            "",            "sys_ctrl_disp_opt", "?=-1",                    "",                      "" }, 
+    { SSC_INPUT,        SSC_NUMBER,      "disp_warm_start",      "Reuse the dispatch model between windows and warm-start the solver", "-",            "",            "sys_ctrl_disp_opt", "?=0",                     "BOOLEAN",               "" }, 
+    { SSC_INPUT,        SSC_NUMBER,      "disp_async",           "Solve the next dispatch window on a background thread",        "-",            "",            "sys_ctrl_disp_opt", "?=0",                     "BOOLEAN",               "" }, 
+    { SSC_INPUT,        SSC_NUMBER,      "disp_async_tes_tol",   "Allowed TES charge and cycle input deviation before the next window is solved again, fraction of capacity", "-", "",      "sys_ctrl_disp_opt", "?=0.05",                  "MIN=0",                 "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "disp_time_weighting",  "Dispatch optimization future time discounting factor",              "-",            "",            "sys_ctrl_disp_opt", "?=0.99",                    "",                      "" }, 
     { SSC_INPUT,        SSC_NUMBER,      "is_write_ampl_dat",    "Write AMPL data files for dispatch run",                            "-",            "",            "sys_ctrl_disp_opt", "?=0",                     "",                      "" }, 
     { SSC_INPUT,        SSC_STRING,      "ampl_data_dir",        "AMPL data file directory",                                          "-",            "",            "sys_ctrl_disp_opt", "?=''",                    "",                      "" }, 
@@ -541,6 +546,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
 	{ SSC_OUTPUT,       SSC_NUMBER,      "kwh_per_kw",           "First year kWh/kW",                                            "kWh/kW",       "",            "",               "*",                       "",           "" },
 	{ SSC_OUTPUT,       SSC_NUMBER,      "annual_total_water_use","Total Annual Water Usage: cycle + mirror washing",            "m3",         "",            "PostProcess",    "*",                         "",           "" },
 
+    { SSC_OUTPUT,       SSC_NUMBER,      "disp_spec_hit_rate",   "Fraction of dispatch windows solved ahead that were used",    "",            "",             "",               "*",                       "",           "" },
     { SSC_OUTPUT,       SSC_NUMBER,      "disp_objective_ann",  "Annual sum of dispatch objective func. value",                 "",            "",             "",               "*",                       "",           "" },
     { SSC_OUTPUT,       SSC_NUMBER,      "disp_iter_ann",       "Annual sum of dispatch solver iterations",                     "",            "",             "",               "*",                       "",           "" },
     { SSC_OUTPUT,       SSC_NUMBER,      "disp_presolve_nconstr_ann",  "Annual sum of dispatch problem constraint count",       "",            "",             "",               "*",                       "",           "" },
@@ -572,7 +578,7 @@ public:
 		// Weather reader
 		C_csp_weatherreader weather_reader;
 		if (is_assigned("solar_resource_file")){
-			weather_reader.m_weather_data_provider = make_shared<weatherfile>(as_string("solar_resource_file"));
+			weather_reader.m_weather_data_provider = std::shared_ptr<weather_data_provider>(open_weather_resource(this, "solar_resource_file"));
 			if (weather_reader.m_weather_data_provider->has_message()) log(weather_reader.m_weather_data_provider->message(), SSC_WARNING);
 		}
 		if (is_assigned("solar_resource_data")){
@@ -1392,6 +1398,7 @@ public:
 		heliostatfield.ms_params.m_v_wind_max = as_double("v_wind_max");			// N/A
 		heliostatfield.ms_params.m_n_flux_x = (int) as_double("n_flux_x");		// sp match
 		heliostatfield.ms_params.m_n_flux_y = (int) as_double("n_flux_y");		// sp match
+		heliostatfield.ms_params.m_interp_method = as_integer("eta_map_interp");
 
 		if (field_model_type != 3)
 		{
@@ -1577,6 +1584,9 @@ public:
 			tou.mc_dispatch_params.m_bb_type = as_integer("disp_spec_bb");
 			tou.mc_dispatch_params.m_disp_reporting = as_integer("disp_reporting");
 			tou.mc_dispatch_params.m_scaling_type = as_integer("disp_spec_scaling");
+			tou.mc_dispatch_params.m_is_warm_start = as_boolean("disp_warm_start");
+			tou.mc_dispatch_params.m_is_async = as_boolean("disp_async");
+			tou.mc_dispatch_params.m_async_tes_tol = as_double("disp_async_tes_tol");
 			tou.mc_dispatch_params.m_disp_time_weighting = as_double("disp_time_weighting");
             tou.mc_dispatch_params.m_rsu_cost = as_double("disp_rsu_cost");
             tou.mc_dispatch_params.m_csu_cost = as_double("disp_csu_cost");
@@ -2033,6 +2043,7 @@ public:
         accumulate_annual_for_year("disp_presolve_nconstr", "disp_presolve_nconstr_ann", sim_setup.m_report_step / 3600.0/ as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour);
         accumulate_annual_for_year("disp_presolve_nvar", "disp_presolve_nvar_ann", sim_setup.m_report_step / 3600.0/ as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour);
         accumulate_annual_for_year("disp_solve_time", "disp_solve_time_ann", sim_setup.m_report_step/3600. / as_double("disp_frequency"), steps_per_hour, 1, n_steps_fixed/steps_per_hour );
+        assign("disp_spec_hit_rate", (ssc_number_t)csp_solver.get_dispatch_speculation_hit_rate());
 
 		// Calculated Outputs
 			// First, sum power cycle water consumption timeseries outputs
@@ -94,6 +94,8 @@ static var_info _cm_vtab_trough_physical_csp_solver[] = {
     { SSC_INPUT,        SSC_NUMBER,      "T_loop_in_des",             "Design loop inlet temperature",                                                    "C",            "",               "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "T_loop_out",                "Target loop outlet temperature",                                                   "C",            "",               "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "Fluid",                     "Field HTF fluid ID number",                                                        "none",         "",               "solar_field",    "*",                       "",                      "" },
+    { SSC_INPUT,        SSC_NUMBER,      "htf_prop_tables",           "Use tabulated field HTF and air properties",                                       "0/1",          "",               "solar_field",    "?=0",                     "BOOLEAN",               "" },
+    { SSC_INPUT,        SSC_NUMBER,      "evac_receiver_memo",        "Reuse receiver heat loss solutions for repeated inputs",                           "0/1",          "",               "solar_field",    "?=0",                     "BOOLEAN",               "" },
     
 	{ SSC_INPUT,        SSC_NUMBER,      "T_fp",                      "Freeze protection temperature (heat trace activation temperature)",                "none",         "",               "solar_field",    "*",                       "",                      "" },
     { SSC_INPUT,        SSC_NUMBER,      "I_bn_des",                  "Solar irradiation at design",                                                      "C",            "",               "solar_field",    "*",                       "",                      "" },
@@ -412,7 +414,7 @@ public:
 
 		// ******************************************************************************
 		// Do some stuff to get site information from weather file; can probably maybe delete this after testing component classes...
-		std::shared_ptr<weatherfile> wfile = make_shared<weatherfile>(as_string("file_name"));
+		std::shared_ptr<weather_data_provider> wfile(open_weather_resource(this, "file_name"));
 		if( !wfile->ok() ) throw exec_error("Physical Trough", wfile->message());
 		if( wfile->has_message() ) log(wfile->message(), SSC_WARNING);
 
@@ -444,6 +446,8 @@ public:
 		c_trough.m_nLoops = as_integer("nLoops");					//[-] Number of loops in the field
 		c_trough.m_FieldConfig = as_integer("FieldConfig");			//[-] Number of subfield headers
 		c_trough.m_Fluid = as_integer("Fluid");						//[-] Field HTF fluid number
+		c_trough.m_use_htf_prop_tables = as_boolean("htf_prop_tables");	//[-] Use tabulated field HTF and air properties
+		c_trough.m_use_evac_memo = as_boolean("evac_receiver_memo");		//[-] Reuse receiver heat loss solutions for repeated inputs
 		c_trough.m_fthrok = as_integer("fthrok");					//[-] Flag to allow partial defocusing of the collectors
 		c_trough.m_fthrctrl = as_integer("fthrctrl");				//[-] Defocusing strategy
 		c_trough.m_accept_loc = as_integer("accept_loc");			//[-] In acceptance testing mode - temperature sensor location (1=hx,2=loop)
@@ -592,7 +596,17 @@ public:
 		c_trough.m_Tau_envelope = as_matrix("Tau_envelope");             //[-] Envelope transmittance
 		c_trough.m_EPSILON_4 = as_matrix("EPSILON_4");                   //[-] Inner glass envelope emissivities
 		c_trough.m_EPSILON_5 = as_matrix("EPSILON_5");                   //[-] Outer glass envelope emissivities
-		c_trough.m_GlazingIntact = (as_matrix("GlazingIntactIn")> 0);         //[-] Glazing intact (broken glass) flag {1=true, else=false}
+		util::matrix_t<double> glazing_intact_double = as_matrix("GlazingIntactIn");	//[-] Glazing intact (broken glass) flag {1=true, else=false}
+		int n_gl_row = (int)glazing_intact_double.nrows();
+		int n_gl_col = (int)glazing_intact_double.ncols();
+		c_trough.m_GlazingIntact.resize(n_gl_row, n_gl_col);
+		for (int i = 0; i < n_gl_row; i++)
+		{
+			for (int j = 0; j < n_gl_col; j++)
+			{
+				c_trough.m_GlazingIntact(i, j) = (glazing_intact_double(i, j) > 0);
+			}
+		}
 		c_trough.m_P_a = as_matrix("P_a");		                         //[torr] Annulus gas pressure				 
 		c_trough.m_AnnulusGas = as_matrix("AnnulusGas");		         //[-] Annulus gas type (1=air, 26=Ar, 27=H2)
 		c_trough.m_AbsorberMaterial = as_matrix("AbsorberMaterial");	 //[-] Absorber material type
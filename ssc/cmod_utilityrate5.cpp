@@ -49,6 +49,7 @@
 
 #include "core.h"
 #include <algorithm>
+#include <map>
 #include <sstream>
 
 
@@ -402,6 +403,37 @@ public:
 
 };
 
+// energy charge of one time step in ur_calc_timestep before rate escalation
+struct ur_ts_energy_charge
+{
+	bool surplus; // credit at the sell rate, otherwise charge at the buy rate
+	int row; // period of the month
+	int tier;
+	double amount; // energy times rate
+};
+
+// monthly energy and demand quantities of one year from the first pass of ur_calc and
+// ur_calc_timestep - do not depend on rate escalation so reused for years with the same
+// load and system scaling
+class ur_quantities
+{
+public:
+	ur_quantities() : valid(false) {}
+	bool valid;
+	std::vector<ur_month> month;
+	ssc_number_t monthly_cumulative_excess_energy[12];
+	ssc_number_t excess_kwhs_earned[12];
+	ssc_number_t excess_kwhs_applied[12];
+	// ur_calc_timestep only
+	std::vector<ur_ts_energy_charge> ts_energy_charge;
+	// ur_calc rollover notices without the leading "year:n", logged again for each year
+	std::vector<std::string> notices;
+};
+
+// keyed by (load scale, system scale)
+typedef std::pair<ssc_number_t, ssc_number_t> ur_quantities_key;
+typedef std::map<ur_quantities_key, ur_quantities> ur_quantities_map;
+
 class cm_utilityrate5 : public compute_module
 {
 private:
@@ -762,9 +794,31 @@ public:
 		bool timestep_reconciliation = (metering_option == 2 || metering_option == 3 || metering_option == 4);
 
 
+		bool lifetime_output = (as_integer("system_use_lifetime_output") == 1);
+
+		// the load does not change with the system output; lifetime system output changes every year
+		ur_quantities_map quantities_wo_sys, quantities_w_sys;
+
+		// quantities are only kept for scaling that recurs in a later year, and are dropped after the
+		// last year that uses them - with escalation or degradation every year has its own scaling
+		std::map<ur_quantities_key, int> years_left_wo_sys, years_left_w_sys;
+		for (i = 0; i < nyears; i++)
+		{
+			years_left_wo_sys[ur_quantities_key(load_scale[i], (ssc_number_t)1.0)]++;
+			if (!lifetime_output)
+				years_left_w_sys[ur_quantities_key(load_scale[i], sys_scale[i])]++;
+		}
+
 		idx = 0;
 		for (i=0;i<nyears;i++)
 		{
+			ur_quantities_key key_wo_sys(load_scale[i], (ssc_number_t)1.0);
+			ur_quantities_key key_w_sys(load_scale[i], sys_scale[i]);
+			ur_quantities *q_wo_sys = (years_left_wo_sys[key_wo_sys] > 1 || quantities_wo_sys.count(key_wo_sys) > 0)
+				? &quantities_wo_sys[key_wo_sys] : 0;
+			ur_quantities *q_w_sys = (!lifetime_output && (years_left_w_sys[key_w_sys] > 1 || quantities_w_sys.count(key_w_sys) > 0))
+				? &quantities_w_sys[key_w_sys] : 0;
+
 			for (j = 0; j<m_num_rec_yearly; j++)
 			{
 				/* for future implementation for lifetime loads
@@ -794,7 +848,7 @@ public:
 
 
 				// update e_sys per year if lifetime output
-				if ((as_integer("system_use_lifetime_output") == 1) && ( idx < nrec_gen ))
+				if (lifetime_output && ( idx < nrec_gen ))
 				{
 //					e_sys[j] = p_sys[j] = 0.0;
 //					ts_power = (idx < nrec_gen) ? pgen[idx] : 0;
@@ -835,7 +889,7 @@ public:
 					&monthly_excess_dollars_applied[0],
 					&monthly_excess_kwhs_earned[0],
 					&monthly_excess_kwhs_applied[0],
-					&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i]);
+					&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], true, true, false, q_wo_sys);
 			}
 			else
 			{
@@ -849,7 +903,7 @@ public:
 					&monthly_excess_dollars_applied[0],
 					&monthly_excess_kwhs_earned[0],
 					&monthly_excess_kwhs_applied[0],
-					&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1);
+					&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1, true, true, false, q_wo_sys);
 			}
 	
 			for (j = 0; j < 12; j++)
@@ -984,7 +1038,7 @@ public:
 						&monthly_excess_dollars_applied[0],
 						&monthly_excess_kwhs_earned[0],
 						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], false, false, true);
+						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], false, false, true, q_w_sys);
 				}
 				else
 				{
@@ -999,7 +1053,7 @@ public:
 						&monthly_excess_dollars_applied[0],
 						&monthly_excess_kwhs_earned[0],
 						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i]);
+						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], true, true, false, q_w_sys);
 				}
 			}
 			else // monthly reconciliation per 2015.6.30 release
@@ -1018,7 +1072,7 @@ public:
 						&monthly_excess_dollars_applied[0],
 						&monthly_excess_kwhs_earned[0],
 						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1, false, false, true);
+						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1, false, false, true, q_w_sys);
 				}
 				else
 				{
@@ -1034,7 +1088,7 @@ public:
 						&monthly_excess_dollars_applied[0],
 						&monthly_excess_kwhs_earned[0],
 						&monthly_excess_kwhs_applied[0],
-						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1);
+						&dc_hourly_peak[0], &monthly_cumulative_excess_energy[0], &monthly_cumulative_excess_dollars[0], &monthly_bill[0], rate_scale[i], i + 1, true, true, false, q_w_sys);
 				}
 			}
 			if (two_meter)
@@ -1319,7 +1373,10 @@ public:
 				ch_w_sys_minimum[i + 1] += monthly_minimum_charges[j];
 			}
 
-
+			if (--years_left_wo_sys[key_wo_sys] == 0)
+				quantities_wo_sys.erase(key_wo_sys);
+			if (!lifetime_output && --years_left_w_sys[key_w_sys] == 0)
+				quantities_w_sys.erase(key_w_sys);
 		}
 
 		assign("elec_cost_with_system_year1", annual_elec_cost_w_sys[1]);
@@ -1891,7 +1948,7 @@ public:
 		ssc_number_t excess_kwhs_applied[12],
 		ssc_number_t *dc_hourly_peak, ssc_number_t monthly_cumulative_excess_energy[12], 
 		ssc_number_t monthly_cumulative_excess_dollars[12], ssc_number_t monthly_bill[12], 
-		ssc_number_t rate_esc, size_t year, bool include_fixed=true, bool include_min=true, bool gen_only=false) 
+		ssc_number_t rate_esc, size_t year, bool include_fixed=true, bool include_min=true, bool gen_only=false, ur_quantities *quantities=0) 
 		throw(general_error)
 	{
 		int i;
@@ -1938,392 +1995,404 @@ public:
 		// calculate the monthly net energy and monthly hours
 		int m, d, h, s, period, tier;
 		int c = 0;
-		for (m = 0; m < (int)m_month.size(); m++)
+		// energy and demand quantities are the same for years with the same load and system scaling
+		if (quantities != 0 && quantities->valid)
 		{
-			m_month[m].energy_net = 0;
-			m_month[m].hours_per_month = 0;
-			m_month[m].dc_flat_peak = 0;
-			m_month[m].dc_flat_peak_hour = 0;
-			for (d = 0; d < util::nday[m]; d++)
+			ur_restore_quantities(*quantities, monthly_cumulative_excess_energy, excess_kwhs_earned, excess_kwhs_applied, dc_enabled);
+			for (size_t i_notice = 0; i_notice < quantities->notices.size(); i_notice++)
+				ur_log_rollover_notice(quantities->notices[i_notice], year, 0);
+		}
+		else
+		{
+			for (m = 0; m < (int)m_month.size(); m++)
 			{
-				for (h = 0; h < 24; h++)
+				m_month[m].energy_net = 0;
+				m_month[m].hours_per_month = 0;
+				m_month[m].dc_flat_peak = 0;
+				m_month[m].dc_flat_peak_hour = 0;
+				for (d = 0; d < util::nday[m]; d++)
 				{
-					for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+					for (h = 0; h < 24; h++)
 					{
-						// net energy use per month
-						m_month[m].energy_net += e_in[c]; // -load and +gen
-						// hours per period per month
-						m_month[m].hours_per_month++;
-						// peak
-						if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_flat_peak)
+						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
-							m_month[m].dc_flat_peak = -p_in[c];
-							m_month[m].dc_flat_peak_hour = c;
+							// net energy use per month
+							m_month[m].energy_net += e_in[c]; // -load and +gen
+							// hours per period per month
+							m_month[m].hours_per_month++;
+							// peak
+							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_flat_peak)
+							{
+								m_month[m].dc_flat_peak = -p_in[c];
+								m_month[m].dc_flat_peak_hour = c;
+							}
+							c++;
 						}
-						c++;
 					}
 				}
 			}
-		}
 
-		// monthly cumulative excess energy (positive = excess energy, negative = excess load)
-		if (enable_nm && !excess_monthly_dollars)
-		{
-			ssc_number_t prev_value = 0;
-			for (m = 0; m < 12; m++)
+			// monthly cumulative excess energy (positive = excess energy, negative = excess load)
+			if (enable_nm && !excess_monthly_dollars)
 			{
-				prev_value = (m > 0) ? monthly_cumulative_excess_energy[m - 1] : 0;
-				monthly_cumulative_excess_energy[m] = ((prev_value + m_month[m].energy_net) > 0) ? (prev_value + m_month[m].energy_net) : 0;
+				ssc_number_t prev_value = 0;
+				for (m = 0; m < 12; m++)
+				{
+					prev_value = (m > 0) ? monthly_cumulative_excess_energy[m - 1] : 0;
+					monthly_cumulative_excess_energy[m] = ((prev_value + m_month[m].energy_net) > 0) ? (prev_value + m_month[m].energy_net) : 0;
+				}
 			}
-		}
 
-		// excess earned
-		for (m = 0; m < 12; m++)
-		{
-			if (m_month[m].energy_net > 0)
-				excess_kwhs_earned[m] = m_month[m].energy_net;
-		}
+			// excess earned
+			for (m = 0; m < 12; m++)
+			{
+				if (m_month[m].energy_net > 0)
+					excess_kwhs_earned[m] = m_month[m].energy_net;
+			}
 
 	
-		// adjust net energy if net metering with monthly rollover
-		if (enable_nm && !excess_monthly_dollars)
-		{
-			for (m = 1; m < (int)m_month.size(); m++)
+			// adjust net energy if net metering with monthly rollover
+			if (enable_nm && !excess_monthly_dollars)
 			{
-				if (m_month[m].energy_net < 0)
+				for (m = 1; m < (int)m_month.size(); m++)
 				{
-					m_month[m].energy_net += monthly_cumulative_excess_energy[m - 1];
-					excess_kwhs_applied[m] = monthly_cumulative_excess_energy[m - 1];
+					if (m_month[m].energy_net < 0)
+					{
+						m_month[m].energy_net += monthly_cumulative_excess_energy[m - 1];
+						excess_kwhs_applied[m] = monthly_cumulative_excess_energy[m - 1];
+					}
 				}
 			}
-		}
 
 
-		if (ec_enabled)
-		{
-			// calculate the monthly net energy per tier and period based on units
-			c = 0;
-			for (m = 0; m < (int)m_month.size(); m++)
+			if (ec_enabled)
 			{
-				int start_tier = 0;
-				int end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
-				int num_periods = (int)m_month[m].ec_tou_ub_init.nrows();
-				int num_tiers = end_tier - start_tier + 1;
-
-				if (!gen_only) // added for two meter no load scenarios to use load tier sizing
+				// calculate the monthly net energy per tier and period based on units
+				c = 0;
+				for (m = 0; m < (int)m_month.size(); m++)
 				{
-					//start_tier = 0;
-					end_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
-					//int num_periods = (int)m_month[m].ec_tou_ub_init.nrows();
-					num_tiers = end_tier - start_tier + 1;
-
-					// kWh/kW (kWh/kW daily handled in Setup)
-					// 1. find kWh/kW tier
-					// 2. set min tier and max tier based on next item in ec_tou matrix
-					// 3. resize use and chart based on number of tiers in kWh/kW section
-					// 4. assumption is that all periods in same month have same tier breakdown
-					// 5. assumption is that tier numbering is correct for the kWh/kW breakdown
-					// That is, first tier must be kWh/kW
-					if ((m_month[m].ec_tou_units.ncols()>0 && m_month[m].ec_tou_units.nrows() > 0)
-						&& ((m_month[m].ec_tou_units.at(0, 0) == 1) || (m_month[m].ec_tou_units.at(0, 0) == 3)))
+					int start_tier = 0;
+					int end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
+					int num_periods = (int)m_month[m].ec_tou_ub_init.nrows();
+					int num_tiers = end_tier - start_tier + 1;
+
+					if (!gen_only) // added for two meter no load scenarios to use load tier sizing
 					{
-						// monthly total energy / monthly peak to determine which kWh/kW tier
-						double mon_kWhperkW = -m_month[m].energy_net; // load negative
-						if (m_month[m].dc_flat_peak != 0)
-							mon_kWhperkW /= m_month[m].dc_flat_peak;
-						// find correct start and end tier based on kWhperkW band
-						start_tier = 1;
-						bool found = false;
-						for (size_t i_tier = 0; i_tier < m_month[m].ec_tou_units.ncols(); i_tier++)
+						//start_tier = 0;
+						end_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
+						//int num_periods = (int)m_month[m].ec_tou_ub_init.nrows();
+						num_tiers = end_tier - start_tier + 1;
+
+						// kWh/kW (kWh/kW daily handled in Setup)
+						// 1. find kWh/kW tier
+						// 2. set min tier and max tier based on next item in ec_tou matrix
+						// 3. resize use and chart based on number of tiers in kWh/kW section
+						// 4. assumption is that all periods in same month have same tier breakdown
+						// 5. assumption is that tier numbering is correct for the kWh/kW breakdown
+						// That is, first tier must be kWh/kW
+						if ((m_month[m].ec_tou_units.ncols()>0 && m_month[m].ec_tou_units.nrows() > 0)
+							&& ((m_month[m].ec_tou_units.at(0, 0) == 1) || (m_month[m].ec_tou_units.at(0, 0) == 3)))
 						{
-							int units = (int)m_month[m].ec_tou_units.at(0, i_tier);
-							if ((units == 1) || (units == 3))
+							// monthly total energy / monthly peak to determine which kWh/kW tier
+							double mon_kWhperkW = -m_month[m].energy_net; // load negative
+							if (m_month[m].dc_flat_peak != 0)
+								mon_kWhperkW /= m_month[m].dc_flat_peak;
+							// find correct start and end tier based on kWhperkW band
+							start_tier = 1;
+							bool found = false;
+							for (size_t i_tier = 0; i_tier < m_month[m].ec_tou_units.ncols(); i_tier++)
 							{
-								if (found)
+								int units = (int)m_month[m].ec_tou_units.at(0, i_tier);
+								if ((units == 1) || (units == 3))
 								{
-									end_tier = (int)i_tier - 1;
-									break;
-								}
-								else if (mon_kWhperkW < m_month[m].ec_tou_ub_init.at(0, i_tier))
-								{
-									start_tier = (int)i_tier + 1;
-									found = true;
+									if (found)
+									{
+										end_tier = (int)i_tier - 1;
+										break;
+									}
+									else if (mon_kWhperkW < m_month[m].ec_tou_ub_init.at(0, i_tier))
+									{
+										start_tier = (int)i_tier + 1;
+										found = true;
+									}
 								}
 							}
-						}
-						// last tier since no max specified in rate
-						if (!found) start_tier = end_tier;
-						if (start_tier >= (int)m_month[m].ec_tou_ub_init.ncols())
-							start_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
-						if (end_tier < start_tier)
-							end_tier = start_tier;
-						num_tiers = end_tier - start_tier + 1;
-						// resize everytime to handle load and energy changes
-						// resize sr, br and ub for use in energy charge calculations below
-						util::matrix_t<float> br(num_periods, num_tiers);
-						util::matrix_t<float> sr(num_periods, num_tiers);
-						util::matrix_t<float> ub(num_periods, num_tiers);
-						// assign appropriate values.
-						for (period = 0; period < num_periods; period++)
-						{
-							for (tier = 0; tier < num_tiers; tier++)
+							// last tier since no max specified in rate
+							if (!found) start_tier = end_tier;
+							if (start_tier >= (int)m_month[m].ec_tou_ub_init.ncols())
+								start_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
+							if (end_tier < start_tier)
+								end_tier = start_tier;
+							num_tiers = end_tier - start_tier + 1;
+							// resize everytime to handle load and energy changes
+							// resize sr, br and ub for use in energy charge calculations below
+							util::matrix_t<float> br(num_periods, num_tiers);
+							util::matrix_t<float> sr(num_periods, num_tiers);
+							util::matrix_t<float> ub(num_periods, num_tiers);
+							// assign appropriate values.
+							for (period = 0; period < num_periods; period++)
 							{
-								br.at(period, tier) = m_month[m].ec_tou_br_init.at(period, start_tier + tier);
-								sr.at(period, tier) = m_month[m].ec_tou_sr_init.at(period, start_tier + tier);
-								ub.at(period, tier) = m_month[m].ec_tou_ub_init.at(period, start_tier + tier);
-								// update for correct tier number column headings
-								m_month[m].ec_periods_tiers[period][tier] = start_tier + m_ec_periods_tiers_init[period][tier];
+								for (tier = 0; tier < num_tiers; tier++)
+								{
+									br.at(period, tier) = m_month[m].ec_tou_br_init.at(period, start_tier + tier);
+									sr.at(period, tier) = m_month[m].ec_tou_sr_init.at(period, start_tier + tier);
+									ub.at(period, tier) = m_month[m].ec_tou_ub_init.at(period, start_tier + tier);
+									// update for correct tier number column headings
+									m_month[m].ec_periods_tiers[period][tier] = start_tier + m_ec_periods_tiers_init[period][tier];
+								}
 							}
+
+							m_month[m].ec_tou_br = br;
+							m_month[m].ec_tou_sr = sr;
+							m_month[m].ec_tou_ub = ub;
 						}
 
-						m_month[m].ec_tou_br = br;
-						m_month[m].ec_tou_sr = sr;
-						m_month[m].ec_tou_ub = ub;
+						// reset now resized - if necessary
 					}
+					start_tier = 0;
+					end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
 
-					// reset now resized - if necessary
-				}
-				start_tier = 0;
-				end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
+					m_month[m].ec_energy_use.resize_fill(num_periods, num_tiers, 0);
+					m_month[m].ec_energy_surplus.resize_fill(num_periods, num_tiers, 0);
+					m_month[m].ec_charge.resize_fill(num_periods, num_tiers, 0);
 
-				m_month[m].ec_energy_use.resize_fill(num_periods, num_tiers, 0);
-				m_month[m].ec_energy_surplus.resize_fill(num_periods, num_tiers, 0);
-				m_month[m].ec_charge.resize_fill(num_periods, num_tiers, 0);
 
 
+					// accumulate energy per period - place all in tier 0 initially and then
+					// break up according to tier boundaries and number of periods
 
-				// accumulate energy per period - place all in tier 0 initially and then
-				// break up according to tier boundaries and number of periods
-
-				/*  hour by hour accumulation - changed to monthly per meeting with Paul 2/29/16 */
-				// monthly accumulation of energy
-				ssc_number_t mon_e_net = 0;
-				if (m>0 && enable_nm && !excess_monthly_dollars)
-				{
-					mon_e_net = monthly_cumulative_excess_energy[m - 1]; // rollover
-				}
+					/*  hour by hour accumulation - changed to monthly per meeting with Paul 2/29/16 */
+					// monthly accumulation of energy
+					ssc_number_t mon_e_net = 0;
+					if (m>0 && enable_nm && !excess_monthly_dollars)
+					{
+						mon_e_net = monthly_cumulative_excess_energy[m - 1]; // rollover
+					}
 
-				for (d = 0; d < util::nday[m]; d++)
-				{
-					for (h = 0; h < 24; h++)
+					for (d = 0; d < util::nday[m]; d++)
 					{
-						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+						for (h = 0; h < 24; h++)
 						{
-							mon_e_net += e_in[c];
-							int toup = m_ec_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
-							if (per_num == m_month[m].ec_periods.end())
+							for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 							{
-								std::ostringstream ss;
-								ss << "Energy rate TOU Period " << toup << " not found for Month " << util::schedule_int_to_month(m) << ".";
-								throw exec_error("utilityrate5", ss.str());
+								mon_e_net += e_in[c];
+								int toup = m_ec_tou_sched[c];
+								std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
+								if (per_num == m_month[m].ec_periods.end())
+								{
+									std::ostringstream ss;
+									ss << "Energy rate TOU Period " << toup << " not found for Month " << util::schedule_int_to_month(m) << ".";
+									throw exec_error("utilityrate5", ss.str());
+								}
+								int row = (int)(per_num - m_month[m].ec_periods.begin());
+								// place all in tier 0 initially and then update appropriately
+								// net energy per period per month
+								m_month[m].ec_energy_use(row, 0) += e_in[c];
+								c++;
 							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
-							// place all in tier 0 initially and then update appropriately
-							// net energy per period per month
-							m_month[m].ec_energy_use(row, 0) += e_in[c];
-							c++;
 						}
 					}
-				}
 
-				/*
-				// rollover energy from correct period - based on matching period number
-				if (m > 0 && enable_nm && !excess_monthly_kwhs)
-				{
-					// check for surplus in previous month for same period
-					for (size_t ir = 0; ir < m_month[m - 1].ec_energy_surplus.nrows(); ir++)
+					/*
+					// rollover energy from correct period - based on matching period number
+					if (m > 0 && enable_nm && !excess_monthly_kwhs)
 					{
-						if (m_month[m - 1].ec_energy_surplus.at(ir, 0) > 0) // surplus - check period
+						// check for surplus in previous month for same period
+						for (size_t ir = 0; ir < m_month[m - 1].ec_energy_surplus.nrows(); ir++)
 						{
-							int toup = m_month[m - 1].ec_periods[ir]; // number of rows of previous month
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
-							if (per_num == m_month[m].ec_periods.end())
+							if (m_month[m - 1].ec_energy_surplus.at(ir, 0) > 0) // surplus - check period
 							{
-								std::ostringstream ss;
-								ss << "utilityrate5: energy charge rollover for period " << toup << " not found for month " << m;
-								log(ss.str(), SSC_NOTICE);
-							}
-							else
-							{
-								ssc_number_t extra = 0;
-								int row = (int)(per_num - m_month[m].ec_periods.begin());
-								for (size_t ic = 0; ic < m_month[m - 1].ec_energy_surplus.ncols(); ic++)
-									extra += m_month[m - 1].ec_energy_surplus.at(ir, ic);
+								int toup = m_month[m - 1].ec_periods[ir]; // number of rows of previous month
+								std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
+								if (per_num == m_month[m].ec_periods.end())
+								{
+									std::ostringstream ss;
+									ss << "utilityrate5: energy charge rollover for period " << toup << " not found for month " << m;
+									log(ss.str(), SSC_NOTICE);
+								}
+								else
+								{
+									ssc_number_t extra = 0;
+									int row = (int)(per_num - m_month[m].ec_periods.begin());
+									for (size_t ic = 0; ic < m_month[m - 1].ec_energy_surplus.ncols(); ic++)
+										extra += m_month[m - 1].ec_energy_surplus.at(ir, ic);
 
-								m_month[m].ec_energy_use(row, 0) += extra;
+									m_month[m].ec_energy_use(row, 0) += extra;
+								}
 							}
 						}
 					}
-				}
-				*/
+					*/
 
-				// rollover energy from correct period - matching time of day - currently four values considered 12a, 6a, 12p, 6p set in loop above.
-				if (m > 0 && enable_nm && !excess_monthly_dollars)
-				{
-					// check for surplus in previous month for same period
-					for (size_t ir = 0; ir < m_month[m - 1].ec_energy_surplus.nrows(); ir++)
+					// rollover energy from correct period - matching time of day - currently four values considered 12a, 6a, 12p, 6p set in loop above.
+					if (m > 0 && enable_nm && !excess_monthly_dollars)
 					{
-						if (m_month[m - 1].ec_energy_surplus.at(ir, 0) > 0) // surplus - check period
+						// check for surplus in previous month for same period
+						for (size_t ir = 0; ir < m_month[m - 1].ec_energy_surplus.nrows(); ir++)
 						{
-							int toup_source = m_month[m - 1].ec_periods[ir]; // number of rows of previous month - and period with surplus
-							// find source period in rollover map for previous month
-							std::vector<int>::iterator source_per_num = std::find(m_month[m-1].ec_rollover_periods.begin(), m_month[m-1].ec_rollover_periods.end(), toup_source);
-							if (source_per_num == m_month[m-1].ec_rollover_periods.end())
+							if (m_month[m - 1].ec_energy_surplus.at(ir, 0) > 0) // surplus - check period
 							{
-								std::ostringstream ss;
-								ss << "year:" << year << " utilityrate5: Unable to determine period for energy charge rollover: Period " << toup_source << " does not exist for 12 am, 6 am, 12 pm or 6 pm in the previous month, which is Month " << util::schedule_int_to_month(m-1) << ".";
-								log(ss.str(), SSC_NOTICE);
-							}
-							else
-							{
-								// find corresponding target period for same time of day
-								ssc_number_t extra = 0;
-								int rollover_index = (int)(source_per_num - m_month[m-1].ec_rollover_periods.begin());
-								if (rollover_index < (int)m_month[m].ec_rollover_periods.size())
+								int toup_source = m_month[m - 1].ec_periods[ir]; // number of rows of previous month - and period with surplus
+								// find source period in rollover map for previous month
+								std::vector<int>::iterator source_per_num = std::find(m_month[m-1].ec_rollover_periods.begin(), m_month[m-1].ec_rollover_periods.end(), toup_source);
+								if (source_per_num == m_month[m-1].ec_rollover_periods.end())
+								{
+									std::ostringstream ss;
+									ss << " utilityrate5: Unable to determine period for energy charge rollover: Period " << toup_source << " does not exist for 12 am, 6 am, 12 pm or 6 pm in the previous month, which is Month " << util::schedule_int_to_month(m-1) << ".";
+									ur_log_rollover_notice(ss.str(), year, quantities);
+								}
+								else
 								{
-									int toup_target = m_month[m].ec_rollover_periods[rollover_index];
-									std::vector<int>::iterator target_per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup_target);
-									if (target_per_num == m_month[m].ec_periods.end())
+									// find corresponding target period for same time of day
+									ssc_number_t extra = 0;
+									int rollover_index = (int)(source_per_num - m_month[m-1].ec_rollover_periods.begin());
+									if (rollover_index < (int)m_month[m].ec_rollover_periods.size())
 									{
-										std::ostringstream ss;
-										ss << "year:" << year << "utilityrate5: Unable to determine period for energy charge rollover: Period " << toup_target << " does not exist for 12 am, 6 am, 12 pm or 6 pm in the current month, which is " << util::schedule_int_to_month(m) << ".";
-										log(ss.str(), SSC_NOTICE);
-									}
-									int target_row = (int)(target_per_num - m_month[m].ec_periods.begin());
-									for (size_t ic = 0; ic < m_month[m - 1].ec_energy_surplus.ncols(); ic++)
-										extra += m_month[m - 1].ec_energy_surplus.at(ir, ic);
+										int toup_target = m_month[m].ec_rollover_periods[rollover_index];
+										std::vector<int>::iterator target_per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup_target);
+										if (target_per_num == m_month[m].ec_periods.end())
+										{
+											std::ostringstream ss;
+											ss << "utilityrate5: Unable to determine period for energy charge rollover: Period " << toup_target << " does not exist for 12 am, 6 am, 12 pm or 6 pm in the current month, which is " << util::schedule_int_to_month(m) << ".";
+											ur_log_rollover_notice(ss.str(), year, quantities);
+										}
+										int target_row = (int)(target_per_num - m_month[m].ec_periods.begin());
+										for (size_t ic = 0; ic < m_month[m - 1].ec_energy_surplus.ncols(); ic++)
+											extra += m_month[m - 1].ec_energy_surplus.at(ir, ic);
 
-									m_month[m].ec_energy_use(target_row, 0) += extra;
+										m_month[m].ec_energy_use(target_row, 0) += extra;
+									}
 								}
 							}
 						}
 					}
-				}
 
-				// set surplus or use
-				for (size_t ir = 0; ir < m_month[m].ec_energy_use.nrows(); ir++)
-				{
-					if (m_month[m].ec_energy_use.at(ir, 0) > 0)
+					// set surplus or use
+					for (size_t ir = 0; ir < m_month[m].ec_energy_use.nrows(); ir++)
 					{
-						m_month[m].ec_energy_surplus.at(ir, 0) = m_month[m].ec_energy_use.at(ir, 0);
-						m_month[m].ec_energy_use.at(ir, 0) = 0;
+						if (m_month[m].ec_energy_use.at(ir, 0) > 0)
+						{
+							m_month[m].ec_energy_surplus.at(ir, 0) = m_month[m].ec_energy_use.at(ir, 0);
+							m_month[m].ec_energy_use.at(ir, 0) = 0;
+						}
+						else
+							m_month[m].ec_energy_use.at(ir, 0) = -m_month[m].ec_energy_use.at(ir, 0);
 					}
-					else
-						m_month[m].ec_energy_use.at(ir, 0) = -m_month[m].ec_energy_use.at(ir, 0);
-				}
 
-				// now ditribute across tier boundaries - upper bounds equally across periods
-				// 3/5/16 prorate based on total net per period / total net
-				// look at total net distributed among tiers
+					// now ditribute across tier boundaries - upper bounds equally across periods
+					// 3/5/16 prorate based on total net per period / total net
+					// look at total net distributed among tiers
 
-				ssc_number_t num_per = (ssc_number_t)m_month[m].ec_energy_use.nrows();
-				ssc_number_t tot_energy = 0;
-				for (size_t ir = 0; ir < num_per; ir++)
-					tot_energy += m_month[m].ec_energy_use.at(ir, 0);
-				if (tot_energy > 0)
-				{
+					ssc_number_t num_per = (ssc_number_t)m_month[m].ec_energy_use.nrows();
+					ssc_number_t tot_energy = 0;
 					for (size_t ir = 0; ir < num_per; ir++)
+						tot_energy += m_month[m].ec_energy_use.at(ir, 0);
+					if (tot_energy > 0)
 					{
-						bool done = false;
-						ssc_number_t per_energy = m_month[m].ec_energy_use.at(ir, 0);
-						for (size_t ic = 0; ic < m_month[m].ec_tou_ub.ncols() && !done; ic++)
+						for (size_t ir = 0; ir < num_per; ir++)
 						{
-							ssc_number_t ub_tier = m_month[m].ec_tou_ub.at(ir, ic);
-							if (per_energy > 0)
+							bool done = false;
+							ssc_number_t per_energy = m_month[m].ec_energy_use.at(ir, 0);
+							for (size_t ic = 0; ic < m_month[m].ec_tou_ub.ncols() && !done; ic++)
 							{
-								if (tot_energy > ub_tier)
+								ssc_number_t ub_tier = m_month[m].ec_tou_ub.at(ir, ic);
+								if (per_energy > 0)
 								{
-									m_month[m].ec_energy_use.at(ir, ic) = (per_energy/tot_energy) * ub_tier;
-									if (ic > 0)
-										m_month[m].ec_energy_use.at(ir, ic) -= (per_energy / tot_energy) * m_month[m].ec_tou_ub.at(ir, ic - 1);
-								}
-								else
-								{
-									m_month[m].ec_energy_use.at(ir, ic) = (per_energy / tot_energy) * tot_energy;
-									if (ic > 0)
-										m_month[m].ec_energy_use.at(ir, ic) -= (per_energy / tot_energy)* m_month[m].ec_tou_ub.at(ir, ic - 1);
-									done=true;
+									if (tot_energy > ub_tier)
+									{
+										m_month[m].ec_energy_use.at(ir, ic) = (per_energy/tot_energy) * ub_tier;
+										if (ic > 0)
+											m_month[m].ec_energy_use.at(ir, ic) -= (per_energy / tot_energy) * m_month[m].ec_tou_ub.at(ir, ic - 1);
+									}
+									else
+									{
+										m_month[m].ec_energy_use.at(ir, ic) = (per_energy / tot_energy) * tot_energy;
+										if (ic > 0)
+											m_month[m].ec_energy_use.at(ir, ic) -= (per_energy / tot_energy)* m_month[m].ec_tou_ub.at(ir, ic - 1);
+										done=true;
+									}
 								}
 							}
 						}
 					}
-				}
 
-				// repeat for surplus
-				tot_energy = 0;
-				for (size_t ir = 0; ir < num_per; ir++)
-					tot_energy += m_month[m].ec_energy_surplus.at(ir, 0);
-				if (tot_energy > 0)
-				{
+					// repeat for surplus
+					tot_energy = 0;
 					for (size_t ir = 0; ir < num_per; ir++)
+						tot_energy += m_month[m].ec_energy_surplus.at(ir, 0);
+					if (tot_energy > 0)
 					{
-						bool done = false;
-						ssc_number_t per_energy = m_month[m].ec_energy_surplus.at(ir, 0);
-						for (size_t ic = 0; ic < m_month[m].ec_tou_ub.ncols() && !done; ic++)
+						for (size_t ir = 0; ir < num_per; ir++)
 						{
-							ssc_number_t ub_tier = m_month[m].ec_tou_ub.at(0, ic);
-							if (per_energy > 0)
+							bool done = false;
+							ssc_number_t per_energy = m_month[m].ec_energy_surplus.at(ir, 0);
+							for (size_t ic = 0; ic < m_month[m].ec_tou_ub.ncols() && !done; ic++)
 							{
-								if (tot_energy > ub_tier)
-								{
-									m_month[m].ec_energy_surplus.at(ir, ic) = (per_energy / tot_energy) * ub_tier;
-									if (ic > 0)
-										m_month[m].ec_energy_surplus.at(ir, ic) -= (per_energy / tot_energy) * m_month[m].ec_tou_ub.at(ir, ic - 1);
-								}
-								else
+								ssc_number_t ub_tier = m_month[m].ec_tou_ub.at(0, ic);
+								if (per_energy > 0)
 								{
-									m_month[m].ec_energy_surplus.at(ir, ic) = (per_energy / tot_energy) * tot_energy;
-									if (ic > 0)
-										m_month[m].ec_energy_surplus.at(ir, ic) -= (per_energy / tot_energy)* m_month[m].ec_tou_ub.at(ir, ic - 1);
-									done = true;
+									if (tot_energy > ub_tier)
+									{
+										m_month[m].ec_energy_surplus.at(ir, ic) = (per_energy / tot_energy) * ub_tier;
+										if (ic > 0)
+											m_month[m].ec_energy_surplus.at(ir, ic) -= (per_energy / tot_energy) * m_month[m].ec_tou_ub.at(ir, ic - 1);
+									}
+									else
+									{
+										m_month[m].ec_energy_surplus.at(ir, ic) = (per_energy / tot_energy) * tot_energy;
+										if (ic > 0)
+											m_month[m].ec_energy_surplus.at(ir, ic) -= (per_energy / tot_energy)* m_month[m].ec_tou_ub.at(ir, ic - 1);
+										done = true;
+									}
 								}
 							}
 						}
 					}
-				}
 
-			} // end month
-		}
+				} // end month
+			}
 
-		// set peak per period - no tier accumulation
-		if (dc_enabled)
-		{
-			c = 0;
-			for (m = 0; m < (int)m_month.size(); m++)
+			// set peak per period - no tier accumulation
+			if (dc_enabled)
 			{
-				m_month[m].dc_tou_peak.clear();
-				m_month[m].dc_tou_peak_hour.clear();
-				for (i = 0; i < (int)m_month[m].dc_periods.size(); i++)
+				c = 0;
+				for (m = 0; m < (int)m_month.size(); m++)
 				{
-					m_month[m].dc_tou_peak.push_back(0);
-					m_month[m].dc_tou_peak_hour.push_back(0);
-				}
-				for (d = 0; d < util::nday[m]; d++)
-				{
-					for (h = 0; h < 24; h++)
+					m_month[m].dc_tou_peak.clear();
+					m_month[m].dc_tou_peak_hour.clear();
+					for (i = 0; i < (int)m_month[m].dc_periods.size(); i++)
 					{
-						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+						m_month[m].dc_tou_peak.push_back(0);
+						m_month[m].dc_tou_peak_hour.push_back(0);
+					}
+					for (d = 0; d < util::nday[m]; d++)
+					{
+						for (h = 0; h < 24; h++)
 						{
-							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
-							{
-								std::ostringstream ss;
-								ss << "Demand rate Period " << todp << " not found for Month " << m << ".";
-								throw exec_error("utilityrate5", ss.str());
-							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
-							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
+							for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 							{
-								m_month[m].dc_tou_peak[row] = -p_in[c];
-								m_month[m].dc_tou_peak_hour[row] = c;
+								int todp = m_dc_tou_sched[c];
+								std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
+								if (per_num == m_month[m].dc_periods.end())
+								{
+									std::ostringstream ss;
+									ss << "Demand rate Period " << todp << " not found for Month " << m << ".";
+									throw exec_error("utilityrate5", ss.str());
+								}
+								int row = (int)(per_num - m_month[m].dc_periods.begin());
+								if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
+								{
+									m_month[m].dc_tou_peak[row] = -p_in[c];
+									m_month[m].dc_tou_peak_hour[row] = c;
+								}
+								c++;
 							}
-							c++;
 						}
 					}
 				}
 			}
+			if (quantities != 0)
+				ur_save_quantities(*quantities, monthly_cumulative_excess_energy, excess_kwhs_earned, excess_kwhs_applied);
 		}
 
 
@@ -2335,171 +2404,160 @@ public:
 		for (m = 0; m < (int)m_month.size(); m++)
 		{
 			if (m_month[m].hours_per_month <= 0) break;
-			for (d = 0; d<util::nday[m]; d++)
+			// charges are applied in the last time step of the month
+			c += util::nday[m] * 24 * (int)steps_per_hour - 1;
+			if (ec_enabled)
 			{
-				for (h = 0; h<24; h++)
+				// energy use and surplus distributed correctly above.
+				// so calculate for all and not based on monthly net
+				// addresses issue if net > 0 but one period net < 0
+				ssc_number_t credit_amt = 0;
+				for (period = 0; period < (int)m_month[m].ec_tou_sr.nrows(); period++)
 				{
-					// energy charge
-					for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+					for (tier = 0; tier < (int)m_month[m].ec_tou_sr.ncols(); tier++)
 					{
-						if (d == util::nday[m] - 1 && h == 23 && s == (int)(steps_per_hour-1) )
-						{
-							if (ec_enabled)
-							{
-								// energy use and surplus distributed correctly above.
-								// so calculate for all and not based on monthly net
-								// addresses issue if net > 0 but one period net < 0
-								ssc_number_t credit_amt = 0;
-								for (period = 0; period < (int)m_month[m].ec_tou_sr.nrows(); period++)
-								{
-									for (tier = 0; tier < (int)m_month[m].ec_tou_sr.ncols(); tier++)
-									{
-										ssc_number_t cr = m_month[m].ec_energy_surplus.at(period, tier) * m_month[m].ec_tou_sr.at(period, tier) * rate_esc;
+						ssc_number_t cr = m_month[m].ec_energy_surplus.at(period, tier) * m_month[m].ec_tou_sr.at(period, tier) * rate_esc;
 
 //										excess_kwhs_earned[m] += m_month[m].ec_energy_surplus.at(period, tier);
 
-										if (!enable_nm)
-										{
-											credit_amt += cr;
-											m_month[m].ec_charge.at(period, tier) = -cr;
-										}
-										else if (excess_monthly_dollars)
-											monthly_cumulative_excess_dollars[m] += cr;
+						if (!enable_nm)
+						{
+							credit_amt += cr;
+							m_month[m].ec_charge.at(period, tier) = -cr;
+						}
+						else if (excess_monthly_dollars)
+							monthly_cumulative_excess_dollars[m] += cr;
 
-										/*
-										if (!enable_nm || excess_monthly_kwhs)
-										{
-										credit_amt += cr;
-										if (!excess_monthly_kwhs)
-										m_month[m].ec_charge.at(period, tier) = -cr;
-										}
-										*/
-									}
-								}
-								monthly_ec_charges[m] -= credit_amt;
+						/*
+						if (!enable_nm || excess_monthly_kwhs)
+						{
+						credit_amt += cr;
+						if (!excess_monthly_kwhs)
+						m_month[m].ec_charge.at(period, tier) = -cr;
+						}
+						*/
+					}
+				}
+				monthly_ec_charges[m] -= credit_amt;
 
-								ssc_number_t charge_amt = 0;
-								for (period = 0; period < (int)m_month[m].ec_tou_br.nrows(); period++)
-								{
-									for (tier = 0; tier < (int)m_month[m].ec_tou_br.ncols(); tier++)
-									{
-										ssc_number_t ch = m_month[m].ec_energy_use.at(period, tier) * m_month[m].ec_tou_br.at(period, tier) * rate_esc;
-										m_month[m].ec_charge.at(period, tier) = ch;
-										charge_amt += ch;
-									}
-								}
-								monthly_ec_charges[m] += charge_amt;
+				ssc_number_t charge_amt = 0;
+				for (period = 0; period < (int)m_month[m].ec_tou_br.nrows(); period++)
+				{
+					for (tier = 0; tier < (int)m_month[m].ec_tou_br.ncols(); tier++)
+					{
+						ssc_number_t ch = m_month[m].ec_energy_use.at(period, tier) * m_month[m].ec_tou_br.at(period, tier) * rate_esc;
+						m_month[m].ec_charge.at(period, tier) = ch;
+						charge_amt += ch;
+					}
+				}
+				monthly_ec_charges[m] += charge_amt;
 
 
-								// monthly rollover with year end sell at reduced rate
-								if (enable_nm)
-								{
-									payment[c] += monthly_ec_charges[m];
-									/*
-									if (monthly_ec_charges[m] < 0)
-									{
-									monthly_cumulative_excess_kwhs[m] = -monthly_ec_charges[m];
-									payment[c] += monthly_ec_charges[m];
-									}
-									*/
-								}
-								else // non-net metering - no rollover 
-								{
-									if (m_month[m].energy_net < 0) // must buy from grid
-										payment[c] += monthly_ec_charges[m];
-									else // surplus - sell to grid
-										income[c] -= monthly_ec_charges[m]; // charge is negative for income!
-								}
+				// monthly rollover with year end sell at reduced rate
+				if (enable_nm)
+				{
+					payment[c] += monthly_ec_charges[m];
+					/*
+					if (monthly_ec_charges[m] < 0)
+					{
+					monthly_cumulative_excess_kwhs[m] = -monthly_ec_charges[m];
+					payment[c] += monthly_ec_charges[m];
+					}
+					*/
+				}
+				else // non-net metering - no rollover 
+				{
+					if (m_month[m].energy_net < 0) // must buy from grid
+						payment[c] += monthly_ec_charges[m];
+					else // surplus - sell to grid
+						income[c] -= monthly_ec_charges[m]; // charge is negative for income!
+				}
 
-								energy_charge[c] += monthly_ec_charges[m];
+				energy_charge[c] += monthly_ec_charges[m];
 
-								// end of energy charge
+				// end of energy charge
 
-							}
+			}
 
 
-							if (dc_enabled)
-							{
-								// fixed demand charge
-								// compute charge based on tier structure for the month
-								ssc_number_t charge = 0;
-								ssc_number_t d_lower = 0;
-								ssc_number_t demand = m_month[m].dc_flat_peak;
-								bool found = false;
-								for (tier = 0; tier < (int)m_month[m].dc_flat_ub.size() && !found; tier++)
-								{
-									if (demand < m_month[m].dc_flat_ub[tier])
-									{
-										found = true;
-										charge += (demand - d_lower) *
-											m_month[m].dc_flat_ch[tier] * rate_esc;
-										m_month[m].dc_flat_charge = charge;
-									}
-									else
-									{
-										charge += (m_month[m].dc_flat_ub[tier] - d_lower) *
-											m_month[m].dc_flat_ch[tier] * rate_esc;
-										d_lower = m_month[m].dc_flat_ub[tier];
-									}
-								}
+			if (dc_enabled)
+			{
+				// fixed demand charge
+				// compute charge based on tier structure for the month
+				ssc_number_t charge = 0;
+				ssc_number_t d_lower = 0;
+				ssc_number_t demand = m_month[m].dc_flat_peak;
+				bool found = false;
+				for (tier = 0; tier < (int)m_month[m].dc_flat_ub.size() && !found; tier++)
+				{
+					if (demand < m_month[m].dc_flat_ub[tier])
+					{
+						found = true;
+						charge += (demand - d_lower) *
+							m_month[m].dc_flat_ch[tier] * rate_esc;
+						m_month[m].dc_flat_charge = charge;
+					}
+					else
+					{
+						charge += (m_month[m].dc_flat_ub[tier] - d_lower) *
+							m_month[m].dc_flat_ch[tier] * rate_esc;
+						d_lower = m_month[m].dc_flat_ub[tier];
+					}
+				}
 
-								monthly_dc_fixed[m] = charge; // redundant...
-								payment[c] += monthly_dc_fixed[m];
-								demand_charge[c] = charge;
-								dc_hourly_peak[m_month[m].dc_flat_peak_hour] = demand;
+				monthly_dc_fixed[m] = charge; // redundant...
+				payment[c] += monthly_dc_fixed[m];
+				demand_charge[c] = charge;
+				dc_hourly_peak[m_month[m].dc_flat_peak_hour] = demand;
 
 
-								// end of fixed demand charge
+				// end of fixed demand charge
 
 
-								// TOU demand charge for each period find correct tier
-								demand = 0;
-								d_lower = 0;
-								int peak_hour = 0;
-								m_month[m].dc_tou_charge.clear();
-								for (period = 0; period < (int)m_month[m].dc_tou_ub.nrows(); period++)
-								{
-									charge = 0;
-									d_lower = 0;
-									if (tou_demand_single_peak)
-									{
-										demand = m_month[m].dc_flat_peak;
-										if (m_month[m].dc_flat_peak_hour != m_month[m].dc_tou_peak_hour[period]) continue; // only one peak per month.
-									}
-									else
-										demand = m_month[m].dc_tou_peak[period];
-									// find tier corresponding to peak demand
-									found = false;
-									for (tier = 0; tier < (int)m_month[m].dc_tou_ub.ncols() && !found; tier++)
-									{
-										if (demand < m_month[m].dc_tou_ub.at(period, tier))
-										{
-											found = true;
-											charge += (demand - d_lower) *
-												m_month[m].dc_tou_ch.at(period, tier)* rate_esc;
-											m_month[m].dc_tou_charge.push_back(charge);
-										}
-										else
-										{
-											charge += (m_month[m].dc_tou_ub.at(period, tier) - d_lower) * m_month[m].dc_tou_ch.at(period, tier)* rate_esc;
-											d_lower = m_month[m].dc_tou_ub.at(period, tier);
-										}
-									}
+				// TOU demand charge for each period find correct tier
+				demand = 0;
+				d_lower = 0;
+				int peak_hour = 0;
+				m_month[m].dc_tou_charge.clear();
+				for (period = 0; period < (int)m_month[m].dc_tou_ub.nrows(); period++)
+				{
+					charge = 0;
+					d_lower = 0;
+					if (tou_demand_single_peak)
+					{
+						demand = m_month[m].dc_flat_peak;
+						if (m_month[m].dc_flat_peak_hour != m_month[m].dc_tou_peak_hour[period]) continue; // only one peak per month.
+					}
+					else
+						demand = m_month[m].dc_tou_peak[period];
+					// find tier corresponding to peak demand
+					found = false;
+					for (tier = 0; tier < (int)m_month[m].dc_tou_ub.ncols() && !found; tier++)
+					{
+						if (demand < m_month[m].dc_tou_ub.at(period, tier))
+						{
+							found = true;
+							charge += (demand - d_lower) *
+								m_month[m].dc_tou_ch.at(period, tier)* rate_esc;
+							m_month[m].dc_tou_charge.push_back(charge);
+						}
+						else
+						{
+							charge += (m_month[m].dc_tou_ub.at(period, tier) - d_lower) * m_month[m].dc_tou_ch.at(period, tier)* rate_esc;
+							d_lower = m_month[m].dc_tou_ub.at(period, tier);
+						}
+					}
 
-									dc_hourly_peak[peak_hour] = demand;
-									// add to payments
-									monthly_dc_tou[m] += charge;
-									payment[c] += charge; // apply to last hour of the month
-									demand_charge[c] += charge; // add TOU charge to hourly demand charge
-								}
-								// end of TOU demand charge
-							}
+					dc_hourly_peak[peak_hour] = demand;
+					// add to payments
+					monthly_dc_tou[m] += charge;
+					payment[c] += charge; // apply to last hour of the month
+					demand_charge[c] += charge; // add TOU charge to hourly demand charge
+				}
+				// end of TOU demand charge
+			}
 
-						} // end of if end of month
-						c++;
-					} // end of steps per hour loop
-				}  // h loop
-			} // d loop
+			c++;
 
 			// Calculate monthly bill (before minimums and fixed charges) and excess kwhs and rollover
 //			monthly_bill[m] = payment[c - 1] - income[c - 1];
@@ -2576,69 +2634,59 @@ public:
 		// process one month at a time
 		for (m = 0; m < 12; m++)
 		{
-			for (d = 0; d < util::nday[m]; d++)
+			// last time step of the month
+			c += util::nday[m] * 24 * (int)steps_per_hour - 1;
+			// apply fixed first
+			if (include_fixed)
 			{
-				for (h = 0; h < 24; h++)
+				payment[c] += mon_fixed;
+				monthly_fixed_charges[m] += mon_fixed;
+			}
+			mon_bill = payment[c] - income[c];
+			if (mon_bill < 0) mon_bill = 0; // for calculating min charge when monthly surplus.
+			// apply monthly minimum
+			if (include_min)
+			{
+				if (mon_bill < mon_min_charge)
 				{
-					for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+					monthly_minimum_charges[m] += mon_min_charge - mon_bill;
+					payment[c] += mon_min_charge - mon_bill;
+				}
+			}
+			ann_bill += mon_bill;
+			if (m == 11)
+			{
+				// apply annual minimum
+				if (include_min)
+				{
+					if (ann_bill < ann_min_charge)
 					{
-						if (d == util::nday[m] - 1 && h == 23 && s == (int)(steps_per_hour - 1))
-						{
-							// apply fixed first
-							if (include_fixed)
-							{
-								payment[c] += mon_fixed;
-								monthly_fixed_charges[m] += mon_fixed;
-							}
-							mon_bill = payment[c] - income[c];
-							if (mon_bill < 0) mon_bill = 0; // for calculating min charge when monthly surplus.
-							// apply monthly minimum
-							if (include_min)
-							{
-								if (mon_bill < mon_min_charge)
-								{
-									monthly_minimum_charges[m] += mon_min_charge - mon_bill;
-									payment[c] += mon_min_charge - mon_bill;
-								}
-							}
-							ann_bill += mon_bill;
-							if (m == 11)
-							{
-								// apply annual minimum
-								if (include_min)
-								{
-									if (ann_bill < ann_min_charge)
-									{
-										monthly_minimum_charges[m] += ann_min_charge - ann_bill;
-										payment[c] += ann_min_charge - ann_bill;
-									}
-								}
-								// apply annual rollovers AFTER minimum calculations
-								if (enable_nm)
-								{
-									// monthly rollover with year end sell at reduced rate
-									if (!excess_monthly_dollars && (monthly_cumulative_excess_energy[11] > 0))
-									{
-										ssc_number_t year_end_dollars = monthly_cumulative_excess_energy[11] * as_number("ur_nm_yearend_sell_rate")*rate_esc;
-										income[8759] += year_end_dollars;
-										monthly_cumulative_excess_dollars[11] = year_end_dollars;
-										excess_dollars_earned[11] += year_end_dollars;
-										excess_dollars_applied[11] += year_end_dollars;
-									}
-									else if (excess_monthly_dollars && (monthly_cumulative_excess_dollars[11] > 0))
-									{
-										income[8759] += monthly_cumulative_excess_dollars[11];
-										// ? net metering energy?
-									}
-								}
-							}
-							revenue[c] = income[c] - payment[c];
-							monthly_bill[m] = -revenue[c];
-						}
-						c++;
+						monthly_minimum_charges[m] += ann_min_charge - ann_bill;
+						payment[c] += ann_min_charge - ann_bill;
+					}
+				}
+				// apply annual rollovers AFTER minimum calculations
+				if (enable_nm)
+				{
+					// monthly rollover with year end sell at reduced rate
+					if (!excess_monthly_dollars && (monthly_cumulative_excess_energy[11] > 0))
+					{
+						ssc_number_t year_end_dollars = monthly_cumulative_excess_energy[11] * as_number("ur_nm_yearend_sell_rate")*rate_esc;
+						income[8759] += year_end_dollars;
+						monthly_cumulative_excess_dollars[11] = year_end_dollars;
+						excess_dollars_earned[11] += year_end_dollars;
+						excess_dollars_applied[11] += year_end_dollars;
+					}
+					else if (excess_monthly_dollars && (monthly_cumulative_excess_dollars[11] > 0))
+					{
+						income[8759] += monthly_cumulative_excess_dollars[11];
+						// ? net metering energy?
 					}
 				}
 			}
+			revenue[c] = income[c] - payment[c];
+			monthly_bill[m] = -revenue[c];
+			c++;
 		}
 
 	}
@@ -2657,7 +2705,7 @@ public:
 		ssc_number_t excess_kwhs_applied[12],
 		ssc_number_t *dc_hourly_peak, ssc_number_t monthly_cumulative_excess_energy[12],
 		ssc_number_t monthly_cumulative_excess_dollars[12], ssc_number_t monthly_bill[12],
-		ssc_number_t rate_esc, bool include_fixed = true, bool include_min = true, bool gen_only = false)
+		ssc_number_t rate_esc, bool include_fixed = true, bool include_min = true, bool gen_only = false, ur_quantities *quantities = 0)
 		throw(general_error)
 	{
 		int i;
@@ -2711,178 +2759,290 @@ public:
 		// calculate the monthly net energy and monthly hours
 		int m, d, h, s, period, tier;
 		size_t c = 0;
-		for (m = 0; m < (int)m_month.size(); m++)
+		// time step charges are kept with the quantities when reused
+		std::vector<ur_ts_energy_charge> ts_energy_charge_year;
+		std::vector<ur_ts_energy_charge> *ts_energy_charge = (quantities != 0) ? &quantities->ts_energy_charge : &ts_energy_charge_year;
+		// quantities from an earlier year as in ur_calc
+		if (quantities != 0 && quantities->valid)
+			ur_restore_quantities(*quantities, monthly_cumulative_excess_energy, excess_kwhs_earned, excess_kwhs_applied, dc_enabled);
+		else
 		{
-			m_month[m].energy_net = 0;
-			m_month[m].hours_per_month = 0;
-			m_month[m].dc_flat_peak = 0;
-			m_month[m].dc_flat_peak_hour = 0;
-			for (d = 0; d < util::nday[m]; d++)
+			for (m = 0; m < (int)m_month.size(); m++)
 			{
-				for (h = 0; h < 24; h++)
+				m_month[m].energy_net = 0;
+				m_month[m].hours_per_month = 0;
+				m_month[m].dc_flat_peak = 0;
+				m_month[m].dc_flat_peak_hour = 0;
+				for (d = 0; d < util::nday[m]; d++)
 				{
-					for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+					for (h = 0; h < 24; h++)
 					{
-						// net energy use per month
-						m_month[m].energy_net += e_in[c]; // -load and +gen
-						// hours per period per month
-						m_month[m].hours_per_month++;
-						// peak
-						if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_flat_peak)
+						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
-							m_month[m].dc_flat_peak = -p_in[c];
-							m_month[m].dc_flat_peak_hour = (int)c;
+							// net energy use per month
+							m_month[m].energy_net += e_in[c]; // -load and +gen
+							// hours per period per month
+							m_month[m].hours_per_month++;
+							// peak
+							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_flat_peak)
+							{
+								m_month[m].dc_flat_peak = -p_in[c];
+								m_month[m].dc_flat_peak_hour = (int)c;
+							}
+							c++;
 						}
-						c++;
 					}
 				}
 			}
-		}
 
-		// excess earned
-		for (m = 0; m < 12; m++)
-		{
-			if (m_month[m].energy_net > 0)
-				excess_kwhs_earned[m] = m_month[m].energy_net;
-		}
+			// excess earned
+			for (m = 0; m < 12; m++)
+			{
+				if (m_month[m].energy_net > 0)
+					excess_kwhs_earned[m] = m_month[m].energy_net;
+			}
 
 
 
 
-		if (ec_enabled)
-		{
-			// calculate the monthly net energy per tier and period based on units
-			c = 0;
-			for (m = 0; m < (int)m_month.size(); m++)
+			if (ec_enabled)
 			{
-				// check for kWh/kW
-				int start_tier = 0;
-				int end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
-				int num_periods = (int)m_month[m].ec_tou_ub.nrows();
-				int num_tiers = end_tier - start_tier + 1;
-
-				if (!gen_only) // added for two meter no load scenarios to use load tier sizing
+				// calculate the monthly net energy per tier and period based on units
+				c = 0;
+				for (m = 0; m < (int)m_month.size(); m++)
 				{
-					//start_tier = 0;
-					end_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
-					//int num_periods = (int)m_month[m].ec_tou_ub_init.nrows();
-					num_tiers = end_tier - start_tier + 1;
-
-
-					// kWh/kW (kWh/kW daily handled in Setup)
-					// 1. find kWh/kW tier
-					// 2. set min tier and max tier based on next item in ec_tou matrix
-					// 3. resize use and chart based on number of tiers in kWh/kW section
-					// 4. assumption is that all periods in same month have same tier breakdown
-					// 5. assumption is that tier numbering is correct for the kWh/kW breakdown
-					// That is, first tier must be kWh/kW
-					if ((m_month[m].ec_tou_units.ncols() > 0 && m_month[m].ec_tou_units.nrows() > 0)
-						&& ((m_month[m].ec_tou_units.at(0, 0) == 1) || (m_month[m].ec_tou_units.at(0, 0) == 3)))
+					// check for kWh/kW
+					int start_tier = 0;
+					int end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
+					int num_periods = (int)m_month[m].ec_tou_ub.nrows();
+					int num_tiers = end_tier - start_tier + 1;
+
+					if (!gen_only) // added for two meter no load scenarios to use load tier sizing
 					{
-						// monthly total energy / monthly peak to determine which kWh/kW tier
-						double mon_kWhperkW = -m_month[m].energy_net; // load negative
-						if (m_month[m].dc_flat_peak != 0)
-							mon_kWhperkW /= m_month[m].dc_flat_peak;
-						// find correct start and end tier based on kWhperkW band
-						start_tier = 1;
-						bool found = false;
-						for (size_t i_tier = 0; i_tier < m_month[m].ec_tou_units.ncols(); i_tier++)
+						//start_tier = 0;
+						end_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
+						//int num_periods = (int)m_month[m].ec_tou_ub_init.nrows();
+						num_tiers = end_tier - start_tier + 1;
+
+
+						// kWh/kW (kWh/kW daily handled in Setup)
+						// 1. find kWh/kW tier
+						// 2. set min tier and max tier based on next item in ec_tou matrix
+						// 3. resize use and chart based on number of tiers in kWh/kW section
+						// 4. assumption is that all periods in same month have same tier breakdown
+						// 5. assumption is that tier numbering is correct for the kWh/kW breakdown
+						// That is, first tier must be kWh/kW
+						if ((m_month[m].ec_tou_units.ncols() > 0 && m_month[m].ec_tou_units.nrows() > 0)
+							&& ((m_month[m].ec_tou_units.at(0, 0) == 1) || (m_month[m].ec_tou_units.at(0, 0) == 3)))
 						{
-							int units = (int)m_month[m].ec_tou_units.at(0, i_tier);
-							if ((units == 1) || (units == 3))
+							// monthly total energy / monthly peak to determine which kWh/kW tier
+							double mon_kWhperkW = -m_month[m].energy_net; // load negative
+							if (m_month[m].dc_flat_peak != 0)
+								mon_kWhperkW /= m_month[m].dc_flat_peak;
+							// find correct start and end tier based on kWhperkW band
+							start_tier = 1;
+							bool found = false;
+							for (size_t i_tier = 0; i_tier < m_month[m].ec_tou_units.ncols(); i_tier++)
 							{
-								if (found)
+								int units = (int)m_month[m].ec_tou_units.at(0, i_tier);
+								if ((units == 1) || (units == 3))
 								{
-									end_tier = (int)i_tier - 1;
-									break;
-								}
-								else if (mon_kWhperkW < m_month[m].ec_tou_ub_init.at(0, i_tier))
-								{
-									start_tier = (int)i_tier + 1;
-									found = true;
+									if (found)
+									{
+										end_tier = (int)i_tier - 1;
+										break;
+									}
+									else if (mon_kWhperkW < m_month[m].ec_tou_ub_init.at(0, i_tier))
+									{
+										start_tier = (int)i_tier + 1;
+										found = true;
+									}
 								}
 							}
-						}
-						// last tier since no max specified in rate
-						if (!found) start_tier = end_tier;
-						if (start_tier >= (int)m_month[m].ec_tou_ub_init.ncols())
-							start_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
-						if (end_tier < start_tier)
-							end_tier = start_tier;
-						num_tiers = end_tier - start_tier + 1;
-						// resize everytime to handle load and energy changes
-						// resize sr, br and ub for use in energy charge calculations below
-						util::matrix_t<float> br(num_periods, num_tiers);
-						util::matrix_t<float> sr(num_periods, num_tiers);
-						util::matrix_t<float> ub(num_periods, num_tiers);
-						// assign appropriate values.
-						for (period = 0; period < num_periods; period++)
-						{
-							for (tier = 0; tier < num_tiers; tier++)
+							// last tier since no max specified in rate
+							if (!found) start_tier = end_tier;
+							if (start_tier >= (int)m_month[m].ec_tou_ub_init.ncols())
+								start_tier = (int)m_month[m].ec_tou_ub_init.ncols() - 1;
+							if (end_tier < start_tier)
+								end_tier = start_tier;
+							num_tiers = end_tier - start_tier + 1;
+							// resize everytime to handle load and energy changes
+							// resize sr, br and ub for use in energy charge calculations below
+							util::matrix_t<float> br(num_periods, num_tiers);
+							util::matrix_t<float> sr(num_periods, num_tiers);
+							util::matrix_t<float> ub(num_periods, num_tiers);
+							// assign appropriate values.
+							for (period = 0; period < num_periods; period++)
 							{
-								br.at(period, tier) = m_month[m].ec_tou_br_init.at(period, start_tier + tier);
-								sr.at(period, tier) = m_month[m].ec_tou_sr_init.at(period, start_tier + tier);
-								ub.at(period, tier) = m_month[m].ec_tou_ub_init.at(period, start_tier + tier);
-								// update for correct tier number column headings
-								m_month[m].ec_periods_tiers[period][tier] = start_tier + m_ec_periods_tiers_init[period][tier];
+								for (tier = 0; tier < num_tiers; tier++)
+								{
+									br.at(period, tier) = m_month[m].ec_tou_br_init.at(period, start_tier + tier);
+									sr.at(period, tier) = m_month[m].ec_tou_sr_init.at(period, start_tier + tier);
+									ub.at(period, tier) = m_month[m].ec_tou_ub_init.at(period, start_tier + tier);
+									// update for correct tier number column headings
+									m_month[m].ec_periods_tiers[period][tier] = start_tier + m_ec_periods_tiers_init[period][tier];
+								}
 							}
-						}
 
-						m_month[m].ec_tou_br = br;
-						m_month[m].ec_tou_sr = sr;
-						m_month[m].ec_tou_ub = ub;
+							m_month[m].ec_tou_br = br;
+							m_month[m].ec_tou_sr = sr;
+							m_month[m].ec_tou_ub = ub;
+						}
 					}
-				}
-				// reset now resized
-				start_tier = 0;
-				end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
+					// reset now resized
+					start_tier = 0;
+					end_tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
 
-				m_month[m].ec_energy_surplus.resize_fill(num_periods, num_tiers, 0);
-				m_month[m].ec_energy_use.resize_fill(num_periods, num_tiers, 0);
-				m_month[m].ec_charge.resize_fill(num_periods, num_tiers, 0);
+					m_month[m].ec_energy_surplus.resize_fill(num_periods, num_tiers, 0);
+					m_month[m].ec_energy_use.resize_fill(num_periods, num_tiers, 0);
+					m_month[m].ec_charge.resize_fill(num_periods, num_tiers, 0);
 
+				}
 			}
-		}
 
 
-		// set peak per period - no tier accumulation
-		if (dc_enabled)
-		{
-			c = 0;
-			for (m = 0; m < (int)m_month.size(); m++)
+			// set peak per period - no tier accumulation
+			if (dc_enabled)
 			{
-				m_month[m].dc_tou_peak.clear();
-				m_month[m].dc_tou_peak_hour.clear();
-				for (i = 0; i < (int)m_month[m].dc_periods.size(); i++)
-				{
-					m_month[m].dc_tou_peak.push_back(0);
-					m_month[m].dc_tou_peak_hour.push_back(0);
-				}
-				for (d = 0; d < util::nday[m]; d++)
+				c = 0;
+				for (m = 0; m < (int)m_month.size(); m++)
 				{
-					for (h = 0; h < 24; h++)
+					m_month[m].dc_tou_peak.clear();
+					m_month[m].dc_tou_peak_hour.clear();
+					for (i = 0; i < (int)m_month[m].dc_periods.size(); i++)
 					{
-						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
+						m_month[m].dc_tou_peak.push_back(0);
+						m_month[m].dc_tou_peak_hour.push_back(0);
+					}
+					for (d = 0; d < util::nday[m]; d++)
+					{
+						for (h = 0; h < 24; h++)
 						{
-							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
+							for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 							{
-								std::ostringstream ss;
-								ss << "Demand charge Period " << todp << " not found for Month " << m << ".";
-								throw exec_error("utilityrate5", ss.str());
+								int todp = m_dc_tou_sched[c];
+								std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
+								if (per_num == m_month[m].dc_periods.end())
+								{
+									std::ostringstream ss;
+									ss << "Demand charge Period " << todp << " not found for Month " << m << ".";
+									throw exec_error("utilityrate5", ss.str());
+								}
+								int row = (int)(per_num - m_month[m].dc_periods.begin());
+								if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
+								{
+									m_month[m].dc_tou_peak[row] = -p_in[c];
+									m_month[m].dc_tou_peak_hour[row] = (int)c;
+								}
+								c++;
 							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
-							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
+						}
+					}
+				}
+			}
+			// period, tier and charge before rate escalation of each time step
+			if (ec_enabled)
+			{
+				ts_energy_charge->resize(m_num_rec_yearly);
+				c = 0;
+				for (m = 0; m < 12; m++)
+				{
+					monthly_surplus_energy = 0;
+					monthly_deficit_energy = 0;
+					for (d = 0; d < util::nday[m]; d++)
+					{
+						daily_surplus_energy = 0;
+						daily_deficit_energy = 0;
+						for (h = 0; h < 24; h++)
+						{
+							for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 							{
-								m_month[m].dc_tou_peak[row] = -p_in[c];
-								m_month[m].dc_tou_peak_hour[row] = (int)c;
+								period = m_ec_tou_sched[c];
+								// find corresponding monthly period
+								// check for valid period
+								std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), period);
+								if (per_num == m_month[m].ec_periods.end())
+								{
+									std::ostringstream ss;
+									ss << "Energy rate Period " << period << " not found for Month " << m << ".";
+									throw exec_error("utilityrate5", ss.str());
+								}
+								int row = (int)(per_num - m_month[m].ec_periods.begin());
+								ur_ts_energy_charge &ts = (*ts_energy_charge)[c];
+								ts.row = row;
+
+								if (e_in[c] >= 0.0)
+								{ // income or credit
+									monthly_surplus_energy += e_in[c];
+									daily_surplus_energy += e_in[c];
+
+									// base period charge on units specified
+									ssc_number_t energy_surplus = e_in[c];
+									ssc_number_t cumulative_energy = e_in[c];
+									if (ur_ec_hourly_acc_period == 1)
+										cumulative_energy = monthly_surplus_energy;
+									else if (ur_ec_hourly_acc_period == 2)
+										cumulative_energy = daily_surplus_energy;
+
+
+									// cumulative energy used to determine tier for credit of entire surplus amount
+									for (tier = 0; tier < (int)m_month[m].ec_tou_ub.ncols(); tier++)
+									{
+										ssc_number_t e_upper = m_month[m].ec_tou_ub.at(row, tier);
+										if (cumulative_energy < e_upper)
+											break;
+									}
+									if (tier >= (int)m_month[m].ec_tou_ub.ncols())
+										tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
+									ssc_number_t tier_energy = energy_surplus;
+									ssc_number_t sr = m_month[m].ec_tou_sr.at(row, tier);
+									// time step sell rates
+									if (c< m_ec_ts_sell_rate.size())
+										sr = m_ec_ts_sell_rate[c];
+
+									ts.surplus = true;
+									ts.tier = tier;
+									ts.amount = (ssc_number_t)(tier_energy * sr);
+									m_month[m].ec_energy_surplus.at(row, tier) += (ssc_number_t)tier_energy;
+									excess_kwhs_earned[m] += tier_energy;
+								}
+								else
+								{ // payment or charge
+									monthly_deficit_energy -= e_in[c];
+									daily_deficit_energy -= e_in[c];
+									double energy_deficit = -e_in[c];
+									// base period charge on units specified
+									double cumulative_deficit = -e_in[c];
+									if (ur_ec_hourly_acc_period == 1)
+										cumulative_deficit = monthly_deficit_energy;
+									else if (ur_ec_hourly_acc_period == 2)
+										cumulative_deficit = daily_deficit_energy;
+
+
+									// cumulative energy used to determine tier for credit of entire surplus amount
+									for (tier = 0; tier < (int)m_month[m].ec_tou_ub.ncols(); tier++)
+									{
+										double e_upper = m_month[m].ec_tou_ub.at(row, tier);
+										if (cumulative_deficit < e_upper)
+											break;
+									}
+									if (tier >= (int)m_month[m].ec_tou_ub.ncols())
+										tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
+									double tier_energy = energy_deficit;
+
+									ts.surplus = false;
+									ts.tier = tier;
+									ts.amount = tier_energy * m_month[m].ec_tou_br.at(row, tier);
+									m_month[m].ec_energy_use.at(row, tier) += (ssc_number_t)tier_energy;
+								}
+								c++;
 							}
-							c++;
 						}
 					}
 				}
 			}
+			if (quantities != 0)
+				ur_save_quantities(*quantities, monthly_cumulative_excess_energy, excess_kwhs_earned, excess_kwhs_applied);
 		}
 
 // main loop
@@ -2890,13 +3050,8 @@ public:
 		// process one timestep at a time
 		for (m = 0; m < 12; m++)
 		{
-			monthly_surplus_energy = 0;
-			monthly_deficit_energy = 0;
 			for (d = 0; d<util::nday[m]; d++)
 			{
-				daily_surplus_energy = 0;
-				daily_deficit_energy = 0;
-				//daily_net_energy = 0;
 				for (h = 0; h<24; h++)
 				{
 					for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
@@ -2904,51 +3059,10 @@ public:
 						// energy charge
 						if (ec_enabled)
 						{
-							period = m_ec_tou_sched[c];
-							// find corresponding monthly period
-							// check for valid period
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), period);
-							if (per_num == m_month[m].ec_periods.end())
-							{
-								std::ostringstream ss;
-								ss << "Energy rate Period " << period << " not found for Month " << m << ".";
-								throw exec_error("utilityrate5", ss.str());
-							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
-
-							if (e_in[c] >= 0.0)
+							const ur_ts_energy_charge &ts = (*ts_energy_charge)[c];
+							if (ts.surplus)
 							{ // calculate income or credit
-								monthly_surplus_energy += e_in[c];
-								daily_surplus_energy += e_in[c];
-
-								// base period charge on units specified
-								ssc_number_t energy_surplus = e_in[c];
-								ssc_number_t cumulative_energy = e_in[c];
-								if (ur_ec_hourly_acc_period == 1)
-									cumulative_energy = monthly_surplus_energy;
-								else if (ur_ec_hourly_acc_period == 2)
-									cumulative_energy = daily_surplus_energy;
-
-
-								// cumulative energy used to determine tier for credit of entire surplus amount
-								ssc_number_t credit_amt = 0;
-								for (tier = 0; tier < (int)m_month[m].ec_tou_ub.ncols(); tier++)
-								{
-									ssc_number_t e_upper = m_month[m].ec_tou_ub.at(row, tier);
-									if (cumulative_energy < e_upper)
-										break;
-								}
-								if (tier >= (int)m_month[m].ec_tou_ub.ncols())
-									tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
-								ssc_number_t tier_energy = energy_surplus;
-								ssc_number_t sr = m_month[m].ec_tou_sr.at(row, tier);
-								// time step sell rates
-								if (c< m_ec_ts_sell_rate.size())
-									sr = m_ec_ts_sell_rate[c];
-								ssc_number_t tier_credit = tier_energy * sr * rate_esc;
-
-								credit_amt = tier_credit;
-
+								ssc_number_t credit_amt = (ssc_number_t)ts.amount * rate_esc;
 
 								if (excess_monthly_dollars)
 								{
@@ -2956,47 +3070,19 @@ public:
 								}
 								else
 								{
-									m_month[m].ec_charge.at(row, tier) -= (ssc_number_t)tier_credit;
-									//								price[c] += (ssc_number_t)credit_amt;
-									monthly_ec_charges[m] -= (ssc_number_t)credit_amt;
-									income[c] = (ssc_number_t)credit_amt;
-									energy_charge[c] = -(ssc_number_t)credit_amt;
+									m_month[m].ec_charge.at(ts.row, ts.tier) -= credit_amt;
+									monthly_ec_charges[m] -= credit_amt;
+									income[c] = credit_amt;
+									energy_charge[c] = -credit_amt;
 								}
-								m_month[m].ec_energy_surplus.at(row, tier) += (ssc_number_t)tier_energy;
-								excess_kwhs_earned[m] += tier_energy;
 							}
 							else
 							{ // calculate payment or charge
-								monthly_deficit_energy -= e_in[c];
-								daily_deficit_energy -= e_in[c];
-								double charge_amt = 0;
-								double energy_deficit = -e_in[c];
-								// base period charge on units specified
-								double cumulative_deficit = -e_in[c];
-								if (ur_ec_hourly_acc_period == 1)
-									cumulative_deficit = monthly_deficit_energy;
-								else if (ur_ec_hourly_acc_period == 2)
-									cumulative_deficit = daily_deficit_energy;
-
-
-								// cumulative energy used to determine tier for credit of entire surplus amount
-								for (tier = 0; tier < (int)m_month[m].ec_tou_ub.ncols(); tier++)
-								{
-									double e_upper = m_month[m].ec_tou_ub.at(row, tier);
-									if (cumulative_deficit < e_upper)
-										break;
-								}
-								if (tier >= (int)m_month[m].ec_tou_ub.ncols())
-									tier = (int)m_month[m].ec_tou_ub.ncols() - 1;
-								double tier_energy = energy_deficit;
-								double tier_charge = tier_energy * m_month[m].ec_tou_br.at(row, tier) * rate_esc;
-								charge_amt = tier_charge;
-								m_month[m].ec_energy_use.at(row, tier) += (ssc_number_t)tier_energy;
-								m_month[m].ec_charge.at(row, tier) += (ssc_number_t)tier_charge;
+								double charge_amt = ts.amount * rate_esc;
+								m_month[m].ec_charge.at(ts.row, ts.tier) += (ssc_number_t)charge_amt;
 
 								payment[c] = (ssc_number_t)charge_amt;
 								monthly_ec_charges[m] += (ssc_number_t)charge_amt;
-//								price[c] += (ssc_number_t)charge_amt;
 								energy_charge[c] = (ssc_number_t)charge_amt;
 							}
 						}
@@ -3235,6 +3321,61 @@ public:
 	}
 
 
+	// logs a notice of the first pass of ur_calc for the year and keeps it for years that reuse the quantities
+	void ur_log_rollover_notice(const std::string &notice, size_t year, ur_quantities *quantities)
+	{
+		std::ostringstream ss;
+		ss << "year:" << year << notice;
+		log(ss.str(), SSC_NOTICE);
+		if (quantities != 0)
+			quantities->notices.push_back(notice);
+	}
+
+	void ur_save_quantities(ur_quantities &quantities, ssc_number_t monthly_cumulative_excess_energy[12],
+		ssc_number_t excess_kwhs_earned[12], ssc_number_t excess_kwhs_applied[12])
+	{
+		quantities.month = m_month;
+		for (int m = 0; m < 12; m++)
+		{
+			quantities.monthly_cumulative_excess_energy[m] = monthly_cumulative_excess_energy[m];
+			quantities.excess_kwhs_earned[m] = excess_kwhs_earned[m];
+			quantities.excess_kwhs_applied[m] = excess_kwhs_applied[m];
+		}
+		quantities.valid = true;
+	}
+
+	// restores only what the first pass of ur_calc and ur_calc_timestep sets
+	void ur_restore_quantities(const ur_quantities &quantities, ssc_number_t monthly_cumulative_excess_energy[12],
+		ssc_number_t excess_kwhs_earned[12], ssc_number_t excess_kwhs_applied[12], bool dc_enabled)
+	{
+		for (size_t m = 0; m < m_month.size() && m < quantities.month.size(); m++)
+		{
+			const ur_month &q = quantities.month[m];
+			m_month[m].energy_net = q.energy_net;
+			m_month[m].hours_per_month = q.hours_per_month;
+			m_month[m].dc_flat_peak = q.dc_flat_peak;
+			m_month[m].dc_flat_peak_hour = q.dc_flat_peak_hour;
+			m_month[m].ec_tou_ub = q.ec_tou_ub;
+			m_month[m].ec_tou_br = q.ec_tou_br;
+			m_month[m].ec_tou_sr = q.ec_tou_sr;
+			m_month[m].ec_periods_tiers = q.ec_periods_tiers;
+			m_month[m].ec_energy_use = q.ec_energy_use;
+			m_month[m].ec_energy_surplus = q.ec_energy_surplus;
+			m_month[m].ec_charge.resize_fill(q.ec_energy_use.nrows(), q.ec_energy_use.ncols(), 0);
+			if (dc_enabled)
+			{
+				m_month[m].dc_tou_peak = q.dc_tou_peak;
+				m_month[m].dc_tou_peak_hour = q.dc_tou_peak_hour;
+			}
+		}
+		for (int m = 0; m < 12; m++)
+		{
+			monthly_cumulative_excess_energy[m] = quantities.monthly_cumulative_excess_energy[m];
+			excess_kwhs_earned[m] = quantities.excess_kwhs_earned[m];
+			excess_kwhs_applied[m] = quantities.excess_kwhs_applied[m];
+		}
+	}
+
 	void ur_update_ec_monthly(int month, util::matrix_t<float>& charge, util::matrix_t<float>& energy, util::matrix_t<float>& surplus)
 		throw(general_error)
 	{
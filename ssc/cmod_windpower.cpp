@@ -78,6 +78,9 @@ static var_info _cm_vtab_windpower[] = {
 	{ SSC_INPUT, SSC_ARRAY,   "wind_farm_yCoordinates",				"Turbine Y coordinates",					"m",		"",		"WindPower",	"*",							"LENGTH_EQUAL=wind_farm_xCoordinates",				"" },
 	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_losses_percent",			"Percentage losses",						"%",		"",		"WindPower",	"*",							"",													"" },
 	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_model",				"Wake Model",								"0/1/2",	"",		"WindPower",	"*",							"INTEGER",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table",				"Use precomputed wake loss table",			"0/1",		"",		"WindPower",	"?=0",							"BOOLEAN",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table_dir_bin",		"Wake table wind direction bin size",		"deg",		"",		"WindPower",	"?=2",							"MIN=0.1,MAX=90",									"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_table_speed_bin",		"Wake table wind speed bin size",			"m/s",		"",		"WindPower",	"?=0.5",						"MIN=0.05,MAX=5",									"" },
 	{ SSC_INPUT, SSC_NUMBER,  "en_low_temp_cutoff",					"Enable Low Temperature Cutoff",			"0/1",		"",		"WindPower",	"?=0",							"INTEGER",											"" },
 	{ SSC_INPUT, SSC_NUMBER,  "low_temp_cutoff",					"Low Temperature Cutoff",					"C",		"",		"WindPower",	"en_low_temp_cutoff=1",			"",													"" },
 	{ SSC_INPUT, SSC_NUMBER,  "en_icing_cutoff",					"Enable Icing Cutoff",						"0/1",		"",		"WindPower",	"?=0",							"INTEGER",											"" },
@@ -100,6 +103,8 @@ static var_info _cm_vtab_windpower[] = {
 	{ SSC_OUTPUT, SSC_NUMBER, "kwh_per_kw",						"First year kWh/kW",						"kWh/kW",	"", "Annual", "*", "", "" },
 
 	{ SSC_OUTPUT, SSC_NUMBER, "cutoff_losses",                  "Cutoff losses",                            "%",		"", "Annual", "", "", "" },
+	{ SSC_OUTPUT, SSC_NUMBER, "wake_table_max_error",           "Wake table max farm power error on sampled steps", "kW", "", "Annual", "", "", "" },
+	{ SSC_OUTPUT, SSC_NUMBER, "wake_table_energy_error",        "Wake table farm energy error on sampled steps", "%", "", "Annual", "", "", "" },
 
 
 
@@ -359,6 +364,26 @@ void cm_windpower::exec() throw(general_error)
 	if (!wpc.InitializeModel(wakeModel))
 		throw exec_error("windpower", util::format("Wake model choice must be 0, 1 or 2"));
 
+	// optionally replace the per-step wake calculation with a direction x speed lookup table,
+	// checked against the exact wake model on a sample of timesteps. building the table takes one
+	// exact evaluation per node, so it is only built when there are more timesteps than nodes
+	bool useWakeTable = as_boolean("wind_farm_wake_table") && wpc.nTurbines > 1;
+	if (useWakeTable)
+	{
+		double dirBin = as_double("wind_farm_wake_table_dir_bin"), speedBin = as_double("wind_farm_wake_table_speed_bin");
+		size_t nWakeTableEvals = wpc.WakeTableEvaluations(dirBin, speedBin);
+		if (nWakeTableEvals >= nstep)
+		{
+			log(util::format("Wake table needs %d wake model evaluations for %d timesteps, using the wake model at each timestep instead.",
+				(int)nWakeTableEvals, (int)nstep), SSC_NOTICE);
+			useWakeTable = false;
+		}
+		else if (!wpc.InitializeWakeTable(dirBin, speedBin))
+			throw exec_error("windpower", "error building wake table: " + wpc.GetErrorDetails());
+	}
+	size_t wakeTableCheckStride = max_of(1.0, nstep / 200.0);
+	double wakeTableMaxError = 0.0, wakeTableSampledExact = 0.0, wakeTableSampledTable = 0.0;
+
 	// allocate output data
 	ssc_number_t *farmpwr = allocate("gen", nstep);
 	ssc_number_t *wspd = allocate("wind_speed", nstep);
@@ -369,6 +394,11 @@ void cm_windpower::exec() throw(general_error)
 	std::vector<double> Power(wpc.nTurbines, 0.), Thrust(wpc.nTurbines, 0.),
 		Eff(wpc.nTurbines, 0.), Wind(wpc.nTurbines, 0.), Turb(wpc.nTurbines, 0.),
 		DistDown(wpc.nTurbines, 0.), DistCross(wpc.nTurbines, 0.);
+	std::vector<double> checkPower, checkThrust, checkEff, checkWind, checkTurb, checkDistDown, checkDistCross;
+	if (useWakeTable)
+	{
+		checkPower = checkThrust = checkEff = checkWind = checkTurb = checkDistDown = checkDistCross = Power;
+	}
 
 	ssc_number_t *monthly = allocate("monthly_energy", 12);
 	for (int i = 0; i < 12; i++)
@@ -433,7 +463,24 @@ void cm_windpower::exec() throw(general_error)
 
 			double farmp = 0;
 
-			if ((int)wpc.nTurbines != wpc.windPowerUsingResource(
+			if (useWakeTable)
+			{
+				if ((int)wpc.nTurbines != wpc.windPowerUsingWakeTable(wind, dir, pres, temp,
+					&farmp, &Power[0], &Thrust[0], &Eff[0], &Wind[0], &Turb[0], &DistDown[0], &DistCross[0]))
+					throw exec_error("windpower", util::format("error in wind calculation at time %d, details: %s", i, wpc.GetErrorDetails().c_str()));
+
+				if (i % wakeTableCheckStride == 0)
+				{
+					double farmExact = 0;
+					if ((int)wpc.nTurbines != wpc.windPowerUsingResource(wind, dir, pres, temp,
+						&farmExact, &checkPower[0], &checkThrust[0], &checkEff[0], &checkWind[0], &checkTurb[0], &checkDistDown[0], &checkDistCross[0]))
+						throw exec_error("windpower", util::format("error in wind calculation at time %d, details: %s", i, wpc.GetErrorDetails().c_str()));
+					wakeTableMaxError = max_of(wakeTableMaxError, fabs(farmp - farmExact));
+					wakeTableSampledExact += farmExact;
+					wakeTableSampledTable += farmp;
+				}
+			}
+			else if ((int)wpc.nTurbines != wpc.windPowerUsingResource(
 				/* inputs */
 				wind,	/* m/s */
 				dir,	/* degrees */
@@ -484,6 +531,15 @@ void cm_windpower::exec() throw(general_error)
 	assign("kwh_per_kw", var_data((ssc_number_t)kWhperkW));
 	assign("cutoff_losses", var_data((ssc_number_t)((withoutLosses-annual)/ withoutLosses)));
 
+	if (useWakeTable)
+	{
+		double energyError = (wakeTableSampledExact > 0) ? 100.0 * (wakeTableSampledTable - wakeTableSampledExact) / wakeTableSampledExact : 0.0;
+		assign("wake_table_max_error", var_data((ssc_number_t)wakeTableMaxError));
+		assign("wake_table_energy_error", var_data((ssc_number_t)energyError));
+		log(util::format("Wake table error against the exact wake model on %d sampled steps: max %lg kW, energy %lg percent.",
+			(int)((nstep + wakeTableCheckStride - 1) / wakeTableCheckStride), wakeTableMaxError, energyError), SSC_NOTICE);
+	}
+
 } // exec
 
 DEFINE_MODULE_ENTRY(windpower, "Utility scale wind farm model (adapted from TRNSYS code by P.Quinlan and openWind software by AWS Truepower)", 2);
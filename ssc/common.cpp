@@ -960,15 +960,34 @@ void weatherdata::set_counter_to(size_t cur_index){
 
 bool weatherdata::read( weather_record *r )
 {
-	if (m_index < m_data.size())
+	if (read_at(m_index, r))
 	{
-		*r = *m_data[m_index++];
+		m_index++;
 		return true;
 	}
 	else
 		return false;
 }
 
+bool weatherdata::read_at( size_t index, weather_record *r )
+{
+	if (r && index < m_data.size())
+	{
+		*r = *m_data[index];
+		return true;
+	}
+	else
+		return false;
+}
+
+weather_data_provider *open_weather_resource(compute_module *cm, const std::string &name)
+{
+	var_data *v = cm->lookup(name);
+	if (v && v->weather)
+		return new shared_weather_reader(v->weather);
+	return new weatherfile(cm->as_string(name));
+}
+
 bool weatherdata::has_data_column( size_t id )
 {
 	return std::find( m_columns.begin(), m_columns.end(), id ) != m_columns.end();
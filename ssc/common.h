@@ -162,9 +162,15 @@ public:
 
 	void set_counter_to(size_t cur_index);
 	bool read(weather_record *r); // reads one more record	
+	bool read_at(size_t index, weather_record *r);
 	bool has_data_column(size_t id);
 };
 
+/* Opens the weather resource named by string variable 'name'. If a data set was attached to the
+variable with ssc_data_set_weather_handle, the returned provider reads it in place with its own
+record counter, otherwise the file is opened. Check ok() and message() on the result. */
+weather_data_provider *open_weather_resource(compute_module *cm, const std::string &name);
+
 bool ssc_cmod_update(std::string &log_msg, std::string &progress_msg, void *data, double progress, int out_type);
 
 #endif
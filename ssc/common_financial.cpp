@@ -51,6 +51,8 @@
 #include "core.h"
 #include <sstream>
 #include <sstream>
+#include <cmath>
+#include <limits>
 
 #ifndef WIN32
 #include <float.h>
@@ -3292,3 +3294,173 @@ bool hourly_energy_calculation::calculate(compute_module *cm)
 	return true;
 }
 
+
+static bool irr_is_valid_iter_bound(double estimated_return_rate)
+{
+	return estimated_return_rate != -1 && (estimated_return_rate < std::numeric_limits<int>::max()) && (estimated_return_rate > std::numeric_limits<int>::min());
+}
+
+irr_prefix_calculation::irr_prefix_calculation(double tolerance, int max_iterations)
+	: m_tolerance(tolerance), m_max_iterations(max_iterations)
+{
+}
+
+double irr_prefix_calculation::poly_sum(const util::matrix_t<double> &cf, int cf_line, int count, double rate)
+{
+	double sum_of_polynomial = 0;
+	if (irr_is_valid_iter_bound(rate))
+	{
+		// discount factors by running product instead of pow per year
+		double val = 1.0;
+		for (int j = 0; j <= count; j++)
+		{
+			if (val != 0.0)
+				sum_of_polynomial += cf.at(cf_line, j) / val;
+			else
+				break;
+			val *= (1 + rate);
+		}
+	}
+	return sum_of_polynomial;
+}
+
+double irr_prefix_calculation::derivative_sum(const util::matrix_t<double> &cf, int cf_line, int count, double rate)
+{
+	double sum_of_derivative = 0;
+	if (irr_is_valid_iter_bound(rate))
+	{
+		double val = (1 + rate);
+		for (int i = 1; i <= count; i++)
+		{
+			val *= (1 + rate);
+			sum_of_derivative += cf.at(cf_line, i)*(i) / val;
+		}
+	}
+	return sum_of_derivative*-1;
+}
+
+double irr_prefix_calculation::npv(const util::matrix_t<double> &cf, int cf_line, int count, double rate)
+{
+	double rr = 1.0;
+	if (rate != -1.0) rr = 1.0 / (1.0 + rate);
+	double result = 0;
+	for (int i = count; i > 0; i--)
+		result = rr * result + cf.at(cf_line, i);
+	return result*rr + cf.at(cf_line, 0);
+}
+
+int irr_prefix_calculation::sign_changes(const util::matrix_t<double> &cf, int cf_line, int count)
+{
+	int n_changes = 0;
+	double last = 0;
+	for (int i = 0; i <= count; i++)
+	{
+		double val = cf.at(cf_line, i);
+		if (val == 0) continue;
+		if (last != 0 && (val > 0) != (last > 0)) n_changes++;
+		last = val;
+	}
+	return n_changes;
+}
+
+double irr_prefix_calculation::calc(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double scale_factor, int &number_of_iterations, double &residual)
+{
+	// slope is held at the initial guess, as in the compute modules' irr_calc
+	double deriv_sum = derivative_sum(cf, cf_line, count, initial_guess);
+	if (deriv_sum == 0.0)
+		return initial_guess;
+
+	double calculated_irr = initial_guess - poly_sum(cf, cf_line, count, initial_guess) / deriv_sum;
+	number_of_iterations++;
+
+	double sum_of_polynomial = poly_sum(cf, cf_line, count, calculated_irr);
+	residual = sum_of_polynomial / scale_factor;
+
+	while (!(fabs(residual) <= m_tolerance) && (number_of_iterations < m_max_iterations))
+	{
+		calculated_irr = calculated_irr - sum_of_polynomial / deriv_sum;
+		number_of_iterations++;
+		sum_of_polynomial = poly_sum(cf, cf_line, count, calculated_irr);
+		residual = sum_of_polynomial / scale_factor;
+	}
+	return calculated_irr;
+}
+
+bool irr_prefix_calculation::is_valid(const util::matrix_t<double> &cf, int cf_line, int count, double residual, int number_of_iterations, double calculated_irr, double scale_factor)
+{
+	double npv_of_irr = npv(cf, cf_line, count, calculated_irr);
+	double npv_of_irr_plus_delta = npv(cf, cf_line, count, calculated_irr + 0.001);
+	return ((number_of_iterations < m_max_iterations) && (fabs(residual) < m_tolerance) && (npv_of_irr > npv_of_irr_plus_delta) && (fabs(npv_of_irr / scale_factor) < m_tolerance));
+}
+
+double irr_prefix_calculation::irr(const util::matrix_t<double> &cf, int cf_line, int count)
+{
+	if (m_count.size() < cf.nrows())
+	{
+		m_count.resize(cf.nrows(), -1);
+		m_root.resize(cf.nrows(), std::numeric_limits<double>::quiet_NaN());
+	}
+
+	double warm_guess = std::numeric_limits<double>::quiet_NaN();
+	if (m_count[cf_line] == count - 1) warm_guess = m_root[cf_line];
+	m_count[cf_line] = count;
+	m_root[cf_line] = std::numeric_limits<double>::quiet_NaN();
+
+	double calculated_irr = std::numeric_limits<double>::quiet_NaN();
+
+	// only possible for first value negative
+	if ((count < 1) || (cf.at(cf_line, 0) > 0))
+		return calculated_irr;
+
+	// scale to max value for better irr convergence
+	double scale_factor = fabs(cf.at(cf_line, 0));
+	for (int i = 0; i <= count; i++)
+		if (fabs(cf.at(cf_line, i)) > scale_factor) scale_factor = fabs(cf.at(cf_line, i));
+	if (scale_factor <= 0) scale_factor = 1;
+
+	int number_of_iterations = 0;
+	double residual = DBL_MAX;
+
+	// previous year's root. With more than one sign change there can be several roots, and
+	// the one nearest the previous root may not be the one that the cold start finds.
+	if ((warm_guess == warm_guess) && (sign_changes(cf, cf_line, count) == 1))
+	{
+		calculated_irr = calc(cf, cf_line, count, warm_guess, scale_factor, number_of_iterations, residual);
+		if (is_valid(cf, cf_line, count, residual, number_of_iterations, calculated_irr, scale_factor))
+		{
+			m_root[cf_line] = calculated_irr;
+			return calculated_irr;
+		}
+	}
+
+	// initial guess from http://zainco.blogspot.com/2008/08/internal-rate-of-return-using-newton.html
+	double initial_guess = -2;
+	if (cf.at(cf_line, 0) != 0)
+	{
+		if (count > 1) // second order
+		{
+			double b = 2.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0);
+			double c = 1.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0) + cf.at(cf_line, 2) / cf.at(cf_line, 0);
+			initial_guess = -0.5*b - 0.5*sqrt(b*b - 4.0*c);
+			if ((initial_guess <= 0) || (initial_guess >= 1)) initial_guess = -0.5*b + 0.5*sqrt(b*b - 4.0*c);
+		}
+		else // first order
+			initial_guess = -(1.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0));
+	}
+
+	// then 0.1, -0.1 and 0 as initial guesses
+	double guesses[4] = { initial_guess, 0.1, -0.1, 0 };
+	for (int k = 0; k < 4; k++)
+	{
+		number_of_iterations = 0;
+		residual = (k == 0) ? DBL_MAX : 0;
+		calculated_irr = calc(cf, cf_line, count, guesses[k], scale_factor, number_of_iterations, residual);
+		if (is_valid(cf, cf_line, count, residual, number_of_iterations, calculated_irr, scale_factor))
+		{
+			m_root[cf_line] = calculated_irr;
+			return calculated_irr;
+		}
+	}
+
+	return std::numeric_limits<double>::quiet_NaN(); // did not converge
+}
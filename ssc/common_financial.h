@@ -114,6 +114,32 @@ public:
 };
 
 
+// IRR of the cash flow prefix [0,count] of a cash flow line, for the per-year irr
+// rows and the irr outputs of the finance compute modules. Calls for count-1 and
+// count on the same line in turn warm start count from the count-1 root when the
+// prefix changes sign only once, so that the irr is unique; otherwise (or if the
+// warm start fails) the cold start guesses of the modules' original irr are used.
+class irr_prefix_calculation
+{
+private:
+	double m_tolerance;
+	int m_max_iterations;
+	std::vector<int> m_count;
+	std::vector<double> m_root;
+
+	double poly_sum(const util::matrix_t<double> &cf, int cf_line, int count, double rate);
+	double derivative_sum(const util::matrix_t<double> &cf, int cf_line, int count, double rate);
+	double npv(const util::matrix_t<double> &cf, int cf_line, int count, double rate);
+	int sign_changes(const util::matrix_t<double> &cf, int cf_line, int count);
+	double calc(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double scale_factor, int &number_of_iterations, double &residual);
+	bool is_valid(const util::matrix_t<double> &cf, int cf_line, int count, double residual, int number_of_iterations, double calculated_irr, double scale_factor);
+
+public:
+	irr_prefix_calculation(double tolerance = 1e-6, int max_iterations = 100);
+	double irr(const util::matrix_t<double> &cf, int cf_line, int count);
+};
+
+
 
 
 /*
@@ -51,20 +51,220 @@
 #include <fstream>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
 
 #include "core.h"
 
 const var_info var_info_invalid = {	0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
 
+// one '&', '|' or test term of a required_if expression
+struct var_required_term
+{
+	var_required_term() : cond_oper(0), op(0) { }
+	char cond_oper; // '&' or '|' for a condition operator, 0 for a test
+	char op; // '=', '~', '<', '>', ':'
+	std::string lhs, rhs, expr;
+	std::string error; // reason the term could not be parsed, reported when evaluated
+};
+
+// one entry of a constraints list
+struct var_constraint
+{
+	enum { TMYEPW, LOCAL_FILE, MXH_SCHEDULE, BOOLEAN, INTEGER, TOUSCHED, POSITIVE, PERCENT, FACTOR, TS_M,
+		MIN, MAX, LENGTH, LENGTH_EQUAL, LENGTH_MULTIPLE_OF, ROWS, COLS, INVALID };
+
+	var_constraint() : test(INVALID), ok(true), value(0) { }
+	int test;
+	bool ok; // numeric rhs was valid
+	double value;
+	std::string rhs, expr;
+};
+
+struct var_info_compiled
+{
+	enum { NOT_REQUIRED, ALWAYS, DEFAULT, CONDITIONAL };
+
+	var_info_compiled() : vi(0), required(NOT_REQUIRED), default_ok(false) { }
+	var_info *vi;
+	int required;
+	std::string required_expr;
+	var_data default_value;
+	bool default_ok;
+	std::vector< var_required_term > terms;
+	std::vector< var_constraint > constraints;
+};
+
+class var_info_table
+{
+public:
+	var_info_table( var_info vi[] );
+
+	const var_info_compiled *find( const std::string &name ) const
+	{
+		unordered_map< std::string, size_t >::const_iterator pos = m_index.find( name );
+		return pos != m_index.end() ? &m_vars[pos->second] : 0;
+	}
+
+	var_info *begin_ptr;
+	std::vector< var_info_compiled > m_vars;
+
+private:
+	unordered_map< std::string, size_t > m_index;
+};
+
+static void compile_required( var_info_compiled &vc )
+{
+	const var_info &inf = *vc.vi;
+	if (inf.required_if == NULL || strlen(inf.required_if)==0)
+		return;
+
+	std::string reqexpr = inf.required_if;
+	vc.required_expr = reqexpr;
+
+	if (reqexpr == "*")
+		vc.required = var_info_compiled::ALWAYS;
+	else if (reqexpr == "?")
+		vc.required = var_info_compiled::NOT_REQUIRED;
+	else if (reqexpr.length() > 2 && reqexpr[0] == '?' && reqexpr[1] == '=')
+	{
+		vc.required = var_info_compiled::DEFAULT;
+		vc.default_ok = var_data::parse( inf.data_type, reqexpr.substr(2), vc.default_value );
+	}
+	else
+	{
+		vc.required = var_info_compiled::CONDITIONAL;
+		std::vector< std::string > expr_list = util::split(util::lower_case(reqexpr), "&|", true, true );
+		for ( std::vector< std::string >::iterator it = expr_list.begin(); it != expr_list.end(); ++it )
+		{
+			var_required_term t;
+			t.expr = *it;
+			if (t.expr == "&" || t.expr == "|")
+			{
+				t.cond_oper = t.expr[0];
+				vc.terms.push_back( t );
+				continue;
+			}
+
+			std::string::size_type pos = std::string::npos;
+			if ( (pos=t.expr.find('=')) != std::string::npos ) t.op = '=';
+			else if ( (pos=t.expr.find('~')) != std::string::npos) t.op = '~';
+			else if ( (pos=t.expr.find('<')) != std::string::npos ) t.op = '<';
+			else if ( (pos=t.expr.find('>')) != std::string::npos ) t.op = '>';
+			else if ( (pos=t.expr.find(':')) != std::string::npos ) t.op = ':';
+
+			if (!t.op)
+				t.error = "invalid operator";
+			else
+			{
+				t.lhs = t.expr.substr(0, pos);
+				t.rhs = t.expr.substr(pos+1);
+				if (t.lhs.length() < 1 || t.rhs.length() < 1)
+					t.error = "null lhs or rhs in subexpr";
+			}
+			vc.terms.push_back( t );
+		}
+	}
+}
+
+static void compile_constraints( var_info_compiled &vc )
+{
+	if (vc.vi->constraints == NULL) return;
+
+	std::vector< std::string > exprlist = util::split( vc.vi->constraints, "," );
+	for ( std::vector<std::string>::iterator it=exprlist.begin(); it!=exprlist.end(); ++it )
+	{
+		var_constraint c;
+		c.expr = util::lower_case(*it);
+
+		std::string::size_type pos;
+		if (c.expr == "tmyepw") c.test = var_constraint::TMYEPW;
+		else if (c.expr == "local_file") c.test = var_constraint::LOCAL_FILE;
+		else if (c.expr == "mxh_schedule") c.test = var_constraint::MXH_SCHEDULE;
+		else if (c.expr == "boolean") c.test = var_constraint::BOOLEAN;
+		else if (c.expr == "integer") c.test = var_constraint::INTEGER;
+		else if (c.expr == "tousched") c.test = var_constraint::TOUSCHED;
+		else if (c.expr == "positive") c.test = var_constraint::POSITIVE;
+		else if (c.expr == "percent") c.test = var_constraint::PERCENT;
+		else if (c.expr == "factor") c.test = var_constraint::FACTOR;
+		else if (c.expr == "ts_m") c.test = var_constraint::TS_M;
+		else if ( (pos=c.expr.find('=')) != std::string::npos )
+		{
+			std::string test = c.expr.substr(0, pos);
+			c.rhs = c.expr.substr(pos+1);
+
+			int ival = 0;
+			if (test == "min" || test == "max")
+			{
+				c.test = (test == "min") ? var_constraint::MIN : var_constraint::MAX;
+				c.ok = util::to_double( c.rhs, &c.value );
+			}
+			else if (test == "length")
+			{
+				c.test = var_constraint::LENGTH;
+				c.ok = util::to_integer( c.rhs, &ival );
+				c.value = ival;
+			}
+			else if (test == "length_equal")
+				c.test = var_constraint::LENGTH_EQUAL;
+			else if (test == "length_multiple_of" || test == "rows" || test == "cols")
+			{
+				if (test == "length_multiple_of") c.test = var_constraint::LENGTH_MULTIPLE_OF;
+				else if (test == "rows") c.test = var_constraint::ROWS;
+				else c.test = var_constraint::COLS;
+				c.ok = util::to_integer( c.rhs, &ival ) && ival >= 1;
+				c.value = ival;
+			}
+			else
+				continue; // unrecognized tests with a value are not checked
+		}
+
+		vc.constraints.push_back( c );
+	}
+}
+
+var_info_table::var_info_table( var_info vi[] )
+	: begin_ptr( vi )
+{
+	int i=0;
+	while ( vi[i].data_type != SSC_INVALID
+		&& vi[i].name != NULL )
+	{
+		var_info_compiled vc;
+		vc.vi = &vi[i];
+		compile_required( vc );
+		compile_constraints( vc );
+		m_vars.push_back( vc );
+		i++;
+	}
+
+	// first entry wins for duplicated names, as with a linear search
+	for ( size_t k=0; k<m_vars.size(); k++ )
+		if ( m_index.find( m_vars[k].vi->name ) == m_index.end() )
+			m_index[ m_vars[k].vi->name ] = k;
+}
+
+// var_info tables are static arrays in each compute module, so the parsed
+// tables are kept for the lifetime of the process
+static std::mutex var_info_tables_mutex;
+static unordered_map< const var_info*, var_info_table* > var_info_tables;
+
+static const var_info_table *get_var_info_table( var_info vi[] )
+{
+	std::lock_guard<std::mutex> lock(var_info_tables_mutex);
+	var_info_table *&t = var_info_tables[vi];
+	if (!t) t = new var_info_table( vi );
+	return t;
+}
+
 compute_module::compute_module( )
-	:  m_infomap(NULL), m_handler(NULL), m_vartab(NULL)
+	:  m_handler(NULL), m_vartab(NULL)
 {
 	/* nothing to do */
 }
 
 compute_module::~compute_module()
 {
-	if (m_infomap) delete m_infomap;
+	/* nothing to do */
 }
 
 bool compute_module::compute( handler_interface *handler, var_table *data )
@@ -108,14 +308,14 @@ bool compute_module::compute( handler_interface *handler, var_table *data )
 
 bool compute_module::verify(const std::string &phase, int check_var_type) throw( general_error )
 {
-	std::vector< var_info* >::iterator it;
-	for (it=m_varlist.begin();it!=m_varlist.end();++it)
+	for (size_t i=0;i<m_varcompiled.size();i++)
 	{
-		var_info *vi = *it;
+		const var_info_compiled &vc = *m_varcompiled[i];
+		var_info *vi = vc.vi;
 		if ( vi->var_type == check_var_type
 			|| vi->var_type == SSC_INOUT )
 		{
-			if ( check_required( vi->name ) )
+			if ( check_required( vc ) )
 			{
 				// if the variable is required, make sure it exists
 				// and that it is of the correct data type
@@ -133,7 +333,7 @@ bool compute_module::verify(const std::string &phase, int check_var_type) throw(
 
 				// now check constraints on it
 				std::string fail_text;
-				if (!check_constraints( vi->name, fail_text ))
+				if (!check_constraints( vc, fail_text ))
 				{
 					log(fail_text, SSC_ERROR);
 					return false;
@@ -147,37 +347,26 @@ bool compute_module::verify(const std::string &phase, int check_var_type) throw(
 
 void compute_module::add_var_info( var_info vi[] )
 {
-	int i=0;
-	while ( vi[i].data_type != SSC_INVALID
-		&& vi[i].name != NULL )
+	const var_info_table *t = get_var_info_table( vi );
+	m_vartables.push_back( t );
+	for (size_t i=0;i<t->m_vars.size();i++)
 	{
-		m_varlist.push_back( &vi[i] );
-		i++;
+		m_varlist.push_back( t->m_vars[i].vi );
+		m_varcompiled.push_back( &t->m_vars[i] );
 	}
 }
 
 void compute_module::remove_var_info(var_info vi[])
 {
-	int i = 0;
-	while (vi[i].data_type != SSC_INVALID
-		&& vi[i].name != NULL)
+	const var_info_table *t = get_var_info_table( vi );
+	m_vartables.erase(std::remove(m_vartables.begin(), m_vartables.end(), t), m_vartables.end());
+	for (size_t i=0;i<t->m_vars.size();i++)
 	{
-		m_varlist.erase(std::remove(m_varlist.begin(), m_varlist.end(), &vi[i]), m_varlist.end());
-		i++;
+		m_varlist.erase(std::remove(m_varlist.begin(), m_varlist.end(), t->m_vars[i].vi), m_varlist.end());
+		m_varcompiled.erase(std::remove(m_varcompiled.begin(), m_varcompiled.end(), &t->m_vars[i]), m_varcompiled.end());
 	}
 }
 
-void compute_module::build_info_map()
-{
-	if (m_infomap) delete m_infomap;
-
-	m_infomap = new unordered_map<std::string, var_info*>;
-	
-	std::vector<var_info*>::iterator it;
-	for (it = m_varlist.begin(); it != m_varlist.end(); ++it)
-		(*m_infomap)[ (*it)->name ] = *it;
-}
-
 bool compute_module::update( const std::string &current_action, float percent_done, float time )
 {
 	// forward to handler interface
@@ -226,39 +415,20 @@ var_info *compute_module::info(int index)
 
 const var_info &compute_module::info( const std::string &name ) throw( general_error )
 {
-	// if there is an info lookup table, use it
-	if (m_infomap != NULL)
-	{
-		unordered_map<std::string, var_info*>::iterator pos = m_infomap->find(name);
-		if (pos != m_infomap->end())
-			return (*(pos->second));
-	}
-
-	// otherwise search
-	std::vector< var_info* >::iterator it;
-	for (it = m_varlist.begin(); it != m_varlist.end(); ++it)
-	{
-		if ( (*it)->name == name )
-			return *(*it);
-	}
+	for (size_t i=0;i<m_vartables.size();i++)
+		if (const var_info_compiled *vc = m_vartables[i]->find( name ))
+			return *vc->vi;
 
 	throw general_error("variable information lookup fail: '" + name + "'");
 }
 
 bool compute_module::is_ssc_array_output( const std::string &name ) throw( general_error )
 {
-	// if there is an info lookup table, use it
-	if (m_infomap != NULL)
-	{
-		unordered_map<std::string, var_info*>::iterator pos = m_infomap->find(name);
-		if (pos != m_infomap->end())
-		{
-			if ( ( ((pos->second)->var_type == SSC_OUTPUT) || ((pos->second)->var_type == SSC_INOUT) ) && (pos->second)->data_type == SSC_ARRAY )
-				return true;
-		}
-	}
+	for (size_t i=0;i<m_vartables.size();i++)
+		if (const var_info_compiled *vc = m_vartables[i]->find( name ))
+			return ( (vc->vi->var_type == SSC_OUTPUT) || (vc->vi->var_type == SSC_INOUT) ) && vc->vi->data_type == SSC_ARRAY;
 
-	// otherwise search
+	// otherwise search, names are matched case insensitively
 	std::vector< var_info* >::iterator it;
 	for (it = m_varlist.begin(); it != m_varlist.end(); ++it)
 	{
@@ -497,6 +667,13 @@ util::matrix_t<double> compute_module::as_matrix_transpose(const std::string &na
 	return mat;
 }
 
+util::matrix_view_t<ssc_number_t> compute_module::as_matrix_view(const std::string &name) throw(general_error)
+{
+	var_data &x = value(name);
+	if (x.type != SSC_MATRIX && x.type != SSC_ARRAY) throw cast_error("matrix", x, name);
+	return util::matrix_view_t<ssc_number_t>( x.num );
+}
+
 bool compute_module::get_matrix(const std::string &name, util::matrix_t<ssc_number_t> &mat) throw(general_error)
 {
 	var_data &x = value(name);
@@ -537,35 +714,33 @@ ssc_number_t compute_module::get_operand_value( const std::string &input, const
 	}
 }
 
-bool compute_module::check_required( const std::string &name ) throw( general_error )
+bool compute_module::check_required( const var_info_compiled &vc ) throw( general_error )
 {
 	// only check if the variable is required as input to the simulation context
 	// if it is an input or an inout variable
 
-	const var_info &inf = info(name);
-	if (inf.required_if == NULL || strlen(inf.required_if)==0)
-		return false;
+	const var_info &inf = *vc.vi;
+	const std::string name = inf.name;
+	const std::string &reqexpr = vc.required_expr;
 
-	std::string reqexpr = inf.required_if;
-
-	if (reqexpr == "*")
+	if (vc.required == var_info_compiled::ALWAYS)
 	{
 		return true; // Always required
 	}
-	else if (reqexpr == "?")
+	else if (vc.required == var_info_compiled::NOT_REQUIRED)
 	{
 		return false; // Always optional
 	}
-	else if (reqexpr.length() > 2 && reqexpr[0] == '?' && reqexpr[1] == '=')
+	else if (vc.required == var_info_compiled::DEFAULT)
 	{
 		// optional but has a default value that is assigned if variable is unassigned
 		var_data *v = lookup(name);
 		if (!v)
 		{
-			v = assign(name, m_null_value );
-
-			if ( !var_data::parse( inf.data_type, reqexpr.substr(2), *v ) )
+			if ( !vc.default_ok )
 				throw check_error(name, "could not parse default value in required_if spec (" + var_data::type_name(inf.data_type) + ")", reqexpr);
+
+			assign(name, vc.default_value );
 		}
 
 		return true; // a default value has been assigned, so this variable is effectively always required
@@ -573,15 +748,12 @@ bool compute_module::check_required( const std::string &name ) throw( general_er
 	else
 	{
 		// run tests
-		std::string::size_type pos = std::string::npos;
-		std::vector< std::string > expr_list = util::split(util::lower_case(reqexpr), "&|", true, true );
-		
 		int cur_result = -1;
 		char cur_cond_oper = 0;
-		for ( std::vector< std::string >::iterator it = expr_list.begin(); it != expr_list.end(); ++it )
+		for ( std::vector< var_required_term >::const_iterator it = vc.terms.begin(); it != vc.terms.end(); ++it )
 		{
-			std::string expr = *it;
-			if (expr == "&")
+			const std::string &expr = it->expr;
+			if (it->cond_oper == '&')
 			{
 				if (cur_result == 0) // short circuit evaluation
 					break;
@@ -589,7 +761,7 @@ bool compute_module::check_required( const std::string &name ) throw( general_er
 				cur_cond_oper = '&';
 				continue;
 			}
-			else if (expr == "|")
+			else if (it->cond_oper == '|')
 			{
 				if (cur_result > 0) // short circuit evaluation
 					break;
@@ -600,19 +772,11 @@ bool compute_module::check_required( const std::string &name ) throw( general_er
 			else
 			{
 				int expr_result = 0;
-				char op = 0;
-				if ( (pos=expr.find('=')) != std::string::npos ) op = '=';
-				else if ( (pos=expr.find('~')) != std::string::npos) op = '~';
-				else if ( (pos=expr.find('<')) != std::string::npos ) op = '<';
-				else if ( (pos=expr.find('>')) != std::string::npos ) op = '>';
-				else if ( (pos=expr.find(':')) != std::string::npos ) op = ':';
+				if (!it->error.empty()) throw check_error(name, it->error, expr );
 
-				if (!op) throw check_error(name, "invalid operator", expr );
-
-				std::string lhs = expr.substr(0, pos);
-				std::string rhs = expr.substr(pos+1);
-				
-				if (lhs.length() < 1 || rhs.length() < 1) throw check_error(name, "null lhs or rhs in subexpr", expr);
+				char op = it->op;
+				const std::string &lhs = it->lhs;
+				const std::string &rhs = it->rhs;
 
 				if (op == ':')
 				{
@@ -694,22 +858,21 @@ bool compute_module::check_required( const std::string &name ) throw( general_er
 	return false;
 }
 
-bool compute_module::check_constraints( const std::string &name, std::string &fail_text) throw( general_error )
+bool compute_module::check_constraints( const var_info_compiled &vc, std::string &fail_text) throw( general_error )
 {
 #define fail_constraint( str ) { fail_text = "fail("+name+", "+expr+"): "+std::string(str); return false; }
 
-	const var_info &inf = info(name);
-
-	if (inf.constraints == NULL) return true; // pass if no constraints defined
+	if (vc.constraints.empty()) return true; // pass if no constraints defined
 
+	const std::string name = vc.vi->name;
 	var_data &dat = value(name);
 	
-	std::vector< std::string > exprlist = util::split( inf.constraints, "," );
-	for ( std::vector<std::string>::iterator it=exprlist.begin(); it!=exprlist.end(); ++it )
+	for ( std::vector<var_constraint>::const_iterator it=vc.constraints.begin(); it!=vc.constraints.end(); ++it )
 	{
-		std::string::size_type pos;
-		std::string expr = util::lower_case(*it);
-		if (expr == "tmyepw")
+		const std::string &expr = it->expr;
+		switch( it->test )
+		{
+		case var_constraint::TMYEPW:
 		{
 			if (dat.type != SSC_STRING || dat.str.length() <= 4)
 				fail_constraint("string data type required with length greater than 4 chars: " + dat.str);
@@ -717,8 +880,9 @@ bool compute_module::check_constraints( const std::string &name, std::string &fa
 			std::string ext = util::lower_case( dat.str.substr( dat.str.length()-3 ) );
 			if (ext != "tm2" || ext != "tm3" || ext != "epw" || ext != "csv")
 				fail_constraint("file extension was not tm2,tm3,epw,csv: " + ext);
+			break;
 		}
-		else if (expr == "local_file")
+		case var_constraint::LOCAL_FILE:
 		{
 			if (dat.type != SSC_STRING)
 				fail_constraint("string data type required");
@@ -728,9 +892,9 @@ bool compute_module::check_constraints( const std::string &name, std::string &fa
 				f_in.close();
 			else
 				fail_constraint("could not open for read: '" + dat.str + "'");
+			break;
 		}
-		else if (expr == "mxh_schedule")
-		{
+		case var_constraint::MXH_SCHEDULE:
 			if (dat.type != SSC_STRING)
 				fail_constraint("string data type required");
 
@@ -740,8 +904,8 @@ bool compute_module::check_constraints( const std::string &name, std::string &fa
 			for ( std::string::size_type i=0;i<dat.str.length(); i++)
 				if ( dat.str[i] < '0' || dat.str[i] > '9' ) 
 					fail_constraint( util::format("invalid character %c at %d", (char)dat.str[i], (int)i) );
-		}
-		else if (expr == "boolean")
+			break;
+		case var_constraint::BOOLEAN:
 		{
 			if (dat.type != SSC_NUMBER)
 				fail_constraint("number data type required");
@@ -749,17 +913,16 @@ bool compute_module::check_constraints( const std::string &name, std::string &fa
 			int val = (int)dat.num;
 			if (val != 0 && val != 1)
 				fail_constraint("value was not 0 nor 1");
+			break;
 		}
-		else if (expr == "integer")
-		{
+		case var_constraint::INTEGER:
 			if (dat.type != SSC_NUMBER)
 				fail_constraint("number data type required");
 
 			if ( ((ssc_number_t)((int)dat.num)) != dat.num )
 				fail_constraint("number could not be interpreted as an integer: " + util::to_string( (double) dat.num ));
-		}
-		else if (expr == "tousched")
-		{
+			break;
+		case var_constraint::TOUSCHED:
 			if (dat.type != SSC_STRING)
 				fail_constraint("string data type required");
 
@@ -768,30 +931,26 @@ bool compute_module::check_constraints( const std::string &name, std::string &fa
 
 			for (std::string::size_type i=0;i<dat.str.length();i++)
 			{
-//				if ( dat.str[i] < '1' || dat.str[i] > '9' )
 				if ( util::schedule_char_to_int(dat.str[i]) == 0 )
 					fail_constraint("all digits must be between 1 and 9, inclusive");
 			}
-		}
-		else if (expr == "positive")
-		{
+			break;
+		case var_constraint::POSITIVE:
 			if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for positive with non-numeric type", expr);
 			if (dat.num <= 0.0)
 				fail_constraint( util::to_string( (double)dat.num ) );
-		}
-		else if (expr == "percent")
-		{
+			break;
+		case var_constraint::PERCENT:
 			if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for percent (%) constraint with non-numeric type", expr);
 			if (dat.num < 0.0 || dat.num > 100.0)
 				fail_constraint( util::to_string( (double)dat.num ) );
-		}
-		else if (expr == "factor")
-		{
+			break;
+		case var_constraint::FACTOR:
 			if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for factor (0..1) constraint with non-numeric type", expr);
 			if (dat.num < 0.0 || dat.num > 1.0)
 				fail_constraint( util::to_string( (double)dat.num ) );
-		}
-		else if (expr == "ts_m")
+			break;
+		case var_constraint::TS_M:
 		{
 			if (dat.type != SSC_NUMBER)
 				fail_constraint("number data type required");
@@ -807,86 +966,69 @@ bool compute_module::check_constraints( const std::string &name, std::string &fa
 			{
 				fail_constraint("time step must be 1,5,10,15,30,60 minutes");
 			}
+			break;
 		}
-		else if ( (pos=expr.find('=')) != std::string::npos )
+		case var_constraint::MIN:
+			if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for min with non-numeric type", expr);
+			if (!it->ok) throw constraint_error(name, "test for min requires a number value", expr);
+			if ( dat.num < (ssc_number_t)it->value )
+				fail_constraint( util::to_string( (double)dat.num ) );
+			break;
+		case var_constraint::MAX:
+			if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for max with non-numeric type", expr);
+			if (!it->ok) throw constraint_error(name, "test for max requires a numeric value", expr);
+			if (dat.num > (ssc_number_t)it->value )
+				fail_constraint( util::to_string( (double)dat.num ) );
+			break;
+		case var_constraint::LENGTH:
+			if (dat.type != SSC_ARRAY) throw constraint_error(name, "cannot test for length with non-array type", expr);
+			if (!it->ok) throw constraint_error(name, "test for length requires an integer value", expr);
+			if (dat.num.length() != (size_t)it->value)
+				fail_constraint( util::to_string( (int)dat.num.length() ) );
+			break;
+		case var_constraint::LENGTH_EQUAL:
 		{
-			std::string test = expr.substr(0, pos);
-			std::string rhs = expr.substr(pos+1);
-
-			if (test == "min")
+			if (dat.type != SSC_ARRAY) throw constraint_error(name, "cannot test for length_equal with non-array type", expr);
+			var_data *other = lookup( it->rhs );
+			if (!other) throw constraint_error(name, "length_equal cannot find variable to test against", expr);
+			if (other->type == SSC_ARRAY)
 			{
-				if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for min with non-numeric type", expr);
-				double minval = 0;
-				if (!util::to_double( rhs, &minval )) throw constraint_error(name, "test for min requires a number value", expr);
-				if ( dat.num < (ssc_number_t)minval )
-					fail_constraint( util::to_string( (double)dat.num ) );
+				if (dat.num.length() != other->num.length())
+					fail_constraint( util::to_string( (int) other->num.length() ) );
 			}
-			else if (test == "max")
+			else if (other->type == SSC_NUMBER)
 			{
-				if (dat.type != SSC_NUMBER) throw constraint_error(name, "cannot test for max with non-numeric type", expr);
-				double maxval = 0;
-				if (!util::to_double( rhs, &maxval )) throw constraint_error(name, "test for max requires a numeric value", expr);
-				if (dat.num > (ssc_number_t)maxval )
-					fail_constraint( util::to_string( (double)dat.num ) );
-			}
-			else if (test == "length")
-			{
-				if (dat.type != SSC_ARRAY) throw constraint_error(name, "cannot test for length with non-array type", expr);
-				int lenval = 0;
-				if (!util::to_integer( rhs, &lenval )) throw constraint_error(name, "test for length requires an integer value", expr);
-				size_t len = (size_t)lenval;
-				if (dat.num.length() != len)
-					fail_constraint( util::to_string( (int)dat.num.length() ) );
-			}
-			else if (test == "length_equal")
-			{
-				if (dat.type != SSC_ARRAY) throw constraint_error(name, "cannot test for length_equal with non-array type", expr);
-				var_data *other = lookup( rhs );
-				if (!other) throw constraint_error(name, "length_equal cannot find variable to test against", expr);
-				if (other->type == SSC_ARRAY)
-				{
-					if (dat.num.length() != other->num.length())
-						fail_constraint( util::to_string( (int) other->num.length() ) );
-				}
-				else if (other->type == SSC_NUMBER)
-				{
-					if (dat.num.length() != (size_t)(ssc_number_t)other->num)
-						fail_constraint( util::to_string( (int) other->num ) );
-				}
-				else throw constraint_error(name, "length_equal must specify a number or array variable to test against", expr);
-			}
-			else if (test == "length_multiple_of")
-			{
-				if (dat.type != SSC_ARRAY) throw constraint_error(name, "cannot test for length_multiple_of with non-array type", expr);
-				int lenval = 0;
-				if (!util::to_integer( rhs, &lenval ) || lenval < 1) throw constraint_error(name, "test for length_multiple_of requires a positive integer value", expr);
-				size_t len = (size_t)lenval;
-				size_t multiplier = dat.num.length() / len;
-				if ( dat.num.length() < len || len*multiplier != dat.num.length() )
-					fail_constraint( util::to_string( (int)dat.num.length() ) );
-			}
-			else if (test == "rows")
-			{
-				if (dat.type != SSC_MATRIX) throw constraint_error(name, "cannot test for rows with non-matrix type", expr);
-				int nrows = 0;
-				if (!util::to_integer( rhs, &nrows ) || nrows < 1) throw constraint_error(name, "test for rows requires a positive integer value", expr);
-				if ( dat.num.nrows() != (size_t)nrows )
-					fail_constraint( util::to_string( (int)dat.num.nrows() ) );
-			}
-			else if (test == "cols")
-			{
-				if (dat.type != SSC_MATRIX) throw constraint_error(name, "cannot test for cols with non-matrix type", expr);
-				int ncols = 0;
-				if (!util::to_integer( rhs, &ncols) || ncols < 1) throw constraint_error(name, "test for cols requires a positive integer value", expr);
-				if ( dat.num.ncols() != (size_t)ncols )
-					fail_constraint( util::to_string( (int)dat.num.ncols() ) );
+				if (dat.num.length() != (size_t)(ssc_number_t)other->num)
+					fail_constraint( util::to_string( (int) other->num ) );
 			}
+			else throw constraint_error(name, "length_equal must specify a number or array variable to test against", expr);
+			break;
 		}
-		else
+		case var_constraint::LENGTH_MULTIPLE_OF:
 		{
+			if (dat.type != SSC_ARRAY) throw constraint_error(name, "cannot test for length_multiple_of with non-array type", expr);
+			if (!it->ok) throw constraint_error(name, "test for length_multiple_of requires a positive integer value", expr);
+			size_t len = (size_t)it->value;
+			size_t multiplier = dat.num.length() / len;
+			if ( dat.num.length() < len || len*multiplier != dat.num.length() )
+				fail_constraint( util::to_string( (int)dat.num.length() ) );
+			break;
+		}
+		case var_constraint::ROWS:
+			if (dat.type != SSC_MATRIX) throw constraint_error(name, "cannot test for rows with non-matrix type", expr);
+			if (!it->ok) throw constraint_error(name, "test for rows requires a positive integer value", expr);
+			if ( dat.num.nrows() != (size_t)it->value )
+				fail_constraint( util::to_string( (int)dat.num.nrows() ) );
+			break;
+		case var_constraint::COLS:
+			if (dat.type != SSC_MATRIX) throw constraint_error(name, "cannot test for cols with non-matrix type", expr);
+			if (!it->ok) throw constraint_error(name, "test for cols requires a positive integer value", expr);
+			if ( dat.num.ncols() != (size_t)it->value )
+				fail_constraint( util::to_string( (int)dat.num.ncols() ) );
+			break;
+		default:
 			throw constraint_error( name, "invalid test or expression", expr );
 		}
-
 	}
 
 	// all constraints passed fine
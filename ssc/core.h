@@ -141,6 +141,8 @@ struct var_info
 extern const var_info var_info_invalid;
 
 class handler_interface; // forward decl
+struct var_info_compiled; // parsed required_if/constraints of one var_info, see core.cpp
+class var_info_table; // parsed var_info table shared by all module instances, see core.cpp
 
 class compute_module
 {
@@ -242,10 +244,9 @@ protected:
 	virtual void exec( ) throw( general_error ) = 0;
 
 	
-	/* can be called in constructors to build up the variable table references */
+	/* can be called in constructors to build up the variable table references.
+	   each table is parsed and indexed once per process and shared by all module instances */
 	void add_var_info( var_info vi[] );
-	void build_info_map();
-	bool has_info_map() { return m_infomap!=NULL; }
 	
 	/* can be called in exec if determine shouldn't run module */
 	void remove_var_info(var_info vi[]);
@@ -280,6 +281,7 @@ public:
 	util::matrix_t<double> as_matrix(const std::string & name) throw(general_error);
 	util::matrix_t<size_t> as_matrix_unsigned_long(const std::string & name) throw(general_error);
 	util::matrix_t<double> as_matrix_transpose(const std::string & name) throw(general_error);
+	util::matrix_view_t<ssc_number_t> as_matrix_view(const std::string &name) throw(general_error);
 	bool get_matrix(const std::string &name, util::matrix_t<ssc_number_t> &mat) throw(general_error);
 
 	size_t check_timestep_seconds( double t_start, double t_end, double t_step ) throw( timestep_error );
@@ -294,8 +296,8 @@ private:
 	// called by 'compute' as necessary for precheck and postcheck
 	bool verify(const std::string &phase, int var_types) throw( general_error );
 	
-	bool check_required( const std::string &name ) throw( general_error );
-	bool check_constraints( const std::string &name, std::string &fail_text ) throw( general_error );
+	bool check_required( const var_info_compiled &vc ) throw( general_error );
+	bool check_constraints( const var_info_compiled &vc, std::string &fail_text ) throw( general_error );
 
 	// helper functions for check_required
 	ssc_number_t get_operand_value( const std::string &input, const std::string &cur_var_name ) throw( general_error );
@@ -303,9 +305,9 @@ private:
 	var_data m_null_value;
 	
 	std::vector< var_info* > m_varlist;
+	std::vector< const var_info_compiled* > m_varcompiled; // parallel to m_varlist
+	std::vector< const var_info_table* > m_vartables;
 	std::vector< log_item > m_loglist;
-	
-	unordered_map< std::string, var_info* > *m_infomap;
 
 	/* these members are take values only during a call to 'compute(..)'
 	  and are NULL otherwise */
@@ -85,7 +85,7 @@ solarpilot_invoke::~solarpilot_invoke()
         delete m_sapi;
 }
 
-AutoPilot_S *solarpilot_invoke::GetSAPI()
+AutoPilot *solarpilot_invoke::GetSAPI()
 {
     return m_sapi;
 }
@@ -98,7 +98,18 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
     if(m_sapi != 0)
         delete m_sapi;
 
-    m_sapi = new AutoPilot_S();
+    //use the multithreaded API unless a single thread is requested (0 = all available cores)
+    int nthreads = m_cmod->is_assigned("sp_n_threads") ? m_cmod->as_integer("sp_n_threads") : 1;
+#ifdef SP_USE_THREADS
+    if( nthreads != 1 )
+    {
+        AutoPilot_MT *sapi_mt = new AutoPilot_MT();
+        sapi_mt->SetMaxThreadCount( nthreads > 0 ? nthreads : 999999 );
+        m_sapi = sapi_mt;
+    }
+    else
+#endif
+        m_sapi = new AutoPilot_S();
 
 	// read inputs from SSC module
 		
@@ -247,16 +258,13 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
 
 	    weather_record wf;
 
-	    vector<string> wfdata;
-	    wfdata.reserve( 8760 );
-	    char buf[1024];
+	    WeatherData wfdata;
 	    for( int i=0;i<8760;i++ )
 	    {
 			if (!wdata->read(&wf))
 			    throw compute_module::exec_error("solarpilot", "could not read data line " + util::to_string(i+1) + " of 8760 in weather data");
 
-		    mysnprintf(buf, 1023, "%d,%d,%d,%.2lf,%.1lf,%.1lf,%.1lf", wf.day, wf.hour, wf.month, wf.dn, wf.tdry, wf.pres/1000., wf.wspd);
-		    wfdata.push_back( std::string(buf) );
+		    wfdata.append( wf.day, wf.hour, wf.month, wf.dn, wf.tdry, wf.pres/1000., wf.wspd, 1. );
 	    }
 
 	    m_sapi->SetDetailCallback( ssc_cmod_solarpilot_callback, m_cmod);
@@ -312,22 +320,26 @@ bool solarpilot_invoke::run(std::shared_ptr<weather_data_provider> wdata)
         /* 
 		Load in the heliostat field positions that are provided by the user.
 		*/
-		//layout.heliostat_positions.clear();
-		//layout.heliostat_positions.resize(m_N_hel);
-		string format = "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;";
         sf.layout_data.val.clear();
 
         util::matrix_t<double> hpos = m_cmod->as_matrix("helio_positions_in");
 
-        char row[200];
+        sp_layout_table positions;
+        positions.positions.resize( hpos.nrows() );
 		for( size_t i=0; i<hpos.nrows(); i++)
 		{
-            sprintf(row, format.c_str(), hpos.at(i,0), hpos.at(i,1),  0. );
-
-            sf.layout_data.val.append( row );
+            sp_layout_table::h_position &hp = positions.positions.at(i);
+            hp.location.x = hpos.at(i,0);
+            hp.location.y = hpos.at(i,1);
+            hp.location.z = 0.;
+            hp.aimpoint.x = hp.aimpoint.y = hp.aimpoint.z = 0.;
+            hp.cant_vector.i = hp.cant_vector.j = hp.cant_vector.k = 0.;
+            hp.focal_length = 0.;
+            hp.template_number = 0;
+            hp.user_optics = false;
 		}
 
-		m_sapi->Setup(*this);
+		m_sapi->Setup(*this, positions);
     }
     
     //check if flux map calculations are desired
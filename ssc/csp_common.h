@@ -60,7 +60,7 @@
 class solarpilot_invoke : public var_map
 {
     compute_module *m_cmod;
-    AutoPilot_S *m_sapi;
+    AutoPilot *m_sapi;
 	std::vector<std::vector<double> > _optimization_sim_points;
 	std::vector<double>
 		_optimization_objectives,
@@ -82,7 +82,7 @@ public:
 
     solarpilot_invoke( compute_module *cm );
     ~solarpilot_invoke();
-    AutoPilot_S *GetSAPI();
+    AutoPilot *GetSAPI();
     bool run(std::shared_ptr<weather_data_provider> wdata = nullptr);
     bool postsim_calcs( compute_module *cm );
 };
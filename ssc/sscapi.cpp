@@ -51,6 +51,7 @@
 #include <cstring>
 
 #include "core.h"
+#include "common.h"
 #include "sscapi.h"
 
 SSCEXPORT int ssc_version()
@@ -342,6 +343,60 @@ SSCEXPORT void ssc_data_set_matrix( ssc_data_t p_data, const char *name, ssc_num
 	vt->assign( name, var_data(pvalues, nrows, ncols) );
 }
 
+SSCEXPORT void ssc_data_set_array_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int length, ssc_deleter_t deleter, void *user_data )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || !pvalues || length < 1) return;
+	var_data ref;
+	ref.borrow( SSC_ARRAY, pvalues, 1, (size_t)length, deleter, user_data );
+	vt->assign( name, ref );
+}
+
+SSCEXPORT void ssc_data_set_matrix_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int nrows, int ncols, ssc_deleter_t deleter, void *user_data )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || !pvalues || nrows < 1 || ncols < 1) return;
+	var_data ref;
+	ref.borrow( SSC_MATRIX, pvalues, (size_t)nrows, (size_t)ncols, deleter, user_data );
+	vt->assign( name, ref );
+}
+
+SSCEXPORT ssc_weather_t ssc_weather_create( const char *file )
+{
+	if (!file) return 0;
+	std::shared_ptr<weather_data_provider> wf( new weatherfile( file ) );
+	if ( !wf->ok() ) return 0;
+	return static_cast<ssc_weather_t>( new std::shared_ptr<weather_data_provider>( wf ) );
+}
+
+SSCEXPORT ssc_weather_t ssc_weather_create_from_data( ssc_data_t table )
+{
+	var_table *value = static_cast<var_table*>(table);
+	if (!value) return 0;
+	var_data tab;
+	tab.type = SSC_TABLE;
+	tab.table = *value;
+	std::shared_ptr<weather_data_provider> wd( new weatherdata( &tab ) );
+	if ( !wd->ok() || wd->nrecords() == 0 ) return 0;
+	return static_cast<ssc_weather_t>( new std::shared_ptr<weather_data_provider>( wd ) );
+}
+
+SSCEXPORT void ssc_weather_free( ssc_weather_t handle )
+{
+	delete static_cast<std::shared_ptr<weather_data_provider>*>(handle);
+}
+
+SSCEXPORT void ssc_data_set_weather_handle( ssc_data_t p_data, const char *name, ssc_weather_t handle )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	std::shared_ptr<weather_data_provider> *wd = static_cast<std::shared_ptr<weather_data_provider>*>(handle);
+	if (!vt || !wd) return;
+	weatherfile *wf = dynamic_cast<weatherfile*>( wd->get() );
+	var_data ref( wf ? wf->filename() : std::string() );
+	ref.weather = *wd;
+	vt->assign( name, ref );
+}
+
 SSCEXPORT void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data_t table )
 {
 	var_table *vt = static_cast<var_table*>(p_data);
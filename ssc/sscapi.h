@@ -164,6 +164,44 @@ SSCEXPORT void ssc_data_set_matrix( ssc_data_t p_data, const char *name, ssc_num
 
 /** Assigns value of type @a SSC_TABLE. */
 SSCEXPORT void ssc_data_set_table( ssc_data_t p_data, const char *name, ssc_data_t table );
+/**@}*/
+
+/** @name Assigning variable values without copying.
+The following functions store a reference to caller-owned array and matrix memory instead of making a deep copy. The memory must remain valid, and must not be
+resized, until the variable is unassigned or reassigned, or the data object is cleared or freed.  Compute modules read borrowed inputs in place.  If a deleter
+callback is given, SSC calls it exactly once, after the last internal reference to the memory is released; pass 0 (NULL) to keep ownership entirely with the caller.
+*/
+/**@{*/
+/** Callback used to release memory passed to ssc_data_set_array_ref() or ssc_data_set_matrix_ref(). The user_data pointer is passed through unchanged. */
+typedef void (*ssc_deleter_t)( ssc_number_t *pvalues, void *user_data );
+
+/** Assigns value of type @a SSC_ARRAY by reference to the caller's memory. */
+SSCEXPORT void ssc_data_set_array_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int length, ssc_deleter_t deleter, void *user_data );
+
+/** Assigns value of type @a SSC_MATRIX by reference to the caller's memory, in row-major order. */
+SSCEXPORT void ssc_data_set_matrix_ref( ssc_data_t p_data, const char *name, ssc_number_t *pvalues, int nrows, int ncols, ssc_deleter_t deleter, void *user_data );
+/**@}*/ 
+
+/** @name Sharing weather data between compute modules.
+A weather resource can be loaded once into a read-only, reference counted object and attached to the data containers of any number of compute modules.
+Each module reads the shared data in place with its own record counter instead of opening the file or copying the table again.
+*/
+/**@{*/
+/** The opaque reference to a shared weather data set. */
+typedef void* ssc_weather_t;
+
+/** Loads a weather file in any format accepted for solar_resource_file. Returns 0 (NULL) if the file cannot be read. Release with ssc_weather_free(). */
+SSCEXPORT ssc_weather_t ssc_weather_create( const char *file );
+
+/** Loads weather data from a @a SSC_TABLE with the same fields as solar_resource_data. Returns 0 (NULL) if the data is invalid. Release with ssc_weather_free(). */
+SSCEXPORT ssc_weather_t ssc_weather_create_from_data( ssc_data_t table );
+
+/** Releases the caller's reference. The data stays in memory while any data container still holds it. */
+SSCEXPORT void ssc_weather_free( ssc_weather_t handle );
+
+/** Assigns a @a SSC_STRING variable holding the data set's file name (empty for table data) with the shared data attached.  Use the name of the module's weather file input,
+for example solar_resource_file.  Modules that support shared weather read the attached data, others open the file by name. */
+SSCEXPORT void ssc_data_set_weather_handle( ssc_data_t p_data, const char *name, ssc_weather_t handle );
 /**@}*/ 
 
 /** @name Retrieving variable values.
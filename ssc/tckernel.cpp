@@ -62,12 +62,6 @@ tcKernel::~tcKernel()
 
 }
 
-#ifdef _MSC_VER
-#define mysnprintf _snprintf
-#else
-#define mysnprintf snprintf
-#endif
-
 void tcKernel::message( const std::string & text, int msgtype )
 {
 	int ssctype = SSC_ERROR;
@@ -98,53 +92,29 @@ bool tcKernel::converged( double time )
 		}
 	}
 
-	std::string buf;
-	char ibuf[128];
-	size_t j,k;
 	for ( size_t i=0;i<m_results.size(); i++ )
 	{
-		tcsvalue &v = m_results[i].u->values[ m_results[i].idx ];
-		switch( m_results[i].type )
+		dataset &d = m_results[i];
+		tcsvalue &v = d.u->values[ d.idx ];
+		switch( d.type )
 		{
 		case TCS_NUMBER:
-			m_results[i].values[ m_dataIndex ].dval = v.data.value;
+			d.dvals[ m_dataIndex ] = v.data.value;
 			break;
 		case TCS_STRING:
-			m_results[i].values[ m_dataIndex ].sval = v.data.cstr;
+			d.svals[ m_dataIndex ] = v.data.cstr;
 			break;
 		case TCS_ARRAY:
-			if ( m_storeArrMatData )
-			{
-				buf = "[ ";
-				for (j=0;j<v.data.array.length;j++)
-				{
-					mysnprintf(ibuf, 126, "%lg%c", v.data.array.values[j],
-						j < v.data.array.length-1 ? ',' : ' ');
-					buf += ibuf;
-				}
-				buf += "]";
-				m_results[i].values[ m_dataIndex ].sval = buf;
-			}
+			d.amoffset.push_back( d.amvals.size() );
+			d.amrows.push_back( 1 );
+			d.amcols.push_back( v.data.array.length );
+			d.amvals.insert( d.amvals.end(), v.data.array.values, v.data.array.values + v.data.array.length );
 			break;
 		case TCS_MATRIX:
-			if ( m_storeArrMatData )
-			{
-				mysnprintf( ibuf, 126, "{ %dx%d ", v.data.matrix.nrows, v.data.matrix.ncols );
-				buf = ibuf;
-				for (j=0;j<v.data.matrix.nrows;j++)
-				{
-					buf += " [";
-					for (k=0;k<v.data.matrix.ncols;k++)
-					{
-						mysnprintf(ibuf, 126, "%lg%c", TCS_MATRIX_INDEX(&v, j, k),
-							k < v.data.matrix.ncols-1 ? ',' : ' ');
-						buf += ibuf;
-					}
-					buf += "]";
-				}
-				buf += " }";
-				m_results[i].values[ m_dataIndex ].sval = buf;		
-			}
+			d.amoffset.push_back( d.amvals.size() );
+			d.amrows.push_back( v.data.matrix.nrows );
+			d.amcols.push_back( v.data.matrix.ncols );
+			d.amvals.insert( d.amvals.end(), v.data.matrix.values, v.data.matrix.values + v.data.matrix.nrows*v.data.matrix.ncols );
 			break;
 		}
 	}
@@ -175,7 +145,7 @@ int tcKernel::simulate( double start, double end, double step, int max_iter )
 		int idx=0;
 		while( vars[idx].var_type != TCS_INVALID )
 		{
-			if (is_ssc_array_output(vars[idx].name) || m_storeAllParameters)
+			if (store_variable( vars[idx] ))
 				ndatasets++;
 			idx++;
 		}
@@ -193,7 +163,7 @@ int tcKernel::simulate( double start, double end, double step, int max_iter )
 		int idx = 0;
 		while( vars[idx].var_type != TCS_INVALID )
 		{
-			if (is_ssc_array_output(vars[idx].name) || m_storeAllParameters )
+			if (store_variable( vars[idx] ))
 			{
 				dataset &d = m_results[ idataset++ ];
 				char buf[32];
@@ -205,7 +175,23 @@ int tcKernel::simulate( double start, double end, double step, int max_iter )
 				d.name = vars[idx].name;
 				d.units = vars[idx].units;
 				d.type = vars[idx].data_type;
-				d.values.resize( nsteps, dataitem(0.0) );
+				d.dvals.clear();
+				d.svals.clear();
+				d.amvals.clear();
+				d.amoffset.clear();
+				d.amrows.clear();
+				d.amcols.clear();
+				// preallocate from the known step count
+				if ( d.type == TCS_NUMBER )
+					d.dvals.resize( nsteps, 0.0 );
+				else if ( d.type == TCS_STRING )
+					d.svals.resize( nsteps );
+				else
+				{
+					d.amoffset.reserve( nsteps );
+					d.amrows.reserve( nsteps );
+					d.amcols.reserve( nsteps );
+				}
 			}
 			idx++;
 		}
@@ -214,6 +200,15 @@ int tcKernel::simulate( double start, double end, double step, int max_iter )
 	return tcskernel::simulate( start, end, step );
 }
 
+bool tcKernel::store_variable( const tcsvarinfo &var )
+{
+	// arrays and matrices are only kept as snapshots when requested
+	if ( (var.data_type == TCS_ARRAY || var.data_type == TCS_MATRIX) && !m_storeArrMatData )
+		return false;
+
+	return m_storeAllParameters || is_ssc_array_output( var.name );
+}
+
 tcKernel::dataset *tcKernel::get_results(int idx)
 {
 	if (idx >= (int) m_results.size()) return 0;
@@ -332,10 +327,10 @@ bool tcKernel::set_output_array(const char *ssc_output_name, const char *tcs_out
 	ssc_number_t *output_array = allocate( ssc_output_name, len );
 	while( tcKernel::dataset *d = get_results(idx++) )
 	{
-		if ( (d->type == TCS_NUMBER) && (d->name == tcs_output_name) && (d->values.size() == len ) )
+		if ( (d->type == TCS_NUMBER) && (d->name == tcs_output_name) && (d->dvals.size() == len ) )
 		{
 			for (size_t i=0;i<len;i++)
-				output_array[i] = (ssc_number_t)(d->values[i].dval * scaling);
+				output_array[i] = (ssc_number_t)(d->dvals[i] * scaling);
 			return true;
 		}
 	}
@@ -352,9 +347,9 @@ bool tcKernel::set_all_output_arrays()
 		// if there is an SSC_OUTPUT with the same name
 		if ( (d->type == TCS_NUMBER) && ( is_ssc_array_output(d->name) ) )
 		{
-			ssc_number_t *output_array = allocate( d->name, d->values.size() );
-			for (size_t i=0; i<d->values.size(); i++)
-				output_array[i] = (ssc_number_t) d->values[i].dval;
+			ssc_number_t *output_array = allocate( d->name, d->dvals.size() );
+			for (size_t i=0; i<d->dvals.size(); i++)
+				output_array[i] = (ssc_number_t) d->dvals[i];
 		}
 	}
 
@@ -83,14 +83,9 @@ public:
 	bool set_output_array(const char *ssc_output_name, const char *tcs_output_name, size_t len, double scaling = 1);
 	bool set_all_output_arrays();
 
-	struct dataitem {
-		dataitem( const char *s ) : sval(s) { }
-		dataitem( const std::string &s ) : sval(s) { }
-		dataitem( double d ) : dval(d) { }
-		std::string sval;
-		double dval;
-	};
-
+	// results are stored column-wise by type: one double per step for TCS_NUMBER,
+	// one string per step for TCS_STRING, and binary snapshots of TCS_ARRAY and
+	// TCS_MATRIX values (only when m_storeArrMatData is set)
 	struct dataset {
 		unit *u;
 		int uidx;
@@ -99,12 +94,18 @@ public:
 		std::string units;
 		std::string group;
 		int type;
-		std::vector<dataitem> values;
+		std::vector<double> dvals;
+		std::vector<std::string> svals;
+		std::vector<double> amvals; // flattened snapshots of all steps
+		std::vector<size_t> amoffset; // start of each step's snapshot in amvals
+		std::vector<int> amrows, amcols;
 	};
 
 	dataset *get_results(int idx);
 
 private:
+	bool store_variable( const tcsvarinfo &var );
+
 	bool m_storeArrMatData;
 	bool m_storeAllParameters; // true = all inputs/outputs for all units will be saved for every time step; false = only store values that match SSC parameters defined as SSC_OUTPUT or SSC_INOUT
 	std::vector< dataset > m_results;
@@ -71,6 +71,30 @@ std::string var_data::type_name(int type)
 	else return "";
 }
 
+void var_data::borrow( unsigned char t, ssc_number_t *pvalues, size_t nr, size_t nc, ssc_deleter_t deleter, void *user_data )
+{
+	type = t;
+	num.borrow( pvalues, nr, nc );
+	if ( deleter != 0 )
+		borrowed_owner = std::shared_ptr<ssc_number_t>( pvalues, [deleter, user_data]( ssc_number_t *p ) { (*deleter)( p, user_data ); } );
+	else
+		borrowed_owner.reset();
+}
+
+void var_data::copy_num( const var_data &rhs )
+{
+	if ( rhs.num.is_borrowed() )
+	{
+		// share the reference instead of duplicating the caller's buffer
+		num.borrow( const_cast<ssc_number_t*>( rhs.num.data() ), rhs.num.nrows(), rhs.num.ncols() );
+		borrowed_owner = rhs.borrowed_owner;
+	}
+	else
+	{
+		num = rhs.num;
+		borrowed_owner.reset();
+	}
+}
 
 std::string var_data::to_string()
 {
@@ -56,6 +56,7 @@
 
 
 #include <unordered_map>
+#include <memory>
 using std::unordered_map;
 
 #ifdef _MSC_VER
@@ -63,6 +64,7 @@ using std::unordered_map;
 #endif
 
 class var_data;
+class weather_data_provider;
 
 typedef unordered_map< std::string, var_data* > var_hash;
 
@@ -93,13 +95,19 @@ class var_data
 public:
 	
 	var_data() : type(SSC_INVALID) { num=0.0; }
-	var_data( const var_data &cp ) : type(cp.type), num(cp.num), str(cp.str) {  }
+	var_data( const var_data &cp ) : type(cp.type), str(cp.str), weather(cp.weather) { copy_num(cp); }
 	var_data( const std::string &s ) : type(SSC_STRING), str(s) {  }
 	var_data( ssc_number_t n ) : type(SSC_NUMBER) { num = n; }
 	var_data(const ssc_number_t *pvalues, int length) : type(SSC_ARRAY) { num.assign(pvalues, (size_t)length); }
 	var_data(const ssc_number_t *pvalues, size_t length) : type(SSC_ARRAY) { num.assign(pvalues, length); }
 	var_data(const ssc_number_t *pvalues, int nr, int nc) : type(SSC_MATRIX) { num.assign(pvalues, (size_t)nr, (size_t)nc); }
 
+	/* reference caller-owned array or matrix data without copying it.
+	   if a deleter is given, it is called once the last var_data that
+	   refers to the memory is destroyed or reassigned */
+	void borrow( unsigned char type, ssc_number_t *pvalues, size_t nr, size_t nc, ssc_deleter_t deleter = 0, void *user_data = 0 );
+	bool is_borrowed() const { return num.is_borrowed(); }
+
 	const char *type_name();
 	static std::string type_name(int type);
 
@@ -108,12 +116,17 @@ public:
 	static bool parse( unsigned char type, const std::string &buf, var_data &value );
 
 	var_data &operator=(const var_data &rhs) { copy(rhs); return *this; }
-	void copy( const var_data &rhs ) { type=rhs.type; num=rhs.num; str=rhs.str; table = rhs.table; }
+	void copy( const var_data &rhs ) { type=rhs.type; copy_num(rhs); str=rhs.str; table = rhs.table; weather = rhs.weather; }
 	
 	unsigned char type;
 	util::matrix_t<ssc_number_t> num;
 	std::string str;
 	var_table table;
+	std::shared_ptr<weather_data_provider> weather; // read-only data set attached with ssc_data_set_weather_handle
+
+private:
+	void copy_num( const var_data &rhs );
+	std::shared_ptr<ssc_number_t> borrowed_owner; // releases borrowed memory via the caller's deleter
 };
 
 #endif
@@ -0,0 +1,109 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#include "CO2_prop_cache.h"
+#include <string.h>
+
+namespace
+{
+	unsigned long long double_bits(double x)
+	{
+		unsigned long long bits;
+		memcpy(&bits, &x, sizeof(bits));
+		return bits;
+	}
+}
+
+C_CO2_prop_cache::C_CO2_prop_cache()
+{
+	clear();
+}
+
+void C_CO2_prop_cache::clear()
+{
+	for (int i = 0; i < N_SLOTS; i++)
+		m_entries[i].m_pair = E_NONE;
+
+	m_n_calls = m_n_hits = 0;
+}
+
+int C_CO2_prop_cache::call(int pair, double x, double y, CO2_state *state)
+{
+	m_n_calls++;
+
+	unsigned long long hash = (double_bits(x) * 0x9E3779B97F4A7C15ULL) ^ (double_bits(y) * 0xC2B2AE3D27D4EB4FULL) ^ (unsigned long long)pair;
+	S_entry & entry = m_entries[(hash >> 32) & (N_SLOTS - 1)];
+
+	if (entry.m_pair == pair && entry.m_x == x && entry.m_y == y)
+	{
+		m_n_hits++;
+		*state = entry.m_state;
+		return entry.m_err;
+	}
+
+	int err = (pair == E_TP) ? CO2_TP(x, y, state) : CO2_PH(x, y, state);
+
+	entry.m_pair = pair;
+	entry.m_err = err;
+	entry.m_x = x;
+	entry.m_y = y;
+	entry.m_state = *state;
+
+	return err;
+}
+
+int C_CO2_prop_cache::TP(double T /*K*/, double P /*kPa*/, CO2_state *state)
+{
+	return call(E_TP, T, P, state);
+}
+
+int C_CO2_prop_cache::PH(double P /*kPa*/, double H /*kJ/kg*/, CO2_state *state)
+{
+	return call(E_PH, P, H, state);
+}
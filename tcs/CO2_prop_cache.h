@@ -0,0 +1,111 @@
+/*******************************************************************************************************
+*  Copyright 2017 Alliance for Sustainable Energy, LLC
+*
+*  NOTICE: This software was developed at least in part by Alliance for Sustainable Energy, LLC
+*  (Alliance) under Contract No. DE-AC36-08GO28308 with the U.S. Department of Energy and the U.S.
+*  The Government retains for itself and others acting on its behalf a nonexclusive, paid-up,
+*  irrevocable worldwide license in the software to reproduce, prepare derivative works, distribute
+*  copies to the public, perform publicly and display publicly, and to permit others to do so.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted
+*  provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice, the above government
+*  rights notice, this list of conditions and the following disclaimer in the documentation and/or
+*  other materials provided with the distribution.
+*
+*  3. The entire corresponding source code of any redistribution, with or without modification, by a
+*  research entity, including but not limited to any contracting manager/operator of a United States
+*  National Laboratory, any institution of higher learning, and any non-profit organization, must be
+*  made publicly available under this license for as long as the redistribution is made available by
+*  the research entity.
+*
+*  4. Redistribution of this software, without modification, must refer to the software by the same
+*  designation. Redistribution of a modified version of this software (i) may not refer to the modified
+*  version by the same designation, or by any confusingly similar designation, and (ii) must refer to
+*  the underlying software originally provided by Alliance as System Advisor Model or SAM. Except
+*  to comply with the foregoing, the terms System Advisor Model, SAM, or any confusingly similar
+*  designation may not be used to refer to any modified version of this software or any modified
+*  version of the underlying software originally provided by Alliance without the prior written consent
+*  of Alliance.
+*
+*  5. The name of the copyright holder, contributors, the United States Government, the United States
+*  Department of Energy, or any of their employees may not be used to endorse or promote products
+*  derived from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+*  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+*  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER,
+*  CONTRIBUTORS, UNITED STATES GOVERNMENT OR UNITED STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR
+*  EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+*  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+*  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+*  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************************************/
+
+#ifndef __CO2_PROP_CACHE_
+#define __CO2_PROP_CACHE_
+
+#include "CO2_properties.h"
+
+// Exact-input cache in front of the CO2_TP and CO2_PH property routines, used by the counterflow heat exchanger
+//    UA and effectiveness solvers
+// The property routines iterate on density for every input pair except (T, D), and the heat exchanger
+//    solvers evaluate the same states many times (e.g. the inlet states on every iteration of a UA solve)
+// Entries are keyed on the exact input values, so a hit returns the state and error code that the property
+//    routine returned for those inputs and results are identical with or without the cache
+// The cache is not synchronized: each solver owns its own instance, so concurrent solvers do not share one
+class C_CO2_prop_cache
+{
+public:
+
+	C_CO2_prop_cache();
+
+	int TP(double T /*K*/, double P /*kPa*/, CO2_state *state);
+	int PH(double P /*kPa*/, double H /*kJ/kg*/, CO2_state *state);
+
+	void clear();
+
+	long long get_n_calls() const
+	{
+		return m_n_calls;
+	}
+	long long get_n_hits() const
+	{
+		return m_n_hits;
+	}
+
+private:
+
+	enum
+	{
+		E_TP,
+		E_PH,
+
+		E_NONE
+	};
+
+	static const int N_SLOTS = 256;		// direct-mapped, must be a power of 2
+
+	struct S_entry
+	{
+		int m_pair;			//[-] E_TP, E_PH, or E_NONE if empty
+		int m_err;			//[-] error code returned by the property routine
+		double m_x;
+		double m_y;
+		CO2_state m_state;
+	};
+
+	S_entry m_entries[N_SLOTS];
+
+	long long m_n_calls;
+	long long m_n_hits;
+
+	int call(int pair, double x, double y, CO2_state *state);
+};
+
+#endif
@@ -107,6 +107,48 @@ void __WINAPI opt_iter_function(lprec *lp, void *userhandle, int msg)
         par->is_abort_flag = true;
 }
 
+/*
+Adds constraint rows to a new model or, when a model is reused for another optimization window, overwrites
+the coefficients and right hand side of the existing rows in the same order they were originally added.
+*/
+class lp_row_writer
+{
+    lprec *m_lp;
+    bool m_update;
+    int m_row;
+
+public:
+    lp_row_writer(lprec *lp, bool update)
+    {
+        m_lp = lp;
+        m_update = update;
+        m_row = 0;
+    }
+
+    void add(int count, REAL *row, int *col, int constr_type, REAL rh)
+    {
+        m_row++;
+        if( ! m_update )
+        {
+            add_constraintex(m_lp, count, row, col, constr_type, rh);
+            return;
+        }
+
+        for(int i=0; i<count; i++)
+            if( get_mat(m_lp, m_row, col[i]) != row[i] )
+                set_mat(m_lp, m_row, col[i], row[i]);
+        if( get_constr_type(m_lp, m_row) != constr_type )
+            set_constr_type(m_lp, m_row, constr_type);
+        if( get_rh(m_lp, m_row) != rh )
+            set_rh(m_lp, m_row, rh);
+    }
+
+    int get_row_count()
+    {
+        return m_row;
+    }
+};
+
 
 csp_dispatch_opt::csp_dispatch_opt()
 {
@@ -118,6 +160,10 @@ csp_dispatch_opt::csp_dispatch_opt()
     price_signal.clear();
     clear_output_arrays();
     m_is_weather_setup = false;
+    m_lp = NULL;
+    m_lp_nstep = 0;
+    m_scaling_mode = -1;
+    m_is_cold_retry = false;
 
     //parameters
     params.is_pb_operating0 = false;
@@ -161,6 +207,19 @@ csp_dispatch_opt::csp_dispatch_opt()
 
 }
 
+csp_dispatch_opt::~csp_dispatch_opt()
+{
+    free_model();
+}
+
+void csp_dispatch_opt::free_model()
+{
+    if( m_lp != NULL )
+        delete_lp(m_lp);
+    m_lp = NULL;
+    m_lp_nstep = 0;
+}
+
 void csp_dispatch_opt::clear_output_arrays()
 {
     m_current_read_step = 0;
@@ -206,6 +265,23 @@ bool csp_dispatch_opt::copy_weather_data(C_csp_weatherreader &weather_source)
     return m_is_weather_setup = true;
 }
 
+void csp_dispatch_opt::copy_setup(const csp_dispatch_opt &source)
+{
+    params = source.params;
+    solver_params = source.solver_params;
+    m_weather = source.m_weather;
+    m_is_weather_setup = source.m_is_weather_setup;
+}
+
+void csp_dispatch_opt::swap_window(csp_dispatch_opt &other)
+{
+    std::swap(m_nstep_opt, other.m_nstep_opt);
+    std::swap(outputs, other.outputs);
+    std::swap(price_signal, other.price_signal);
+    std::swap(w_lim, other.w_lim);
+    std::swap(solver_params.log_message, other.solver_params.log_message);
+}
+
 bool csp_dispatch_opt::predict_performance(int step_start, int ntimeints, int divs_per_int)
 {
     //Step number - 1-based index for first hour of the year.
@@ -433,6 +509,24 @@ bool csp_dispatch_opt::optimize()
         return optimize_ampl();
     }
 
+    /*
+    A window is formulated again when the kept model doesn't match or a warm-started solve fails. The first retry 
+    drops the kept model and the second solves without warm start, so there are at most three attempts.
+    */
+    bool is_ok = false;
+    bool is_retry = true;
+    for(int i=0; i<3 && is_retry; i++)
+    {
+        is_retry = false;
+        is_ok = optimize_window(is_retry);
+    }
+    m_is_cold_retry = false;
+
+    return is_ok;
+}
+
+bool csp_dispatch_opt::optimize_window(bool &is_retry)
+{
     /* 
     Formulate the optimization problem for dispatch generation. We are trying to maximize revenue subject to inventory
     constraints.
@@ -465,7 +559,7 @@ bool csp_dispatch_opt::optimize()
     ychsp           1 if cycle hot startup penalty is enforced at time t; 0 otherwise
     -------------------------------------------------------------
     */
-    lprec *lp;
+    lprec *lp = NULL;
     int ret = 0;
 
 
@@ -507,13 +601,60 @@ bool csp_dispatch_opt::optimize()
 
         int nvar = O.get_total_var_count(); //total number of variables in the problem
 
-        lp = make_lp(0, nvar);  //build the context
+        //integer handles for the variable groups so columns aren't looked up by name in the formulation
+        struct
+        {
+            int xr, xrsu, ursu, yr, yrsu, yrsup, x, y, s, ucsu, ycsu, ycsb, ycsd, ycsup, ychsp, wdot, delta_w;
+        } V;
+        V.xr = O.get_var_index("xr");
+        V.xrsu = O.get_var_index("xrsu");
+        V.ursu = O.get_var_index("ursu");
+        V.yr = O.get_var_index("yr");
+        V.yrsu = O.get_var_index("yrsu");
+        V.yrsup = O.get_var_index("yrsup");
+        V.x = O.get_var_index("x");
+        V.y = O.get_var_index("y");
+        V.s = O.get_var_index("s");
+        V.ucsu = O.get_var_index("ucsu");
+        V.ycsu = O.get_var_index("ycsu");
+        V.ycsb = O.get_var_index("ycsb");
+        V.ycsd = O.get_var_index("ycsd");
+        V.ycsup = O.get_var_index("ycsup");
+        V.ychsp = O.get_var_index("ychsp");
+        V.wdot = O.get_var_index("wdot");
+        V.delta_w = O.get_var_index("delta_w");
+
+        /*
+        When warm starting, the model from the previous window is kept if it has the same horizon. The formulation
+        below is then replayed against it so only the objective, coefficients, right hand sides and bounds change,
+        and lp_solve starts from the basis of the last solution. A window that fails without presolve is retried as
+        a regular solve.
+        */
+        bool is_warm = solver_params.is_warm_start && !m_is_cold_retry;
+        bool is_update = is_warm && m_lp != NULL && m_lp_nstep == nt;
+
+        if( is_update )
+        {
+            lp = m_lp;
+        }
+        else
+        {
+            free_model();
+
+            lp = make_lp(0, nvar);  //build the context
+
+            if(lp == NULL)
+                throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
 
-        if(lp == NULL)
-            throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
+            if( is_warm )
+            {
+                m_lp = lp;
+                m_lp_nstep = nt;
+            }
+        }
 
         //set variable names and types for each column
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        for(int i=0; i<O.get_num_varobjs() && !is_update; i++)
         {
             optimization_vars::opt_var *v = O.get_var(i);
 
@@ -576,25 +717,25 @@ bool csp_dispatch_opt::optimize()
             for(int t=0; t<nt; t++)
             {
                 i = 0;
-                col[ t + nt*(i  ) ] = O.column("wdot", t);
+                col[ t + nt*(i  ) ] = O.column(V.wdot, t);
                 row[ t + nt*(i++) ] = P["delta"] * price_signal.at(t)*tadj*(1.-outputs.w_condf_expected.at(t));
 
-                col[ t + nt*(i  ) ] = O.column("xr", t);
+                col[ t + nt*(i  ) ] = O.column(V.xr, t);
                 row[ t + nt*(i++) ] = -(P["delta"] * price_signal.at(t) * P["Lr"])+tadj*pmean;  // tadj added to prefer receiver production sooner (i.e. delay dumping)
 
-                col[ t + nt*(i  ) ] = O.column("xrsu", t);
+                col[ t + nt*(i  ) ] = O.column(V.xrsu, t);
                 row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * P["Lr"];
 
-                col[ t + nt*(i  ) ] = O.column("yrsu", t);
+                col[ t + nt*(i  ) ] = O.column(V.yrsu, t);
                 row[ t + nt*(i++) ] = -price_signal.at(t) * (params.w_rec_ht + params.w_stow);
 
-                col[ t + nt*(i  ) ] = O.column("yr", t);
+                col[ t + nt*(i  ) ] = O.column(V.yr, t);
                 row[ t + nt*(i++) ] = -(P["delta"] * price_signal.at(t) * params.w_track) + tadj;	// tadj added to prefer receiver operation in nearer term to longer term
 
-                col[ t + nt*(i  ) ] = O.column("x", t);
+                col[ t + nt*(i  ) ] = O.column(V.x, t);
                 row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * params.w_cycle_pump;
 
-                col[ t + nt*(i  ) ] = O.column("ycsb", t);
+                col[ t + nt*(i  ) ] = O.column(V.ycsb, t);
                 row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * params.w_cycle_standby;
 
                 //xxcol[ t + nt*(i   ] = O.column("yrsb", t);
@@ -606,19 +747,19 @@ bool csp_dispatch_opt::optimize()
                 //xxcol[ t + nt*(i   ] = O.column("ycsd", t);
                 //xxrow[ t + nt*(i++) ] = -0.5;
 
-                col[ t + nt*(i  ) ] = O.column("yrsup", t);
+                col[ t + nt*(i  ) ] = O.column(V.yrsup, t);
                 row[ t + nt*(i++) ] = -P["rsu_cost"]*tadj;
 
                 //xxcol[ t + nt*(i   ] = O.column("yrhsp", t);
                 //xxrow[ t + nt*(i++) ] = -tadj;
 
-                col[ t + nt*(i  ) ] = O.column("ycsup", t);
+                col[ t + nt*(i  ) ] = O.column(V.ycsup, t);
                 row[ t + nt*(i++) ] = -P["csu_cost"]*tadj;
 
-                col[ t + nt*(i  ) ] = O.column("ychsp", t);
+                col[ t + nt*(i  ) ] = O.column(V.ychsp, t);
                 row[ t + nt*(i++) ] = -P["csu_cost"]*tadj * 0.1;
 
-                col[ t + nt*(i  ) ] = O.column("delta_w", t);
+                col[ t + nt*(i  ) ] = O.column(V.delta_w, t);
                 row[ t + nt*(i++) ] = -P["pen_delta_w"]*tadj;
 
                 tadj *= P["disp_time_weighting"];
@@ -631,14 +772,15 @@ bool csp_dispatch_opt::optimize()
         }
 
         //set the row mode
-        set_add_rowmode(lp, TRUE);
+        if( ! is_update )
+            set_add_rowmode(lp, TRUE);
 
         /* 
         --------------------------------------------------------------------------------
         set up the variable properties
         --------------------------------------------------------------------------------
         */
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        for(int i=0; i<O.get_num_varobjs() && !is_update; i++)
         {
             optimization_vars::opt_var *v = O.get_var(i);
             if( v->var_type == optimization_vars::VAR_TYPE::BINARY_T )
@@ -660,6 +802,8 @@ bool csp_dispatch_opt::optimize()
         set up the constraints
         --------------------------------------------------------------------------------
         */
+        lp_row_writer rows(lp, is_update);
+
         //cycle production change
         {
             REAL row[3];
@@ -667,22 +811,22 @@ bool csp_dispatch_opt::optimize()
             
             for(int t=0; t<nt; t++)
             {
-                col[0] = O.column("delta_w", t);
+                col[0] = O.column(V.delta_w, t);
                 row[0] = 1.;
 
-                col[1] = O.column("wdot", t);
+                col[1] = O.column(V.wdot, t);
                 row[1] = -1.;
 
                 if(t>0)
                 {
-                    col[2] = O.column("wdot", t-1);
+                    col[2] = O.column(V.wdot, t-1);
                     row[2] = 1.;
                     
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    rows.add(3, row, col, GE, 0.);
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, GE, -P["Wdot0"]);
+                    rows.add(2, row, col, GE, -P["Wdot0"]);
                 }
             }
         }
@@ -699,18 +843,18 @@ bool csp_dispatch_opt::optimize()
                 int i=0;
                 //power production curve
                 row[i  ] = 1.;
-                col[i++] = O.column("wdot", t);
+                col[i++] = O.column(V.wdot, t);
 
                 row[i  ] = -P["etap"]*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref;
-                col[i++] = O.column("x", t);
+                col[i++] = O.column(V.x, t);
 
                 row[i  ] = -(P["Wdotu"] - P["etap"]*P["Qu"])*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref;
-                col[i++] = O.column("y", t);
+                col[i++] = O.column(V.y, t);
 
                 //row[i  ] = -outputs.eta_pb_expected.at(t);
                 //col[i++] = O.column("x", t);
 
-                add_constraintex(lp, i, row, col, EQ, 0.);
+                rows.add(i, row, col, EQ, 0.);
 
             }
         }
@@ -732,7 +876,7 @@ bool csp_dispatch_opt::optimize()
         //        row[i  ] = 1.;
         //        col[i++] = O.column("xrsu", t);
 
-        //        add_constraintex(lp, i, row, col, GE, outputs.q_sfavail_expected.at(t)*0.999 );
+        //        rows.add(i, row, col, GE, outputs.q_sfavail_expected.at(t)*0.999 );
         //    }
         //} //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -746,112 +890,112 @@ bool csp_dispatch_opt::optimize()
 
                 //Receiver startup inventory
                 row[0] = 1.;
-                col[0] = O.column("ursu", t);
+                col[0] = O.column(V.ursu, t);
 
                 row[1] = -P["delta"];
-                col[1] = O.column("xrsu", t);
+                col[1] = O.column(V.xrsu, t);
 
                 if(t>0)
                 {
                     row[2] = -1.;
-                    col[2] = O.column("ursu", t-1);
+                    col[2] = O.column(V.ursu, t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0);
+                    rows.add(3, row, col, LE, 0);
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, LE, 0.);
+                    rows.add(2, row, col, LE, 0.);
                 }
 
                 //-----
 
                 //inventory nonzero
                 row[0] = 1.;
-                col[0] = O.column("ursu", t);
+                col[0] = O.column(V.ursu, t);
 
                 row[1] = -P["Er"];
-                col[1] = O.column("yrsu", t);
+                col[1] = O.column(V.yrsu, t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                rows.add(2, row, col, LE, 0.);
 
                 //Receiver operation allowed when:
                 row[0] = 1.;
-                col[0] = O.column("yr", t);
+                col[0] = O.column(V.yr, t);
                 
                 row[1] = -1.0/P["Er"]; 
-                col[1] = O.column("ursu", t);
+                col[1] = O.column(V.ursu, t);
 
                 if(t>0)
                 {
                     row[2] = -1.;
-                    col[2] = O.column("yr", t-1);
+                    col[2] = O.column(V.yr, t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0.); 
+                    rows.add(3, row, col, LE, 0.); 
                 }
                 else
                 {
-                    add_constraintex(lp, 2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
+                    rows.add(2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
                 }
 
                 //Receiver startup can't be enabled after a time step where the Receiver was operating
                 if(t>0)
                 {
                     row[0] = 1.;
-                    col[0] = O.column("yrsu", t);
+                    col[0] = O.column(V.yrsu, t);
 
                     row[1] = 1.;
-                    col[1] = O.column("yr", t-1);
+                    col[1] = O.column(V.yr, t-1);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
+                    rows.add(2, row, col, LE, 1.);
                 }
 
                 //Receiver startup energy consumption
                 row[0] = 1.;
-                col[0] = O.column("xrsu", t);
+                col[0] = O.column(V.xrsu, t);
 
                 row[1] = -P["Qru"];
-                col[1] = O.column("yrsu", t);
+                col[1] = O.column(V.yrsu, t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                rows.add(2, row, col, LE, 0.);
 
                 //Receiver startup only during solar positive periods
                 row[0] = 1.;
-                col[0] = O.column("yrsu", t);
+                col[0] = O.column(V.yrsu, t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
+                rows.add(1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
 
                 //Receiver consumption limit
                 row[0] = 1.;
-                col[0] = O.column("xr", t);
+                col[0] = O.column(V.xr, t);
 
                 row[1] = 1.;
-                col[1] = O.column("xrsu", t);
+                col[1] = O.column(V.xrsu, t);
                 
-                add_constraintex(lp, 2, row, col, LE, outputs.q_sfavail_expected.at(t));
+                rows.add(2, row, col, LE, outputs.q_sfavail_expected.at(t));
 
                 //Receiver operation mode requirement
                 row[0] = 1.;
-                col[0] = O.column("xr", t);
+                col[0] = O.column(V.xr, t);
 
                 row[1] = -outputs.q_sfavail_expected.at(t);
-                col[1] = O.column("yr", t);
+                col[1] = O.column(V.yr, t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                rows.add(2, row, col, LE, 0.);
 
                 //Receiver minimum operation requirement
                 row[0] = 1.;
-                col[0] = O.column("xr", t);
+                col[0] = O.column(V.xr, t);
 
                 row[1] = -P["Qrl"];
-                col[1] = O.column("yr", t);
+                col[1] = O.column(V.yr, t);
 
-                add_constraintex(lp, 2, row, col, GE, 0.);
+                rows.add(2, row, col, GE, 0.);
 
                 //Receiver can't continue operating when no energy is available
                 row[0] = 1.;
-                col[0] = O.column("yr", t);
+                col[0] = O.column(V.yr, t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
+                rows.add(1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
 
                 // --- new constraints ---
 
@@ -862,7 +1006,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("yrsb", t);
 
-                add_constraintex(lp, 2, row, col, LE, 1.);*/
+                rows.add(2, row, col, LE, 1.);*/
 
                 //recever standby partition
                 /*row[0] = 1.;
@@ -871,7 +1015,7 @@ bool csp_dispatch_opt::optimize()
                 row[1] = 1.;
                 col[1] = O.column("yrsb", t);
 
-                add_constraintex(lp, 2, row, col, LE, 1.);*/
+                rows.add(2, row, col, LE, 1.);*/
 
                 if( t > 0 )
                 {
@@ -885,19 +1029,19 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("yrsb", t-1);
 
-                    add_constraintex(lp, 3, row, col, LE, 0.);*/
+                    rows.add(3, row, col, LE, 0.);*/
 
                     //receiver startup penalty
                     row[0] = 1.;
-                    col[0] = O.column("yrsup", t);
+                    col[0] = O.column(V.yrsup, t);
 
                     row[1] = -1.;
-                    col[1] = O.column("yrsu", t);
+                    col[1] = O.column(V.yrsu, t);
 
                     row[2] = 1.;
-                    col[2] = O.column("yrsu", t-1);
+                    col[2] = O.column(V.yrsu, t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    rows.add(3, row, col, GE, 0.);
 
                     //receiver hot startup penalty
                     /*row[0] = 1.;
@@ -909,7 +1053,7 @@ bool csp_dispatch_opt::optimize()
                     row[2] = -1.;
                     col[2] = O.column("yrsb", t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, -1);*/
+                    rows.add(3, row, col, GE, -1);*/
 
                     //receiver shutdown energy
                     /*row[0] = 1.;
@@ -927,7 +1071,7 @@ bool csp_dispatch_opt::optimize()
                     row[4] = 1.;
                     col[4] = O.column("yrsb", t);
 
-                    add_constraintex(lp, 5, row, col, GE, 0.);*/
+                    rows.add(5, row, col, GE, 0.);*/
 
                 }
             }
@@ -946,176 +1090,176 @@ bool csp_dispatch_opt::optimize()
                 int i=0;
                 //Startup Inventory balance
                 row[i  ] = 1.;
-                col[i++] = O.column("ucsu", t);
+                col[i++] = O.column(V.ucsu, t);
                 
                 row[i  ] = -P["delta"] * P["Qc"];
-                col[i++] = O.column("ycsu", t);
+                col[i++] = O.column(V.ycsu, t);
 
                 if(t>0)
                 {
                     row[i  ] = -1.;
-                    col[i++] = O.column("ucsu", t-1);
+                    col[i++] = O.column(V.ucsu, t-1);
                 }
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+                rows.add(i, row, col, LE, 0.);
 
                 //Inventory nonzero
                 row[0] = 1.;
-                col[0] = O.column("ucsu", t);
+                col[0] = O.column(V.ucsu, t);
 
                 row[1] = -P["M"];
-                col[1] = O.column("ycsu", t);
+                col[1] = O.column(V.ycsu, t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                rows.add(2, row, col, LE, 0.);
 
                 //Cycle operation allowed when:
                 i=0;
                 row[i  ] = 1.;
-                col[i++] = O.column("y", t);
+                col[i++] = O.column(V.y, t);
                 
                 row[i  ] = -1.0/P["Ec"]; 
-                col[i++] = O.column("ucsu", t);
+                col[i++] = O.column(V.ucsu, t);
 
                 if(t>0)
                 {
                     row[i  ] = -1.;
-                    col[i++] = O.column("y", t-1);
+                    col[i++] = O.column(V.y, t-1);
 
                     row[i  ] = -1.;
-                    col[i++] = O.column("ycsb", t-1);
+                    col[i++] = O.column(V.ycsb, t-1);
 
-                    add_constraintex(lp, i, row, col, LE, 0.); 
+                    rows.add(i, row, col, LE, 0.); 
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
+                    rows.add(i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
                 }
 
                 //Cycle consumption limit
                 i=0;
                 row[i  ] = 1.;
-                col[i++] = O.column("x", t);
+                col[i++] = O.column(V.x, t);
 
                 //mjw 2016.12.2 --> This constraint seems to be problematic in identifying feasible solutions for subhourly runs. Needs attention.
                 row[i  ] = P["Qc"];
-                col[i++] = O.column("ycsu", t);
+                col[i++] = O.column(V.ycsu, t);
                 
                 row[i  ] = -P["Qu"];
-                col[i++] = O.column("y", t);
+                col[i++] = O.column(V.y, t);
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+                rows.add(i, row, col, LE, 0.);
 
                 //cycle operation mode requirement
                 row[0] = 1.;
-                col[0] = O.column("x", t);
+                col[0] = O.column(V.x, t);
 
                 row[1] = -P["Qu"];
-                col[1] = O.column("y", t);
+                col[1] = O.column(V.y, t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                rows.add(2, row, col, LE, 0.);
 
                 //Minimum cycle energy contribution
                 i=0;
                 row[i  ] = 1.;
-                col[i++] = O.column("x", t);
+                col[i++] = O.column(V.x, t);
 
                 row[i  ] = -P["Ql"];
-                col[i++] = O.column("y", t);
+                col[i++] = O.column(V.y, t);
 
-                add_constraintex(lp, i, row, col, GE, 0);
+                rows.add(i, row, col, GE, 0);
 
                 //cycle startup can't be enabled after a time step where the cycle was operating
                 if(t>0)
                 {
                     row[0] = 1.;
-                    col[0] = O.column("ycsu", t);
+                    col[0] = O.column(V.ycsu, t);
 
                     row[1] = 1.;
-                    col[1] = O.column("y", t-1);
+                    col[1] = O.column(V.y, t-1);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
+                    rows.add(2, row, col, LE, 1.);
                 }
 
 
                 //Standby mode entry
                 i=0;
                 row[i  ] = 1.;
-                col[i++] = O.column("ycsb", t);
+                col[i++] = O.column(V.ycsb, t);
 
                 if(t>0)
                 {
                     row[i  ] = -1.;
-                    col[i++] = O.column("y", t-1);
+                    col[i++] = O.column(V.y, t-1);
 
                     row[i  ] = -1.;
-                    col[i++] = O.column("ycsb", t-1);
+                    col[i++] = O.column(V.ycsb, t-1);
 
-                    add_constraintex(lp, i, row, col, LE, 0);
+                    rows.add(i, row, col, LE, 0);
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
+                    rows.add(i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
                 }
 
                 //some modes can't coincide
                 row[0] = 1.;
-                col[0] = O.column("ycsu", t);
+                col[0] = O.column(V.ycsu, t);
                 row[1] = 1.;
-                col[1] = O.column("ycsb", t);    
+                col[1] = O.column(V.ycsb, t);    
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+                rows.add(2, row, col, LE, 1);   
 
                 row[0] = 1.;
-                col[0] = O.column("y", t);
+                col[0] = O.column(V.y, t);
                 row[1] = 1.;
-                col[1] = O.column("ycsb", t);    
+                col[1] = O.column(V.ycsb, t);    
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+                rows.add(2, row, col, LE, 1);   
 
                 if( t > 0 )
                 {
                     //cycle start penalty
                     row[0] = 1.;
-                    col[0] = O.column("ycsup", t);
+                    col[0] = O.column(V.ycsup, t);
 
                     row[1] = -1.;
-                    col[1] = O.column("ycsu", t);
+                    col[1] = O.column(V.ycsu, t);
 
                     row[2] = 1.;
-                    col[2] = O.column("ycsu", t-1);
+                    col[2] = O.column(V.ycsu, t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+                    rows.add(3, row, col, GE, 0.);
 
                     //cycle standby start penalty
                     row[0] = 1.;
-                    col[0] = O.column("ychsp", t);
+                    col[0] = O.column(V.ychsp, t);
 
                     row[1] = -1.;
-                    col[1] = O.column("y", t);
+                    col[1] = O.column(V.y, t);
 
                     row[2] = -1.;
-                    col[2] = O.column("ycsb", t-1);
+                    col[2] = O.column(V.ycsb, t-1);
 
-                    add_constraintex(lp, 3, row, col, GE, -1.);
+                    rows.add(3, row, col, GE, -1.);
 
 #ifdef MOD_CYCLE_SHUTDOWN
                     //cycle shutdown energy penalty
                     row[0] = 1.;
-                    col[0] = O.column("ycsd", t-1);
+                    col[0] = O.column(V.ycsd, t-1);
 
                     row[1] = -1.;
-                    col[1] = O.column("y", t-1);
+                    col[1] = O.column(V.y, t-1);
                     
                     row[2] = 1.;
-                    col[2] = O.column("y", t);
+                    col[2] = O.column(V.y, t);
                     
                     row[3] = -1.;
-                    col[3] = O.column("ycsb", t-1);
+                    col[3] = O.column(V.ycsb, t-1);
                     
                     row[4] = 1.;
-                    col[4] = O.column("ycsb", t);
+                    col[4] = O.column(V.ycsb, t);
 
-                    add_constraintex(lp, 5, row, col, GE, 0.);
+                    rows.add(5, row, col, GE, 0.);
 #endif
 
                 }
@@ -1134,34 +1278,34 @@ bool csp_dispatch_opt::optimize()
                 int i=0;
 
                 row[i  ] = P["delta"];
-                col[i++] = O.column("xr", t);
+                col[i++] = O.column(V.xr, t);
                 
                 row[i  ] = -P["delta"]*P["Qc"];
-                col[i++] = O.column("ycsu", t);
+                col[i++] = O.column(V.ycsu, t);
                 
                 row[i  ] = -P["delta"]*P["Qb"]; 
-                col[i++] = O.column("ycsb", t);
+                col[i++] = O.column(V.ycsb, t);
                 
                 row[i  ] = -P["delta"];
-                col[i++] = O.column("x", t);
+                col[i++] = O.column(V.x, t);
 #ifdef MOD_REC_STANDBY                
                 row[i  ] = -delta*Qrsb;
                 col[i++] = O.column("yrsb", t);
 #endif
                 
                 row[i  ] = -1.;
-                col[i++] = O.column("s", t);
+                col[i++] = O.column(V.s, t);
                 
                 if(t>0)
                 {
                     row[i  ] = 1.;
-                    col[i++] = O.column("s", t-1);
+                    col[i++] = O.column(V.s, t-1);
 
-                    add_constraintex(lp, i, row, col, EQ, 0.);
+                    rows.add(i, row, col, EQ, 0.);
                 }
                 else
                 {
-                    add_constraintex(lp, i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
+                    rows.add(i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
                 }
             }
         }
@@ -1175,9 +1319,9 @@ bool csp_dispatch_opt::optimize()
             {
                 
                 row[0] = 1.;
-                col[0] = O.column("s", t);
+                col[0] = O.column(V.s, t);
 
-                add_constraintex(lp, 1, row, col, LE, P["Eu"]);
+                rows.add(1, row, col, LE, P["Eu"]);
 
 				//max cycle thermal input in time periods where cycle operates and receiver is starting up
                 //outputs.delta_rs.resize(nt);
@@ -1190,27 +1334,27 @@ bool csp_dispatch_opt::optimize()
 					int i = 0;
 
 					row[i] = 1.;
-					col[i++] = O.column("x", t + 1);
+					col[i++] = O.column(V.x, t + 1);
 
 					row[i] = params.q_pb_standby + large;
-					col[i++] = O.column("ycsb", t + 1);
+					col[i++] = O.column(V.ycsb, t + 1);
 
 					row[i] = -1. / t_rec_startup;
-					col[i++] = O.column("s", t);
+					col[i++] = O.column(V.s, t);
 
 					row[i] = large;
-					col[i++] = O.column("yrsu", t + 1);
+					col[i++] = O.column(V.yrsu, t + 1);
 
 					row[i] = large;
-					col[i++] = O.column("y", t + 1);
+					col[i++] = O.column(V.y, t + 1);
 
 					row[i] = large;
-					col[i++] = O.column("y", t);
+					col[i++] = O.column(V.y, t);
 
 					row[i] = large;
-					col[i++] = O.column("ycsb", t);
+					col[i++] = O.column(V.ycsb, t);
 
-					add_constraintex(lp, i, row, col, LE, 3.0*large);
+					rows.add(i, row, col, LE, 3.0*large);
 				}
 
             }
@@ -1224,9 +1368,9 @@ bool csp_dispatch_opt::optimize()
             for( int t = 0; t<nt; t++ )
             {
                 row[0] = 1.;
-                col[0] = O.column("wdot", t);
+                col[0] = O.column(V.wdot, t);
 
-				add_constraintex(lp, 1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
+				rows.add(1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
             }
         }
 
@@ -1247,43 +1391,49 @@ bool csp_dispatch_opt::optimize()
                     
                 }
 
-				if (w_lim.at(t) > 0.)	// Power cycle operation is possible
+				//a kept model needs the same rows in every window, so when operation is impossible the limit row 
+				//is relaxed and gross production is bounded to zero instead of being fixed by an equality row
+				bool is_wlim_op = w_lim.at(t) > 0.;
+				if (is_wlim_op || is_warm)	// Power cycle operation is possible
 				{
 					int i = 0;
 
 					row[i] = 1.0-outputs.w_condf_expected.at(t);
-					col[i++] = O.column("wdot", t);
+					col[i++] = O.column(V.wdot, t);
 
 					row[i] = -params.w_rec_pump;
-					col[i++] = O.column("xr", t);
+					col[i++] = O.column(V.xr, t);
 
 					row[i] = -params.w_rec_pump;
-					col[i++] = O.column("xrsu", t);
+					col[i++] = O.column(V.xrsu, t);
 
 					row[i] = -(params.w_rec_ht / params.dt) - (params.w_stow / params.dt);	//kWe
-					col[i++] = O.column("yrsu", t);
+					col[i++] = O.column(V.yrsu, t);
 
 					row[i] = -params.w_track;
-					col[i++] = O.column("yr", t);
+					col[i++] = O.column(V.yr, t);
 
 					row[i] = -params.w_cycle_standby;
-					col[i++] = O.column("ycsb", t);
+					col[i++] = O.column(V.ycsb, t);
 
 					row[i] = -params.w_cycle_pump;
-					col[i++] = O.column("x", t);
+					col[i++] = O.column(V.x, t);
 
 					//row[i] = -(params.w_rec_pump*params.q_rec_min) - (params.w_stow / params.dt); //kWe
 					//col[i++] = O.column("yrsb", t);
 					//row[i] - params.w_stow / params.dt;	//kWe
 					//col[i++] = O.column("yrsd", t);
 
-					add_constraintex(lp, 7, row, col, LE, w_lim.at(t));
+					rows.add(7, row, col, LE, is_wlim_op ? w_lim.at(t) : get_infinite(lp));
+
+					if( is_warm )
+						set_upbo(lp, O.column(V.wdot, t), is_wlim_op ? get_infinite(lp) : 0.);
 				}
 				else // Power cycle operation is impossible at current constrained wlim
 				{
 					row[0] = 1.0;
-					col[0] = O.column("wdot", t);
-					add_constraintex(lp, 1, row, col, EQ, 0.);
+					col[0] = O.column(V.wdot, t);
+					rows.add(1, row, col, EQ, 0.);
 				}
 			}
 		}
@@ -1293,7 +1443,18 @@ bool csp_dispatch_opt::optimize()
         set_maxim(lp);
 
         //reset the row mode
-        set_add_rowmode(lp, FALSE);
+        if( ! is_update )
+        {
+            set_add_rowmode(lp, FALSE);
+        }
+        else if( rows.get_row_count() != get_Nrows(lp) )
+        {
+            //the kept model doesn't match the formulation; start over with a new one
+            free_model();
+            lp = NULL;
+            is_retry = true;
+            return false;
+        }
 
         //set the log function
         solver_params.reset();
@@ -1342,8 +1503,10 @@ bool csp_dispatch_opt::optimize()
             NODE_PSEUDOCOSTSELECT + NODE_RANDOMIZEMODE :: optimal from independent optimization, THIS VERSION CURRENT AS OF 12/5/2016
         */
 
-        //presolve
-        if(solver_params.presolve_type > 0)
+        //presolve. Presolve removes rows and columns from the model, so it can't be used when the model is kept.
+        if( is_warm )
+            set_presolve(lp, PRESOLVE_NONE, get_presolveloops(lp));
+        else if(solver_params.presolve_type > 0)
             set_presolve(lp, solver_params.presolve_type, get_presolveloops(lp));
         else
             set_presolve(lp, PRESOLVE_ROWS + PRESOLVE_COLS + PRESOLVE_ELIMEQ2 + PRESOLVE_PROBEFIX, get_presolveloops(lp) );   //independent optimization
@@ -1367,17 +1530,21 @@ bool csp_dispatch_opt::optimize()
 		}
         
  
-       //Problem scaling loop
-        int scaling_iter = 0;
+       //Problem scaling loop. When warm starting, the mode that last solved successfully is tried first.
+        int scaling_order[5] = {0, 1, 2, 3, 4};
+        if( is_warm && m_scaling_mode > 0 )
+        {
+            for(int i=m_scaling_mode; i>0; i--)
+                scaling_order[i] = scaling_order[i-1];
+            scaling_order[0] = m_scaling_mode;
+        }
         bool return_ok = false;
-        while(scaling_iter < 5)
+        for(int k=0; k<5; k++)
         {
+            int scaling_iter = scaling_order[k];
 
             if( solver_params.scaling_type < 0 && scaling_iter == 0)
-            {
-                scaling_iter ++;
                 continue;
-            }
 
             //Scaling algorithm
             switch(scaling_iter)
@@ -1410,7 +1577,11 @@ bool csp_dispatch_opt::optimize()
             return_ok = ret == OPTIMAL || ret == SUBOPTIMAL;
             
             if(return_ok)
+            {
+                if( is_warm )
+                    m_scaling_mode = scaling_iter;
                 break;      //break the scaling loop
+            }
 
             //If the problem was reported as unbounded, this probably has to do with poor scaling. Try again with no scaling.
             string fail_type;
@@ -1426,12 +1597,33 @@ bool csp_dispatch_opt::optimize()
                 fail_type = "... Infeasible";
                 break;
             }
+
+            //lp_solve state carried over in a kept model can make an otherwise solvable problem fail. Formulate the 
+            //window again with a new model.
+            if( is_update )
+            {
+                params.messages->add_message(C_csp_messages::NOTICE, fail_type + " dispatch optimization problem. Retrying with a new model.");
+                free_model();
+                lp = NULL;
+                is_retry = true;
+                return false;
+            }
+
             params.messages->add_message(C_csp_messages::NOTICE, fail_type + " dispatch optimization problem. Retrying with modified problem scaling.");
             
             unscale(lp);
             default_basis(lp);
+        }
 
-            scaling_iter ++;
+        //a new warm-start model failed with every scaling mode. Solve the window again without warm start.
+        if( !return_ok && is_warm )
+        {
+            params.messages->add_message(C_csp_messages::NOTICE, "Dispatch optimization failed with the warm-start model. Retrying without warm start.");
+            m_is_cold_retry = true;
+            free_model();
+            lp = NULL;
+            is_retry = true;
+            return false;
         }
 
         //keep track of problem efficiency
@@ -1468,101 +1660,76 @@ bool csp_dispatch_opt::optimize()
             outputs.q_rec_startup.resize(nt, 0.);
             outputs.w_pb_target.resize(nt, 0.);
 
-            int ncols = get_Ncolumns(lp);
-
-//            char name[15];
-            REAL *vars = new REAL[ncols];
-            get_variables(lp, vars);
-//            int col;
-
-
-            for(int c=1; c<ncols; c++)
+            //map each column back to its variable group and time index. With presolve, columns may have been removed.
+            vector<int> col_var(nvar + 1, -1), col_t(nvar + 1, 0);
+            for(int i=0; i<O.get_num_varobjs(); i++)
             {
-                char *colname = get_col_name(lp, c);
-                if(! colname) continue;
-
-                char root[15];
-
-                int i;
-                for(i=0; i<15; i++)
-                {
-                    if(colname[i] == '-')
-                    {
-                        root[i] = '\0';
-                        break;
-                    }
-                    else
-                        root[i] = colname[i];
-                }
-                int i1=1 + i++;
-                char ind[4];
-                bool not_interested = false;
-                for(i=i1; i<15; i++)
+                optimization_vars::opt_var *v = O.get_var(i);
+                if( v->var_dim != optimization_vars::VAR_DIM::DIM_T ) continue;     //2D variable. Not interested at the moment..
+                for(int t=0; t<v->var_dim_size; t++)
                 {
-                    if(colname[i] == '-')
-                    {
-                        //2D variable. Not interested at the moment..
-                        not_interested = true;
-                        break;
-                    }
-                    else if(colname[i] == 0)
-                    {
-                        ind[i-i1] = '\0';
-                        break;
-                    }
-                    else
-                        ind[i-i1] = colname[i];
+                    col_var[ O.column(i, t) ] = i;
+                    col_t[ O.column(i, t) ] = t;
                 }
+            }
+
+            int ncols = get_Ncolumns(lp);
+            int nrows = get_Nrows(lp);
+            REAL *vars;
+            get_ptr_variables(lp, &vars);
 
-                if(not_interested) continue;  //a 2D variable
+            for(int c=1; c<ncols; c++)
+            {
+                int oc = get_orig_index(lp, nrows + c);
+                if( oc < 1 || oc > nvar ) continue;
 
-                int t = atoi(ind);
+                int var = col_var[oc];
+                int t = col_t[oc];
+                double val = vars[ c-1 ];
 
-                if(strcmp(root, "ycsb") == 0)  //Cycle standby
+                if( var == V.ycsb )  //Cycle standby
                 {
-                    outputs.pb_standby.at(t) = vars[ c-1 ] == 1.;
+                    outputs.pb_standby.at(t) = val == 1.;
                 }
-                else if(strcmp(root, "ycsu") == 0)     //Cycle start up
+                else if( var == V.ycsu )     //Cycle start up
                 {
-                    bool su = (fabs(1 - vars[ c-1 ]) < 0.001);
+                    bool su = (fabs(1 - val) < 0.001);
                     outputs.pb_operation.at(t) = outputs.pb_operation.at(t) || su;
                     outputs.q_pb_startup.at(t) = su ? P["Qc"] : 0.;
                 }
-                else if(strcmp(root, "y") == 0)     //Cycle operation
+                else if( var == V.y )     //Cycle operation
                 {
-                    outputs.pb_operation.at(t) = outputs.pb_operation.at(t) || ( fabs(1. - vars[ c-1 ]) < 0.001 );
+                    outputs.pb_operation.at(t) = outputs.pb_operation.at(t) || ( fabs(1. - val) < 0.001 );
                 }
-                else if(strcmp(root, "x") == 0)     //Cycle thermal energy consumption
+                else if( var == V.x )     //Cycle thermal energy consumption
                 {
-                    outputs.q_pb_target.at(t) = vars[ c-1 ];
+                    outputs.q_pb_target.at(t) = val;
                 }
-                else if(strcmp(root, "yrsu") == 0)     //Receiver start up
+                else if( var == V.yrsu )     //Receiver start up
                 {
-                    outputs.rec_operation.at(t) = outputs.rec_operation.at(t) || (fabs(1 - vars[ c-1 ]) < 0.001);
+                    outputs.rec_operation.at(t) = outputs.rec_operation.at(t) || (fabs(1 - val) < 0.001);
                 }
-                else if(strcmp(root, "xrsu") == 0)
+                else if( var == V.xrsu )
                 {
-                    outputs.q_rec_startup.at(t) = vars[ c-1 ];
+                    outputs.q_rec_startup.at(t) = val;
                 }
-                else if(strcmp(root, "yr") == 0)
+                else if( var == V.yr )
                 {
-                    outputs.rec_operation.at(t) = outputs.rec_operation.at(t) || (fabs(1 - vars[ c-1 ]) < 0.001);
+                    outputs.rec_operation.at(t) = outputs.rec_operation.at(t) || (fabs(1 - val) < 0.001);
                 }
-                else if(strcmp(root, "s") == 0)         //Thermal storage charge state
+                else if( var == V.s )         //Thermal storage charge state
                 {
-                    outputs.tes_charge_expected.at(t) = vars[ c-1 ];
+                    outputs.tes_charge_expected.at(t) = val;
                 }
-                else if(strcmp(root, "xr") == 0)   //receiver production
+                else if( var == V.xr )   //receiver production
                 {
-                    outputs.q_sf_expected.at(t) = vars[ c-1 ];
+                    outputs.q_sf_expected.at(t) = val;
                 }
-                else if(strcmp(root, "wdot") == 0) //electricity production
+                else if( var == V.wdot ) //electricity production
                 {
-                    outputs.w_pb_target.at(t) = vars[ c-1 ];
+                    outputs.w_pb_target.at(t) = val;
                 }
             }
-
-            delete [] vars;
         }
         else
         {
@@ -1578,7 +1745,8 @@ bool csp_dispatch_opt::optimize()
         outputs.solve_iter = (int)get_total_iter(lp);
 
 
-        delete_lp(lp);
+        if( lp != m_lp )
+            delete_lp(lp);
         lp = NULL;
 
         stringstream s;
@@ -1654,7 +1822,10 @@ bool csp_dispatch_opt::optimize()
     catch(exception &e)
     {
         //clean up memory and pass on the exception
-        if( lp != NULL )
+        m_is_cold_retry = false;
+        if( lp == m_lp )
+            free_model();
+        else if( lp != NULL )
             delete_lp(lp);
         
         throw e;
@@ -1663,7 +1834,10 @@ bool csp_dispatch_opt::optimize()
     catch(...)
     {
         //clean up memory and pass on the exception
-        if( lp != NULL )
+        m_is_cold_retry = false;
+        if( lp == m_lp )
+            free_model();
+        else if( lp != NULL )
             delete_lp(lp);
 
         return false;
@@ -2080,3 +2254,11 @@ optimization_vars::opt_var *optimization_vars::get_var(int varindex)
 {
     return &var_objects[varindex];
 }
+
+int optimization_vars::get_var_index(const string &varname)
+{
+    for(int i=0; i<(int)var_objects.size(); i++)
+        if( var_objects[i].name == varname )
+            return i;
+    return -1;
+}
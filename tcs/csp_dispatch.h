@@ -68,8 +68,19 @@ class csp_dispatch_opt
 {
     int  m_nstep_opt;              //number of time steps in the optimized array
     bool m_is_weather_setup;  //bool indicating whether the weather has been copied
+
+    lprec *m_lp;                //model kept between optimization windows when warm starting
+    int m_lp_nstep;             //number of time steps the kept model was built for
+    int m_scaling_mode;         //index of the last scaling mode that solved successfully, -1 if none yet
+    bool m_is_cold_retry;       //the current window is being solved again without warm start
     
     void clear_output_arrays();
+    void free_model();
+    bool optimize_window(bool &is_retry);   //sets is_retry when the window has to be formulated again
+
+    //not copyable: owns the lp_solve model
+    csp_dispatch_opt(const csp_dispatch_opt &);
+    csp_dispatch_opt &operator=(const csp_dispatch_opt &);
 
 public:
     bool m_last_opt_successful;   //last optimization run was successful?
@@ -93,6 +104,7 @@ public:
         int bb_type;  
         int disp_reporting;
         int scaling_type;
+        bool is_warm_start;         //keep the model between windows, update it in place and start from the last basis (presolve is not used)
 
         bool is_write_ampl_dat;     //write ampl data files?
         bool is_ampl_engine;        //run with external AMPL engine
@@ -105,6 +117,7 @@ public:
             disp_reporting = -1;
             presolve_type = -1;
             scaling_type = -1;
+            is_warm_start = false;
         };
 
         void reset()
@@ -295,6 +308,7 @@ public:
     //----- public member functions ----
 
     csp_dispatch_opt();
+    ~csp_dispatch_opt();
 
     //check parameters and inputs to make sure everything has been set up correctly
     bool check_setup(int nstep);
@@ -302,6 +316,12 @@ public:
     //copy the weather data over
     bool copy_weather_data(C_csp_weatherreader &weather_source);
 
+    //copy the parameters, solver settings and weather data of another instance
+    void copy_setup(const csp_dispatch_opt &source);
+
+    //exchange the solved window, its horizon and its signals with another instance
+    void swap_window(csp_dispatch_opt &other);
+
     //multi-variate forecasts
     //bool dispatch_forecast();
 
@@ -381,6 +401,7 @@ public:
 
     opt_var *get_var(const string &varname);
     opt_var *get_var(int varindex);
+    int get_var_index(const string &varname);
 };
 
 
@@ -56,6 +56,54 @@
 #include <algorithm>
 
 #include <sstream>
+#include <thread>
+
+// Runs a dispatch optimization on a background thread. The thread is joined before the object goes out of scope.
+class C_dispatch_worker
+{
+	std::thread m_thread;
+	bool m_is_ok;
+
+public:
+	C_dispatch_worker()
+	{
+		m_is_ok = false;
+	}
+
+	~C_dispatch_worker()
+	{
+		if( m_thread.joinable() )
+			m_thread.join();
+	}
+
+	bool is_running()
+	{
+		return m_thread.joinable();
+	}
+
+	void start(csp_dispatch_opt &dispatch)
+	{
+		m_is_ok = false;
+		m_thread = std::thread([this, &dispatch]()
+		{
+			// a failed window is solved again on the main thread, which reports the error
+			try
+			{
+				m_is_ok = dispatch.optimize();
+			}
+			catch(...)
+			{
+				m_is_ok = false;
+			}
+		});
+	}
+
+	bool finish()
+	{
+		m_thread.join();
+		return m_is_ok;
+	}
+};
 
 void C_timestep_fixed::init(double time_start /*s*/, double step /*s*/)
 {
@@ -265,6 +313,8 @@ C_csp_solver::C_csp_solver(C_csp_weatherreader &weather,
 		m_cycle_P_hot_des = m_cycle_x_hot_des = 
 		m_m_dot_pc_des = m_m_dot_pc_min = m_m_dot_pc_max = m_T_htf_pc_cold_est = std::numeric_limits<double>::quiet_NaN();
 
+	m_disp_n_speculated = m_disp_n_spec_hits = 0;
+
 	// Reporting and Output Tracking
 	mc_reported_outputs.construct(S_solver_output_info);
 
@@ -421,6 +471,14 @@ double C_csp_solver::get_cr_aperture_area()
 	return m_A_aperture;	//[m2]
 }
 
+double C_csp_solver::get_dispatch_speculation_hit_rate()
+{
+	if( m_disp_n_speculated == 0 )
+		return 0.0;
+
+	return (double)m_disp_n_spec_hits / (double)m_disp_n_speculated;	//[-]
+}
+
 void C_csp_solver::init()
 {
 	// First, initialize each component and update solver-level membe data as necessary
@@ -619,12 +677,54 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
     dispatch.solver_params.disp_reporting = mc_tou.mc_dispatch_params.m_disp_reporting;
     dispatch.solver_params.scaling_type = mc_tou.mc_dispatch_params.m_scaling_type;
     dispatch.solver_params.presolve_type = mc_tou.mc_dispatch_params.m_presolve_type;
+    dispatch.solver_params.is_warm_start = mc_tou.mc_dispatch_params.m_is_warm_start;
     dispatch.solver_params.is_write_ampl_dat = mc_tou.mc_dispatch_params.m_is_write_ampl_dat;
     dispatch.solver_params.is_ampl_engine = mc_tou.mc_dispatch_params.m_is_ampl_engine;
     dispatch.solver_params.ampl_data_dir = mc_tou.mc_dispatch_params.m_ampl_data_dir;
     dispatch.solver_params.ampl_exec_call = mc_tou.mc_dispatch_params.m_ampl_exec_call;
     //-------------------------------
 
+    //speculative dispatch: the next window is solved on a worker thread while the current one is simulated.
+    //the worker only runs the optimization; forecasts and prices are prepared on this thread.
+    bool is_disp_async = mc_tou.mc_dispatch_params.m_dispatch_optimize && mc_tou.mc_dispatch_params.m_is_async
+        && !mc_tou.mc_dispatch_params.m_is_write_ampl_dat && !mc_tou.mc_dispatch_params.m_is_ampl_engine;
+
+    csp_dispatch_opt dispatch_next;
+    C_csp_messages disp_next_messages;
+    C_dispatch_worker disp_worker;
+    double disp_next_time = -9999.;
+
+    if( is_disp_async )
+    {
+        dispatch_next.copy_setup(dispatch);
+        dispatch_next.params.messages = &disp_next_messages;
+    }
+    m_disp_n_speculated = m_disp_n_spec_hits = 0;
+
+    //fill the price signal and net generation limits for the window starting at 'time'
+    auto set_dispatch_signals = [&](csp_dispatch_opt &disp, double time /*s*/, int horizon /*hr*/)
+    {
+        int nstep = horizon*mc_tou.mc_dispatch_params.m_disp_steps_per_hour;
+
+        disp.price_signal.clear();
+        disp.price_signal.resize(nstep, 1.);
+
+        for(int t=0; t<nstep; t++)
+        {
+            mc_tou.call(time + t * 3600./(double)mc_tou.mc_dispatch_params.m_disp_steps_per_hour, mc_tou_outputs);
+            disp.price_signal.at(t) = mc_tou_outputs.m_price_mult;
+        }
+
+        disp.w_lim.clear();
+        disp.w_lim.resize(nstep, 1.e99);
+        int hour_start = (int)(ceil (time / 3600. - 1.e-6)) - 1;
+        for (int t = 0; t<horizon; t++)
+        {
+            for (int d = 0; d < mc_tou.mc_dispatch_params.m_disp_steps_per_hour; d++)
+                disp.w_lim.at(t*mc_tou.mc_dispatch_params.m_disp_steps_per_hour+d) = mc_tou.mc_dispatch_params.m_w_lim_full.at(hour_start + t);
+        }
+    };
+
         
 	int cr_operating_state = C_csp_collector_receiver::OFF;
 	int pc_operating_state = C_csp_power_cycle::OFF;
@@ -882,27 +982,6 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
 
                 ss.flush();
 
-                //get the new price signal
-                dispatch.price_signal.clear();
-                dispatch.price_signal.resize(opt_horizon*mc_tou.mc_dispatch_params.m_disp_steps_per_hour, 1.);
-
-                for(int t=0; t<opt_horizon*mc_tou.mc_dispatch_params.m_disp_steps_per_hour; t++)
-                {
-					mc_tou.call(mc_kernel.mc_sim_info.ms_ts.m_time + t * 3600./(double)mc_tou.mc_dispatch_params.m_disp_steps_per_hour, mc_tou_outputs);
-		            dispatch.price_signal.at(t) = mc_tou_outputs.m_price_mult;
-                }
-
-				// get the new electricity generation limits
-				dispatch.w_lim.clear();
-				dispatch.w_lim.resize(opt_horizon*mc_tou.mc_dispatch_params.m_disp_steps_per_hour, 1.e99);
-				int hour_start = (int)(ceil (mc_kernel.mc_sim_info.ms_ts.m_time / 3600. - 1.e-6)) - 1;
-				for (int t = 0; t<opt_horizon; t++)
-				{
-					for (int d = 0; d < mc_tou.mc_dispatch_params.m_disp_steps_per_hour; d++)
-						dispatch.w_lim.at(t*mc_tou.mc_dispatch_params.m_disp_steps_per_hour+d) = mc_tou.mc_dispatch_params.m_w_lim_full.at(hour_start + t);
-				}
-
-
                 //note the states of the power cycle and receiver
                 dispatch.params.is_pb_operating0 = mc_power_cycle.get_operating_state() == 1;
                 dispatch.params.is_pb_standby0 = mc_power_cycle.get_operating_state() == 2;
@@ -924,27 +1003,107 @@ void C_csp_solver::Ssimulate(C_csp_solver::S_sim_setup & sim_setup)
                 if(dispatch.params.e_tes_init > dispatch.params.e_tes_max )
                     dispatch.params.e_tes_init = dispatch.params.e_tes_max;
 
-                //predict performance for the time horizon
-                if( 
-                    dispatch.predict_performance((int)
-                            (mc_kernel.mc_sim_info.ms_ts.m_time/ baseline_step - 1), 
-                            (int)(opt_horizon * mc_tou.mc_dispatch_params.m_disp_steps_per_hour), 
-                            (int)((3600./baseline_step)/mc_tou.mc_dispatch_params.m_disp_steps_per_hour)
-                            ) 
-                    )
+                //use the window solved ahead if the plant reached the state it was solved from
+                bool is_spec_used = false;
+                if( disp_worker.is_running() )
                 {
-                    
-                    //call the optimize method
-                    opt_complete = dispatch.m_last_opt_successful = 
-                        dispatch.optimize();
-                    
+                    bool is_spec_ok = disp_worker.finish();
+                    m_disp_n_speculated++;
+
+                    if( is_spec_ok
+                        && fabs(disp_next_time - mc_kernel.mc_sim_info.ms_ts.m_time) < 1.
+                        && (int)dispatch_next.price_signal.size() == (int)(opt_horizon * mc_tou.mc_dispatch_params.m_disp_steps_per_hour)
+                        && fabs(dispatch_next.params.e_tes_init - dispatch.params.e_tes_init) <= 
+                            mc_tou.mc_dispatch_params.m_async_tes_tol * (dispatch.params.e_tes_max - dispatch.params.e_tes_min)
+                        && fabs(dispatch_next.params.q_pb0 - dispatch.params.q_pb0) <= 
+                            mc_tou.mc_dispatch_params.m_async_tes_tol * dispatch.params.q_pb_max
+                        && dispatch_next.params.is_pb_operating0 == dispatch.params.is_pb_operating0
+                        && dispatch_next.params.is_pb_standby0 == dispatch.params.is_pb_standby0
+                        && dispatch_next.params.is_rec_operating0 == dispatch.params.is_rec_operating0
+                        )
+                    {
+                        dispatch.swap_window(dispatch_next);
+
+                        for( size_t i=0; i<disp_next_messages.m_message_list.size(); i++ )
+                            mc_csp_messages.add_message(disp_next_messages.m_message_list[i].m_type, disp_next_messages.m_message_list[i].msg);
+
+                        m_disp_n_spec_hits++;
+                        is_spec_used = true;
+                    }
+                    disp_next_messages.m_message_list.clear();
+                }
+
+                if( is_spec_used )
+                {
+                    opt_complete = dispatch.m_last_opt_successful = true;
+
                     if(dispatch.solver_params.disp_reporting && (! dispatch.solver_params.log_message.empty()) )
                         mc_csp_messages.add_message(C_csp_messages::NOTICE, dispatch.solver_params.log_message.c_str() );
-                    
-					//mc_csp_messages.add_message(C_csp_messages::NOTICE, dispatch.solver_params.log_message.c_str());
 
                     dispatch.m_current_read_step = 0;   //reset
                 }
+                else
+                {
+                    //get the new price signal and electricity generation limits
+                    set_dispatch_signals(dispatch, mc_kernel.mc_sim_info.ms_ts.m_time, opt_horizon);
+
+                    //predict performance for the time horizon
+                    if( 
+                        dispatch.predict_performance((int)
+                                (mc_kernel.mc_sim_info.ms_ts.m_time/ baseline_step - 1), 
+                                (int)(opt_horizon * mc_tou.mc_dispatch_params.m_disp_steps_per_hour), 
+                                (int)((3600./baseline_step)/mc_tou.mc_dispatch_params.m_disp_steps_per_hour)
+                                ) 
+                        )
+                    {
+                    
+                        //call the optimize method
+                        opt_complete = dispatch.m_last_opt_successful = 
+                            dispatch.optimize();
+                    
+                        if(dispatch.solver_params.disp_reporting && (! dispatch.solver_params.log_message.empty()) )
+                            mc_csp_messages.add_message(C_csp_messages::NOTICE, dispatch.solver_params.log_message.c_str() );
+                    
+					    //mc_csp_messages.add_message(C_csp_messages::NOTICE, dispatch.solver_params.log_message.c_str());
+
+                        dispatch.m_current_read_step = 0;   //reset
+                    }
+                }
+
+                //start solving the next window from the state this one is expected to end in
+                int n_read = mc_tou.mc_dispatch_params.m_optimize_frequency * mc_tou.mc_dispatch_params.m_disp_steps_per_hour;
+                double time_next = mc_kernel.mc_sim_info.ms_ts.m_time + 3600.*mc_tou.mc_dispatch_params.m_optimize_frequency;
+
+                if( is_disp_async && dispatch.m_last_opt_successful
+                    && time_next <= mc_kernel.get_sim_setup()->m_sim_time_end
+                    && n_read <= (int)dispatch.outputs.tes_charge_expected.size() )
+                {
+                    int horizon_next = mc_tou.mc_dispatch_params.m_optimize_horizon;
+                    double hour_next = time_next / 3600.;
+                    if( hour_next >= (8760 - horizon_next) )
+                        horizon_next = (int)min((double)horizon_next, (double)(8761-hour_next));
+
+                    set_dispatch_signals(dispatch_next, time_next, horizon_next);
+
+                    dispatch_next.params.is_pb_operating0 = dispatch.outputs.pb_operation.at(n_read - 1);
+                    dispatch_next.params.is_pb_standby0 = dispatch.outputs.pb_standby.at(n_read - 1);
+                    dispatch_next.params.is_rec_operating0 = dispatch.outputs.rec_operation.at(n_read - 1);
+                    dispatch_next.params.q_pb0 = dispatch.outputs.q_pb_target.at(n_read - 1);
+                    dispatch_next.params.info_time = time_next;
+                    dispatch_next.params.e_tes_init = max(dispatch.params.e_tes_min, min(dispatch.params.e_tes_max, dispatch.outputs.tes_charge_expected.at(n_read - 1)));
+
+                    if( 
+                        dispatch_next.predict_performance((int)
+                                (time_next / baseline_step - 1), 
+                                (int)(horizon_next * mc_tou.mc_dispatch_params.m_disp_steps_per_hour), 
+                                (int)((3600./baseline_step)/mc_tou.mc_dispatch_params.m_disp_steps_per_hour)
+                                ) 
+                        )
+                    {
+                        disp_worker.start(dispatch_next);
+                        disp_next_time = time_next;
+                    }
+                }
 
                 //call again to go back to original state
                 mc_tou.call(mc_kernel.mc_sim_info.ms_ts.m_time, mc_tou_outputs);
@@ -281,6 +281,9 @@ public:
         int m_bb_type;
         int m_disp_reporting;
         int m_scaling_type;
+        bool m_is_warm_start;
+        bool m_is_async;                //solve the next window on a background thread while the current one is simulated
+        double m_async_tes_tol;         //[-] allowed deviation of the actual TES charge and cycle thermal input from the speculated ones, fraction of capacity
         int m_max_iterations;
         double m_disp_time_weighting;
         double m_rsu_cost;
@@ -319,6 +322,9 @@ public:
             m_disp_reporting = -1;
             m_presolve_type = -1;
             m_scaling_type = -1;
+            m_is_warm_start = false;
+            m_is_async = false;
+            m_async_tes_tol = 0.05;
 
             m_disp_time_weighting = 0.99;
             m_rsu_cost = 952.;
@@ -993,6 +999,10 @@ private:
 		// Storage logic
 	bool m_is_tes;			//[-] True: plant has storage
 
+		// Speculative dispatch
+	int m_disp_n_speculated;			//[-] Number of windows solved ahead on the worker thread and checked against the plant state
+	int m_disp_n_spec_hits;				//[-] Number of those solutions that were used
+
 		// Reporting and Output Tracking
 	int m_i_reporting;					//[-]
 	double m_report_time_start;			//[s]
@@ -1126,6 +1136,9 @@ public:
 
 	double get_cr_aperture_area();
 
+	// Fraction of speculatively solved dispatch windows that were used
+	double get_dispatch_speculation_hit_rate();
+
 	// Output vectors
 	// Need to be sure these are always up-to-date as multiple operating modes are tested during one timestep
 	std::vector< std::vector< double > > mvv_outputs_temp;
@@ -60,6 +60,7 @@
 #include "lib_weatherfile.h"
 
 #include <sstream>
+#include <memory>
 
 #define az_scale 6.283125908 
 #define zen_scale 1.570781477 
@@ -335,7 +336,18 @@ void C_pt_heliostatfield::init()
 		case RUN_TYPE::AUTO:
 		case RUN_TYPE::USER_FIELD:
 		{
-			AutoPilot_S sapi;
+			std::unique_ptr<AutoPilot> sapi_ptr;
+#ifdef SP_USE_THREADS
+			if( ms_params.m_n_threads != 1 )
+			{
+				AutoPilot_MT *sapi_mt = new AutoPilot_MT();
+				sapi_mt->SetMaxThreadCount( ms_params.m_n_threads > 0 ? ms_params.m_n_threads : 999999 );
+				sapi_ptr.reset( sapi_mt );
+			}
+			else
+#endif
+				sapi_ptr.reset( new AutoPilot_S() );
+			AutoPilot &sapi = *sapi_ptr;
 
 			sp_optimize opt;
 			sp_layout layout;
@@ -449,8 +461,7 @@ void C_pt_heliostatfield::init()
 				/* 
 				Generate the heliostat field layout using the settings provided by the user				
 				*/
-				vector<string> wfdata;
-				wfdata.reserve( 8760 );
+				WeatherData wfdata;
 				for( int i=0;i<8760;i++ )
 				{
 					weather_record rec;
@@ -460,9 +471,7 @@ void C_pt_heliostatfield::init()
 						mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
 					}
 
-					error_msg = util::format("%d,%d,%d,%.2lf,%.1lf,%.1lf,%.1lf", 
-						rec.day, rec.hour, rec.month, rec.dn, rec.tdry, rec.pres / 1000., rec.wspd);
-					wfdata.push_back(error_msg);
+					wfdata.append( rec.day, rec.hour, rec.month, rec.dn, rec.tdry, rec.pres / 1000., rec.wspd, 1. );
 				}
 
 				if( mf_callback && m_cdata )
@@ -503,22 +512,27 @@ void C_pt_heliostatfield::init()
 				/* 
 				Load in the heliostat field positions that are provided by the user.
 				*/
-				string format = "0,%f,%f,%f,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL;";
                 V.sf.layout_data.val.clear();
 
-                char row[200];
+                sp_layout_table positions;
+                positions.positions.resize( m_N_hel );
 				for( int i=0; i<m_N_hel; i++)
 				{
-                    sprintf(row, format.c_str(), helio_positions(i,0), helio_positions(i,1), pos_dim == 3 ? helio_positions(i,2) : 0. );
-
-                    V.sf.layout_data.val.append( row );
-
+                    sp_layout_table::h_position &hp = positions.positions.at(i);
+                    hp.location.x = helio_positions(i,0);
+                    hp.location.y = helio_positions(i,1);
+                    hp.location.z = pos_dim == 3 ? helio_positions(i,2) : 0.;
+                    hp.aimpoint.x = hp.aimpoint.y = hp.aimpoint.z = 0.;
+                    hp.cant_vector.i = hp.cant_vector.j = hp.cant_vector.k = 0.;
+                    hp.focal_length = 0.;
+                    hp.template_number = 0;
+                    hp.user_optics = false;
 				}
 
                 //set the template name 
                 V.sf.temp_which.set_from_string( "Template 1" ); 
 
-                sapi.Setup(V);
+                sapi.Setup(V, positions);
 								
 			}
             //land area update
@@ -181,6 +181,7 @@ public:
 		int m_focus_type;
 		int m_n_flux_days;
 		int m_delta_flux_hrs;
+		int m_n_threads;		//[-] SolarPILOT threads, 0 = all available cores
 
 		double m_dni_des;
 		double m_land_area;
@@ -193,6 +194,7 @@ public:
 			m_run_type = m_land_bound_type = /*m_nrows_land_bound_table = m_ncols_land_bound_table =*/ /* m_nrows_land_bound_list =*/ m_n_flux_x = m_n_flux_y = /*m_N_hel = m_pos_dim = */
 				/*m_nrows_helio_aim_points = m_ncols_helio_aim_points =*/ /*m_nrows_eta_map = m_ncols_eta_map =*/ /*m_nfluxpos = m_nfposdim = */
 				/*m_nfluxmap = m_nfluxcol =*/ m_n_facet_x = m_n_facet_y = m_cant_type = m_focus_type = m_n_flux_days = m_delta_flux_hrs = -1;
+			m_n_threads = 1;
 
 			// Doubles
 			m_helio_width = m_helio_height = m_helio_optical_error = m_helio_active_fraction = m_dens_mirror = m_helio_reflectance = m_rec_absorptance = m_rec_height = m_rec_aspect =
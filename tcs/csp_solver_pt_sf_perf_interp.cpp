@@ -73,6 +73,7 @@ C_pt_sf_perf_interp::C_pt_sf_perf_interp()
 	m_n_flux_x = m_n_flux_y = -1;
 
 	field_efficiency_table = 0;
+	m_is_eff_grid = false;
 
 	m_cdata = 0;		// = NULL
 	mf_callback = 0;	// = NULL
@@ -213,6 +214,69 @@ void C_pt_sf_perf_interp::init()
 		mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
 	}
 
+	m_is_eff_grid = false;
+	if( ms_params.m_interp_method == INTERP_METHOD::BICUBIC_GRID )
+	{
+		if( ms_params.m_eta_map_aod_format )
+		{
+			mc_csp_messages.add_message(C_csp_messages::WARNING, "The bicubic grid field efficiency interpolation does not support "
+				"AOD efficiency maps. Gauss-Markov interpolation will be used instead.");
+		}
+		else
+		{
+			// Sample the kriging fit on a regular grid that covers all solar azimuths and zenith angles above the horizon.
+			// A 2.5 deg spacing resolves the curvature of typical efficiency maps well below the kriging fit error.
+			double az_min = 0.0;
+			double az_max = 2.0*CSP::pi / az_scale;
+			for( int i = 0; i < npoints; i++ )
+			{
+				az_min = fmin(az_min, sunpos.at(i).at(0));
+				az_max = fmax(az_max, sunpos.at(i).at(0));
+			}
+			double zen_min = 0.0;
+			double zen_max = CSP::pi / 2.0 / zen_scale;
+			double d_grid = 2.5*CSP::pi / 180.0;
+			int n_az = (int)ceil((az_max - az_min)*az_scale / d_grid) + 1;
+			int n_zen = (int)ceil((zen_max - zen_min)*zen_scale / d_grid) + 1;
+
+			util::matrix_t<double> eff_grid(n_zen, n_az);
+			VectDoub pos(2);
+			for( int j = 0; j < n_zen; j++ )
+			{
+				pos.at(1) = zen_min + (zen_max - zen_min)*j / (double)(n_zen - 1);
+				for( int i = 0; i < n_az; i++ )
+				{
+					pos.at(0) = az_min + (az_max - az_min)*i / (double)(n_az - 1);
+					eff_grid(j, i) = field_efficiency_table->interp(pos);
+				}
+			}
+			m_is_eff_grid = m_eff_grid.Set_2D_Grid(az_min, az_max, zen_min, zen_max, eff_grid);
+
+			// test how well the grid matches the data
+			vector<double> az_pts(npoints), zen_pts(npoints), eff_pts(npoints);
+			for( int i = 0; i < npoints; i++ )
+			{
+				az_pts.at(i) = sunpos.at(i).at(0);
+				zen_pts.at(i) = sunpos.at(i).at(1);
+			}
+			if( npoints > 0 )
+				m_eff_grid.bicubic_2D_interp(npoints, &az_pts[0], &zen_pts[0], &eff_pts[0]);
+			double err_grid = 0.;
+			for( int i = 0; i < npoints; i++ )
+			{
+				double dz = effs.at(i) - eff_pts.at(i);
+				err_grid += dz * dz;
+			}
+			err_grid = sqrt(err_grid);
+			if( err_grid > 0.01 )
+			{
+				error_msg = util::format("The heliostat field efficiency grid does not match the efficiency map well (err_fit=%f RMS). "
+					"Consider using Gauss-Markov interpolation.", err_grid);
+				mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
+			}
+		}
+	}
+
 	// Initialize stored variables
 	m_eta_prev = 0.0;
 	m_v_wind_prev = 0.0;
@@ -289,7 +353,10 @@ void C_pt_sf_perf_interp::call(const C_csp_weatherreader::S_outputs &weather, do
                 sunpos.push_back( weather.m_aod );
         }
 
-		eta_field = field_efficiency_table->interp(sunpos) * eff_scale;
+		if( m_is_eff_grid )
+			eta_field = m_eff_grid.bicubic_2D_interp(sunpos[0], sunpos[1]) * eff_scale;
+		else
+			eta_field = field_efficiency_table->interp(sunpos) * eff_scale;
 		eta_field = fmin(fmax(eta_field, 0.0), 1.0) * field_control * sf_adjust;		// Ensure physical behavior 
 
 		//Set the active flux map
@@ -113,6 +113,8 @@ C_csp_trough_collector_receiver::C_csp_trough_collector_receiver()
 	m_nLoops =  -1;
 	m_FieldConfig = -1;
 	m_include_fixed_heat_sink_runner = true;
+	m_use_htf_prop_tables = false;
+	m_use_evac_memo = false;
 	m_L_heat_sink_piping = std::numeric_limits<double>::quiet_NaN();
 	m_eta_pump = std::numeric_limits<double>::quiet_NaN();
 	m_HDR_rough = std::numeric_limits<double>::quiet_NaN();
@@ -259,6 +261,8 @@ void C_csp_trough_collector_receiver::init(const C_csp_collector_receiver::S_csp
 	//Initialize air properties -- used in reeiver calcs
 	m_airProps.SetFluid(HTFProperties::Air);
 
+	m_evac_memo.clear();
+
 	// Save init_inputs to member data
 	m_latitude = init_inputs.m_latitude;	//[deg]
 	m_longitude = init_inputs.m_longitude;	//[deg]
@@ -364,6 +368,27 @@ void C_csp_trough_collector_receiver::init(const C_csp_collector_receiver::S_csp
 	m_T_fp += 273.15;				//[K] convert from C
 	m_mc_bal_sca *= 3.6e3;			//[Wht/K-m] -> [J/K-m]
 
+	if (m_use_htf_prop_tables)
+	{
+		// Cover the HTF temperatures seen in operation and freeze protection, and the air film temperatures in the receiver.
+		// Temperatures outside these ranges use the property correlations
+		// The tables are only used when they match the correlations to within 0.1%
+		double prop_table_err_max = 1.E-3;
+		double htf_table_err = m_htfProps.set_prop_tables(fmin(m_T_fp, m_T_loop_in_des) - 50.0, m_T_loop_out_des + 100.0, 0.5);
+		if (htf_table_err > prop_table_err_max)
+		{
+			m_error_msg = util::format("The field HTF property tables differ from the property correlations by up to %lg %%. "
+				"Disable the HTF property tables for this fluid", htf_table_err*100.0);
+			throw(C_csp_exception(m_error_msg, "Trough Collector Solver"));
+		}
+		double air_table_err = m_airProps.set_prop_tables(200.0, 900.0, 0.5);
+		if (air_table_err > prop_table_err_max)
+		{
+			m_error_msg = util::format("The receiver annulus air property tables differ from the property correlations by up to %lg %%", air_table_err*100.0);
+			throw(C_csp_exception(m_error_msg, "Trough Collector Solver"));
+		}
+	}
+
 
 	/*--- Do any initialization calculations here ---- */
 	//Allocate space for the loop simulation objects
@@ -433,6 +458,7 @@ void C_csp_trough_collector_receiver::init(const C_csp_collector_receiver::S_csp
 
 	// Set previous operating mode
 	m_operating_mode_converged = C_csp_collector_receiver::OFF;					//[-] 0 = requires startup, 1 = starting up, 2 = running
+	m_operating_mode = C_csp_collector_receiver::OFF;							//[-] estimates() reads this before the first call to off(), startup(), or on()
 
 	return;
 }
@@ -3708,6 +3734,38 @@ double C_csp_trough_collector_receiver::get_collector_area()
 
 // ------------------------------------------ supplemental methods -----------------------------------------------------------
 
+// Quantization steps for the EvacReceiver memo key. Calls whose inputs agree to within these steps reuse the stored solution,
+//   which is well inside the convergence tolerances of the receiver energy balance itself
+static const double evac_memo_dT = 1.E-3;			//[K] Inlet, ambient, and sky temperatures
+static const double evac_memo_dm_dot = 1.E-6;		//[kg/s] Loop mass flow rate
+static const double evac_memo_dv = 1.E-3;			//[m/s] Wind velocity
+static const double evac_memo_dP = 1.0;				//[Pa] Ambient pressure
+static const double evac_memo_dq = 1.E-3;			//[W/m] Incident irradiation after collector optics
+static const size_t evac_memo_max_size = 200000;	//[-] Memo is cleared when it grows to this many solutions
+
+static long long evac_memo_quantize(double x, double step)
+{
+	return (long long)floor(x / step + 0.5);
+}
+
+bool C_csp_trough_collector_receiver::S_evac_memo_key::operator==(const S_evac_memo_key &rhs) const
+{
+	return m_T_1_in == rhs.m_T_1_in && m_m_dot == rhs.m_m_dot && m_T_amb == rhs.m_T_amb && m_T_sky == rhs.m_T_sky
+		&& m_v_6 == rhs.m_v_6 && m_P_6 == rhs.m_P_6 && m_q_opt == rhs.m_q_opt
+		&& m_hn == rhs.m_hn && m_hv == rhs.m_hv && m_ct == rhs.m_ct && m_flags == rhs.m_flags;
+}
+
+size_t C_csp_trough_collector_receiver::S_evac_memo_key_hash::operator()(const S_evac_memo_key &key) const
+{
+	std::hash<long long> h;
+	size_t seed = h(key.m_T_1_in);
+	long long fields[] = {key.m_m_dot, key.m_T_amb, key.m_T_sky, key.m_v_6, key.m_P_6, key.m_q_opt,
+		((long long)key.m_hn << 24) | ((long long)key.m_hv << 16) | ((long long)key.m_ct << 8) | key.m_flags};
+	for (int i = 0; i < 7; i++)
+		seed ^= h(fields[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	return seed;
+}
+
 
 /*
 This subroutine contains the trough detailed plant model.  The collector field is modeled
@@ -3805,6 +3863,30 @@ void C_csp_trough_collector_receiver::EvacReceiver(double T_1_in, double m_dot,
 	//cc -- note that collector/hce geometry is part of the parent class. Only the indices specifying the
 	//		number of the HCE and collector need to be passed here.
 
+	// If memoization is enabled, look for the solution from a previous call with the same quantized inputs. A stored
+	// solution is used after the reguess checks below, so the guess state is updated the same way as for a full solve.
+	// The incident irradiation and collector optical efficiency only enter the energy balance as a product
+	S_evac_memo_key memo_key;
+	const S_evac_memo_solution *memo_sol = 0;
+	if (m_use_evac_memo)
+	{
+		memo_key.m_T_1_in = evac_memo_quantize(T_1_in, evac_memo_dT);
+		memo_key.m_m_dot = evac_memo_quantize(m_dot, evac_memo_dm_dot);
+		memo_key.m_T_amb = evac_memo_quantize(T_amb, evac_memo_dT);
+		memo_key.m_T_sky = evac_memo_quantize(m_T_sky, evac_memo_dT);
+		memo_key.m_v_6 = evac_memo_quantize(v_6, evac_memo_dv);
+		memo_key.m_P_6 = evac_memo_quantize(P_6, evac_memo_dP);
+		memo_key.m_q_opt = evac_memo_quantize(m_q_i*m_ColOptEff(ct, sca_num), evac_memo_dq);
+		memo_key.m_hn = hn;
+		memo_key.m_hv = hv;
+		memo_key.m_ct = ct;
+		memo_key.m_flags = (single_point ? 1 : 0) | (ncall > 8 ? 2 : 0);	// tolerances are tightened after 8 calls
+
+		std::unordered_map<S_evac_memo_key, S_evac_memo_solution, S_evac_memo_key_hash>::const_iterator it_memo = m_evac_memo.find(memo_key);
+		if (it_memo != m_evac_memo.end())
+			memo_sol = &it_memo->second;
+	}
+
 	//---Variable declarations------
 	bool reguess;
 	double T_2, T_3, T_4, T_5, T_6, T_7, m_v_1, k_23, q_34conv, q_34rad, h_34conv, h_34rad, q_23cond,
@@ -3881,6 +3963,19 @@ lab_keep_guess:
 		}
 	}
 
+	if (memo_sol != 0)
+	{
+		q_heatloss = memo_sol->m_q_heatloss;
+		q_12conv = memo_sol->m_q_12conv;
+		q_34tot = memo_sol->m_q_34tot;
+		c_1ave = memo_sol->m_c_1ave;
+		rho_1ave = memo_sol->m_rho_1ave;
+		for (int i = 0; i < 4; i++)
+			m_T_save[i + 1] = memo_sol->m_T_save[i];
+
+		return;
+	}
+
 	//Set intial guess values
 	T_2 = m_T_save[1];
 	T_3 = m_T_save[2];
@@ -4283,6 +4378,21 @@ lab_keep_guess:
 	m_T_save[3] = T_4;
 	m_T_save[4] = T_5;
 
+	if (m_use_evac_memo)
+	{
+		if (m_evac_memo.size() >= evac_memo_max_size)
+			m_evac_memo.clear();
+
+		S_evac_memo_solution &sol = m_evac_memo[memo_key];
+		sol.m_q_heatloss = q_heatloss;
+		sol.m_q_12conv = q_12conv;
+		sol.m_q_34tot = q_34tot;
+		sol.m_c_1ave = c_1ave;
+		sol.m_rho_1ave = rho_1ave;
+		for (int i = 0; i < 4; i++)
+			sol.m_T_save[i] = m_T_save[i + 1];
+	}
+
 };
 
 
@@ -62,6 +62,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 
 class C_csp_trough_collector_receiver : public C_csp_collector_receiver
 {
@@ -308,6 +309,28 @@ private:
 	// Member variables that are used to store information for the EvacReceiver method
 	double m_T_save[5];			//[K] Saved temperatures from previous call to EvacReceiver single SCA energy balance model
 	std::vector<double> mv_reguess_args;	//[-] Logic to determine whether to use previous guess values or start iteration fresh
+
+	// Memoized EvacReceiver solutions, keyed on the quantized inputs that determine the single SCA energy balance
+	struct S_evac_memo_key
+	{
+		long long m_T_1_in, m_m_dot, m_T_amb, m_T_sky, m_v_6, m_P_6, m_q_opt;
+		int m_hn, m_hv, m_ct, m_flags;
+
+		bool operator==(const S_evac_memo_key &rhs) const;
+	};
+
+	struct S_evac_memo_key_hash
+	{
+		size_t operator()(const S_evac_memo_key &key) const;
+	};
+
+	struct S_evac_memo_solution
+	{
+		double m_q_heatloss, m_q_12conv, m_q_34tot, m_c_1ave, m_rho_1ave;	//[W/m], [W/m], [W/m], [kJ/kg-K], [kg/m3]
+		double m_T_save[4];		//[K] T_2 through T_5, restored as the next guess values
+	};
+
+	std::unordered_map<S_evac_memo_key, S_evac_memo_solution, S_evac_memo_key_hash> m_evac_memo;
 	
 	// member string for exception messages
 	std::string m_error_msg;
@@ -348,6 +371,8 @@ public:
 	double m_T_loop_in_des;	//[C] Design loop inlet temperature, converted to K in init
 	double m_T_loop_out_des;//[C] Target loop outlet temperature, converted to K in init
 	int m_Fluid;			//[-] Field HTF fluid number
+	bool m_use_htf_prop_tables;	//[-] Evaluate field HTF and air properties from precomputed temperature tables
+	bool m_use_evac_memo;		//[-] Reuse EvacReceiver solutions for repeated calls with (nearly) identical inputs
 	
 	double m_T_fp;			//[C] Freeze protection temperature (heat trace activation temperature), convert to K in init
 	double m_I_bn_des;		//[W/m^2] Solar irradiation at design
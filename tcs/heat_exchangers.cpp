@@ -53,10 +53,28 @@
 #include <algorithm>
 #include "numeric_solvers.h"
 
+// Use the solver's property cache when one is supplied
+static int co2_PH(C_CO2_prop_cache *p_co2_cache, double P /*kPa*/, double h /*kJ/kg*/, CO2_state *co2_props)
+{
+	if (p_co2_cache != 0)
+		return p_co2_cache->PH(P, h, co2_props);
+
+	return CO2_PH(P, h, co2_props);
+}
+
+static int co2_TP(C_CO2_prop_cache *p_co2_cache, double T /*K*/, double P /*kPa*/, CO2_state *co2_props)
+{
+	if (p_co2_cache != 0)
+		return p_co2_cache->TP(T, P, co2_props);
+
+	return CO2_TP(T, P, co2_props);
+}
+
 double NS_HX_counterflow_eqs::calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
 	int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
 	double h_h_in /*kJ/kg*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/, double m_dot_h /*kg/s*/,
-	double h_c_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double m_dot_c /*kg/s*/)
+	double h_c_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double m_dot_c /*kg/s*/,
+	C_CO2_prop_cache *p_co2_cache)
 {
 	int prop_error_code = 0;
 
@@ -65,7 +83,7 @@ double NS_HX_counterflow_eqs::calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProp
 	if (hot_fl_code == NS_HX_counterflow_eqs::CO2)
 	{
 		CO2_state ms_co2_props;
-		prop_error_code = CO2_PH(P_h_in, h_h_in, &ms_co2_props);
+		prop_error_code = co2_PH(p_co2_cache, P_h_in, h_h_in, &ms_co2_props);
 		if (prop_error_code != 0)
 		{
 			throw(C_csp_exception("C_HX_counterflow::design",
@@ -93,7 +111,7 @@ double NS_HX_counterflow_eqs::calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProp
 	if (cold_fl_code == NS_HX_counterflow_eqs::CO2)
 	{
 		CO2_state ms_co2_props;
-		prop_error_code = CO2_PH(P_c_in, h_c_in, &ms_co2_props);
+		prop_error_code = co2_PH(p_co2_cache, P_c_in, h_c_in, &ms_co2_props);
 		if (prop_error_code != 0)
 		{
 			throw(C_csp_exception("C_HX_counterflow::design",
@@ -123,7 +141,7 @@ double NS_HX_counterflow_eqs::calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProp
 	if (cold_fl_code == NS_HX_counterflow_eqs::CO2)
 	{
 		CO2_state ms_co2_props;
-		prop_error_code = CO2_TP(T_h_in, P_c_out, &ms_co2_props);
+		prop_error_code = co2_TP(p_co2_cache, T_h_in, P_c_out, &ms_co2_props);
 		if (prop_error_code == 205)
 		{
 			prop_error_code = CO2_TQ(T_h_in, 0.0, &ms_co2_props);
@@ -163,7 +181,7 @@ double NS_HX_counterflow_eqs::calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProp
 	if (hot_fl_code == NS_HX_counterflow_eqs::CO2)
 	{
 		CO2_state ms_co2_props;
-		prop_error_code = CO2_TP(T_c_in, P_h_out, &ms_co2_props);
+		prop_error_code = co2_TP(p_co2_cache, T_c_in, P_h_out, &ms_co2_props);
 		if (prop_error_code == 205)
 		{
 			prop_error_code = CO2_TQ(T_c_in, 1.0, &ms_co2_props);
@@ -402,7 +420,8 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 	double q_dot /*kWt*/, double m_dot_c /*kg/s*/, double m_dot_h /*kg/s*/,
 	double h_c_in /*kJ/kg*/, double h_h_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/,
 	double & h_h_out /*kJ/kg*/, double & T_h_out /*K*/, double & h_c_out /*kJ/kg*/, double & T_c_out /*K*/,
-	double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/)
+	double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/,
+	C_CO2_prop_cache *p_co2_cache)
 {
 	// Check inputs
 	if (q_dot < 0.0)
@@ -465,7 +484,7 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 		double T_h = std::numeric_limits<double>::quiet_NaN();
 		if (hot_fl_code == NS_HX_counterflow_eqs::CO2)
 		{
-			prop_error_code = CO2_PH(P_h, h_h, &ms_co2_props);
+			prop_error_code = co2_PH(p_co2_cache, P_h, h_h, &ms_co2_props);
 			if (prop_error_code != 0)
 			{
 				throw(C_csp_exception("C_HX_counterflow::design",
@@ -491,7 +510,7 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 		double T_c = std::numeric_limits<double>::quiet_NaN();
 		if (cold_fl_code == NS_HX_counterflow_eqs::CO2)
 		{
-			prop_error_code = CO2_PH(P_c, h_c, &ms_co2_props);
+			prop_error_code = co2_PH(p_co2_cache, P_c, h_c, &ms_co2_props);
 			if (prop_error_code != 0)
 			{
 				throw(C_csp_exception("C_HX_counterflow::design",
@@ -609,7 +628,8 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 	double q_dot_max = NS_HX_counterflow_eqs::calc_max_q_dot_enth(hot_fl_code, hot_htf_class,
 		cold_fl_code, cold_htf_class,
 		h_h_in, P_h_in, P_h_out, m_dot_h,
-		h_c_in, P_c_in, P_c_out, m_dot_c);
+		h_c_in, P_c_in, P_c_out, m_dot_c,
+		p_co2_cache);
 
 	eff = q_dot / q_dot_max;
 
@@ -671,7 +691,8 @@ int NS_HX_counterflow_eqs::C_mono_eq_UA_v_q_enth::operator()(double q_dot /*kWt*
 			q_dot, m_m_dot_c, m_m_dot_h, 
 			m_h_c_in, m_h_h_in, m_P_c_in, m_P_c_out, m_P_h_in, m_P_h_out, 
 			m_h_h_out, m_T_h_out, m_h_c_out, m_T_c_out,
-			m_UA_calc, m_min_DT, m_eff, m_NTU, q_dot_calc);
+			m_UA_calc, m_min_DT, m_eff, m_NTU, q_dot_calc,
+			&mc_co2_cache);
 	}
 	catch (C_csp_exception &csp_except)
 	{
@@ -725,10 +746,18 @@ void NS_HX_counterflow_eqs::solve_q_dot_for_fixed_UA_enth(int hot_fl_code /*-*/,
 		return;
 	}
 
+	NS_HX_counterflow_eqs::C_mono_eq_UA_v_q_enth od_hx_eq(hot_fl_code, hot_htf_class,
+		cold_fl_code, cold_htf_class,
+		N_sub_hx,
+		P_c_out, P_h_out,
+		h_c_in, P_c_in, m_dot_c,
+		h_h_in, P_h_in, m_dot_h);
+
 	double q_dot_max = NS_HX_counterflow_eqs::calc_max_q_dot_enth(hot_fl_code, hot_htf_class,
 		cold_fl_code, cold_htf_class,
 		h_h_in, P_h_in, P_h_out, m_dot_h,
-		h_c_in, P_c_in, P_c_out, m_dot_c);
+		h_c_in, P_c_in, P_c_out, m_dot_c,
+		&od_hx_eq.mc_co2_cache);
 
 	double q_dot_upper = eff_limit*q_dot_max;
 
@@ -746,12 +775,6 @@ void NS_HX_counterflow_eqs::solve_q_dot_for_fixed_UA_enth(int hot_fl_code /*-*/,
 	double tol = 0.001;
 	double q_dot_lower = 1.E-10;		//[kWt]
 
-	NS_HX_counterflow_eqs::C_mono_eq_UA_v_q_enth od_hx_eq(hot_fl_code, hot_htf_class,
-		cold_fl_code, cold_htf_class,
-		N_sub_hx,
-		P_c_out, P_h_out,
-		h_c_in, P_c_in, m_dot_c,
-		h_h_in, P_h_in, m_dot_h);
 	C_monotonic_eq_solver od_hx_solver(od_hx_eq);
 
 	// First, test at q_dot_upper
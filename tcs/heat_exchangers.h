@@ -51,6 +51,7 @@
 #define __HEAT_EXCHANGERS_
 
 #include "CO2_properties.h"
+#include "CO2_prop_cache.h"
 #include "water_properties.h"
 #include "htf_props.h"
 #include "lib_util.h"
@@ -69,7 +70,8 @@ namespace NS_HX_counterflow_eqs
 	double calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
 		int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
 		double h_h_in /*kJ/kg*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/, double m_dot_h /*kg/s*/,
-		double h_c_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double m_dot_c /*kg/s*/);
+		double h_c_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double m_dot_c /*kg/s*/,
+		C_CO2_prop_cache *p_co2_cache = 0);
 
 	double calc_max_q_dot(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
 		int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
@@ -89,7 +91,8 @@ namespace NS_HX_counterflow_eqs
 		double q_dot /*kWt*/, double m_dot_c /*kg/s*/, double m_dot_h /*kg/s*/,
 		double h_c_in /*kJ/kg*/, double h_h_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/,
 		double & h_h_out /*kJ/kg*/, double & T_h_out /*K*/, double & h_c_out /*kJ/kg*/, double & T_c_out /*K*/,
-		double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/);
+		double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/,
+		C_CO2_prop_cache *p_co2_cache = 0);
 	
 	void solve_q_dot_for_fixed_UA(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
 		int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
@@ -172,6 +175,9 @@ namespace NS_HX_counterflow_eqs
 		double m_NTU;			//[-]
 		double m_UA_calc;		//[kW/K]
 
+		// The inlet states are the same on every iteration of the solve, so they are answered from this cache
+		C_CO2_prop_cache mc_co2_cache;
+
 		virtual int operator()(double q_dot /*kWt*/, double *UA_calc /*kW/K*/);
 	};
 }
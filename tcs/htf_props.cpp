@@ -57,6 +57,11 @@ HTFProperties::HTFProperties()
 	uf_err_msg = "The user-defined htf property table is invalid (rows=%d cols=%d)";
 
 	m_is_temp_enth_avail = false;
+
+	m_is_prop_tables = false;
+	m_is_dens_tabulated = false;
+	m_T_tab_low = m_T_tab_high = m_delta_T_tab_max = m_inv_delta_T_tab = std::numeric_limits<double>::quiet_NaN();
+	m_n_tab = 0;
 }
 
 bool HTFProperties::SetUserDefinedFluid(const util::matrix_t<double> &table, bool calc_temp_enth_table)
@@ -97,6 +102,9 @@ bool HTFProperties::SetUserDefinedFluid( const util::matrix_t<double> &table )
 		set_temp_enth_lookup();
 	}
 
+	if( m_n_tab > 0 )
+		build_prop_tables();
+
 	return true;
 }
 
@@ -198,9 +206,111 @@ bool HTFProperties::SetFluid( int fluid )
 		set_temp_enth_lookup();
 	}
 
+	if( m_n_tab > 0 )
+		build_prop_tables();
+
 	return true;
 }
 
+double HTFProperties::set_prop_tables( double T_low_K, double T_high_K, double delta_T_K )
+{
+	if( !(T_high_K > T_low_K) || !(delta_T_K > 0.0) )
+	{
+		throw(C_csp_exception("The property table temperature range and spacing must be positive",
+			"HTFProperties::set_prop_tables"));
+	}
+
+	m_T_tab_low = T_low_K;
+	m_T_tab_high = T_high_K;
+	m_delta_T_tab_max = delta_T_K;
+	m_n_tab = (int)ceil((T_high_K - T_low_K) / delta_T_K) + 1;
+
+	return build_prop_tables();
+}
+
+void HTFProperties::clear_prop_tables()
+{
+	m_is_prop_tables = false;
+	m_n_tab = 0;
+	m_prop_tab.clear();
+}
+
+double HTFProperties::build_prop_tables()
+{
+	// Evaluate the correlations at the table nodes. Tables are only used once they are complete
+	m_is_prop_tables = false;
+
+	m_inv_delta_T_tab = double(m_n_tab - 1) / (m_T_tab_high - m_T_tab_low);
+	double delta_T = 1.0 / m_inv_delta_T_tab;
+
+	// Gases modeled as ideal gases have a pressure dependent density
+	m_is_dens_tabulated = !(m_fluid == Air || m_fluid == Argon_ideal || m_fluid == Hydrogen_ideal);
+
+	m_prop_tab.resize(m_n_tab*N_TAB_PROPS);
+	for( int i = 0; i < m_n_tab; i++ )
+	{
+		double T_K = m_T_tab_low + delta_T*i;
+		double *p = &m_prop_tab[i*N_TAB_PROPS];
+		p[TAB_CP] = Cp(T_K);
+		p[TAB_DENS] = m_is_dens_tabulated ? dens(T_K, 0.0) : std::numeric_limits<double>::quiet_NaN();
+		p[TAB_VISC] = visc(T_K);
+		p[TAB_COND] = cond(T_K);
+		p[TAB_ENTH] = enth(T_K);
+	}
+
+	// Compare the interpolated values to the correlations halfway between nodes, where the linear interpolation error is largest.
+	// Skip properties that aren't defined for this fluid (NaN) and enthalpy near its zero point
+	double err_max = 0.0;
+	for( int i = 0; i < m_n_tab - 1; i++ )
+	{
+		double T_K = m_T_tab_low + delta_T*(i + 0.5);
+		double props[N_TAB_PROPS] = { Cp(T_K), m_is_dens_tabulated ? dens(T_K, 0.0) : 0.0, visc(T_K), cond(T_K), enth(T_K) };
+		for( int k = 0; k < N_TAB_PROPS; k++ )
+		{
+			if( k == TAB_DENS && !m_is_dens_tabulated )
+				continue;
+			double y_tab = 0.5*(m_prop_tab[i*N_TAB_PROPS + k] + m_prop_tab[(i + 1)*N_TAB_PROPS + k]);
+			if( props[k] != props[k] || y_tab != y_tab || fabs(props[k]) < 1.E-6 )
+				continue;
+			err_max = fmax(err_max, fabs(y_tab / props[k] - 1.0));
+		}
+	}
+
+	m_is_prop_tables = true;
+
+	return err_max;
+}
+
+void HTFProperties::Cp( int n, const double *T_K, double *cp )
+{
+	for( int i = 0; i < n; i++ )
+		cp[i] = Cp(T_K[i]);
+}
+
+void HTFProperties::dens( int n, const double *T_K, double P, double *rho )
+{
+	for( int i = 0; i < n; i++ )
+		rho[i] = dens(T_K[i], P);
+}
+
+void HTFProperties::visc( int n, const double *T_K, double *mu )
+{
+	for( int i = 0; i < n; i++ )
+		mu[i] = visc(T_K[i]);
+}
+
+void HTFProperties::cond( int n, const double *T_K, double *k )
+{
+	for( int i = 0; i < n; i++ )
+		k[i] = cond(T_K[i]);
+}
+
+void HTFProperties::enth( int n, const double *T_K, double *h )
+{
+	for( int i = 0; i < n; i++ )
+		h[i] = enth(T_K[i]);
+}
+
 const util::matrix_t<double> *HTFProperties::get_prop_table()
 {
 	return &m_userTable;
@@ -251,6 +361,9 @@ double HTFProperties::Cp( double T_K )
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( is_in_prop_tables(T_K) )
+		return prop_table_interp(TAB_CP, T_K);
+
 	double T_C = T_K - 273.15;		// Also provide temperature in C
 
 	switch(m_fluid)
@@ -330,6 +443,9 @@ double HTFProperties::dens(double T_K, double P)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( is_in_prop_tables(T_K) && m_is_dens_tabulated )
+		return prop_table_interp(TAB_DENS, T_K);
+
 	double T_C = T_K - 273.15;		// This function accepts as inputs temperature[K]. Convert to [C] for correlations
 
 	switch(m_fluid)
@@ -408,6 +524,9 @@ double HTFProperties::visc(double T_K)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( is_in_prop_tables(T_K) )
+		return prop_table_interp(TAB_VISC, T_K);
+
 	double T_C = T_K - 273.15;		// This function accepts as inputs temperature[K]. Convert to [C] for correlations
 
 	switch(m_fluid)
@@ -495,6 +614,9 @@ double HTFProperties::cond(double T_K)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( is_in_prop_tables(T_K) )
+		return prop_table_interp(TAB_COND, T_K);
+
 	double T_C = T_K - 273.15;
 
 	switch(m_fluid)
@@ -613,6 +735,9 @@ double HTFProperties::enth(double T_K)
 	Converted to c++ from Fortran code Type 229 in November 2012 by Ty Neises
 	Original author: Michael J. Wagner */
 
+	if( is_in_prop_tables(T_K) )
+		return prop_table_interp(TAB_ENTH, T_K);
+
 	double T_C = T_K - 273.15;
 
 	switch(m_fluid)
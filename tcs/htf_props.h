@@ -53,6 +53,7 @@
 
 #include "interpolation_routines.h"
 #include <limits>
+#include <vector>
 
 class HTFProperties
 {
@@ -127,6 +128,23 @@ public:
 	double temp_lookup( double enth /*kJ/kg*/ );
 	double enth_lookup( double temp /*K*/ );
 
+	/* Optional tabulated mode: Cp, dens, visc, cond and enth are precomputed on a uniform temperature grid
+	 over [T_low_K, T_high_K] with spacing of at most delta_T_K, and are linearly interpolated inside that range.
+	 Temperatures outside the range, and the density of fluids that depend on pressure, use the correlations.
+	 The tables are rebuilt whenever the fluid is set. Returns the largest relative difference from the 
+	 correlations found at the midpoints between table nodes, which bounds the interpolation error for smooth 
+	 properties. */
+	double set_prop_tables( double T_low_K, double T_high_K, double delta_T_K );
+	void clear_prop_tables();
+	bool is_prop_tables(){ return m_is_prop_tables; }
+
+	// Batch evaluation of n temperatures [K]
+	void Cp( int n, const double *T_K, double *cp );
+	void dens( int n, const double *T_K, double P, double *rho );
+	void visc( int n, const double *T_K, double *mu );
+	void cond( int n, const double *T_K, double *k );
+	void enth( int n, const double *T_K, double *h );
+
 	// 12.11.15 twn: Add method to calculate Cp as average of values throughout temperature range
 	//               rather than at the range's midpoint
 	double Cp_ave(double T_cold_K, double T_hot_K, int n_points);
@@ -147,6 +165,30 @@ private:
 	int m_fluid;	// Store fluid number as member integer
 	util::matrix_t<double> m_userTable;	// User table of properties
 
+	enum { TAB_CP, TAB_DENS, TAB_VISC, TAB_COND, TAB_ENTH, N_TAB_PROPS };
+	bool m_is_prop_tables;			// Use the property tables within [m_T_tab_low, m_T_tab_high]
+	bool m_is_dens_tabulated;		// False for fluids whose density depends on pressure
+	double m_T_tab_low;				//[K]
+	double m_T_tab_high;			//[K]
+	double m_delta_T_tab_max;		//[K] requested maximum table spacing
+	double m_inv_delta_T_tab;		//[1/K]
+	int m_n_tab;					// number of table nodes
+	std::vector<double> m_prop_tab;	// N_TAB_PROPS values for each node, stored node by node
+	double build_prop_tables();
+
+	bool is_in_prop_tables( double T_K )
+	{
+		return m_is_prop_tables && T_K >= m_T_tab_low && T_K <= m_T_tab_high;
+	}
+	double prop_table_interp( int prop, double T_K )
+	{
+		double x = (T_K - m_T_tab_low)*m_inv_delta_T_tab;
+		int i = (int)x;
+		if( i > m_n_tab - 2 ) i = m_n_tab - 2;
+		const double *p = &m_prop_tab[i*N_TAB_PROPS + prop];
+		return p[0] + (x - i)*(p[N_TAB_PROPS] - p[0]);
+	}
+
 	std::string uf_err_msg;	//Error message when the user HTF table is invalid
 	
 };
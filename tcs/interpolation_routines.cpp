@@ -51,6 +51,7 @@
 #include <algorithm>
 
 #include <cmath>
+#include <limits>
 
 #include "interpolation_routines.h"
 
@@ -497,6 +498,93 @@ double Trilinear_Interp::trilinear_3D_interp( double x, double y, double z )
 	return (m1*p1 + m2*p2 + m3*p3 + m4*p4) * z_frac + (m1*q1 + m2*q2 + m3*q3 + m4*q4) * (1.0 - z_frac);
 }
 
+Bicubic_Grid_Interp::Bicubic_Grid_Interp()
+{
+	m_x0 = m_dx = m_y0 = m_dy = std::numeric_limits<double>::quiet_NaN();
+	m_nx = m_ny = 0;
+}
+
+bool Bicubic_Grid_Interp::Set_2D_Grid( double x0, double x1, double y0, double y1, const util::matrix_t<double> &z )
+{
+	int nx = (int)z.ncols();
+	int ny = (int)z.nrows();
+	if( nx < 2 || ny < 2 || !(x1 > x0) || !(y1 > y0) )
+		return false;
+
+	m_nx = nx;
+	m_ny = ny;
+	m_x0 = x0;
+	m_y0 = y0;
+	m_dx = (x1 - x0) / (double)(nx - 1);
+	m_dy = (y1 - y0) / (double)(ny - 1);
+
+	// Copy the values and add linearly extrapolated ghost nodes so the edge cells use the same stencil
+	int nxg = nx + 2;
+	m_z.assign( nxg*(ny + 2), 0.0 );
+	for( int j = 0; j < ny; j++ )
+	{
+		double *row = &m_z[(j + 1)*nxg];
+		for( int i = 0; i < nx; i++ )
+			row[i + 1] = z(j, i);
+		row[0] = 2.0*row[1] - row[2];
+		row[nx + 1] = 2.0*row[nx] - row[nx - 1];
+	}
+	for( int i = 0; i < nxg; i++ )
+	{
+		m_z[i] = 2.0*m_z[nxg + i] - m_z[2 * nxg + i];
+		m_z[(ny + 1)*nxg + i] = 2.0*m_z[ny*nxg + i] - m_z[(ny - 1)*nxg + i];
+	}
+
+	return true;
+}
+
+double Bicubic_Grid_Interp::bicubic_2D_interp( double x, double y )
+{
+	double z;
+	bicubic_2D_interp( 1, &x, &y, &z );
+	return z;
+}
+
+void Bicubic_Grid_Interp::bicubic_2D_interp( int n, const double *x, const double *y, double *z )
+{
+	int nxg = m_nx + 2;
+	const double *zg = m_z.data();
+
+	for( int k = 0; k < n; k++ )
+	{
+		// Grid coordinates, clamped to the grid
+		double u = fmin( fmax( (x[k] - m_x0) / m_dx, 0.0 ), (double)(m_nx - 1) );
+		double v = fmin( fmax( (y[k] - m_y0) / m_dy, 0.0 ), (double)(m_ny - 1) );
+		int i = (int)fmin( u, (double)(m_nx - 2) );
+		int j = (int)fmin( v, (double)(m_ny - 2) );
+		double t = u - i;
+		double s = v - j;
+
+		// Catmull-Rom weights in x and y
+		double t2 = t*t, t3 = t2*t;
+		double wx0 = 0.5*(-t3 + 2.0*t2 - t);
+		double wx1 = 0.5*(3.0*t3 - 5.0*t2 + 2.0);
+		double wx2 = 0.5*(-3.0*t3 + 4.0*t2 + t);
+		double wx3 = 0.5*(t3 - t2);
+		double s2 = s*s, s3 = s2*s;
+		double wy0 = 0.5*(-s3 + 2.0*s2 - s);
+		double wy1 = 0.5*(3.0*s3 - 5.0*s2 + 2.0);
+		double wy2 = 0.5*(-3.0*s3 + 4.0*s2 + s);
+		double wy3 = 0.5*(s3 - s2);
+
+		// Node (i,j) is at padded index (j+1)*nxg + i+1, so the 4x4 stencil starts at j*nxg + i
+		const double *r0 = zg + j*nxg + i;
+		const double *r1 = r0 + nxg;
+		const double *r2 = r1 + nxg;
+		const double *r3 = r2 + nxg;
+
+		z[k] = wy0*(wx0*r0[0] + wx1*r0[1] + wx2*r0[2] + wx3*r0[3])
+			+ wy1*(wx0*r1[0] + wx1*r1[1] + wx2*r1[2] + wx3*r1[3])
+			+ wy2*(wx0*r2[0] + wx1*r2[1] + wx2*r2[2] + wx3*r2[3])
+			+ wy3*(wx0*r3[0] + wx1*r3[1] + wx2*r3[2] + wx3*r3[3]);
+	}
+}
+
 LUdcmp::LUdcmp(MatDoub &a) 
 {
 	n = (int)a.size(); 
@@ -145,6 +145,31 @@ private:
 
 };
 
+class Bicubic_Grid_Interp
+{
+	// Bicubic (Catmull-Rom) interpolation on a uniform grid
+	// z table: ny rows by nx cols, z(j,i) is the value at x0 + i*dx, y0 + j*dy
+	// Points outside the grid are clamped to the grid edge
+
+public:
+	Bicubic_Grid_Interp();
+
+	bool Set_2D_Grid( double x0, double x1, double y0, double y1, const util::matrix_t<double> &z );
+	double bicubic_2D_interp( double x, double y );
+	// Evaluate n points at once. The loop is branch-free so the compiler can vectorize it
+	void bicubic_2D_interp( int n, const double *x, const double *y, double *z );
+
+private:
+	std::vector<double> m_z;	// values with one ghost node on each edge, (ny+2) rows by (nx+2) cols
+
+	double 
+		m_x0, m_dx,
+		m_y0, m_dy;
+	int 
+		m_nx,
+		m_ny;
+};
+
 typedef std::vector<double> VectDoub;
 typedef std::vector<VectDoub >  MatDoub;
 
@@ -262,6 +262,7 @@ enum{	//Parameters
 		P_focus_type,
 		P_n_flux_days,
 		P_delta_flux_hrs,
+		P_n_threads,
 		P_dni_des,
 		P_land_area,
         P_ADJUST,
@@ -325,6 +326,7 @@ tcsvarinfo sam_mw_pt_heliostatfield_variables[] = {
     { TCS_PARAM,    TCS_NUMBER,   P_focus_type,              "focus_type",            "Heliostat focus method",                               "",       "",                              "", ""          },
     { TCS_PARAM,    TCS_NUMBER,   P_n_flux_days,             "n_flux_days",           "No. days in flux map lookup",                          "",       "",                              "", "8"         },
     { TCS_PARAM,    TCS_NUMBER,   P_delta_flux_hrs,          "delta_flux_hrs",        "Hourly frequency in flux map lookup",                  "hrs",    "",                              "", "1"         },
+    { TCS_PARAM,    TCS_NUMBER,   P_n_threads,               "sp_n_threads",          "No. threads for SolarPILOT simulations (0=all cores)", "",       "",                              "", "1"         },
     { TCS_PARAM,    TCS_NUMBER,   P_dni_des,                 "dni_des",               "Design-point DNI",                                     "W/m2",   "",                              "", ""          },
 	{ TCS_PARAM,    TCS_NUMBER,   P_land_area,               "land_area",             "CALCULATED land area",                                 "acre",   "",                              "", ""          },
 	{ TCS_PARAM,     TCS_ARRAY,   P_ADJUST,                  "sf_adjust",             "Time series solar field production adjustment",        "none",   "",                              "", "" },
@@ -494,6 +496,7 @@ public:
 		mc_heliostatfield.ms_params.m_focus_type = (int)value(P_focus_type);
 		mc_heliostatfield.ms_params.m_n_flux_days = (int)value(P_n_flux_days);
 		mc_heliostatfield.ms_params.m_delta_flux_hrs = (int)value(P_delta_flux_hrs);
+		mc_heliostatfield.ms_params.m_n_threads = (int)value(P_n_threads);
 		mc_heliostatfield.ms_params.m_dni_des = value(P_dni_des);
 
 		mc_heliostatfield.ms_params.m_land_area = value(P_land_area);
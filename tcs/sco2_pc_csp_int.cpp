@@ -1125,16 +1125,40 @@ int C_sco2_recomp_csp::C_sco2_csp_od::operator()(S_f_inputs inputs, S_f_outputs
 	return off_design_code;
 }
 
+C_od_pc_function * C_sco2_recomp_csp::C_sco2_csp_od::clone()
+{
+	C_sco2_csp_od *p_sco2_csp_od = new C_sco2_csp_od(mpc_sco2_rc);
+
+	C_sco2_recomp_csp *p_sco2_rc = new C_sco2_recomp_csp(*mpc_sco2_rc);
+	p_sco2_csp_od->mp_sco2_rc_copy.reset(p_sco2_rc);
+	p_sco2_csp_od->mpc_sco2_rc = p_sco2_rc;
+
+	// The member-wise copy still points to the original's cycle model
+	if (p_sco2_rc->ms_des_par.m_cycle_config == 2)
+		p_sco2_rc->mpc_sco2_cycle = &p_sco2_rc->mc_partialcooling_cycle;
+	else
+		p_sco2_rc->mpc_sco2_cycle = &p_sco2_rc->mc_rc_cycle;
+
+	// Only the thread that owns the original reports back to the caller
+	p_sco2_rc->mf_callback_update = 0;
+	p_sco2_rc->mp_mf_update = 0;
+	p_sco2_rc->mc_messages = C_csp_messages();
+
+	return p_sco2_csp_od;
+}
+
 int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 	double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 	double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind)
+	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+	int n_threads /*-*/)
 {
 	C_sco2_csp_od c_sco2_csp(this);
 	C_ud_pc_table_generator c_sco2_ud_pc(c_sco2_csp);
 
 	c_sco2_ud_pc.mf_callback = mf_callback_update;
 	c_sco2_ud_pc.mp_mf_active = mp_mf_update;
+	c_sco2_ud_pc.m_n_threads = n_threads;
 
 	double T_htf_ref = ms_des_par.m_T_htf_hot_in - 273.15;	//[C] convert from K
 	double T_amb_ref = ms_des_par.m_T_amb_des - 273.15;		//[C] convert from K
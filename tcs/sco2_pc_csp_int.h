@@ -64,6 +64,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 class C_sco2_recomp_csp
 {
@@ -288,6 +289,8 @@ public:
 	private:
 		C_sco2_recomp_csp *mpc_sco2_rc;
 
+		std::unique_ptr<C_sco2_recomp_csp> mp_sco2_rc_copy;	// Set if this function owns its copy of the designed system
+
 	public:
 		C_sco2_csp_od(C_sco2_recomp_csp *pc_sco2_rc)
 		{
@@ -295,12 +298,16 @@ public:
 		}
 	
 		virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs);
+
+		// Copies the designed system so that the clone can run off-design concurrently with this function
+		virtual C_od_pc_function * clone();
 	};
 
 	int generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 		double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 		double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind);
+		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+		int n_threads = 1 /*-*/);
 
 	void design(S_des_par des_par);
 
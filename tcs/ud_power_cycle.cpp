@@ -50,6 +50,14 @@
 #include "ud_power_cycle.h"
 #include "csp_solver_util.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 void C_ud_power_cycle::init(const util::matrix_t<double> & T_htf_ind, double T_htf_ref /*C*/, double T_htf_low /*C*/, double T_htf_high /*C*/,
 	const util::matrix_t<double> & T_amb_ind, double T_amb_ref /*C*/, double T_amb_low /*C*/, double T_amb_high /*C*/,
 	const util::matrix_t<double> & m_dot_htf_ind, double m_dot_htf_ref /*-*/, double m_dot_htf_low /*-*/, double m_dot_htf_high /*-*/)
@@ -378,6 +386,7 @@ C_ud_pc_table_generator::C_ud_pc_table_generator(C_od_pc_function & f_pc_eq) : m
 {
 	mf_callback = 0;		// = NULL
 	mp_mf_active = 0;			// = NULL
+	m_n_threads = 1;
 	m_progress_msg = "Power cycle preprocessing...";
 	m_log_msg = "Log message";
 
@@ -451,11 +460,8 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		throw(C_csp_exception(msg, "User defined power cycle, generate tables"));
 	}
 
-	C_od_pc_function::S_f_inputs pc_inputs;
-	C_od_pc_function::S_f_outputs pc_outputs;
-
 	// ******************************************
-	// Setup T_HTF parameteric runs
+	// Check the number of parametric levels
 	if(n_T_htf < 3)
 	{
 		std::string msg = util::format("The input argument for number of indepedent HTF temperatures is %d."
@@ -463,165 +469,243 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		mc_messages.add_notice(msg);
 		n_T_htf = 3;
 	}
+	if(n_T_amb < 3)
+	{
+		std::string msg = util::format("The input argument for number of independent ambient temperatures"
+						" is %d. It was reset to the minimum value of 3.", n_T_amb);
+		mc_messages.add_notice(msg);
+		n_T_amb = 3;
+	}
+	if(n_m_dot_htf_ND < 3)
+	{
+		std::string msg = util::format("The input argument for number of independent normalized HTF mass flow rates"
+						" is %d. It was reset to the minimum value of 3.", n_m_dot_htf_ND);
+		mc_messages.add_notice(msg);
+		n_m_dot_htf_ND = 3;
+	}
+
+	int n_runs_total = 3*(n_T_htf + n_T_amb + n_m_dot_htf_ND);
+	std::vector<C_od_pc_function::S_f_inputs> v_pc_inputs(n_runs_total);
+	int i_run = 0;
 
+	// ******************************************
+	// Setup T_HTF parameteric runs
 	T_htf_ind.clear();
 	T_htf_ind.resize(n_T_htf, 13);		// Set matrix size
 	double delta_T_htf = (T_htf_high - T_htf_low)/double(n_T_htf-1);
 
-	double n_runs_total = 3.0*(n_T_htf + n_T_amb + n_m_dot_htf_ND);
-
-	// Set ambient temperature because it is constant for the HTF temperature parametrics
-	pc_inputs.m_T_amb = T_amb_ref;	//[C]
+	// Call at low, ref, and high ND mass flow rate levels
+	std::vector<double> m_dot_htf_ND_levels(3);
+	m_dot_htf_ND_levels[0] = m_dot_htf_ND_low;
+	m_dot_htf_ND_levels[1] = m_dot_htf_ND_ref;
+	m_dot_htf_ND_levels[2] = m_dot_htf_ND_high;
 	for(int i = 0; i < n_T_htf; i++)
 	{
 		T_htf_ind(i,0) = T_htf_low + delta_T_htf*i;	//[C]
-		pc_inputs.m_T_htf_hot = T_htf_ind(i,0);
-
-		// Call at low, ref, and high ND mass flow rate levels
-		std::vector<double> m_dot_htf_ND_levels(3);
-		m_dot_htf_ND_levels[0] = m_dot_htf_ND_low;
-		m_dot_htf_ND_levels[1] = m_dot_htf_ND_ref;
-		m_dot_htf_ND_levels[2] = m_dot_htf_ND_high;
-		for(int j = 0; j < 3; j++)
+		for(int j = 0; j < 3; j++, i_run++)
 		{
-			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
-
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else
-			{
-				std::string err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
-
-			double run_number = i*3 + j;
-
-			send_callback((int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				pc_outputs.m_W_dot_gross_ND, pc_outputs.m_Q_dot_in_ND,
-				pc_outputs.m_W_dot_cooling_ND, pc_outputs.m_m_dot_water_ND);
-
+			v_pc_inputs[i_run].m_T_htf_hot = T_htf_ind(i,0);				//[C]
+			v_pc_inputs[i_run].m_m_dot_htf_ND = m_dot_htf_ND_levels[j];	//[-]
+			// Ambient temperature is constant for the HTF temperature parametrics
+			v_pc_inputs[i_run].m_T_amb = T_amb_ref;						//[C]
 		}
-
 	}
 	// ******************************************
 
 	// ******************************************
 	// Setup T_amb parametric runs
-	if(n_T_amb < 3)
-	{
-		std::string msg = util::format("The input argument for number of independent ambient temperatures"
-						" is %d. It was reset to the minimum value of 3.", n_T_amb);
-		mc_messages.add_notice(msg);
-		n_T_amb = 3;
-	}
-
 	T_amb_ind.clear();
 	T_amb_ind.resize(n_T_amb, 13);		// Set matrix size
 	double delta_T_amb = (T_amb_high - T_amb_low)/double(n_T_amb-1);
 
-	// Set ND htf mass flow rate because it is constant for the ambient temperature parametrics
-	pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;
+	// Call at low, ref, and high HTF temperature levels
+	std::vector<double> T_htf_levels(3);
+	T_htf_levels[0] = T_htf_low;   //[C]
+	T_htf_levels[1] = T_htf_ref;   //[C]
+	T_htf_levels[2] = T_htf_high;  //[C]
 	for(int i = 0; i < n_T_amb; i++)
 	{
 		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
-		pc_inputs.m_T_amb = T_amb_ind(i,0);				//[C]
-
-		// Call at low, ref, and high HTF temperature levels
-		std::vector<double> T_htf_levels(3);
-		T_htf_levels[0] = T_htf_low;   //[C]
-		T_htf_levels[1] = T_htf_ref;   //[C]
-		T_htf_levels[2] = T_htf_high;  //[C]
-		for(int j = 0; j < 3; j++)
+		for(int j = 0; j < 3; j++, i_run++)
 		{
-			pc_inputs.m_T_htf_hot = T_htf_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
-
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_amb_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_amb_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_amb_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_amb_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else
-			{
-				std::string err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", pc_inputs.m_T_amb, pc_inputs.m_T_htf_hot);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
-
-			double run_number = 3.0*n_T_htf + i*3 + j;
-
-			send_callback((int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				pc_outputs.m_W_dot_gross_ND, pc_outputs.m_Q_dot_in_ND,
-				pc_outputs.m_W_dot_cooling_ND, pc_outputs.m_m_dot_water_ND);
+			v_pc_inputs[i_run].m_T_amb = T_amb_ind(i,0);			//[C]
+			v_pc_inputs[i_run].m_T_htf_hot = T_htf_levels[j];		//[C]
+			// ND htf mass flow rate is constant for the ambient temperature parametrics
+			v_pc_inputs[i_run].m_m_dot_htf_ND = m_dot_htf_ND_ref;	//[-]
 		}
 	}
 	// ******************************************
 
 	// ******************************************
 	// Setup ND m_dot parametric runs
-	if(n_m_dot_htf_ND < 3)
-	{
-		std::string msg = util::format("The input argument for number of independent normalized HTF mass flow rates"
-						" is %d. It was reset to the minimum value of 3.", n_m_dot_htf_ND);
-		mc_messages.add_notice(msg);
-		n_m_dot_htf_ND = 3;
-	}
-
 	m_dot_htf_ind.clear();
 	m_dot_htf_ind.resize(n_m_dot_htf_ND,13);		// Set matrix size
 	double delta_m_dot = (m_dot_htf_ND_high-m_dot_htf_ND_low)/double(n_m_dot_htf_ND-1);
 
-	// Set HTF temperature because it is constant for the ambient temperature parametrics
-	pc_inputs.m_T_htf_hot = T_htf_ref;
+	// Call at low, ref, and high ambient temperatures
+	std::vector<double> T_amb_levels(3);
+	T_amb_levels[0] = T_amb_low;    //[C]
+	T_amb_levels[1] = T_amb_ref;	//[C]
+	T_amb_levels[2] = T_amb_high;	//[C]
 	for(int i = 0; i < n_m_dot_htf_ND; i++)
 	{
 		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
-		pc_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);				//[-]
-
-		// Call at low, ref, and high ambient temperatures
-		std::vector<double> T_amb_levels(3);
-		T_amb_levels[0] = T_amb_low;    //[C]
-		T_amb_levels[1] = T_amb_ref;	//[C]
-		T_amb_levels[2] = T_amb_high;	//[C]
-		for(int j = 0; j < 3; j++)
+		for(int j = 0; j < 3; j++, i_run++)
+		{
+			v_pc_inputs[i_run].m_m_dot_htf_ND = m_dot_htf_ind(i,0);	//[-]
+			v_pc_inputs[i_run].m_T_amb = T_amb_levels[j];				//[C]
+			// HTF temperature is constant for the ND mass flow rate parametrics
+			v_pc_inputs[i_run].m_T_htf_hot = T_htf_ref;				//[C]
+		}
+	}
+	// ******************************************
+
+	std::vector<C_od_pc_function::S_f_outputs> v_pc_outputs(n_runs_total);
+	std::vector<int> v_od_codes(n_runs_total, -1);
+
+	// Save the outputs of run 'i_run_save' to its table, and report it
+	auto save_run = [&](int i_run_save)
+	{
+		const C_od_pc_function::S_f_inputs & pc_inputs = v_pc_inputs[i_run_save];
+		const C_od_pc_function::S_f_outputs & pc_outputs = v_pc_outputs[i_run_save];
+
+		util::matrix_t<double> * p_table = &T_htf_ind;
+		int i_table_run = i_run_save;
+		if( i_run_save >= 3*(n_T_htf + n_T_amb) )
+		{
+			p_table = &m_dot_htf_ind;
+			i_table_run = i_run_save - 3*(n_T_htf + n_T_amb);
+		}
+		else if( i_run_save >= 3*n_T_htf )
+		{
+			p_table = &T_amb_ind;
+			i_table_run = i_run_save - 3*n_T_htf;
+		}
+		int i = i_table_run / 3;
+		int j = i_table_run % 3;
+
+		if( v_od_codes[i_run_save] == 0 )
+		{
+			// Save outputs
+			(*p_table)(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
+			(*p_table)(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
+			(*p_table)(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
+			(*p_table)(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
+		}
+		else if( p_table == &T_htf_ind )
+		{
+			std::string err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND);
+			throw(C_csp_exception(err_msg, "UDPC"));
+		}
+		else if( p_table == &T_amb_ind )
+		{
+			std::string err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", pc_inputs.m_T_amb, pc_inputs.m_T_htf_hot);
+			throw(C_csp_exception(err_msg, "UDPC"));
+		}
+		else
 		{
-			pc_inputs.m_T_amb = T_amb_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs, pc_outputs);
-		
-			if( off_design_code == 0 )
+			std::string err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_amb, pc_inputs.m_m_dot_htf_ND);
+			throw(C_csp_exception(err_msg, "UDPC"));
+		}
+
+		send_callback(i_run_save + 1, n_runs_total,
+			pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
+			pc_outputs.m_W_dot_gross_ND, pc_outputs.m_Q_dot_in_ND,
+			pc_outputs.m_W_dot_cooling_ND, pc_outputs.m_m_dot_water_ND);
+	};
+
+	// Each worker thread evaluates its own clone of the power cycle function
+	int n_threads = m_n_threads;
+	if( n_threads < 1 )
+		n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+	n_threads = std::min(n_threads, n_runs_total);
+
+	std::vector< std::unique_ptr<C_od_pc_function> > v_pc_eq_clones;
+	for(int i = 0; n_threads > 1 && i < n_threads; i++)
+	{
+		C_od_pc_function *p_pc_eq_clone = mf_pc_eq.clone();
+		if( p_pc_eq_clone == 0 )
+		{	// Function can't be copied, so evaluate the runs on this thread
+			v_pc_eq_clones.clear();
+			break;
+		}
+		v_pc_eq_clones.push_back(std::unique_ptr<C_od_pc_function>(p_pc_eq_clone));
+	}
+
+	if( v_pc_eq_clones.empty() )
+	{
+		for(int i = 0; i < n_runs_total; i++)
+		{
+			v_od_codes[i] = mf_pc_eq(v_pc_inputs[i], v_pc_outputs[i]);
+			save_run(i);
+		}
+
+		return 0;
+	}
+
+	// Workers take the next run in order. This thread saves and reports the runs in order as they complete,
+	//    so errors and user cancellation are handled as in the single thread evaluation
+	std::vector<char> v_is_run_done(n_runs_total, 0);
+	std::vector<std::exception_ptr> v_run_errors(n_runs_total);
+	std::mutex run_mutex;
+	std::condition_variable run_done_cv;
+	std::atomic<int> i_run_next(0);
+	std::atomic<bool> is_stop(false);
+
+	std::vector<std::thread> workers;
+	for(size_t i_thread = 0; i_thread < v_pc_eq_clones.size(); i_thread++)
+	{
+		C_od_pc_function *p_pc_eq = v_pc_eq_clones[i_thread].get();
+		workers.push_back(std::thread([&, p_pc_eq]()
+		{
+			int i_run_worker;
+			while( !is_stop && (i_run_worker = i_run_next++) < n_runs_total )
 			{
-				// Save outputs
-				m_dot_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				m_dot_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				m_dot_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				m_dot_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
+				int od_code = -1;
+				std::exception_ptr run_error;
+				try
+				{
+					od_code = (*p_pc_eq)(v_pc_inputs[i_run_worker], v_pc_outputs[i_run_worker]);
+				}
+				catch(...)
+				{
+					run_error = std::current_exception();
+				}
+
+				std::lock_guard<std::mutex> lock(run_mutex);
+				v_od_codes[i_run_worker] = od_code;
+				v_run_errors[i_run_worker] = run_error;
+				v_is_run_done[i_run_worker] = 1;
+				run_done_cv.notify_all();
 			}
-			else
+		}));
+	}
+
+	try
+	{
+		for(int i = 0; i < n_runs_total; i++)
+		{
 			{
-				std::string err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_amb, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
+				std::unique_lock<std::mutex> lock(run_mutex);
+				run_done_cv.wait(lock, [&]() { return v_is_run_done[i] != 0; });
 			}
 
-			double run_number = 3.0*n_T_htf + 3.0*n_T_amb  + i*3 + j;
+			if( v_run_errors[i] )
+				std::rethrow_exception(v_run_errors[i]);
 
-			send_callback((int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				pc_outputs.m_W_dot_gross_ND, pc_outputs.m_Q_dot_in_ND,
-				pc_outputs.m_W_dot_cooling_ND, pc_outputs.m_m_dot_water_ND);
+			save_run(i);
 		}
 	}
-	// ******************************************
-	
+	catch(...)
+	{
+		is_stop = true;
+		for(size_t i_thread = 0; i_thread < workers.size(); i_thread++)
+			workers[i_thread].join();
+		throw;
+	}
+
+	for(size_t i_thread = 0; i_thread < workers.size(); i_thread++)
+		workers[i_thread].join();
+
 	return 0;
 }
\ No newline at end of file
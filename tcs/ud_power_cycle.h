@@ -175,11 +175,18 @@ public:
 	C_od_pc_function()
 	{
 	}
-	~C_od_pc_function()
+	virtual ~C_od_pc_function()
 	{
 	}
 
 	virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs) = 0;
+
+	// Returns a new function that evaluates an independent copy of the model, so that it can be called on another thread
+	//    The caller owns the returned function. Returns 0 if the model can't be copied
+	virtual C_od_pc_function * clone()
+	{
+		return 0;
+	}
 };
 
 class C_ud_pc_table_generator
@@ -212,6 +219,10 @@ public:
 	bool(*mf_callback)(std::string &log_msg, std::string &progress_msg, void *data, double progress, int out_type);
 	void *mp_mf_active;
 
+	// Number of threads that evaluate the parametric runs (0 = all cores). Each thread calls its own clone() of the function
+	// Tables, callbacks, and errors are reported in the same run order as the single thread evaluation
+	int m_n_threads;
+
 };
 
 #endif
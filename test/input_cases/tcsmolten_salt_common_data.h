@@ -0,0 +1,256 @@
+#ifndef _TCSMOLTEN_SALT_COMMON_DATA_H_
+#define _TCSMOLTEN_SALT_COMMON_DATA_H_
+
+#include <stdio.h>
+#include <math.h>
+
+#include "code_generator_utilities.h"
+
+/**
+*  Normalized main effect of HTF temperature (i_var = 0), ambient temperature (1) or normalized HTF mass flow (2) on
+*  gross power (i_out = 0), heat input (1), cooling power (2) and water use (3) of the user-defined power cycle
+*/
+static double tcsmolten_salt_ud_effect(int i_out, int i_var, double x)
+{
+	switch (i_var)
+	{
+	case 0:
+		return i_out == 0 ? 1. + 0.0015*(x - 574.) : (i_out == 1 ? 1. + 0.0005*(x - 574.) : 1.);
+	case 1:
+		return i_out == 0 ? 1. - 0.003*(x - 43.) : 1.;
+	default:
+		return i_out == 0 ? x*(0.9 + 0.1*x) : x;
+	}
+}
+
+/**
+*  Default data for a 115 MWe molten salt tower with 10 hours of storage, user-defined field performance maps,
+*  a user-defined power cycle and dispatch optimization. The run covers the first ten days of the year.
+*/
+void tcsmolten_salt_default(ssc_data_t &data)
+{
+	char solar_resource_path[256];
+	sprintf(solar_resource_path, "%s/test/input_docs/weather.csv", std::getenv("SSCDIR"));
+	ssc_data_set_string(data, "solar_resource_file", solar_resource_path);
+
+	ssc_data_set_number(data, "time_start", 0);
+	ssc_data_set_number(data, "time_stop", 864000);
+	ssc_data_set_number(data, "adjust:constant", 4);
+	ssc_data_set_number(data, "sf_adjust:constant", 0);
+
+	// field performance maps vs solar position, uniform flux over the receiver panels
+	ssc_data_set_number(data, "field_model_type", 3);
+	ssc_data_set_number(data, "N_panels", 20);
+	const int n_az = 12, n_zen = 7, n_flux = 20;
+	ssc_number_t p_eta_map[n_az * n_zen * 3];
+	ssc_number_t p_flux_maps[n_az * n_zen * n_flux];
+	for (int i = 0; i < n_az; i++){
+		for (int j = 0; j < n_zen; j++){
+			int k = i*n_zen + j;
+			double az = 30.*i;
+			double zen = j == 0 ? 0.5 : (j == n_zen - 1 ? 89.5 : 15.*j);
+			p_eta_map[k * 3] = (ssc_number_t)az;
+			p_eta_map[k * 3 + 1] = (ssc_number_t)zen;
+			p_eta_map[k * 3 + 2] = (ssc_number_t)(0.65 - 0.3*pow(zen / 90., 2) + 0.02*cos(az*3.14159265 / 180.));
+			for (int f = 0; f < n_flux; f++)
+				p_flux_maps[k*n_flux + f] = (ssc_number_t)(1. / n_flux);
+		}
+	}
+	ssc_data_set_matrix(data, "eta_map", p_eta_map, n_az * n_zen, 3);
+	ssc_data_set_number(data, "eta_map_aod_format", 0);
+	ssc_data_set_matrix(data, "flux_maps", p_flux_maps, n_az * n_zen, n_flux);
+	ssc_data_set_number(data, "A_sf_in", 1269055);
+	ssc_data_set_number(data, "N_hel", 8790);
+	ssc_number_t p_helio_positions[2] = { 0, 100 };
+	ssc_data_set_matrix(data, "helio_positions", p_helio_positions, 1, 2);
+	ssc_data_set_number(data, "land_area_base", 1847);
+
+	// heliostats
+	ssc_data_set_number(data, "gross_net_conversion_factor", 0.9);
+	ssc_data_set_number(data, "helio_width", 12.2);
+	ssc_data_set_number(data, "helio_height", 12.2);
+	ssc_data_set_number(data, "helio_optical_error_mrad", 1.53);
+	ssc_data_set_number(data, "helio_active_fraction", 0.99);
+	ssc_data_set_number(data, "dens_mirror", 0.97);
+	ssc_data_set_number(data, "helio_reflectance", 0.9);
+	ssc_data_set_number(data, "rec_absorptance", 0.94);
+	ssc_data_set_number(data, "rec_hl_perm2", 30);
+	ssc_data_set_number(data, "dni_des", 950);
+	ssc_data_set_number(data, "p_start", 0.025);
+	ssc_data_set_number(data, "p_track", 0.055);
+	ssc_data_set_number(data, "hel_stow_deploy", 8);
+	ssc_data_set_number(data, "v_wind_max", 15);
+	ssc_data_set_number(data, "n_facet_x", 2);
+	ssc_data_set_number(data, "n_facet_y", 8);
+	ssc_data_set_number(data, "focus_type", 1);
+	ssc_data_set_number(data, "cant_type", 1);
+	ssc_data_set_number(data, "water_usage_per_wash", 0.7);
+	ssc_data_set_number(data, "washing_frequency", 63);
+	ssc_data_set_number(data, "opt_flux_penalty", 0.25);
+
+	// costs
+	ssc_data_set_number(data, "tower_fixed_cost", 3000000);
+	ssc_data_set_number(data, "tower_exp", 0.0113);
+	ssc_data_set_number(data, "rec_ref_cost", 103000000);
+	ssc_data_set_number(data, "rec_ref_area", 1571);
+	ssc_data_set_number(data, "rec_cost_exp", 0.7);
+	ssc_data_set_number(data, "site_spec_cost", 16);
+	ssc_data_set_number(data, "heliostat_spec_cost", 140);
+	ssc_data_set_number(data, "plant_spec_cost", 1040);
+	ssc_data_set_number(data, "bop_spec_cost", 290);
+	ssc_data_set_number(data, "tes_spec_cost", 22);
+	ssc_data_set_number(data, "land_spec_cost", 0);
+	ssc_data_set_number(data, "contingency_rate", 7);
+	ssc_data_set_number(data, "sales_tax_rate", 5);
+	ssc_data_set_number(data, "sales_tax_frac", 80);
+	ssc_data_set_number(data, "cost_sf_fixed", 0);
+	ssc_data_set_number(data, "fossil_spec_cost", 0);
+	ssc_data_set_number(data, "csp.pt.cost.epc.per_acre", 0);
+	ssc_data_set_number(data, "csp.pt.cost.epc.percent", 13);
+	ssc_data_set_number(data, "csp.pt.cost.epc.per_watt", 0);
+	ssc_data_set_number(data, "csp.pt.cost.epc.fixed", 0);
+	ssc_data_set_number(data, "csp.pt.cost.plm.percent", 0);
+	ssc_data_set_number(data, "csp.pt.cost.plm.per_watt", 0);
+	ssc_data_set_number(data, "csp.pt.cost.plm.fixed", 0);
+	ssc_data_set_number(data, "csp.pt.sf.fixed_land_area", 45);
+	ssc_data_set_number(data, "csp.pt.sf.land_overhead_factor", 1);
+	for (int i = 1; i <= 5; i++){
+		char name[64];
+		sprintf(name, "const_per_interest_rate%d", i);
+		ssc_data_set_number(data, name, i == 1 ? 4 : 0);
+		sprintf(name, "const_per_months%d", i);
+		ssc_data_set_number(data, name, i == 1 ? 24 : 0);
+		sprintf(name, "const_per_percent%d", i);
+		ssc_data_set_number(data, name, i == 1 ? 100 : 0);
+		sprintf(name, "const_per_upfront_rate%d", i);
+		ssc_data_set_number(data, name, i == 1 ? 1 : 0);
+	}
+
+	// tower and receiver
+	ssc_data_set_number(data, "rec_height", 21.6);
+	ssc_data_set_number(data, "D_rec", 17.65);
+	ssc_data_set_number(data, "h_tower", 193.5);
+	ssc_data_set_number(data, "T_htf_cold_des", 290);
+	ssc_data_set_number(data, "T_htf_hot_des", 574);
+	ssc_data_set_number(data, "P_ref", 115);
+	ssc_data_set_number(data, "design_eff", 0.412);
+	ssc_data_set_number(data, "tshours", 10);
+	ssc_data_set_number(data, "solarm", 2.4);
+	ssc_data_set_number(data, "d_tube_out", 40);
+	ssc_data_set_number(data, "th_tube", 1.25);
+	ssc_data_set_number(data, "mat_tube", 2);
+	ssc_data_set_number(data, "rec_htf", 17);
+	ssc_number_t p_field_fl_props[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	ssc_data_set_matrix(data, "field_fl_props", p_field_fl_props, 1, 9);
+	ssc_data_set_number(data, "Flow_type", 1);
+	ssc_data_set_number(data, "epsilon", 0.88);
+	ssc_data_set_number(data, "hl_ffact", 1);
+	ssc_data_set_number(data, "f_rec_min", 0.25);
+	ssc_data_set_number(data, "rec_su_delay", 0.2);
+	ssc_data_set_number(data, "rec_qf_delay", 0.25);
+	ssc_data_set_number(data, "csp.pt.rec.max_oper_frac", 1.2);
+	ssc_data_set_number(data, "eta_pump", 0.85);
+	ssc_data_set_number(data, "piping_loss", 10200);
+	ssc_data_set_number(data, "piping_length_mult", 2.6);
+	ssc_data_set_number(data, "piping_length_const", 0);
+
+	// storage
+	ssc_data_set_number(data, "csp.pt.tes.init_hot_htf_percent", 30);
+	ssc_data_set_number(data, "h_tank", 12);
+	ssc_data_set_number(data, "cold_tank_max_heat", 15);
+	ssc_data_set_number(data, "u_tank", 0.4);
+	ssc_data_set_number(data, "tank_pairs", 1);
+	ssc_data_set_number(data, "cold_tank_Thtr", 280);
+	ssc_data_set_number(data, "h_tank_min", 1);
+	ssc_data_set_number(data, "hot_tank_Thtr", 500);
+	ssc_data_set_number(data, "hot_tank_max_heat", 30);
+
+	// user-defined power cycle
+	ssc_data_set_number(data, "pc_config", 1);
+	ssc_data_set_number(data, "pb_pump_coef", 0.55);
+	ssc_data_set_number(data, "startup_time", 0.5);
+	ssc_data_set_number(data, "startup_frac", 0.5);
+	ssc_data_set_number(data, "cycle_max_frac", 1.05);
+	ssc_data_set_number(data, "cycle_cutoff_frac", 0.2);
+	ssc_data_set_number(data, "q_sby_frac", 0.2);
+	ssc_data_set_number(data, "ud_T_amb_des", 43);
+	ssc_data_set_number(data, "ud_f_W_dot_cool_des", 0);
+	ssc_data_set_number(data, "ud_m_dot_water_cool_des", 0);
+	ssc_data_set_number(data, "ud_T_htf_low", 500);
+	ssc_data_set_number(data, "ud_T_htf_high", 580);
+	ssc_data_set_number(data, "ud_T_amb_low", 0);
+	ssc_data_set_number(data, "ud_T_amb_high", 55);
+	ssc_data_set_number(data, "ud_m_dot_htf_low", 0.3);
+	ssc_data_set_number(data, "ud_m_dot_htf_high", 1.2);
+	{
+		// Each row holds the independent value, then gross power, heat input, cooling power and water use, each at the low,
+		// design and high level of the interacting variable. The responses add up without interaction, so the low and high
+		// columns are the design column plus the main effect of the interacting variable at that level.
+		const int n_T_htf = 12, n_T_amb = 12, n_m_dot = 12;
+		ssc_number_t p_T_htf[n_T_htf * 13], p_T_amb[n_T_amb * 13], p_m_dot[n_m_dot * 13];
+		double T_htf_levels[3] = { 500, 574, 580 }, T_amb_levels[3] = { 0, 43, 55 }, m_dot_levels[3] = { 0.3, 1., 1.2 };
+		for (int i = 0; i < 12; i++){
+			double T_htf = 480. + 10.*i, T_amb = 5.*i, m_dot = 0.2 + 0.1*i;
+			p_T_htf[i * 13] = (ssc_number_t)T_htf;
+			p_T_amb[i * 13] = (ssc_number_t)T_amb;
+			p_m_dot[i * 13] = (ssc_number_t)m_dot;
+			for (int k = 0; k < 4; k++){
+				for (int j = 0; j < 3; j++){
+					p_T_htf[i * 13 + 1 + k * 3 + j] = (ssc_number_t)(tcsmolten_salt_ud_effect(k, 0, T_htf) + tcsmolten_salt_ud_effect(k, 2, m_dot_levels[j]) - 1.);
+					p_T_amb[i * 13 + 1 + k * 3 + j] = (ssc_number_t)(tcsmolten_salt_ud_effect(k, 1, T_amb) + tcsmolten_salt_ud_effect(k, 0, T_htf_levels[j]) - 1.);
+					p_m_dot[i * 13 + 1 + k * 3 + j] = (ssc_number_t)(tcsmolten_salt_ud_effect(k, 2, m_dot) + tcsmolten_salt_ud_effect(k, 1, T_amb_levels[j]) - 1.);
+				}
+			}
+		}
+		ssc_data_set_matrix(data, "ud_T_htf_ind_od", p_T_htf, n_T_htf, 13);
+		ssc_data_set_matrix(data, "ud_T_amb_ind_od", p_T_amb, n_T_amb, 13);
+		ssc_data_set_matrix(data, "ud_m_dot_htf_ind_od", p_m_dot, n_m_dot, 13);
+	}
+
+	// parasitics
+	ssc_data_set_number(data, "pb_fixed_par", 0.0055);
+	ssc_data_set_number(data, "aux_par", 0.023);
+	ssc_data_set_number(data, "aux_par_f", 1);
+	ssc_data_set_number(data, "aux_par_0", 0.483);
+	ssc_data_set_number(data, "aux_par_1", 0.571);
+	ssc_data_set_number(data, "aux_par_2", 0);
+	ssc_data_set_number(data, "bop_par", 0);
+	ssc_data_set_number(data, "bop_par_f", 1);
+	ssc_data_set_number(data, "bop_par_0", 0);
+	ssc_data_set_number(data, "bop_par_1", 0.483);
+	ssc_data_set_number(data, "bop_par_2", 0);
+
+	// operation and pricing schedules: period 1 in the evening peak, period 2 otherwise
+	ssc_number_t p_f_turb_tou_periods[9] = { 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	ssc_data_set_array(data, "f_turb_tou_periods", p_f_turb_tou_periods, 9);
+	ssc_number_t p_ops_schedule[12 * 24];
+	ssc_number_t p_price_schedule[12 * 24];
+	for (int i = 0; i < 12 * 24; i++){
+		p_ops_schedule[i] = 1;
+		p_price_schedule[i] = (i % 24 >= 16 && i % 24 < 21) ? 1 : 2;
+	}
+	ssc_data_set_matrix(data, "weekday_schedule", p_ops_schedule, 12, 24);
+	ssc_data_set_matrix(data, "weekend_schedule", p_ops_schedule, 12, 24);
+	ssc_data_set_matrix(data, "dispatch_sched_weekday", p_price_schedule, 12, 24);
+	ssc_data_set_matrix(data, "dispatch_sched_weekend", p_price_schedule, 12, 24);
+	ssc_data_set_number(data, "dispatch_factor1", 1.8);
+	ssc_data_set_number(data, "dispatch_factor2", 0.9);
+	for (int i = 3; i <= 9; i++){
+		char name[64];
+		sprintf(name, "dispatch_factor%d", i);
+		ssc_data_set_number(data, name, 1);
+	}
+
+	// dispatch optimization
+	ssc_data_set_number(data, "is_dispatch", 1);
+	ssc_data_set_number(data, "disp_horizon", 48);
+	ssc_data_set_number(data, "disp_frequency", 24);
+	ssc_data_set_number(data, "disp_max_iter", 35000);
+	ssc_data_set_number(data, "disp_timeout", 5);
+	ssc_data_set_number(data, "disp_mip_gap", 0.001);
+	ssc_data_set_number(data, "disp_rsu_cost", 950);
+	ssc_data_set_number(data, "disp_csu_cost", 10000);
+	ssc_data_set_number(data, "disp_pen_delta_w", 0.1);
+}
+
+#endif
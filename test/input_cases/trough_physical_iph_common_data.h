@@ -0,0 +1,176 @@
+#ifndef _TROUGH_PHYSICAL_IPH_COMMON_DATA_H_
+#define _TROUGH_PHYSICAL_IPH_COMMON_DATA_H_
+
+#include <stdio.h>
+
+#include "code_generator_utilities.h"
+
+/**
+*  Default data for a physical trough process heat plant with 6 hours of storage, using the solar field and receiver
+*  inputs of the tcstrough_physical default test case
+*/
+void trough_physical_iph_default(ssc_data_t &data)
+{
+	char solar_resource_path[256];
+	sprintf(solar_resource_path, "%s/test/input_cases/pvsamv1_data/USA AZ Tucson (TMY2).csv", std::getenv("SSCDIR"));
+	ssc_data_set_string(data, "file_name", solar_resource_path);
+
+	ssc_data_set_number(data, "adjust:constant", 4);
+	ssc_data_set_number(data, "track_mode", 1);
+	ssc_data_set_number(data, "tilt", 0);
+	ssc_data_set_number(data, "azimuth", 0);
+	ssc_data_set_number(data, "system_capacity", 99899.9921875);
+	ssc_data_set_number(data, "I_bn_des", 950);
+	ssc_data_set_number(data, "solar_mult", 2);
+	ssc_data_set_number(data, "T_loop_in_des", 293);
+	ssc_data_set_number(data, "T_loop_out", 391);
+	ssc_data_set_number(data, "q_pb_design", 311.79776000976563);
+	ssc_data_set_number(data, "tshours", 6);
+	ssc_data_set_number(data, "nSCA", 8);
+	ssc_data_set_number(data, "nHCEt", 4);
+	ssc_data_set_number(data, "nColt", 4);
+	ssc_data_set_number(data, "nHCEVar", 4);
+	ssc_data_set_number(data, "nLoops", 181);
+	ssc_data_set_number(data, "eta_pump", 0.85000002384185791);
+	ssc_data_set_number(data, "HDR_rough", 4.5699998736381531e-05);
+	ssc_data_set_number(data, "theta_stow", 170);
+	ssc_data_set_number(data, "theta_dep", 10);
+	ssc_data_set_number(data, "Row_Distance", 15);
+	ssc_data_set_number(data, "FieldConfig", 2);
+	ssc_data_set_number(data, "is_model_heat_sink_piping", 0);
+	ssc_data_set_number(data, "L_heat_sink_piping", 50);
+	ssc_data_set_number(data, "m_dot_htfmin", 1);
+	ssc_data_set_number(data, "m_dot_htfmax", 12);
+	ssc_data_set_number(data, "Fluid", 21);
+	ssc_number_t p_field_fl_props[1] = { 0 };
+	ssc_data_set_matrix(data, "field_fl_props", p_field_fl_props, 1, 1);
+	ssc_data_set_number(data, "T_fp", 150);
+	ssc_data_set_number(data, "V_hdr_max", 3);
+	ssc_data_set_number(data, "V_hdr_min", 2);
+	ssc_data_set_number(data, "Pipe_hl_coef", 0.44999998807907104);
+	ssc_data_set_number(data, "SCA_drives_elec", 125);
+	ssc_data_set_number(data, "fthrok", 1);
+	ssc_data_set_number(data, "fthrctrl", 2);
+	ssc_data_set_number(data, "water_usage_per_wash", 0.69999998807907104);
+	ssc_data_set_number(data, "washing_frequency", 63);
+	ssc_data_set_number(data, "accept_mode", 0);
+	ssc_data_set_number(data, "accept_init", 0);
+	ssc_data_set_number(data, "accept_loc", 1);
+	ssc_data_set_number(data, "mc_bal_hot", 0.20000000298023224);
+	ssc_data_set_number(data, "mc_bal_cold", 0.20000000298023224);
+	ssc_data_set_number(data, "mc_bal_sca", 4.5);
+	ssc_number_t p_W_aperture[4] = { 6, 6, 6, 6 };
+	ssc_data_set_array(data, "W_aperture", p_W_aperture, 4);
+	ssc_number_t p_A_aperture[4] = { 656, 656, 656, 656 };
+	ssc_data_set_array(data, "A_aperture", p_A_aperture, 4);
+	ssc_number_t p_TrackingError[4] = { 0.98799997568130493, 0.98799997568130493, 0.98799997568130493, 0.98799997568130493 };
+	ssc_data_set_array(data, "TrackingError", p_TrackingError, 4);
+	ssc_number_t p_GeomEffects[4] = { 0.95200002193450928, 0.95200002193450928, 0.95200002193450928, 0.95200002193450928 };
+	ssc_data_set_array(data, "GeomEffects", p_GeomEffects, 4);
+	ssc_number_t p_Rho_mirror_clean[4] = { 0.93000000715255737, 0.93000000715255737, 0.93000000715255737, 0.93000000715255737 };
+	ssc_data_set_array(data, "Rho_mirror_clean", p_Rho_mirror_clean, 4);
+	ssc_number_t p_Dirt_mirror[4] = { 0.97000002861022949, 0.97000002861022949, 0.97000002861022949, 0.97000002861022949 };
+	ssc_data_set_array(data, "Dirt_mirror", p_Dirt_mirror, 4);
+	ssc_number_t p_Error[4] = { 1, 1, 1, 1 };
+	ssc_data_set_array(data, "Error", p_Error, 4);
+	ssc_number_t p_Ave_Focal_Length[4] = { 2.1500000953674316, 2.1500000953674316, 2.1500000953674316, 2.1500000953674316 };
+	ssc_data_set_array(data, "Ave_Focal_Length", p_Ave_Focal_Length, 4);
+	ssc_number_t p_L_SCA[4] = { 115, 115, 115, 115 };
+	ssc_data_set_array(data, "L_SCA", p_L_SCA, 4);
+	ssc_number_t p_L_aperture[4] = { 14.375, 14.375, 14.375, 14.375 };
+	ssc_data_set_array(data, "L_aperture", p_L_aperture, 4);
+	ssc_number_t p_ColperSCA[4] = { 8, 8, 8, 8 };
+	ssc_data_set_array(data, "ColperSCA", p_ColperSCA, 4);
+	ssc_number_t p_Distance_SCA[4] = { 1, 1, 1, 1 };
+	ssc_data_set_array(data, "Distance_SCA", p_Distance_SCA, 4);
+	ssc_number_t p_IAM_matrix[12] = { 1, 0.032699998468160629, -0.13510000705718994, 1, 0.032699998468160629, -0.13510000705718994, 1, 0.032699998468160629, -0.13510000705718994, 1, 0.032699998468160629, -0.13510000705718994 };
+	ssc_data_set_matrix(data, "IAM_matrix", p_IAM_matrix, 4, 3);
+	ssc_number_t p_HCE_FieldFrac[16] = { 0.98500001430511475, 0.0099999997764825821, 0.004999999888241291, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 };
+	ssc_data_set_matrix(data, "HCE_FieldFrac", p_HCE_FieldFrac, 4, 4);
+	ssc_number_t p_D_2[16] = { 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564, 0.075999997556209564 };
+	ssc_data_set_matrix(data, "D_2", p_D_2, 4, 4);
+	ssc_number_t p_D_3[16] = { 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657, 0.079999998211860657 };
+	ssc_data_set_matrix(data, "D_3", p_D_3, 4, 4);
+	ssc_number_t p_D_4[16] = { 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257, 0.11500000208616257 };
+	ssc_data_set_matrix(data, "D_4", p_D_4, 4, 4);
+	ssc_number_t p_D_5[16] = { 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099, 0.11999999731779099 };
+	ssc_data_set_matrix(data, "D_5", p_D_5, 4, 4);
+	ssc_number_t p_D_p[16] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	ssc_data_set_matrix(data, "D_p", p_D_p, 4, 4);
+	ssc_number_t p_Flow_type[16] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	ssc_data_set_matrix(data, "Flow_type", p_Flow_type, 4, 4);
+	ssc_number_t p_Rough[16] = { 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05, 4.5000000682193786e-05 };
+	ssc_data_set_matrix(data, "Rough", p_Rough, 4, 4);
+	ssc_number_t p_alpha_env[16] = { 0.019999999552965164, 0.019999999552965164, 0, 0, 0.019999999552965164, 0.019999999552965164, 0, 0, 0.019999999552965164, 0.019999999552965164, 0, 0, 0.019999999552965164, 0.019999999552965164, 0, 0 };
+	ssc_data_set_matrix(data, "alpha_env", p_alpha_env, 4, 4);
+	ssc_number_t p_epsilon_3_11[18] = { 100, 0.064000003039836884, 150, 0.066500000655651093, 200, 0.070000000298023224, 250, 0.074500001966953278, 300, 0.079999998211860657, 350, 0.086499996483325958, 400, 0.093999996781349182, 450, 0.10249999910593033, 500, 0.1120000034570694 };
+	ssc_data_set_matrix(data, "epsilon_3_11", p_epsilon_3_11, 9, 2);
+	ssc_number_t p_epsilon_3_12[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_12", p_epsilon_3_12, 1, 1);
+	ssc_number_t p_epsilon_3_13[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_13", p_epsilon_3_13, 1, 1);
+	ssc_number_t p_epsilon_3_14[1] = { 0 };
+	ssc_data_set_matrix(data, "epsilon_3_14", p_epsilon_3_14, 1, 1);
+	ssc_number_t p_epsilon_3_21[18] = { 100, 0.064000003039836884, 150, 0.066500000655651093, 200, 0.070000000298023224, 250, 0.074500001966953278, 300, 0.079999998211860657, 350, 0.086499996483325958, 400, 0.093999996781349182, 450, 0.10249999910593033, 500, 0.1120000034570694 };
+	ssc_data_set_matrix(data, "epsilon_3_21", p_epsilon_3_21, 9, 2);
+	ssc_number_t p_epsilon_3_22[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_22", p_epsilon_3_22, 1, 1);
+	ssc_number_t p_epsilon_3_23[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_23", p_epsilon_3_23, 1, 1);
+	ssc_number_t p_epsilon_3_24[1] = { 0 };
+	ssc_data_set_matrix(data, "epsilon_3_24", p_epsilon_3_24, 1, 1);
+	ssc_number_t p_epsilon_3_31[18] = { 100, 0.064000003039836884, 150, 0.066500000655651093, 200, 0.070000000298023224, 250, 0.074500001966953278, 300, 0.079999998211860657, 350, 0.086499996483325958, 400, 0.093999996781349182, 450, 0.10249999910593033, 500, 0.1120000034570694 };
+	ssc_data_set_matrix(data, "epsilon_3_31", p_epsilon_3_31, 9, 2);
+	ssc_number_t p_epsilon_3_32[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_32", p_epsilon_3_32, 1, 1);
+	ssc_number_t p_epsilon_3_33[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_33", p_epsilon_3_33, 1, 1);
+	ssc_number_t p_epsilon_3_34[1] = { 0 };
+	ssc_data_set_matrix(data, "epsilon_3_34", p_epsilon_3_34, 1, 1);
+	ssc_number_t p_epsilon_3_41[18] = { 100, 0.064000003039836884, 150, 0.066500000655651093, 200, 0.070000000298023224, 250, 0.074500001966953278, 300, 0.079999998211860657, 350, 0.086499996483325958, 400, 0.093999996781349182, 450, 0.10249999910593033, 500, 0.1120000034570694 };
+	ssc_data_set_matrix(data, "epsilon_3_41", p_epsilon_3_41, 9, 2);
+	ssc_number_t p_epsilon_3_42[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_42", p_epsilon_3_42, 1, 1);
+	ssc_number_t p_epsilon_3_43[1] = { 0.64999997615814209 };
+	ssc_data_set_matrix(data, "epsilon_3_43", p_epsilon_3_43, 1, 1);
+	ssc_number_t p_epsilon_3_44[1] = { 0 };
+	ssc_data_set_matrix(data, "epsilon_3_44", p_epsilon_3_44, 1, 1);
+	ssc_number_t p_alpha_abs[16] = { 0.96299999952316284, 0.96299999952316284, 0.80000001192092896, 0, 0.96299999952316284, 0.96299999952316284, 0.80000001192092896, 0, 0.96299999952316284, 0.96299999952316284, 0.80000001192092896, 0, 0.96299999952316284, 0.96299999952316284, 0.80000001192092896, 0 };
+	ssc_data_set_matrix(data, "alpha_abs", p_alpha_abs, 4, 4);
+	ssc_number_t p_Tau_envelope[16] = { 0.96399998664855957, 0.96399998664855957, 1, 0, 0.96399998664855957, 0.96399998664855957, 1, 0, 0.96399998664855957, 0.96399998664855957, 1, 0, 0.96399998664855957, 0.96399998664855957, 1, 0 };
+	ssc_data_set_matrix(data, "Tau_envelope", p_Tau_envelope, 4, 4);
+	ssc_number_t p_EPSILON_4[16] = { 0.86000001430511475, 0.86000001430511475, 1, 0, 0.86000001430511475, 0.86000001430511475, 1, 0, 0.86000001430511475, 0.86000001430511475, 1, 0, 0.86000001430511475, 0.86000001430511475, 1, 0 };
+	ssc_data_set_matrix(data, "EPSILON_4", p_EPSILON_4, 4, 4);
+	ssc_number_t p_EPSILON_5[16] = { 0.86000001430511475, 0.86000001430511475, 1, 0, 0.86000001430511475, 0.86000001430511475, 1, 0, 0.86000001430511475, 0.86000001430511475, 1, 0, 0.86000001430511475, 0.86000001430511475, 1, 0 };
+	ssc_data_set_matrix(data, "EPSILON_5", p_EPSILON_5, 4, 4);
+	ssc_number_t p_GlazingIntactIn[16] = { 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1 };
+	ssc_data_set_matrix(data, "GlazingIntactIn", p_GlazingIntactIn, 4, 4);
+	ssc_number_t p_P_a[16] = { 9.9999997473787516e-05, 750, 750, 0, 9.9999997473787516e-05, 750, 750, 0, 9.9999997473787516e-05, 750, 750, 0, 9.9999997473787516e-05, 750, 750, 0 };
+	ssc_data_set_matrix(data, "P_a", p_P_a, 4, 4);
+	ssc_number_t p_AnnulusGas[16] = { 27, 1, 1, 27, 27, 1, 1, 27, 27, 1, 1, 27, 27, 1, 1, 27 };
+	ssc_data_set_matrix(data, "AnnulusGas", p_AnnulusGas, 4, 4);
+	ssc_number_t p_AbsorberMaterial[16] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	ssc_data_set_matrix(data, "AbsorberMaterial", p_AbsorberMaterial, 4, 4);
+	ssc_number_t p_Shadowing[16] = { 0.93500000238418579, 0.93500000238418579, 0.93500000238418579, 0.96299999952316284, 0.93500000238418579, 0.93500000238418579, 0.93500000238418579, 0.96299999952316284, 0.93500000238418579, 0.93500000238418579, 0.93500000238418579, 0.96299999952316284, 0.93500000238418579, 0.93500000238418579, 0.93500000238418579, 0.96299999952316284 };
+	ssc_data_set_matrix(data, "Shadowing", p_Shadowing, 4, 4);
+	ssc_number_t p_Dirt_HCE[16] = { 0.98000001907348633, 0.98000001907348633, 1, 0.98000001907348633, 0.98000001907348633, 0.98000001907348633, 1, 0.98000001907348633, 0.98000001907348633, 0.98000001907348633, 1, 0.98000001907348633, 0.98000001907348633, 0.98000001907348633, 1, 0.98000001907348633 };
+	ssc_data_set_matrix(data, "Dirt_HCE", p_Dirt_HCE, 4, 4);
+	ssc_number_t p_Design_loss[16] = { 190, 1270, 1500, 0, 190, 1270, 1500, 0, 190, 1270, 1500, 0, 190, 1270, 1500, 0 };
+	ssc_data_set_matrix(data, "Design_loss", p_Design_loss, 4, 4);
+	ssc_number_t p_SCAInfoArray[16] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+	ssc_data_set_matrix(data, "SCAInfoArray", p_SCAInfoArray, 8, 2);
+	ssc_number_t p_SCADefocusArray[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+	ssc_data_set_array(data, "SCADefocusArray", p_SCADefocusArray, 8);
+	ssc_data_set_number(data, "pb_pump_coef", 0.55000001192092896);
+	ssc_data_set_number(data, "init_hot_htf_percent", 30);
+	ssc_data_set_number(data, "h_tank", 20);
+	ssc_data_set_number(data, "cold_tank_max_heat", 25);
+	ssc_data_set_number(data, "u_tank", 0.40000000596046448);
+	ssc_data_set_number(data, "tank_pairs", 1);
+	ssc_data_set_number(data, "cold_tank_Thtr", 250);
+	ssc_data_set_number(data, "h_tank_min", 1);
+	ssc_data_set_number(data, "hot_tank_Thtr", 365);
+	ssc_data_set_number(data, "hot_tank_max_heat", 25);
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef _UTILITYRATE5_COMMON_DATA_H_
+#define _UTILITYRATE5_COMMON_DATA_H_
+
+#include <stdio.h>
+#include <math.h>
+
+#include "code_generator_utilities.h"
+
+/**
+*  Default data for a five year residential bill with net metering, a two period tiered energy rate with
+*  TOU and flat demand charges, using the pvsamv1 residential load and a clear sky PV profile
+*/
+void utilityrate5_default(ssc_data_t &data)
+{
+	char load_path[256];
+	sprintf(load_path, "%s/test/input_cases/pvsamv1_data/pvsamv1_residential_load.csv", std::getenv("SSCDIR"));
+	set_array(data, "load", load_path, 8760);
+
+	// 3 kW peak, higher in summer
+	ssc_number_t p_gen[8760];
+	for (int i = 0; i < 8760; i++)
+	{
+		double hour_of_day = i % 24 + 0.5;
+		double day = i / 24;
+		double sun = sin(M_PI * (hour_of_day - 6.) / 12.);
+		double season = 0.75 + 0.25 * cos(2. * M_PI * (day - 172.) / 365.);
+		p_gen[i] = (ssc_number_t)(sun > 0 ? 3. * sun * season : 0.);
+	}
+	ssc_data_set_array(data, "gen", p_gen, 8760);
+
+	ssc_data_set_number(data, "analysis_period", 5);
+	ssc_data_set_number(data, "system_use_lifetime_output", 0);
+	ssc_data_set_number(data, "inflation_rate", 2.5);
+	ssc_number_t p_degradation[1] = { 0.5 };
+	ssc_data_set_array(data, "degradation", p_degradation, 1);
+	ssc_number_t p_load_escalation[1] = { 0 };
+	ssc_data_set_array(data, "load_escalation", p_load_escalation, 1);
+	ssc_number_t p_rate_escalation[1] = { 1 };
+	ssc_data_set_array(data, "rate_escalation", p_rate_escalation, 1);
+
+	ssc_data_set_number(data, "ur_metering_option", 0);
+	ssc_data_set_number(data, "ur_nm_yearend_sell_rate", 0.03f);
+	ssc_data_set_number(data, "ur_monthly_fixed_charge", 10);
+	ssc_data_set_number(data, "ur_monthly_min_charge", 5);
+	ssc_data_set_number(data, "ur_annual_min_charge", 0);
+	ssc_data_set_number(data, "ur_en_ts_sell_rate", 0);
+
+	// period 2 from 1 pm to 5 pm on weekdays, period 1 otherwise - period 2 is never in effect at the
+	// 12 am, 6 am, 12 pm or 6 pm hours used for kWh rollover
+	ssc_number_t p_sched_weekday[288], p_sched_weekend[288];
+	for (int m = 0; m < 12; m++)
+	{
+		for (int h = 0; h < 24; h++)
+		{
+			p_sched_weekday[m * 24 + h] = (h >= 13 && h < 17) ? 2.f : 1.f;
+			p_sched_weekend[m * 24 + h] = 1;
+		}
+	}
+	ssc_data_set_matrix(data, "ur_ec_sched_weekday", p_sched_weekday, 12, 24);
+	ssc_data_set_matrix(data, "ur_ec_sched_weekend", p_sched_weekend, 12, 24);
+	// period, tier, max usage, max usage units, buy rate, sell rate
+	ssc_number_t p_ur_ec_tou_mat[24] = { 1, 1, 300, 0, 0.1f, 0.05f,
+		1, 2, 9.9999996802856925e+37f, 0, 0.14f, 0.05f,
+		2, 1, 300, 0, 0.2f, 0.08f,
+		2, 2, 9.9999996802856925e+37f, 0, 0.25f, 0.08f };
+	ssc_data_set_matrix(data, "ur_ec_tou_mat", p_ur_ec_tou_mat, 4, 6);
+
+	ssc_data_set_number(data, "ur_dc_enable", 1);
+	ssc_data_set_matrix(data, "ur_dc_sched_weekday", p_sched_weekday, 12, 24);
+	ssc_data_set_matrix(data, "ur_dc_sched_weekend", p_sched_weekend, 12, 24);
+	// period, tier, peak demand, charge
+	ssc_number_t p_ur_dc_tou_mat[8] = { 1, 1, 9.9999996802856925e+37f, 2, 2, 1, 9.9999996802856925e+37f, 8 };
+	ssc_data_set_matrix(data, "ur_dc_tou_mat", p_ur_dc_tou_mat, 2, 4);
+	// month, tier, peak demand, charge
+	ssc_number_t p_ur_dc_flat_mat[48];
+	for (int m = 0; m < 12; m++)
+	{
+		p_ur_dc_flat_mat[m * 4] = (ssc_number_t)m;
+		p_ur_dc_flat_mat[m * 4 + 1] = 1;
+		p_ur_dc_flat_mat[m * 4 + 2] = 9.9999996802856925e+37f;
+		p_ur_dc_flat_mat[m * 4 + 3] = 3;
+	}
+	ssc_data_set_matrix(data, "ur_dc_flat_mat", p_ur_dc_flat_mat, 12, 4);
+}
+
+#endif
@@ -165,4 +165,145 @@ TEST_F(LeadAcidBattery, LeadAcidCapacityUnitTest_lib_battery)
 	*/
 	
 
-}
\ No newline at end of file
+}
+class BatterySnapshot : public ::testing::Test
+{
+protected:
+	std::vector<capacity_t *> capacities;
+	std::vector<voltage_t *> voltages;
+	std::vector<lifetime_cycle_t *> cycles;
+	std::vector<lifetime_calendar_t *> calendars;
+	std::vector<lifetime_t *> lifetimes;
+	std::vector<thermal_t *> thermals;
+	std::vector<losses_t *> losses;
+	std::vector<battery_t *> batteries;
+
+	battery_t * createBattery(int chem)
+	{
+		double dt_hour = 1;
+		double lifetime_vals[] = { 20, 0, 100, 20, 5000, 80, 20, 10000, 60, 80, 0, 100, 80, 1000, 80, 80, 2000, 60 };
+		util::matrix_t<double> lifetime_matrix;
+		lifetime_matrix.assign(lifetime_vals, 6, 3);
+		double cap_vals[] = { -10, 60, 0, 80, 25, 100, 40, 100 };
+		util::matrix_t<double> cap_vs_temp;
+		cap_vs_temp.assign(cap_vals, 4, 2);
+		util::matrix_t<double> calendar_matrix;
+
+		capacity_t * capacity;
+		voltage_t * voltage;
+		if (chem == battery_t::LEAD_ACID)
+		{
+			capacity = new capacity_kibam_t(415, 5, 340, 374, 100, 100, 20);
+			voltage = new voltage_dynamic_t(6, 1, 2, 2.2, 2.06, 2.03, 20.47, 0.25, 18.5, 0.05, 0.1);
+		}
+		else
+		{
+			capacity = new capacity_lithium_ion_t(225, 100, 100, 20);
+			voltage = new voltage_dynamic_t(100, 100, 3.6, 4.1, 4.05, 3.4, 2.25, 0.04, 2.0, 0.2, 0.2);
+		}
+		lifetime_cycle_t * cycle = new lifetime_cycle_t(lifetime_matrix);
+		lifetime_calendar_t * calendar = new lifetime_calendar_t(lifetime_calendar_t::LITHIUM_ION_CALENDAR_MODEL, calendar_matrix, dt_hour);
+		lifetime_t * lifetime = new lifetime_t(cycle, calendar, battery_t::NO_REPLACEMENTS, 0);
+		thermal_t * thermal = new thermal_t(507, 0.58, 0.58, 0.58, 1004, 20, 298.15, cap_vs_temp);
+		losses_t * loss = new losses_t(lifetime, thermal, capacity, losses_t::TIMESERIES, double_vec(), double_vec(), double_vec(), double_vec(8760, 0.));
+
+		battery_t * battery = new battery_t(dt_hour, chem);
+		battery->initialize(capacity, voltage, lifetime, thermal, loss);
+
+		capacities.push_back(capacity);
+		voltages.push_back(voltage);
+		cycles.push_back(cycle);
+		calendars.push_back(calendar);
+		lifetimes.push_back(lifetime);
+		thermals.push_back(thermal);
+		losses.push_back(loss);
+		batteries.push_back(battery);
+		return battery;
+	}
+
+	// alternate charge and discharge with varying depth so the rainflow counter keeps peaks
+	void runBattery(battery_t * battery, size_t idx_start, size_t n, double current)
+	{
+		for (size_t idx = idx_start; idx < idx_start + n; idx++)
+		{
+			double I = current * (1 + 0.1 * (idx % 7));
+			if ((idx / 3) % 2)
+				I = -I;
+			battery->run(idx, I);
+		}
+	}
+
+	void expectSameState(battery_t * a, battery_t * b)
+	{
+		EXPECT_DOUBLE_EQ(a->battery_soc(), b->battery_soc());
+		EXPECT_DOUBLE_EQ(a->battery_charge_total(), b->battery_charge_total());
+		EXPECT_DOUBLE_EQ(a->battery_charge_maximum(), b->battery_charge_maximum());
+		EXPECT_DOUBLE_EQ(a->battery_charge_maximum_thermal(), b->battery_charge_maximum_thermal());
+		EXPECT_DOUBLE_EQ(a->battery_voltage(), b->battery_voltage());
+		EXPECT_DOUBLE_EQ(a->capacity_model()->I(), b->capacity_model()->I());
+		EXPECT_DOUBLE_EQ(a->capacity_model()->DOD(), b->capacity_model()->DOD());
+		EXPECT_DOUBLE_EQ(a->capacity_model()->prev_DOD(), b->capacity_model()->prev_DOD());
+		EXPECT_EQ(a->capacity_model()->charge_operation(), b->capacity_model()->charge_operation());
+		EXPECT_DOUBLE_EQ(a->capacity_model()->q1(), b->capacity_model()->q1());
+		EXPECT_DOUBLE_EQ(a->thermal_model()->T_battery(), b->thermal_model()->T_battery());
+		EXPECT_DOUBLE_EQ(a->lifetime_model()->capacity_percent(), b->lifetime_model()->capacity_percent());
+		EXPECT_EQ(a->lifetime_model()->cycleModel()->cycles_elapsed(), b->lifetime_model()->cycleModel()->cycles_elapsed());
+		EXPECT_DOUBLE_EQ(a->lifetime_model()->cycleModel()->cycle_range(), b->lifetime_model()->cycleModel()->cycle_range());
+		EXPECT_DOUBLE_EQ(a->lifetime_model()->cycleModel()->computeCycleDamageAtDOD(), b->lifetime_model()->cycleModel()->computeCycleDamageAtDOD());
+	}
+
+	// compare restore_state against the deep copy path it replaced in the dispatch iterations
+	void checkRoundTrip(int chem, double current)
+	{
+		battery_t * battery = createBattery(chem);
+		battery_t * reference = createBattery(chem);
+
+		runBattery(battery, 0, 50, current);
+		runBattery(reference, 0, 50, current);
+		expectSameState(battery, reference);
+
+		battery_state state;
+		battery->save_state(state);
+		battery_t * reference_initial = new battery_t(*reference);
+		EXPECT_GT(state.peaks.size(), 0);
+
+		runBattery(battery, 50, 10, current);
+		runBattery(reference, 50, 10, 1.5 * current);
+		battery->restore_state(state);
+		reference->copy(reference_initial);
+		expectSameState(battery, reference);
+
+		// the restored battery must also evolve identically, which checks the rainflow peaks
+		runBattery(battery, 50, 40, current);
+		runBattery(reference, 50, 40, current);
+		expectSameState(battery, reference);
+
+		reference_initial->delete_clone();
+		delete reference_initial;
+	}
+
+	void TearDown()
+	{
+		for (size_t i = 0; i < batteries.size(); i++)
+		{
+			delete batteries[i];
+			delete capacities[i];
+			delete voltages[i];
+			delete cycles[i];
+			delete calendars[i];
+			delete lifetimes[i];
+			delete thermals[i];
+			delete losses[i];
+		}
+	}
+};
+
+TEST_F(BatterySnapshot, LithiumIonRoundTrip_lib_battery)
+{
+	checkRoundTrip(battery_t::LITHIUM_ION, 60);
+}
+
+TEST_F(BatterySnapshot, LeadAcidRoundTrip_lib_battery)
+{
+	checkRoundTrip(battery_t::LEAD_ACID, 40);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <lib_pv_shade_loss_mpp.h>
+
+
+TEST(libPvShadeLossMppTests, testIndexTable)
+{
+	ShadeDB8_mpp db8;
+
+	// running offset over all (N, d, t) in storage order, as the index was originally computed
+	size_t expected = 0;
+	for (size_t N = 1; N <= 8; N++)
+	{
+		for (size_t d = 1; d <= 10; d++)
+		{
+			for (size_t t = 1; t <= 10; t++)
+			{
+				size_t num_s = db8.n_choose_k(t + N - 1, t);
+				size_t ndx = 0;
+				ASSERT_TRUE(db8.get_index(N, d, t, 1, ShadeDB8_mpp::VMPP, &ndx));
+				ASSERT_EQ(ndx, expected);
+				ASSERT_TRUE(db8.get_index(N, d, t, num_s, ShadeDB8_mpp::IMPP, &ndx));
+				ASSERT_EQ(ndx, expected + (num_s - 1) * 8);
+				ASSERT_FALSE(db8.get_index(N, d, t, num_s + 1, ShadeDB8_mpp::VMPP, &ndx));
+				expected += num_s * 8;
+			}
+		}
+	}
+	// last entry ends at the size of the uint16 tables
+	ASSERT_EQ(expected, ShadeDB8_tables::vmpp_uint8_size / 2);
+
+	size_t ndx = 0;
+	ASSERT_FALSE(db8.get_index(0, 1, 1, 1, ShadeDB8_mpp::VMPP, &ndx));
+	ASSERT_FALSE(db8.get_index(9, 1, 1, 1, ShadeDB8_mpp::VMPP, &ndx));
+	ASSERT_FALSE(db8.get_index(1, 11, 1, 1, ShadeDB8_mpp::VMPP, &ndx));
+	ASSERT_FALSE(db8.get_index(1, 1, 0, 1, ShadeDB8_mpp::VMPP, &ndx));
+}
+
+TEST(libPvShadeLossMppTests, testSharedTables)
+{
+	std::weak_ptr<const ShadeDB8_tables> tables;
+	short vmpp_100 = 0;
+	{
+		std::shared_ptr<const ShadeDB8_tables> a = ShadeDB8_tables::acquire();
+		std::shared_ptr<const ShadeDB8_tables> b = ShadeDB8_tables::acquire();
+		ASSERT_EQ(a.get(), b.get());
+		tables = a;
+
+		ShadeDB8_mpp db1, db2;
+		db1.init();
+		db2.init();
+		ASSERT_EQ(db1.vmpp(100), db2.vmpp(100));
+		ASSERT_EQ(db1.impp(100), db2.impp(100));
+		ASSERT_EQ(db1.vmpp(6045839), (short)((a->vmpp()[2 * 6045839 + 1] << 8) | a->vmpp()[2 * 6045839]));
+		vmpp_100 = db1.vmpp(100);
+
+		// tables stay alive while any user still holds them
+		a.reset();
+		b.reset();
+		ASSERT_FALSE(tables.expired());
+	}
+	// and are released with the last user
+	ASSERT_TRUE(tables.expired());
+
+	// a missing pre-decompressed file falls back to the embedded database
+	ShadeDB8_mpp db3;
+	db3.init("this_file_does_not_exist.bin");
+	ASSERT_FALSE(db3.get_warning().empty());
+	ASSERT_EQ(db3.vmpp(100), vmpp_100);
+}
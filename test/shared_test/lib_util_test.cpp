@@ -13,4 +13,66 @@ TEST(libUtilTests, testFormat)
 	str = "query point (301.3, 10.4) is too far out of convex hull of data (dist=4.3)... estimating value from 5 parameter modele at (2.2, 2.1)=2.4";
 	ASSERT_EQ(util::format("query point (%lg, %lg) is too far out of convex hull of data (dist=%lg)... estimating value from 5 parameter modele at (%lg, %lg)=%lg",
 		301.3, 10.4, 4.3, 2.2, 2.1, 2.4), str);
-}
\ No newline at end of file
+}
+TEST(libUtilTests, testMatrixBorrow)
+{
+	double buf[6] = { 1, 2, 3, 4, 5, 6 };
+	util::matrix_t<double> mat;
+	mat.borrow(buf, 2, 3);
+	ASSERT_TRUE(mat.is_borrowed());
+	ASSERT_EQ(mat.data(), buf);
+	ASSERT_EQ(mat.at(1, 2), 6.0);
+
+	// copies of a borrowed matrix own their storage
+	util::matrix_t<double> cp(mat);
+	ASSERT_FALSE(cp.is_borrowed());
+	ASSERT_EQ(cp.at(1, 0), 4.0);
+
+	// resizing detaches from the caller's buffer without touching it
+	mat.resize_fill(2, 3, 0.0);
+	ASSERT_FALSE(mat.is_borrowed());
+	ASSERT_EQ(buf[5], 6.0);
+}
+
+TEST(libUtilTests, testMatrixMove)
+{
+	util::matrix_t<double> a(3, 4, 2.0);
+	const double *p = a.data();
+
+	// moves hand over the heap buffer and leave an empty 1x1 matrix
+	util::matrix_t<double> b(std::move(a));
+	ASSERT_EQ(b.data(), p);
+	ASSERT_EQ(b.nrows(), 3);
+	ASSERT_EQ(b.ncols(), 4);
+	ASSERT_EQ(a.ncells(), 1);
+
+	util::matrix_t<double> c;
+	c = std::move(b);
+	ASSERT_EQ(c.data(), p);
+	ASSERT_EQ(c.at(2, 3), 2.0);
+
+	// single values are stored inline and survive a move
+	util::matrix_t<double> s;
+	s = 5.0;
+	util::matrix_t<double> t(std::move(s));
+	ASSERT_EQ(t.value(), 5.0);
+	ASSERT_NE(t.data(), s.data());
+}
+
+TEST(libUtilTests, testMatrixAlignmentAndView)
+{
+	util::matrix_t<double> mat(4, 5, 1.5);
+	mat.at(3, 4) = 7.0;
+	mat.set_alignment(64);
+	ASSERT_EQ(reinterpret_cast<size_t>(mat.data()) % 64, 0);
+	ASSERT_EQ(mat.at(3, 4), 7.0);
+
+	mat.resize_fill(10, 10, 0.0);
+	ASSERT_EQ(reinterpret_cast<size_t>(mat.data()) % 64, 0);
+
+	util::matrix_view_t<double> view(mat);
+	mat.at(9, 9) = 3.0;
+	ASSERT_EQ(view.data(), mat.data());
+	ASSERT_EQ(view(9, 9), 3.0);
+	ASSERT_EQ(view.nrows(), 10);
+}
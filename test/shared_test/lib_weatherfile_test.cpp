@@ -1,6 +1,16 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <fstream>
+#include <sstream>
+#include <time.h>
+#ifdef _WIN32
+#include <sys/utime.h>
+#define utime _utime
+#define utimbuf _utimbuf
+#else
+#include <utime.h>
+#endif
  
 #include <gtest/gtest.h>
 #include "lib_weatherfile.h"
@@ -49,6 +59,150 @@ TEST_F(CSVCase_WeatherfileTest, initTest){
 	EXPECT_FALSE(wf.has_data_column(4));
 }
 
+static void expect_same_record(const weather_record &a, const weather_record &b, size_t i)
+{
+	const double x[] = { a.minute, a.gh, a.dn, a.df, a.poa, a.wspd, a.wdir, a.tdry, a.twet, a.tdew, a.rhum, a.pres, a.snow, a.alb, a.aod };
+	const double y[] = { b.minute, b.gh, b.dn, b.df, b.poa, b.wspd, b.wdir, b.tdry, b.twet, b.tdew, b.rhum, b.pres, b.snow, b.alb, b.aod };
+	EXPECT_EQ(a.year, b.year) << "record " << i;
+	EXPECT_EQ(a.month, b.month) << "record " << i;
+	EXPECT_EQ(a.day, b.day) << "record " << i;
+	EXPECT_EQ(a.hour, b.hour) << "record " << i;
+	for (size_t k = 0; k < sizeof(x) / sizeof(x[0]); k++)
+	{
+		if (std::isnan(x[k])) EXPECT_TRUE(std::isnan(y[k])) << "record " << i << " field " << k;
+		else EXPECT_EQ(x[k], y[k]) << "record " << i << " field " << k;
+	}
+}
+
+/// Binary columnar file reproduces the text file exactly
+TEST_F(CSVCase_WeatherfileTest, binaryRoundTrip_lib_weatherfile){
+	std::string bin = "weather-noRHum.wfbin";
+	ASSERT_TRUE(weatherfile::convert_to_wfbin(file, bin));
+
+	weatherfile wfb(bin);
+	ASSERT_TRUE(wfb.ok()) << wfb.message();
+	EXPECT_EQ(wfb.type(), wf.type());
+	EXPECT_EQ(wfb.nrecords(), wf.nrecords());
+	EXPECT_EQ(wfb.start_sec(), wf.start_sec());
+	EXPECT_EQ(wfb.step_sec(), wf.step_sec());
+	EXPECT_EQ(wfb.header().city, wf.header().city);
+	EXPECT_EQ(wfb.header().lat, wf.header().lat);
+	for (size_t k = 0; k < weather_data_provider::_MAXCOL_; k++)
+		EXPECT_EQ(wfb.has_data_column(k), wf.has_data_column(k));
+
+	weather_record r, rb;
+	for (size_t i = 0; i < wf.nrecords(); i++)
+	{
+		ASSERT_TRUE(wf.read(&r));
+		ASSERT_TRUE(wfb.read(&rb));
+		expect_same_record(r, rb, i);
+	}
+	EXPECT_FALSE(wfb.read(&rb));
+	util::remove_file(bin.c_str());
+}
+
+/// Sidecar cache is written, reused, and ignored once the source changes
+TEST_F(CSVCase_WeatherfileTest, binaryCache_lib_weatherfile){
+	std::string text;
+	{
+		std::ifstream in(file.c_str(), std::ios::binary);
+		std::stringstream ss;
+		ss << in.rdbuf();
+		text = ss.str();
+	}
+	std::string copy = "weather-cache-test.csv";
+	std::string cache = copy + ".wfbin";
+	{
+		std::ofstream out(copy.c_str(), std::ios::binary);
+		out << text;
+	}
+
+	weatherfile::enable_binary_cache(true);
+	weatherfile wf1(copy);
+	ASSERT_TRUE(wf1.ok());
+	ASSERT_TRUE(util::file_exists(cache.c_str()));
+
+	weatherfile wf2(copy);
+	ASSERT_TRUE(wf2.ok());
+	EXPECT_EQ(wf2.message(), wf1.message());
+	weather_record r, r2;
+	for (size_t i = 0; i < wf.nrecords(); i++)
+	{
+		ASSERT_TRUE(wf.read(&r));
+		ASSERT_TRUE(wf2.read(&r2));
+		expect_same_record(r, r2, i);
+	}
+
+	// same size, possibly same modification time, different content
+	std::string::size_type pos = text.find("1988,1,1,0,0,0,20.9,");
+	ASSERT_NE(pos, std::string::npos);
+	text.replace(pos, 20, "1988,1,1,0,0,0,25.9,");
+	{
+		std::ofstream out(copy.c_str(), std::ios::binary);
+		out << text;
+	}
+	weatherfile wf3(copy);
+	ASSERT_TRUE(wf3.ok());
+	ASSERT_TRUE(wf3.read(&r));
+	EXPECT_NEAR(r.tdry, 25.9, e);
+
+	weatherfile::enable_binary_cache(false);
+	util::remove_file(cache.c_str());
+	util::remove_file(copy.c_str());
+}
+
+/// An older source is keyed on size and modification time alone, without reading it
+TEST_F(CSVCase_WeatherfileTest, binaryCacheMtimeKey_lib_weatherfile){
+	std::string text;
+	{
+		std::ifstream in(file.c_str(), std::ios::binary);
+		std::stringstream ss;
+		ss << in.rdbuf();
+		text = ss.str();
+	}
+	std::string copy = "weather-cache-mtime-test.csv";
+	std::string cache = copy + ".wfbin";
+	{
+		std::ofstream out(copy.c_str(), std::ios::binary);
+		out << text;
+	}
+	struct utimbuf old_time;
+	old_time.actime = old_time.modtime = time(0) - 3600;
+	ASSERT_EQ(utime(copy.c_str(), &old_time), 0);
+
+	weatherfile::enable_binary_cache(true);
+	weatherfile wf1(copy);
+	ASSERT_TRUE(wf1.ok());
+	ASSERT_TRUE(util::file_exists(cache.c_str()));
+
+	// same size and modification time: the cache is trusted without hashing the source
+	std::string::size_type pos = text.find("1988,1,1,0,0,0,20.9,");
+	ASSERT_NE(pos, std::string::npos);
+	text.replace(pos, 20, "1988,1,1,0,0,0,25.9,");
+	{
+		std::ofstream out(copy.c_str(), std::ios::binary);
+		out << text;
+	}
+	ASSERT_EQ(utime(copy.c_str(), &old_time), 0);
+	weather_record r;
+	weatherfile wf2(copy);
+	ASSERT_TRUE(wf2.ok());
+	ASSERT_TRUE(wf2.read(&r));
+	EXPECT_NEAR(r.tdry, 20.9, e);
+
+	// a new modification time invalidates it
+	old_time.modtime += 60;
+	ASSERT_EQ(utime(copy.c_str(), &old_time), 0);
+	weatherfile wf3(copy);
+	ASSERT_TRUE(wf3.ok());
+	ASSERT_TRUE(wf3.read(&r));
+	EXPECT_NEAR(r.tdry, 25.9, e);
+
+	weatherfile::enable_binary_cache(false);
+	util::remove_file(cache.c_str());
+	util::remove_file(copy.c_str());
+}
+
 TEST_F(CSVCase_WeatherfileTest, normalizeCityTest_lib_weatherfile){
 	EXPECT_EQ("Buenos Aires", wf.normalize_city("buenos aires"));
 }
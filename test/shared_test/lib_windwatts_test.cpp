@@ -87,4 +87,44 @@ TEST_F(windPowerCalculatorTest, windPowerUsingWeibull_lib_windwatts){
 
 	double energyTotal = wpc.windPowerUsingWeibull(weibullK, avgSpeed, refHeight, &energy[0]); // runs method we want to test
 	EXPECT_NEAR(energyTotal, 5639180, e);
-}
\ No newline at end of file
+}
+TEST_F(windPowerCalculatorTest, windPowerUsingWakeTable_lib_windwatts){
+	wpc.XCoords = { 0, 400, 800 };
+	wpc.YCoords = { 0, 0, 0 };
+	std::shared_ptr<parkWakeModel> park(new parkWakeModel(nTurbines, &wt));
+	park->setRotorDiameter(wt.rotorDiameter);
+	wpc.InitializeModel(park);
+	// one evaluation per direction bin and nonzero speed bin up to past the end of the power curve
+	size_t nSpeedEvals = (size_t)ceil(wt.getPowerCurveWS().back() / 0.25) + 1;
+	EXPECT_EQ(wpc.WakeTableEvaluations(2., 0.25), 180 * nSpeedEvals);
+	EXPECT_EQ(wpc.WakeTableEvaluations(0., 0.25), (size_t)0);
+
+	ASSERT_TRUE(wpc.InitializeWakeTable(2., 0.25));
+	EXPECT_TRUE(wpc.UsingWakeTable());
+
+	std::vector<double> powerT(nTurbines), thrustT(nTurbines), effT(nTurbines), windT(nTurbines), turbT(nTurbines), ddT(nTurbines), dcT(nTurbines);
+	double farmPowerT = 0.;
+
+	// on a table node at the table density the lookup reproduces the wake model
+	wpc.windPowerUsingResource(8., 270., 1.0, 15.0, &farmPower, &power[0], &thrust[0], &eff[0], &windSpeed[0], &turbulenceCoeff[0], &distDownwind[0], &distCrosswind[0]);
+	int run = wpc.windPowerUsingWakeTable(8., 270., 1.0, 15.0, &farmPowerT, &powerT[0], &thrustT[0], &effT[0], &windT[0], &turbT[0], &ddT[0], &dcT[0]);
+	EXPECT_EQ(run, 3);
+	EXPECT_LT(farmPower, 3 * 656.49);
+	EXPECT_NEAR(farmPowerT, farmPower, 1e-6 * farmPower);
+	for (int i = 0; i < nTurbines; i++){
+		EXPECT_NEAR(windT[i], windSpeed[i], 1e-9);
+		EXPECT_NEAR(ddT[i], distDownwind[i], 1e-6);
+	}
+
+	// between nodes and at other densities the error stays small
+	double directions[] = { 269.3, 271.1, 85.7, 3.9 }, speeds[] = { 6.13, 9.87, 12.4, 4.6 };
+	for (size_t k = 0; k < 4; k++){
+		wpc.windPowerUsingResource(speeds[k], directions[k], 0.95, 28.0, &farmPower, &power[0], &thrust[0], &eff[0], &windSpeed[0], &turbulenceCoeff[0], &distDownwind[0], &distCrosswind[0]);
+		wpc.windPowerUsingWakeTable(speeds[k], directions[k], 0.95, 28.0, &farmPowerT, &powerT[0], &thrustT[0], &effT[0], &windT[0], &turbT[0], &ddT[0], &dcT[0]);
+		EXPECT_NEAR(farmPowerT, farmPower, 0.02 * farmPower) << "direction " << directions[k] << ", speed " << speeds[k];
+	}
+
+	wpc.ClearWakeTable();
+	EXPECT_FALSE(wpc.UsingWakeTable());
+	EXPECT_FALSE(wpc.InitializeWakeTable(0., 0.25));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "solarfield_test.h"
+#include "Toolbox.h"
+
+/**
+* Flux density at each point of the flux surface, evaluated one point at a time with hermiteFluxEval in the image
+* plane of each heliostat. This is the per-point form that Flux::fluxDensity evaluated before the flux points were
+* collected into arrays.
+*/
+static void fluxDensityPerPoint(Flux *flux, FluxSurface &flux_surface, Hvector &helios, std::vector<double> &result)
+{
+	FluxGrid *grid = flux_surface.getFluxMap();
+	int
+		nfx = (int)grid->size(),
+		nfy = (int)grid->at(0).size();
+	sp_point *offset = flux_surface.getSurfaceOffset();
+
+	result.assign(nfx*nfy, 0.);
+	for (size_t i = 0; i < helios.size(); i++){
+		Heliostat *H = helios.at(i);
+		if (!H->IsEnabled())
+			continue;
+		double tht = H->getWhichReceiver()->getVarMap()->optical_height.Val();
+		double cnorm = H->getArea() * H->getEfficiencyTotal() / (tht*tht);
+		double sigx, sigy;
+		H->getImageSize(sigx, sigy);
+		sp_point *aim = H->getAimPoint();
+		Vect tvr = *H->getTowerVector();
+		tvr.Set(-tvr.i, -tvr.j, -tvr.k);
+		double azpt = atan2(tvr.i, tvr.j);
+		double zenpt = acos(tvr.k);
+
+		for (int j = 0; j < nfx; j++){
+			for (int k = 0; k < nfy; k++){
+				FluxPoint *pt = &grid->at(j).at(k);
+				double f_dot_t = Toolbox::dotprod(pt->normal, tvr);
+				if (f_dot_t < 0. || f_dot_t > 1.)
+					continue;
+				sp_point pt_g, pt_ip;
+				pt_g.Set(pt->location.x + offset->x, pt->location.y + offset->y, pt->location.z + tht);
+				Toolbox::plane_intersect(*aim, tvr, pt_g, tvr, pt_ip);
+				pt_ip.Subtract(*aim);
+				Toolbox::rotation(PI - azpt, 2, pt_ip);
+				Toolbox::rotation(zenpt, 0, pt_ip);
+				double xn = -pt_ip.x / tht / sigx;
+				double yn = pt_ip.y / tht / sigy;
+				result.at(j*nfy + k) += f_dot_t * flux->hermiteFluxEval(H, xn, yn) * exp(-0.5*(xn*xn + yn*yn)) * cnorm;
+			}
+		}
+	}
+}
+
+/**
+* Expects the flux from fluxDensity to match the per-point evaluation to within round-off
+*/
+static void compareFluxDensity(SolarField &SF, Hvector &helios)
+{
+	FluxSurface &fs = SF.getReceivers()->at(0)->getFluxSurfaces()->at(0);
+	SF.getFluxObject()->fluxDensity(SF.getSimInfoObject(), fs, helios, true, false);
+
+	std::vector<double> expected;
+	fluxDensityPerPoint(SF.getFluxObject(), fs, helios, expected);
+
+	FluxGrid *grid = fs.getFluxMap();
+	int nfy = (int)grid->at(0).size();
+	double fmax = 0.;
+	for (size_t p = 0; p < expected.size(); p++)
+		fmax = std::max(fmax, expected.at(p));
+	ASSERT_GT(fmax, 0.);
+	for (size_t p = 0; p < expected.size(); p++)
+		ASSERT_NEAR(grid->at(p / nfy).at(p % nfy).flux, expected.at(p), 1.e-9*fmax) << "flux point " << p;
+}
+
+/// The flux from the whole field and from single heliostats matches the per-point Hermite evaluation
+TEST_F(SolarFieldTest, FluxDensityMatchesPointEval_Flux){
+	Hvector *helios = SF.getHeliostats();
+	compareFluxDensity(SF, *helios);
+
+	//heliostats from the inner and outer rings and from different sides of the tower
+	int ids[] = { 0, n_per_ring / 4 + 1, n_per_ring*(n_rings / 2) + n_per_ring / 2, n_rings*n_per_ring - 1 };
+	for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]); i++){
+		Hvector one(1, helios->at(ids[i]));
+		compareFluxDensity(SF, one);
+	}
+}
+
+/// Aim points away from the receiver center move the image on the flux surface the same way as the per-point evaluation
+TEST_F(SolarFieldTest, FluxDensityMatchesPointEvalOffsetAim_Flux){
+	Hvector *helios = SF.getHeliostats();
+	double tht = V.sf.tht.val;
+	double dz[] = { 4., -3., 0.5 };
+	double dxy[] = { 0., 2., -1.5 };
+
+	for (int a = 0; a < 3; a++){
+		Hvector some;
+		for (size_t i = 0; i < helios->size(); i += 7){
+			Heliostat *H = helios->at(i);
+			sp_point *aim = H->getAimPoint();
+			H->setAimPoint(aim->x + dxy[a], aim->y - dxy[a], tht + dz[a]);
+			some.push_back(H);
+		}
+		compareFluxDensity(SF, some);
+	}
+}
@@ -0,0 +1,79 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "solarfield_test.h"
+
+/**
+* Expects every heliostat that shadows or blocks H to be among the neighbors that SimulateHeliostatEfficiency 
+* takes from the neighbor index, and the losses summed over those neighbors to match a search over the whole field
+*/
+static void compareNeighbors(SolarField &SF, Heliostat *H, Vect &Sun, bool is_layout)
+{
+	double interaction_limit = SF.getVarMap()->sf.interaction_limit.val;
+
+	//neighbors from the index, as found in SimulateHeliostatEfficiency
+	helio_neighbor_index *index = SF.getNeighborIndex();
+	sp_point *loc = H->getLocation();
+	double reach = SF.calcInteractionReach(H, Sun, is_layout);
+	int row0, row1, col0, col1;
+	index->cellRange(loc->x, loc->y, reach, row0, row1, col0, col1);
+	std::set<Heliostat*> neighbors;
+	for (int r = row0; r <= row1; r++){
+		Heliostat **neib_end = index->cellEnd(r, col1);
+		for (Heliostat **neib = index->cellBegin(r, col0); neib != neib_end; neib++)
+			neighbors.insert(*neib);
+	}
+
+	//brute force search over all heliostats
+	Hvector *helios = SF.getHeliostats();
+	double shad_all = 0., block_all = 0., shad_neib = 0., block_neib = 0.;
+	for (size_t i = 0; i < helios->size(); i++){
+		Heliostat *HI = helios->at(i);
+		if (HI == H) continue;
+		double shad = is_layout ? 0. : SF.calcShadowBlock(H, HI, 0, Sun, interaction_limit);
+		double block = SF.calcShadowBlock(H, HI, 1, Sun, interaction_limit);
+		shad_all += shad;
+		block_all += block;
+		if (neighbors.count(HI) > 0){
+			shad_neib += shad;
+			block_neib += block;
+		}
+		else{
+			EXPECT_EQ(shad, 0.) << "heliostat " << HI->getId() << " shadows " << H->getId() << " but isn't a neighbor";
+			EXPECT_EQ(block, 0.) << "heliostat " << HI->getId() << " blocks " << H->getId() << " but isn't a neighbor";
+		}
+	}
+	EXPECT_EQ(shad_neib, shad_all);
+	EXPECT_EQ(block_neib, block_all);
+}
+
+/// The neighbor index finds every heliostat that shadows or blocks another one, for high and low sun positions
+TEST_F(SolarFieldTest, NeighborIndexMatchesBruteForce_SolarField){
+	//azimuth and zenith [deg] of the sun
+	double sun_pos[][2] = { { 180., 20. }, { 100., 60. }, { 250., 75. }, { 30., 85. } };
+	Hvector *helios = SF.getHeliostats();
+
+	int n_interact = 0;
+	for (int s = 0; s < 4; s++){
+		double az = sun_pos[s][0] * D2R, zen = sun_pos[s][1] * D2R;
+		Vect Sun;
+		Sun.Set(sin(zen)*sin(az), sin(zen)*cos(az), cos(zen));
+		SF.updateAllTrackVectors(Sun);
+
+		for (size_t i = 0; i < helios->size(); i++){
+			compareNeighbors(SF, helios->at(i), Sun, false);
+			compareNeighbors(SF, helios->at(i), Sun, true);
+		}
+
+		//make sure the field actually has shadowing and blocking to find
+		for (size_t i = 0; i < helios->size(); i += 3){
+			for (size_t j = 0; j < helios->size(); j++){
+				if (i == j) continue;
+				if (SF.calcShadowBlock(helios->at(i), helios->at(j), 0, Sun) != 0. || SF.calcShadowBlock(helios->at(i), helios->at(j), 1, Sun) != 0.)
+					n_interact++;
+			}
+		}
+	}
+	EXPECT_GT(n_interact, 100);
+}
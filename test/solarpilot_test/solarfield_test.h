@@ -0,0 +1,66 @@
+#ifndef __SOLARFIELD_TEST_H_
+#define __SOLARFIELD_TEST_H_
+
+#include <cmath>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "SolarField.h"
+#include "Heliostat.h"
+#include "Receiver.h"
+#include "Flux.h"
+#include "interop.h"
+
+/**
+* \class SolarFieldTest
+*
+* A small external receiver field with heliostats in staggered rings around the tower. SetUp creates the field 
+* from the default variable map and runs a Hermite flux simulation at the default flux sun position, so the 
+* heliostats have tracking vectors, aim points, image sizes and Hermite coefficients.
+*/
+class SolarFieldTest : public ::testing::Test {
+protected:
+	var_map V;
+	SolarField SF;
+	int n_rings, n_per_ring;
+
+	void SetUp() {
+		n_rings = 8;
+		n_per_ring = 72;
+
+		//use the first heliostat template
+		V.sf.temp_which.combo_clear();
+		std::string name = "Template 1", val = "0";
+		V.sf.temp_which.combo_add_choice(name, val);
+		V.sf.temp_which.combo_select_by_choice_index(0);
+
+		//rings start one tower height from the tower and are close enough together that neighbors block each 
+		//other. Every other ring is rotated by half a slot.
+		double tht = V.sf.tht.val;
+		double dr = 1.3*V.hels.front().height.val;
+		layout_shell layout(n_rings*n_per_ring);
+		for (int i = 0; i < n_rings; i++){
+			double r = tht + dr*i;
+			for (int j = 0; j < n_per_ring; j++){
+				double az = 2.*PI*(j + 0.5*(i % 2)) / (double)n_per_ring;
+				layout_obj &lo = layout.at(i*n_per_ring + j);
+				lo.helio_type = 0;
+				lo.location.Set(r*sin(az), r*cos(az), 0.02*r);	//field slopes up away from the tower
+				lo.aim.Set(0., 0., 0.);
+				lo.cant.Set(0., 0., 0.);
+				lo.focal_x = lo.focal_y = 0.;
+				lo.is_user_cant = lo.is_user_focus = lo.is_user_aim = false;
+				lo.is_enabled = lo.is_in_layout = true;
+			}
+		}
+
+		SF.Create(V, &layout);
+		SolarField::PrepareFieldLayout(SF, 0, true);	//returns false when no layout simulation is needed
+		ASSERT_TRUE(interop::PerformanceSimulationPrep(SF, *SF.getHeliostats(), 0));
+		SF.HermiteFluxSimulation(*SF.getHeliostats());
+		ASSERT_FALSE(SF.ErrCheck());
+	}
+};
+
+#endif
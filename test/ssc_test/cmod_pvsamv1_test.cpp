@@ -496,4 +496,202 @@ TEST_F(CMPvsamv1PowerIntegration, InvTempDerate) {
 
 	monthly_energy = ssc_data_get_array(data, "monthly_energy", nullptr)[11];
 	EXPECT_NEAR(monthly_energy, 740, 10) << "Month energy of December not reduced";
-}
\ No newline at end of file
+}
+/// Test that later years of a lifetime simulation replay the year one irradiance and shading results
+TEST_F(CMPvsamv1PowerIntegration, LifetimeRepeatsYearOneDC)
+{
+	std::map<std::string, double> pairs;
+	pairs["system_use_lifetime_output"] = 1;
+	pairs["analysis_period"] = 2;
+	pairs["subarray1_shade_mode"] = 1;
+	ssc_number_t p_dc_degradation[1] = { 0 };
+	ssc_data_set_array(data, "dc_degradation", p_dc_degradation, 1);
+
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+	if (!pvsam_errors)
+	{
+		int n = 0;
+		ssc_number_t *dc_net = ssc_data_get_array(data, "dc_net", &n);
+		ASSERT_EQ(n, 2 * 8760);
+		for (int i = 0; i < 8760; i++)
+			EXPECT_EQ(dc_net[i], dc_net[i + 8760]) << "dc_net differs between years at hour " << i;
+	}
+}
+
+/// Test that replaying the year one irradiance in a lifetime simulation matches recalculating it every year
+TEST_F(CMPvsamv1PowerIntegration, LifetimePOACacheMatchesRecompute)
+{
+	std::map<std::string, double> pairs;
+	pairs["system_use_lifetime_output"] = 1;
+	pairs["analysis_period"] = 3;
+	pairs["modules_per_string"] = 6;
+	pairs["inverter_count"] = 2;
+	pairs["subarray1_nstrings"] = 2;
+	pairs["subarray1_azimuth"] = 90;
+	pairs["subarray1_shade_mode"] = 1;
+	pairs["subarray1_mod_orient"] = 1;
+	pairs["subarray1_nmody"] = 1;
+	pairs["subarray1_nmodx"] = 6;
+	pairs["subarray2_enable"] = 1;
+	pairs["subarray2_nstrings"] = 2;
+	pairs["subarray2_azimuth"] = 270;
+	pairs["subarray1_shading:diff"] = 10.010875701904297;
+	pairs["subarray2_shading:diff"] = 10.278481483459473;
+	pairs["en_snow_model"] = 1;
+	set_matrix(data, "subarray1_shading:timestep", subarray1_shading, 8760, 2);
+	set_matrix(data, "subarray2_shading:timestep", subarray2_shading, 8760, 2);
+	ssc_number_t p_soiling[12] = { 5, 5, 5, 5, 6, 6, 6, 6, 5, 5, 5, 5 };
+	ssc_data_set_array(data, "subarray1_soiling", p_soiling, 12);
+	ssc_number_t p_dc_degradation[3] = { 0, 1, 2.5 };
+	ssc_data_set_array(data, "dc_degradation", p_dc_degradation, 3);
+
+	pairs["enable_lifetime_poa_cache"] = 0;
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	ASSERT_FALSE(pvsam_errors);
+	int n = 0;
+	ssc_number_t *p = ssc_data_get_array(data, "dc_net", &n);
+	ASSERT_EQ(n, 3 * 8760);
+	std::vector<ssc_number_t> dc_recomputed(p, p + n);
+	p = ssc_data_get_array(data, "gen", &n);
+	std::vector<ssc_number_t> gen_recomputed(p, p + n);
+
+	pairs["enable_lifetime_poa_cache"] = 1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	ASSERT_FALSE(pvsam_errors);
+	p = ssc_data_get_array(data, "dc_net", &n);
+	ASSERT_EQ(n, (int)dc_recomputed.size());
+	for (int i = 0; i < n; i++)
+		EXPECT_EQ(p[i], dc_recomputed[i]) << "dc_net differs at index " << i;
+	p = ssc_data_get_array(data, "gen", &n);
+	ASSERT_EQ(n, (int)gen_recomputed.size());
+	for (int i = 0; i < n; i++)
+		EXPECT_EQ(p[i], gen_recomputed[i]) << "gen differs at index " << i;
+
+	// later years must differ from year one because of degradation
+	double dc_year1 = 0, dc_year3 = 0;
+	for (int i = 0; i < 8760; i++)
+	{
+		dc_year1 += dc_recomputed[i];
+		dc_year3 += dc_recomputed[i + 2 * 8760];
+	}
+	EXPECT_LT(dc_year3, dc_year1);
+}
+
+/// Test that calculating subarray irradiance in parallel gives the same results as the serial calculation
+TEST_F(CMPvsamv1PowerIntegration, ParallelSubarraysMatchSerial)
+{
+	std::map<std::string, double> pairs;
+	pairs["subarray1_nstrings"] = 14;
+	pairs["subarray1_shade_mode"] = 1;
+	pairs["subarray2_enable"] = 1;
+	pairs["subarray2_nstrings"] = 15;
+	pairs["subarray2_azimuth"] = 90;
+	pairs["subarray3_enable"] = 1;
+	pairs["subarray3_nstrings"] = 10;
+	pairs["subarray3_track_mode"] = 1;
+	pairs["subarray4_enable"] = 1;
+	pairs["subarray4_nstrings"] = 10;
+	pairs["subarray4_tilt"] = 45;
+	pairs["enable_mismatch_vmax_calc"] = 1;
+	pairs["enable_parallel_subarrays"] = 0;
+
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	ASSERT_FALSE(pvsam_errors);
+	int n = 0;
+	ssc_number_t *p = ssc_data_get_array(data, "dc_net", &n);
+	std::vector<ssc_number_t> dc_serial(p, p + n);
+	p = ssc_data_get_array(data, "poa_eff", &n);
+	std::vector<ssc_number_t> poa_serial(p, p + n);
+
+	pairs["enable_parallel_subarrays"] = 1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	ASSERT_FALSE(pvsam_errors);
+	p = ssc_data_get_array(data, "dc_net", &n);
+	ASSERT_EQ(n, (int)dc_serial.size());
+	for (int i = 0; i < n; i++)
+		EXPECT_EQ(p[i], dc_serial[i]) << "dc_net differs at index " << i;
+	p = ssc_data_get_array(data, "poa_eff", &n);
+	ASSERT_EQ(n, (int)poa_serial.size());
+	for (int i = 0; i < n; i++)
+		EXPECT_EQ(p[i], poa_serial[i]) << "poa_eff differs at index " << i;
+}
+
+/// Test that skipping the time series output groups keeps the annual and monthly totals and drops the series
+TEST_F(CMPvsamv1PowerIntegration, OutputGroupsKeepTotals)
+{
+	std::vector<std::string> annual_outputs = { "annual_gh", "annual_poa_nom", "annual_poa_beam_nom", "annual_poa_shaded",
+		"annual_poa_shaded_soiled", "annual_poa_front", "annual_poa_rear", "annual_poa_eff", "annual_poa_beam_eff",
+		"annual_snow_loss", "annual_inv_cliploss", "annual_dc_invmppt_loss", "annual_inv_psoloss", "annual_inv_pntloss",
+		"annual_inv_tdcloss", "annual_energy" };
+	std::vector<std::string> monthly_outputs = { "monthly_snow_loss", "monthly_poa_nom", "monthly_poa_beam_nom",
+		"monthly_poa_front", "monthly_poa_rear", "monthly_poa_eff", "monthly_poa_beam_eff", "monthly_energy" };
+	std::vector<std::string> series_outputs = { "gh", "dn", "tdry", "sol_zen", "subarray1_poa_eff", "subarray1_celltemp",
+		"poa_eff", "poa_nom", "dc_snow_loss", "inv_cliploss", "inv_eff", "ac_wiring_loss", "xfmr_loss_ts" };
+
+	std::map<std::string, double> pairs;
+	pairs["en_snow_model"] = 1;
+	pairs["timeseries_output_groups"] = 0;
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	ASSERT_FALSE(pvsam_errors);
+
+	std::vector<ssc_number_t> annual_skipped;
+	for (size_t i = 0; i < annual_outputs.size(); i++)
+	{
+		SetCalculated(annual_outputs[i]);
+		annual_skipped.push_back(calculated_value);
+	}
+	std::vector<std::vector<ssc_number_t>> monthly_skipped;
+	for (size_t i = 0; i < monthly_outputs.size(); i++)
+	{
+		int n = 0;
+		ssc_number_t *p = ssc_data_get_array(data, monthly_outputs[i].c_str(), &n);
+		ASSERT_TRUE(p != nullptr) << monthly_outputs[i];
+		monthly_skipped.push_back(std::vector<ssc_number_t>(p, p + n));
+	}
+	for (size_t i = 0; i < series_outputs.size(); i++)
+		EXPECT_TRUE(ssc_data_get_array(data, series_outputs[i].c_str(), nullptr) == nullptr) << series_outputs[i] << " should not be saved";
+	EXPECT_TRUE(ssc_data_get_array(data, "gen", nullptr) != nullptr);
+
+	pairs["timeseries_output_groups"] = -1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	ASSERT_FALSE(pvsam_errors);
+
+	for (size_t i = 0; i < annual_outputs.size(); i++)
+	{
+		SetCalculated(annual_outputs[i]);
+		EXPECT_EQ(calculated_value, annual_skipped[i]) << annual_outputs[i];
+	}
+	for (size_t i = 0; i < monthly_outputs.size(); i++)
+	{
+		int n = 0;
+		ssc_number_t *p = ssc_data_get_array(data, monthly_outputs[i].c_str(), &n);
+		ASSERT_EQ(n, (int)monthly_skipped[i].size()) << monthly_outputs[i];
+		for (int m = 0; m < n; m++)
+			EXPECT_EQ(p[m], monthly_skipped[i][m]) << monthly_outputs[i] << " month " << m;
+	}
+	for (size_t i = 0; i < series_outputs.size(); i++)
+		EXPECT_TRUE(ssc_data_get_array(data, series_outputs[i].c_str(), nullptr) != nullptr) << series_outputs[i] << " should be saved";
+}
+
+/// Test that a shading database file which cannot be mapped is reported before falling back to the embedded database
+TEST_F(CMPvsamv1PowerIntegration, BadShadingDatabaseFileWarns)
+{
+	set_matrix(data, "subarray1_shading:timestep", subarray1_shading, 8760, 2);
+	ssc_data_set_number(data, "subarray1_shading:string_option", 0);
+	ssc_data_set_string(data, "shading_db_file", "this_shade_db_does_not_exist.bin");
+
+	ssc_module_exec_set_print(0);
+	ssc_module_t module = ssc_module_create("pvsamv1");
+	ASSERT_TRUE(module != nullptr);
+	EXPECT_TRUE(ssc_module_exec(module, data) != 0);
+
+	int nwarnings = 0;
+	int type = 0;
+	float time = 0;
+	for (int i = 0; const char *text = ssc_module_log(module, i, &type, &time); i++)
+		if (type == SSC_WARNING && std::string(text).find("using embedded shading database") != std::string::npos)
+			nwarnings++;
+	EXPECT_EQ(nwarnings, 1);
+	ssc_module_free(module);
+}
@@ -37,4 +37,35 @@ TEST_F(CMPvwattsV5Integration, DefaultNoFinancialModel){
 	ssc_data_get_number(data, "capacity_factor", &capacity_factor);
 	EXPECT_NEAR(capacity_factor, 19.7197, error_tolerance) << "Capacity factor";
 
-}
\ No newline at end of file
+}
+
+/// Weather loaded once and attached to two data containers gives the same results as the file
+TEST_F(CMPvwattsV5Integration, SharedWeatherHandle){
+	compute();
+	int count;
+	ssc_number_t* gen_file = ssc_data_get_array(data, "gen", &count);
+	std::vector<ssc_number_t> expected(gen_file, gen_file + count);
+
+	ssc_weather_t wf = ssc_weather_create(ssc_data_get_string(data, "solar_resource_file"));
+	ASSERT_TRUE(wf != 0);
+
+	ssc_data_t data2 = ssc_data_create();
+	pvwattsv5_nofinancial_testfile(data2);
+	ssc_data_set_weather_handle(data, "solar_resource_file", wf);
+	ssc_data_set_weather_handle(data2, "solar_resource_file", wf);
+	ssc_weather_free(wf); // the data containers keep their own references
+
+	for (ssc_data_t d : { data, data2 })
+	{
+		ssc_module_t module = ssc_module_create("pvwattsv5");
+		ASSERT_TRUE(ssc_module_exec(module, d) != 0);
+		ssc_module_free(module);
+
+		int n;
+		ssc_number_t* gen = ssc_data_get_array(d, "gen", &n);
+		ASSERT_EQ(n, count);
+		for (int i = 0; i < n; i++)
+			EXPECT_EQ(gen[i], expected[i]) << "hour " << i;
+	}
+	ssc_data_free(data2);
+}
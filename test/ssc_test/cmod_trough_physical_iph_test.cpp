@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "../ssc/core.h"
+#include "../input_cases/trough_physical_iph_common_data.h"
+
+/**
+ * CMTroughPhysicalIph runs cmod_trough_physical_iph through the SSCAPI interfaces with the default data in
+ * trough_physical_iph_common_data.h
+ */
+class CMTroughPhysicalIph : public ::testing::Test{
+
+public:
+
+	ssc_data_t data;
+
+	void SetUp()
+	{
+		data = ssc_data_create();
+		trough_physical_iph_default(data);
+	}
+	void TearDown() {
+		if (data) {
+			ssc_data_free(data);
+			data = nullptr;
+		}
+	}
+};
+
+/// Reusing receiver heat loss solutions gives the same results as solving the receiver on every call, to within
+/// the quantization of the memo inputs
+TEST_F(CMTroughPhysicalIph, EvacReceiverMemo_cmod_trough_physical_iph){
+	ssc_data_t data_memo = ssc_data_create();
+	trough_physical_iph_default(data_memo);
+
+	ssc_data_set_number(data, "evac_receiver_memo", 0);
+	ssc_data_set_number(data_memo, "evac_receiver_memo", 1);
+
+	ASSERT_FALSE(run_module(data, "trough_physical_process_heat"));
+	ASSERT_FALSE(run_module(data_memo, "trough_physical_process_heat"));
+
+	ssc_number_t annual_energy, annual_energy_memo;
+	ssc_data_get_number(data, "annual_energy", &annual_energy);
+	ssc_data_get_number(data_memo, "annual_energy", &annual_energy_memo);
+	EXPECT_GT(annual_energy, 0.);
+	EXPECT_NEAR(annual_energy_memo, annual_energy, 1.E-5*annual_energy);
+
+	// [MWt] thermal power and [C] temperature outputs
+	const char *arrays[] = { "q_dot_rec_thermal_loss", "q_dot_rec_abs", "q_dot_htf_sf_out", "T_rec_hot_out", "T_field_hot_out" };
+	double tols[] = { 1.E-3, 1.E-3, 1.E-3, 1.E-2, 1.E-2 };
+	for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++){
+		int n = 0, n_memo = 0;
+		ssc_number_t *values = ssc_data_get_array(data, arrays[i], &n);
+		ssc_number_t *values_memo = ssc_data_get_array(data_memo, arrays[i], &n_memo);
+		ASSERT_TRUE(values != nullptr && values_memo != nullptr) << arrays[i];
+		ASSERT_EQ(n, n_memo) << arrays[i];
+		for (int j = 0; j < n; j++)
+			ASSERT_NEAR(values_memo[j], values[j], tols[i]) << arrays[i] << " at step " << j;
+	}
+
+	ssc_data_free(data_memo);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "../ssc/core.h"
+#include "../input_cases/utilityrate5_common_data.h"
+
+/**
+ * CMUtilityRate5 runs cmod_utilityrate5 through the SSCAPI interfaces with the default data in
+ * utilityrate5_common_data.h, with system and load scaling that repeat across years so that some
+ * years reuse the energy and demand quantities of earlier years
+ */
+class CMUtilityRate5 : public ::testing::Test{
+
+public:
+
+	ssc_data_t data;
+
+	// expected yearly values from the model before quantities were reused
+	struct annual_values
+	{
+		const char *name;
+		double values[5];
+	};
+
+	// Expects the yearly outputs to match, skipping year 0
+	void compare_annual(const annual_values *expected, size_t n)
+	{
+		for (size_t i = 0; i < n; i++){
+			int len = 0;
+			ssc_number_t *values = ssc_data_get_array(data, expected[i].name, &len);
+			ASSERT_TRUE(values != nullptr) << expected[i].name;
+			ASSERT_EQ(len, 6) << expected[i].name;
+			for (int y = 0; y < 5; y++)
+				EXPECT_NEAR(values[y + 1], expected[i].values[y], 1e-3) << expected[i].name << " in year " << y + 1;
+		}
+	}
+
+	void SetUp()
+	{
+		data = ssc_data_create();
+		utilityrate5_default(data);
+		// years 1-2, 3 and 4-5 have the same system and load scaling
+		ssc_number_t p_degradation[5] = { 0, 0, 0.5, 0.5, 0.5 };
+		ssc_data_set_array(data, "degradation", p_degradation, 5);
+		ssc_number_t p_load_escalation[5] = { 0, 0, 0, 1, 1 };
+		ssc_data_set_array(data, "load_escalation", p_load_escalation, 5);
+	}
+	void TearDown() {
+		if (data) {
+			ssc_data_free(data);
+			data = nullptr;
+		}
+	}
+};
+
+/// Bills with monthly reconciliation match for every year, with kWh and $ rollover
+TEST_F(CMUtilityRate5, MultiYearMonthlyBills_cmod_utilityrate5){
+	ssc_data_set_number(data, "ur_metering_option", 0);
+	ASSERT_FALSE(run_module(data, "utilityrate5"));
+	annual_values expected_kwh_rollover[] = {
+		{ "utility_bill_w_sys", { 308.767761, 319.574585, 334.194977, 355.09552, 367.523895 } },
+		{ "utility_bill_wo_sys", { 1147.69153, 1187.86084, 1229.43579, 1285.53186, 1330.52539 } },
+		{ "charge_w_sys_ec", { 74.6420746, 77.2545395, 82.1392059, 90.3557816, 93.5182419 } },
+		{ "charge_w_sys_dc_tou", { 73.7008362, 76.2803726, 79.2539062, 83.4736481, 86.3952179 } },
+	};
+	compare_annual(expected_kwh_rollover, 4);
+
+	ssc_data_set_number(data, "ur_metering_option", 1);
+	ASSERT_FALSE(run_module(data, "utilityrate5"));
+	annual_values expected_dollar_rollover[] = {
+		{ "utility_bill_w_sys", { 244.706924, 253.271637, 265.264801, 282.407928, 292.292267 } },
+		{ "utility_bill_wo_sys", { 1147.69153, 1187.86084, 1229.43579, 1285.53186, 1330.52539 } },
+		{ "charge_w_sys_ec", { 2.86143303, 2.96158266, 5.52305174, 11.4829817, 11.8848839 } },
+		{ "charge_w_sys_dc_tou", { 73.7008362, 76.2803726, 79.2539062, 83.4736481, 86.3952179 } },
+	};
+	compare_annual(expected_dollar_rollover, 4);
+}
+
+/// Bills with timestep reconciliation match for every year, without rollover and with $ rollover
+TEST_F(CMUtilityRate5, MultiYearTimestepBills_cmod_utilityrate5){
+	ssc_data_set_number(data, "ur_metering_option", 2);
+	ASSERT_FALSE(run_module(data, "utilityrate5"));
+	annual_values expected_net_billing[] = {
+		{ "utility_bill_w_sys", { 398.627289, 412.579254, 429.624939, 453.591492, 469.467224 } },
+		{ "utility_bill_wo_sys", { 1147.82959, 1188.00366, 1229.58362, 1285.73523, 1330.73608 } },
+		{ "charge_w_sys_ec", { 156.341965, 161.813965, 169.779083, 182.666519, 189.059891 } },
+		{ "charge_w_sys_dc_tou", { 73.7008362, 76.2803726, 79.2539062, 83.4736481, 86.3952179 } },
+	};
+	compare_annual(expected_net_billing, 4);
+
+	ssc_data_set_number(data, "ur_metering_option", 3);
+	ASSERT_FALSE(run_module(data, "utilityrate5"));
+	annual_values expected_net_billing_dollars[] = {
+		{ "utility_bill_w_sys", { 424.187714, 439.034271, 456.823486, 481.648132, 498.505798 } },
+		{ "utility_bill_wo_sys", { 1147.82959, 1188.00366, 1229.58362, 1285.73523, 1330.73608 } },
+		{ "charge_w_sys_ec", { 194.736404, 201.55217, 210.612442, 224.74292, 232.608917 } },
+		{ "charge_w_sys_dc_tou", { 73.7008362, 76.2803726, 79.2539062, 83.4736481, 86.3952179 } },
+	};
+	compare_annual(expected_net_billing_dollars, 4);
+}
+
+/// Energy charge rollover notices are logged for every year, including years that reuse quantities
+TEST_F(CMUtilityRate5, RolloverNoticesEveryYear_cmod_utilityrate5){
+	ssc_data_set_number(data, "ur_metering_option", 0);
+	ssc_module_exec_set_print(0);
+	ssc_module_t module = ssc_module_create("utilityrate5");
+	ASSERT_TRUE(module != nullptr);
+	ASSERT_TRUE(ssc_module_exec(module, data));
+
+	int notices[5] = { 0, 0, 0, 0, 0 };
+	int i = 0, type;
+	float time;
+	const char *text;
+	while ((text = ssc_module_log(module, i++, &type, &time)) != nullptr){
+		int year = 0;
+		if (type == SSC_NOTICE && sscanf(text, "year:%d", &year) == 1 && year >= 1 && year <= 5)
+			notices[year - 1]++;
+	}
+	ssc_module_free(module);
+
+	EXPECT_GT(notices[0], 0);
+	for (int y = 1; y < 5; y++)
+		EXPECT_EQ(notices[y], notices[0]) << "year " << y + 1;
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "../ssc/common_financial.h"
+
+static void fill_cash_flows(util::matrix_t<double> &cf)
+{
+	cf.resize_fill(2, 31, 0.0);
+	// project return: investment then growing revenue
+	cf.at(0, 0) = -60e6;
+	for (int i = 1; i <= 30; i++)
+		cf.at(0, i) = (i < 5) ? 2e6 : 6e6 + 1e5 * i;
+	// no irr when the first value is positive
+	cf.at(1, 0) = 50.0;
+	for (int i = 1; i <= 30; i++)
+		cf.at(1, i) = -10.0;
+}
+
+TEST(irrPrefixCalculationTests, testWarmStartMatchesColdStart)
+{
+	util::matrix_t<double> cf;
+	fill_cash_flows(cf);
+
+	irr_prefix_calculation warm;
+	int n_solved = 0;
+	for (int i = 1; i <= 30; i++)
+	{
+		double irr_warm = warm.irr(cf, 0, i);
+		irr_prefix_calculation cold;
+		double irr_cold = cold.irr(cf, 0, i);
+		ASSERT_EQ(irr_warm != irr_warm, irr_cold != irr_cold) << "year " << i;
+		if (irr_cold != irr_cold)
+			continue;
+		n_solved++;
+		EXPECT_NEAR(irr_warm, irr_cold, 1e-6) << "year " << i;
+
+		// npv at the irr of the prefix is zero
+		double npv = 0;
+		for (int j = 0; j <= i; j++)
+			npv += cf.at(0, j) / pow(1.0 + irr_warm, j);
+		EXPECT_NEAR(npv / 60e6, 0.0, 1e-6) << "year " << i;
+	}
+	EXPECT_GT(n_solved, 20);
+}
+
+TEST(irrPrefixCalculationTests, testNoIrr)
+{
+	util::matrix_t<double> cf;
+	fill_cash_flows(cf);
+
+	irr_prefix_calculation calc;
+	EXPECT_TRUE(calc.irr(cf, 0, 0) != calc.irr(cf, 0, 0));
+	for (int i = 1; i <= 30; i++)
+	{
+		double irr = calc.irr(cf, 1, i);
+		EXPECT_TRUE(irr != irr) << "year " << i;
+	}
+}
+
+TEST(irrPrefixCalculationTests, testSignChangingCashFlows)
+{
+	// cash flows that change sign more than once can have several irrs
+	util::matrix_t<double> cf;
+	cf.resize_fill(3, 11, 0.0);
+	// irrs of 10% and 20% at year 2; the year 1 root is closer to 20%, but that isn't the cold start result
+	double two_roots[3] = { -100.0, 230.0, -132.0 };
+	for (int i = 0; i < 3; i++)
+		cf.at(0, i) = two_roots[i];
+	// investment, revenue, a mid-life refurbishment, then revenue again
+	double refurbish[11] = { -100.0, 50.0, 50.0, 50.0, 50.0, -150.0, 30.0, 30.0, 30.0, 30.0, 30.0 };
+	for (int i = 0; i < 11; i++)
+		cf.at(1, i) = refurbish[i];
+	// revenue, then decommissioning cost at the end
+	double decommission[11] = { -100.0, 60.0, 60.0, 60.0, -90.0, 40.0, 40.0, 40.0, 40.0, -30.0, -50.0 };
+	for (int i = 0; i < 11; i++)
+		cf.at(2, i) = decommission[i];
+
+	int n_years[3] = { 2, 10, 10 };
+	for (int line = 0; line < 3; line++)
+	{
+		irr_prefix_calculation warm;
+		for (int i = 1; i <= n_years[line]; i++)
+		{
+			double irr_warm = warm.irr(cf, line, i);
+			irr_prefix_calculation cold;
+			double irr_cold = cold.irr(cf, line, i);
+			ASSERT_EQ(irr_warm != irr_warm, irr_cold != irr_cold) << "line " << line << " year " << i;
+			if (irr_cold == irr_cold)
+				EXPECT_NEAR(irr_warm, irr_cold, 1e-6) << "line " << line << " year " << i;
+		}
+	}
+	irr_prefix_calculation calc;
+	EXPECT_NEAR(calc.irr(cf, 0, 1), 1.3, 1e-9);
+	EXPECT_TRUE(calc.irr(cf, 0, 2) != calc.irr(cf, 0, 2));
+}
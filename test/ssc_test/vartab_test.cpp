@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "../ssc/vartab.h"
+#include "../ssc/sscapi.h"
+
+static void count_release(ssc_number_t *, void *user_data)
+{
+	(*static_cast<int*>(user_data))++;
+}
+
+TEST(varTableTests, testBorrowedArray)
+{
+	ssc_number_t values[4] = { 1, 2, 3, 4 };
+	int released = 0;
+
+	ssc_data_t data = ssc_data_create();
+	ssc_data_set_array_ref(data, "arr", values, 4, count_release, &released);
+
+	int len = 0;
+	ssc_number_t *p = ssc_data_get_array(data, "arr", &len);
+	ASSERT_EQ(p, values);
+	ASSERT_EQ(len, 4);
+
+	// copying the table shares the reference rather than the data
+	var_table copy;
+	copy = *static_cast<var_table*>(data);
+	var_data *v = copy.lookup("arr");
+	ASSERT_TRUE(v->is_borrowed());
+	ASSERT_EQ(v->num.data(), values);
+
+	ssc_data_free(data);
+	ASSERT_EQ(released, 0);
+	copy.clear();
+	ASSERT_EQ(released, 1);
+}
+
+TEST(varTableTests, testBorrowedMatrix)
+{
+	ssc_number_t values[6] = { 1, 2, 3, 4, 5, 6 };
+
+	ssc_data_t data = ssc_data_create();
+	ssc_data_set_matrix_ref(data, "mat", values, 2, 3, 0, 0);
+	ASSERT_EQ(ssc_data_query(data, "mat"), SSC_MATRIX);
+
+	int nr = 0, nc = 0;
+	ssc_number_t *p = ssc_data_get_matrix(data, "mat", &nr, &nc);
+	ASSERT_EQ(p, values);
+	ASSERT_EQ(nr, 2);
+	ASSERT_EQ(nc, 3);
+
+	// reassigning by value detaches from the caller's memory
+	ssc_data_set_number(data, "mat", 7.0);
+	ASSERT_EQ(values[0], 1.0);
+	ssc_data_free(data);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "../tcs/CO2_prop_cache.h"
+
+/**
+ * The cache keys on the exact inputs, so cached states must be identical to the property routine's states
+ * and repeated inputs must be counted as hits.
+ */
+TEST(CO2PropCache, MatchesPropertyRoutines_co2_prop_cache){
+	C_CO2_prop_cache cache;
+	CO2_state exact, cached;
+
+	for (double T = 320.; T < 900.; T += 37.3){
+		// the repeated call is answered from the cache
+		int err = CO2_TP(T, 20000., &exact);
+		for (int pass = 0; pass < 2; pass++){
+			EXPECT_EQ(cache.TP(T, 20000., &cached), err);
+			EXPECT_EQ(cached.dens, exact.dens);
+			EXPECT_EQ(cached.enth, exact.enth);
+		}
+
+		double h = exact.enth;
+		err = CO2_PH(8000., h, &exact);
+		for (int pass = 0; pass < 2; pass++){
+			EXPECT_EQ(cache.PH(8000., h, &cached), err);
+			EXPECT_EQ(cached.temp, exact.temp);
+			EXPECT_EQ(cached.cp, exact.cp);
+		}
+	}
+	EXPECT_EQ(cache.get_n_calls(), 64);
+	EXPECT_EQ(cache.get_n_hits(), 32);
+
+	// Errors are returned for cached states as well
+	EXPECT_NE(cache.PH(70000., 500., &cached), 0);
+	EXPECT_EQ(cache.PH(70000., 500., &cached), CO2_PH(70000., 500., &exact));
+
+	cache.clear();
+	EXPECT_EQ(cache.get_n_calls(), 0);
+	EXPECT_EQ(cache.get_n_hits(), 0);
+}
@@ -0,0 +1,255 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/csp_dispatch.h"
+
+/**
+ * Collector-receiver with constant efficiencies, only the calls used by the dispatch forecast do anything
+ */
+class C_test_dispatch_cr : public C_csp_collector_receiver
+{
+public:
+	virtual void init(const C_csp_collector_receiver::S_csp_cr_init_inputs init_inputs,
+		C_csp_collector_receiver::S_csp_cr_solved_params & solved_params){}
+	virtual int get_operating_state(){ return OFF; }
+	virtual double get_startup_time(){ return 0.5*3600.; }	//[s]
+	virtual double get_startup_energy(){ return 40.; }		//[MWh]
+	virtual double get_pumping_parasitic_coef(){ return 0.0125; }
+	virtual double get_min_power_delivery(){ return 60.; }	//[MWt]
+	virtual double get_tracking_power(){ return 0.15; }		//[MWe]
+	virtual double get_col_startup_power(){ return 0.1; }	//[MWe-hr]
+	virtual void off(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info){}
+	virtual void startup(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info){}
+	virtual void on(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		double field_control, C_csp_collector_receiver::S_csp_cr_out_solver &cr_out_solver, const C_csp_solver_sim_info &sim_info){}
+	virtual void estimates(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_htf_1state &htf_state_in,
+		C_csp_collector_receiver::S_csp_cr_est_out &est_out, const C_csp_solver_sim_info &sim_info){}
+	virtual void converged(){}
+	virtual void write_output_intervals(double report_time_start,
+		const std::vector<double> & v_temp_ts_time_end, double report_time_end){}
+	virtual double calculate_optical_efficiency(const C_csp_weatherreader::S_outputs &weather, const C_csp_solver_sim_info &sim){ return 0.55; }
+	virtual double calculate_thermal_efficiency_approx(const C_csp_weatherreader::S_outputs &weather, double q_incident){ return 0.85; }
+	virtual double get_collector_area(){ return 1.2e6; }	//[m2]
+};
+
+/**
+ * Power cycle with a flat temperature response, only the calls used by the dispatch forecast do anything
+ */
+class C_test_dispatch_pc : public C_csp_power_cycle
+{
+public:
+	virtual void init(C_csp_power_cycle::S_solved_params &solved_params){}
+	virtual int get_operating_state(){ return OFF; }
+	virtual double get_cold_startup_time(){ return 0.5; }	//[hr]
+	virtual double get_warm_startup_time(){ return 0.5; }	//[hr]
+	virtual double get_hot_startup_time(){ return 0.5; }	//[hr]
+	virtual double get_standby_energy_requirement(){ return 55.; }	//[MW]
+	virtual double get_cold_startup_energy(){ return 140.; }	//[MWh]
+	virtual double get_warm_startup_energy(){ return 140.; }	//[MWh]
+	virtual double get_hot_startup_energy(){ return 140.; }	//[MWh]
+	virtual double get_max_thermal_power(){ return 290.; }		//[MW]
+	virtual double get_min_thermal_power(){ return 70.; }		//[MW]
+	virtual void get_max_power_output_operation_constraints(double T_amb, double & m_dot_HTF_ND_max, double & W_dot_ND_max)
+	{
+		m_dot_HTF_ND_max = W_dot_ND_max = 1.0;
+	}
+	virtual double get_efficiency_at_TPH(double T_degC, double P_atm, double relhum_pct, double *w_dot_condenser = 0)
+	{
+		if (w_dot_condenser != 0)
+			*w_dot_condenser = 2.0 + 0.05*T_degC;	//[MWe]
+		return 0.41*(1.0 - 0.002*(T_degC - 20.0));
+	}
+	virtual double get_efficiency_at_load(double load_frac, double *w_dot_condenser = 0)
+	{
+		return 0.41*(0.86 + 0.28*load_frac - 0.14*load_frac*load_frac);
+	}
+	virtual double get_htf_pumping_parasitic_coef(){ return 0.0055; }
+	virtual double get_max_q_pc_startup(){ return 140.; }	//[MWt]
+	virtual void call(const C_csp_weatherreader::S_outputs &weather, C_csp_solver_htf_1state &htf_state_in,
+		const C_csp_power_cycle::S_control_inputs &inputs, C_csp_power_cycle::S_csp_pc_out_solver &out_solver,
+		const C_csp_solver_sim_info &sim_info){}
+	virtual void converged(){}
+	virtual void write_output_intervals(double report_time_start,
+		const std::vector<double> & v_temp_ts_time_end, double report_time_end){}
+	virtual void assign(int index, float *p_reporting_ts_array, int n_reporting_ts_array){}
+};
+
+/**
+ * Sets up the dispatch optimization the same way C_csp_solver::Ssimulate does, for a 115 MWe tower with
+ * 10 hours of storage and a two-period price signal. Each test solves consecutive 48 hour windows a day apart.
+ */
+class CspDispatchTest : public ::testing::Test{
+protected:
+	C_csp_weatherreader wr;
+	C_csp_solver_sim_info sim_info;
+	C_test_dispatch_cr cr;
+	C_test_dispatch_pc pc;
+	int horizon;
+
+	virtual void SetUp(){
+		char hourly[150];
+		sprintf(hourly, "%s/test/input_docs/weather.csv", std::getenv("SSCDIR"));
+
+		wr.m_filename = hourly;
+		wr.m_trackmode = 0;
+		wr.m_tilt = 0;
+		wr.m_azimuth = 0.0;
+		wr.m_weather_data_provider = make_shared<weatherfile>(hourly);
+		wr.init();
+
+		sim_info.ms_ts.m_step = 3600.;
+		horizon = 48;
+	}
+
+	void setup_dispatch(csp_dispatch_opt &disp, C_csp_messages &messages, bool is_warm_start){
+		disp.copy_weather_data(wr);
+		disp.params.col_rec = &cr;
+		disp.params.mpc_pc = &pc;
+		disp.params.siminfo = &sim_info;
+		disp.params.messages = &messages;
+
+		disp.params.dt = 1.;
+		disp.params.dt_pb_startup_cold = pc.get_cold_startup_time();
+		disp.params.dt_pb_startup_hot = pc.get_hot_startup_time();
+		disp.params.q_pb_standby = pc.get_standby_energy_requirement()*1000.;
+		disp.params.e_pb_startup_cold = pc.get_cold_startup_energy()*1000.;
+		disp.params.e_pb_startup_hot = pc.get_hot_startup_energy()*1000.;
+
+		disp.params.dt_rec_startup = cr.get_startup_time() / 3600.;
+		disp.params.e_rec_startup = cr.get_startup_energy() * 1000;
+		disp.params.q_rec_min = cr.get_min_power_delivery()*1000.;
+		disp.params.w_rec_pump = cr.get_pumping_parasitic_coef();
+
+		disp.params.e_tes_init = 0.;
+		disp.params.e_tes_min = 0.;
+		disp.params.e_tes_max = 2.8e6;		//[kWht]
+		disp.params.tes_degrade_rate = 0.;
+
+		disp.params.q_pb_max = pc.get_max_thermal_power() * 1000;
+		disp.params.q_pb_min = pc.get_min_thermal_power() * 1000;
+		disp.params.q_pb_des = 280.*1000.;
+		disp.params.eta_cycle_ref = pc.get_efficiency_at_load(1.);
+		disp.params.sf_effadj = 1.;
+
+		disp.params.disp_time_weighting = 0.99;
+		disp.params.rsu_cost = 952.;
+		disp.params.csu_cost = 10000.;
+		disp.params.pen_delta_w = 0.1;
+		disp.params.q_rec_standby = 9.e99;
+		disp.params.w_rec_ht = 0.;
+		disp.params.w_track = cr.get_tracking_power()*1000.0;
+		disp.params.w_stow = cr.get_col_startup_power()*1000.0;
+		disp.params.w_cycle_pump = pc.get_htf_pumping_parasitic_coef();
+		disp.params.w_cycle_standby = disp.params.q_pb_standby*disp.params.w_cycle_pump;
+
+		disp.params.eff_table_load.clear();
+		disp.params.eff_table_load.add_point(0., 0.);
+		for (int i = 0; i < 2; i++){
+			double x = disp.params.q_pb_min + (disp.params.q_pb_max - disp.params.q_pb_min)*i;
+			disp.params.eff_table_load.add_point(x, pc.get_efficiency_at_load(x / disp.params.q_pb_des));
+		}
+
+		disp.params.eff_table_Tdb.clear();
+		disp.params.wcondcoef_table_Tdb.clear();
+		for (int i = 0; i < 40; i++){
+			double T = -10. + 60. / 39.*i;
+			double wcond;
+			double eta = pc.get_efficiency_at_TPH(T, 1., 30., &wcond) / 0.41;
+			disp.params.eff_table_Tdb.add_point(T, eta);
+			disp.params.wcondcoef_table_Tdb.add_point(T, wcond / 115.);
+		}
+
+		disp.solver_params.max_bb_iter = 10000;
+		disp.solver_params.mip_gap = 0.001;
+		disp.solver_params.solution_timeout = 5.;
+		disp.solver_params.is_warm_start = is_warm_start;
+		disp.solver_params.is_write_ampl_dat = false;
+		disp.solver_params.is_ampl_engine = false;
+	}
+
+	//window starting at 'day'. Returns the result of the optimization.
+	bool solve_window(csp_dispatch_opt &disp, int day, double e_tes_init, bool is_pb_operating0, double q_pb0){
+		disp.price_signal.clear();
+		disp.w_lim.clear();
+		for (int t = 0; t < horizon; t++){
+			int hour = t % 24;
+			disp.price_signal.push_back(hour >= 16 && hour < 21 ? 2.0 : 0.8);
+			disp.w_lim.push_back(1.e99);
+		}
+
+		disp.params.is_pb_operating0 = is_pb_operating0;
+		disp.params.is_pb_standby0 = false;
+		disp.params.is_rec_operating0 = false;
+		disp.params.q_pb0 = q_pb0;
+		disp.params.e_tes_init = e_tes_init;
+		disp.params.info_time = day*24.*3600.;
+
+		if (!disp.predict_performance(day * 24, horizon, 1))
+			return false;
+
+		disp.m_last_opt_successful = disp.optimize();
+		return disp.m_last_opt_successful;
+	}
+
+	static bool has_message(const C_csp_messages &messages, const std::string &text){
+		for (size_t i = 0; i < messages.m_message_list.size(); i++)
+			if (messages.m_message_list[i].msg.find(text) != std::string::npos)
+				return true;
+		return false;
+	}
+};
+
+/// Windows solved with the kept, warm-started model reach the same objective as solving each window from scratch
+TEST_F(CspDispatchTest, WarmStartMatchesCold_csp_dispatch){
+	csp_dispatch_opt cold, warm;
+	C_csp_messages cold_messages, warm_messages;
+	setup_dispatch(cold, cold_messages, false);
+	setup_dispatch(warm, warm_messages, true);
+
+	double e_tes = 0.;
+	bool is_pb_on = false;
+	double q_pb0 = 0.;
+	for (int day = 0; day < 4; day++){
+		ASSERT_TRUE(solve_window(cold, day, e_tes, is_pb_on, q_pb0)) << "day " << day;
+		ASSERT_TRUE(solve_window(warm, day, e_tes, is_pb_on, q_pb0)) << "day " << day;
+
+		double tol = 2.*cold.solver_params.mip_gap*fabs(cold.outputs.objective_relaxed) + 1.e-6*fabs(cold.outputs.objective);
+		EXPECT_NEAR(warm.outputs.objective, cold.outputs.objective, tol) << "day " << day;
+		EXPECT_EQ(warm.outputs.q_pb_target.size(), cold.outputs.q_pb_target.size());
+
+		//next window starts from where this one is expected to be after a day
+		e_tes = std::max(0., std::min(cold.params.e_tes_max, cold.outputs.tes_charge_expected.at(23)));
+		is_pb_on = cold.outputs.pb_operation.at(23);
+		q_pb0 = cold.outputs.q_pb_target.at(23);
+	}
+
+	//the first window may still need another scaling mode, but regular windows shouldn't have to be formulated again
+	EXPECT_FALSE(has_message(warm_messages, "Retrying with a new model.")) << "Regular windows should solve on the kept model";
+	EXPECT_FALSE(has_message(warm_messages, "Retrying without warm start."));
+}
+
+/// A window that fails on the kept model is formulated again, first with a new model and then without warm start,
+/// and the next window still solves
+TEST_F(CspDispatchTest, WarmStartRetry_csp_dispatch){
+	csp_dispatch_opt warm;
+	C_csp_messages messages;
+	setup_dispatch(warm, messages, true);
+
+	ASSERT_TRUE(solve_window(warm, 0, 0., false, 0.));
+	EXPECT_FALSE(has_message(messages, "Retrying without warm start."));
+
+	//initial charge well above capacity can't be discharged in the first hour, so the window is infeasible
+	EXPECT_FALSE(solve_window(warm, 1, 10.*warm.params.e_tes_max, false, 0.));
+	EXPECT_TRUE(has_message(messages, "Retrying with a new model."));
+	EXPECT_TRUE(has_message(messages, "Retrying without warm start."));
+
+	messages.m_message_list.clear();
+	ASSERT_TRUE(solve_window(warm, 2, 0.5*warm.params.e_tes_max, false, 0.));
+	EXPECT_FALSE(has_message(messages, "Retrying with a new model."));
+}
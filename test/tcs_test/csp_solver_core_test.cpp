@@ -281,3 +281,80 @@ protected:
 		solver->Ssimulate(sim_setup);
 	}
 };
+
+/**
+ *	Heliostat field efficiency interpolation
+ */
+TEST(Bicubic_Grid_Interp, LinearFieldIsExact){
+	// values are linear in x and y, which the Catmull-Rom stencil with extrapolated ghost nodes reproduces exactly
+	util::matrix_t<double> z(5, 7);
+	for (int j = 0; j < 5; j++)
+		for (int i = 0; i < 7; i++)
+			z(j, i) = 1.0 + 0.5 * (i * 0.5) - 2.0 * (1.0 + j * 0.25);
+
+	Bicubic_Grid_Interp grid;
+	ASSERT_TRUE(grid.Set_2D_Grid(0.0, 3.0, 1.0, 2.0, z));
+
+	double x[4] = { 0.0, 1.3, 2.95, 3.0 };
+	double y[4] = { 1.0, 1.6, 1.05, 2.0 };
+	double zb[4];
+	grid.bicubic_2D_interp(4, x, y, zb);
+	for (int k = 0; k < 4; k++){
+		EXPECT_NEAR(zb[k], 1.0 + 0.5 * x[k] - 2.0 * y[k], 1.e-12) << "point " << k;
+		EXPECT_EQ(zb[k], grid.bicubic_2D_interp(x[k], y[k])) << "batch and single point calls should match";
+	}
+
+	// points outside the grid are clamped to the edge
+	EXPECT_NEAR(grid.bicubic_2D_interp(-1.0, 3.0), 1.0 - 2.0 * 2.0, 1.e-12);
+
+	util::matrix_t<double> z_small(1, 7, 0.0);
+	EXPECT_FALSE(grid.Set_2D_Grid(0.0, 3.0, 1.0, 2.0, z_small));
+}
+
+TEST(C_pt_sf_perf_interp, GridMatchesGaussMarkov){
+	// smooth efficiency map on scattered sun positions [deg]
+	util::matrix_t<double> eta_map(17 * 8, 3);
+	int n = 0;
+	for (int i = 0; i < 17; i++){
+		for (int j = 0; j < 8; j++){
+			double az = 60. + 15. * i + 5. * sin((double)j);
+			double zen = 10. + 10. * j + 3. * cos((double)i);
+			eta_map(n, 0) = az;
+			eta_map(n, 1) = zen;
+			eta_map(n, 2) = 0.62 - 0.25 * pow(zen / 90., 2) + 0.03 * cos(az * CSP::pi / 180.);
+			n++;
+		}
+	}
+
+	C_pt_sf_perf_interp fields[2];
+	for (int k = 0; k < 2; k++){
+		C_pt_sf_perf_interp::S_params *p = &fields[k].ms_params;
+		p->m_interp_method = k == 0 ? C_pt_sf_perf_interp::INTERP_METHOD::GAUSS_MARKOV : C_pt_sf_perf_interp::INTERP_METHOD::BICUBIC_GRID;
+		p->m_eta_map = eta_map;
+		p->m_eta_map_aod_format = false;
+		p->m_flux_maps.resize_fill(n, 1, 0.0);
+		p->m_n_flux_x = p->m_n_flux_y = 1;
+		p->m_N_hel = 1;
+		p->m_A_sf = 1.;
+		p->m_p_start = p->m_p_track = 0.;
+		p->m_hel_stow_deploy = 8.;
+		p->m_v_wind_max = 15.;
+		fields[k].init();
+	}
+
+	C_csp_weatherreader::S_outputs weather;
+	weather.m_wspd = 1.;
+	weather.m_beam = 800.;
+	C_csp_solver_sim_info sim_info;
+	sim_info.ms_ts.m_step = 3600.;
+	sim_info.ms_ts.m_time = 7200.;
+	for (double az = 70.; az < 300.; az += 13.){
+		for (double zen = 12.; zen < 80.; zen += 7.){
+			weather.m_solazi = az;
+			weather.m_solzen = zen;
+			fields[0].call(weather, 1., sim_info);
+			fields[1].call(weather, 1., sim_info);
+			EXPECT_NEAR(fields[1].ms_outputs.m_eta_field, fields[0].ms_outputs.m_eta_field, 1.e-3) << "az=" << az << " zen=" << zen;
+		}
+	}
+}
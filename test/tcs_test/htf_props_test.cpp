@@ -0,0 +1,66 @@
+#include <vector>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "../tcs/htf_props.h"
+
+/**
+ * Tabulated HTF properties should match the property correlations within the reported 
+ * interpolation error, and fall back to the correlations outside of the tabulated range.
+ */
+TEST(HTFProperties, TabulatedMatchesCorrelations_htf_props){
+	int fluids[3] = { HTFProperties::Therminol_VP1, HTFProperties::Nitrate_Salt, HTFProperties::Air };
+	for (int f = 0; f < 3; f++){
+		HTFProperties exact, tab;
+		exact.SetFluid(fluids[f]);
+		tab.SetFluid(fluids[f]);
+		double err = tab.set_prop_tables(400., 900., 0.5);
+		EXPECT_TRUE(tab.is_prop_tables());
+		EXPECT_LT(err, 1.e-3) << "fluid " << fluids[f];
+
+		for (double T = 401.23; T < 900.; T += 7.77){
+			EXPECT_NEAR(tab.Cp(T), exact.Cp(T), 2.*err*fabs(exact.Cp(T))) << "fluid " << fluids[f] << " T " << T;
+			EXPECT_NEAR(tab.dens(T, 1.e5), exact.dens(T, 1.e5), 2.*err*fabs(exact.dens(T, 1.e5))) << "fluid " << fluids[f] << " T " << T;
+			EXPECT_NEAR(tab.visc(T), exact.visc(T), 2.*err*fabs(exact.visc(T))) << "fluid " << fluids[f] << " T " << T;
+			EXPECT_NEAR(tab.cond(T), exact.cond(T), 2.*err*fabs(exact.cond(T))) << "fluid " << fluids[f] << " T " << T;
+		}
+
+		// outside of the table range the correlations are used
+		EXPECT_EQ(tab.Cp(950.), exact.Cp(950.));
+		EXPECT_EQ(tab.visc(350.), exact.visc(350.));
+	}
+}
+
+TEST(HTFProperties, BatchMatchesScalar_htf_props){
+	HTFProperties htf;
+	htf.SetFluid(HTFProperties::Hitec_XL);
+	htf.set_prop_tables(500., 800., 1.0);
+
+	std::vector<double> T(50), cp(50), rho(50), mu(50), k(50), h(50);
+	for (size_t i = 0; i < T.size(); i++)
+		T[i] = 450. + 8.*i;		// includes temperatures below and above the table
+
+	htf.Cp((int)T.size(), &T[0], &cp[0]);
+	htf.dens((int)T.size(), &T[0], 1.e5, &rho[0]);
+	htf.visc((int)T.size(), &T[0], &mu[0]);
+	htf.cond((int)T.size(), &T[0], &k[0]);
+	htf.enth((int)T.size(), &T[0], &h[0]);
+	for (size_t i = 0; i < T.size(); i++){
+		EXPECT_EQ(cp[i], htf.Cp(T[i]));
+		EXPECT_EQ(rho[i], htf.dens(T[i], 1.e5));
+		EXPECT_EQ(mu[i], htf.visc(T[i]));
+		EXPECT_EQ(k[i], htf.cond(T[i]));
+		EXPECT_EQ(h[i], htf.enth(T[i]));
+	}
+
+	// changing the fluid rebuilds the tables
+	HTFProperties exact;
+	exact.SetFluid(HTFProperties::Therminol_66);
+	htf.SetFluid(HTFProperties::Therminol_66);
+	EXPECT_NEAR(htf.Cp(650.), exact.Cp(650.), 1.e-6);
+
+	htf.clear_prop_tables();
+	EXPECT_FALSE(htf.is_prop_tables());
+	EXPECT_EQ(htf.visc(651.3), exact.visc(651.3));
+}
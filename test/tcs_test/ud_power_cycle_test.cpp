@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "../tcs/ud_power_cycle.h"
+
+/**
+ * Analytic power cycle function that fails at one HTF temperature, for checking the table generator
+ */
+class C_test_pc_function : public C_od_pc_function
+{
+public:
+	double m_T_htf_fail;	//[C]
+
+	C_test_pc_function()
+	{
+		m_T_htf_fail = -999.0;
+	}
+
+	virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs)
+	{
+		if (inputs.m_T_htf_hot == m_T_htf_fail)
+			return -1;
+
+		outputs.m_W_dot_gross_ND = inputs.m_m_dot_htf_ND*(1.0 + 0.001*(inputs.m_T_htf_hot - 570.0) - 0.002*(inputs.m_T_amb - 35.0));
+		outputs.m_Q_dot_in_ND = inputs.m_m_dot_htf_ND*(1.0 + 0.0005*(inputs.m_T_htf_hot - 570.0));
+		outputs.m_W_dot_cooling_ND = outputs.m_W_dot_gross_ND;
+		outputs.m_m_dot_water_ND = 1.0;
+		return 0;
+	}
+
+	virtual C_od_pc_function * clone()
+	{
+		return new C_test_pc_function(*this);
+	}
+};
+
+TEST(UDPCTableGenerator, ThreadedMatchesSerial_ud_power_cycle){
+	C_test_pc_function pc_f;
+	util::matrix_t<double> T_htf_ind[2], T_amb_ind[2], m_dot_ind[2];
+
+	for (int k = 0; k < 2; k++){
+		C_ud_pc_table_generator generator(pc_f);
+		generator.m_n_threads = (k == 0 ? 1 : 4);
+		EXPECT_EQ(generator.generate_tables(570., 550., 585., 5,
+			35., 0., 45., 6,
+			1.0, 0.5, 1.05, 4,
+			T_htf_ind[k], T_amb_ind[k], m_dot_ind[k]), 0);
+	}
+
+	ASSERT_EQ(T_htf_ind[1].nrows(), 5);
+	ASSERT_EQ(T_amb_ind[1].nrows(), 6);
+	ASSERT_EQ(m_dot_ind[1].nrows(), 4);
+	for (size_t j = 0; j < 13; j++){
+		for (size_t i = 0; i < 5; i++)
+			EXPECT_EQ(T_htf_ind[1](i, j), T_htf_ind[0](i, j));
+		for (size_t i = 0; i < 6; i++)
+			EXPECT_EQ(T_amb_ind[1](i, j), T_amb_ind[0](i, j));
+		for (size_t i = 0; i < 4; i++)
+			EXPECT_EQ(m_dot_ind[1](i, j), m_dot_ind[0](i, j));
+	}
+	EXPECT_NEAR(T_htf_ind[1](4, 3), 1.05*1.015, 1.e-12);
+}
+
+TEST(UDPCTableGenerator, ThreadedReportsFirstFailure_ud_power_cycle){
+	C_test_pc_function pc_f;
+	pc_f.m_T_htf_fail = 585.;	// fails in the 1st table and at the high level of the 2nd table
+	util::matrix_t<double> T_htf_ind, T_amb_ind, m_dot_ind;
+
+	C_ud_pc_table_generator generator(pc_f);
+	generator.m_n_threads = 3;
+	try{
+		generator.generate_tables(570., 550., 585., 3,
+			35., 0., 45., 3,
+			1.0, 0.5, 1.05, 3,
+			T_htf_ind, T_amb_ind, m_dot_ind);
+		FAIL() << "table generation should fail";
+	}
+	catch (C_csp_exception &csp_exception){
+		EXPECT_NE(csp_exception.m_error_message.find("1st UDPC table"), std::string::npos);
+	}
+}